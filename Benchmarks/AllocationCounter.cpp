@@ -0,0 +1,77 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./AllocationCounter.h"
+
+#include <atomic> // for std::atomic
+#include <cstdlib> // for std::malloc(), std::free()
+#include <new> // for std::bad_alloc
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Number of heap allocations performed since the program started</summary>
+  std::atomic<std::size_t> allocationCount(0);
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+void *operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  void *memory = std::malloc((size == 0) ? 1 : size);
+  if(memory == nullptr) [[unlikely]] {
+    throw std::bad_alloc();
+  }
+
+  return memory;
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+namespace Nuclex::ThinOrm::Benchmarks {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t AllocationCounter::GetAllocationCount() noexcept {
+    return allocationCount.load(std::memory_order_relaxed);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Benchmarks
@@ -0,0 +1,62 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_BENCHMARKS_ALLOCATIONCOUNTER_H
+#define NUCLEX_THINORM_BENCHMARKS_ALLOCATIONCOUNTER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <celero/UserDefinedMeasurementTemplate.h> // for UserDefinedMeasurementTemplate
+
+#include <cstddef> // for std::size_t
+#include <string> // for std::string
+
+namespace Nuclex::ThinOrm::Benchmarks {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Counts the heap allocations performed by the benchmark executable</summary>
+  /// <remarks>
+  ///   The benchmark executable replaces the global operator new, so every heap allocation
+  ///   made by the library (or by the standard library on its behalf) is counted here.
+  /// </remarks>
+  class AllocationCounter {
+
+    /// <summary>Retrieves the number of heap allocations made so far</summary>
+    /// <returns>The total number of heap allocations since the program started</returns>
+    public: static std::size_t GetAllocationCount() noexcept;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Celero measurement that reports the number of allocations per operation</summary>
+  class AllocationsPerOperation : public celero::UserDefinedMeasurementTemplate<double> {
+
+    /// <summary>Provides the name under which the measurement is reported</summary>
+    /// <returns>The name of the measurement</returns>
+    public: std::string getName() const override { return "Allocations/Op"; }
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Benchmarks
+
+#endif // NUCLEX_THINORM_BENCHMARKS_ALLOCATIONCOUNTER_H
@@ -0,0 +1,228 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Connections/StandardConnectionPool.h"
+#include "Nuclex/ThinOrm/Connections/ConcurrentConnectionPool.h"
+#include "Nuclex/ThinOrm/Connections/Connection.h"
+#include "Nuclex/ThinOrm/Value.h"
+#include "Nuclex/ThinOrm/RowReader.h"
+
+#include <celero/Celero.h>
+
+#include <atomic> // for std::atomic
+#include <memory> // for std::shared_ptr
+#include <stdexcept> // for std::logic_error
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Number of borrow/return pairs each thread performs per sample</summary>
+  const std::size_t BorrowsPerThread = 1000;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Connection that doesn't connect anywhere, only used as a token</summary>
+  class DummyConnection : public Nuclex::ThinOrm::Connections::Connection {
+
+    /// <summary>Pretends to run a statement on the database</summary>
+    /// <param name="statement">Statement that will not be run</param>
+    public: void RunStatement(const Nuclex::ThinOrm::Query &statement) override {
+      (void)statement;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to run a query with a single result on the database</summary>
+    /// <param name="scalarQuery">Query that will not be run</param>
+    /// <returns>Nothing, always throws</returns>
+    public: Nuclex::ThinOrm::Value RunScalarQuery(
+      const Nuclex::ThinOrm::Query &scalarQuery
+    ) override {
+      (void)scalarQuery;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to run an updating query on the database</summary>
+    /// <param name="updateQuery">Query that will not be run</param>
+    /// <returns>Nothing, always throws</returns>
+    public: std::size_t RunUpdateQuery(const Nuclex::ThinOrm::Query &updateQuery) override {
+      (void)updateQuery;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to run a query producing rows on the database</summary>
+    /// <param name="rowQuery">Query that will not be run</param>
+    /// <returns>Nothing, always throws</returns>
+    public: std::unique_ptr<Nuclex::ThinOrm::RowReader> RunRowQuery(
+      const Nuclex::ThinOrm::Query &rowQuery
+    ) override {
+      (void)rowQuery;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to check whether a table exists</summary>
+    /// <param name="tableName">Name of the table that will not be checked</param>
+    /// <returns>Always false</returns>
+    public: bool DoesTableOrViewExist(const std::u8string &tableName) override {
+      (void)tableName;
+      return false;
+    }
+
+    /// <summary>Pretends to check whether the connection is still alive</summary>
+    /// <returns>Always true</returns>
+    public: bool CheckHealth() override { return true; }
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Factory that creates dummy connections</summary>
+  class DummyConnectionFactory : public Nuclex::ThinOrm::Connections::ConnectionFactory {
+
+    /// <summary>Creates a new dummy connection</summary>
+    /// <param name="connectionProperties">Ignored</param>
+    /// <returns>The new dummy connection</returns>
+    public: std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> Connect(
+      const Nuclex::ThinOrm::Configuration::ConnectionProperties &connectionProperties
+    ) const override {
+      (void)connectionProperties;
+      return std::make_shared<DummyConnection>();
+    }
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixture that hammers a connection pool from a varying number of threads</summary>
+  class ConnectionPoolContentionFixture : public celero::TestFixture {
+
+    /// <summary>Initializes a new connection pool contention fixture</summary>
+    public: ConnectionPoolContentionFixture() :
+      threadCount(1),
+      standardPool(),
+      concurrentPool() {}
+
+    /// <summary>Provides the thread counts the benchmarks will be run with</summary>
+    /// <returns>A list of the thread counts that will be tested</returns>
+    public: std::vector<std::shared_ptr<celero::TestFixture::ExperimentValue>>
+    getExperimentValues() const override {
+      std::vector<std::shared_ptr<celero::TestFixture::ExperimentValue>> threadCounts;
+      for(std::int64_t count = 1; count <= 32; count *= 2) {
+        threadCounts.push_back(std::make_shared<celero::TestFixture::ExperimentValue>(count));
+      }
+      return threadCounts;
+    }
+
+    /// <summary>Called before each sample is run</summary>
+    /// <param name="experimentValue">Number of threads that should borrow at once</param>
+    public: void setUp(
+      const celero::TestFixture::ExperimentValue *const experimentValue
+    ) override {
+      using Nuclex::ThinOrm::Connections::StandardConnectionPool;
+      using Nuclex::ThinOrm::Connections::ConcurrentConnectionPool;
+
+      this->threadCount = static_cast<std::size_t>(experimentValue->Value);
+
+      // Both pools retain enough connections for every thread, so neither has to
+      // establish connections while the sample is running
+      std::shared_ptr<DummyConnectionFactory> factory = (
+        std::make_shared<DummyConnectionFactory>()
+      );
+      this->standardPool = std::make_unique<StandardConnectionPool<>>(
+        factory, Nuclex::ThinOrm::Configuration::ConnectionString(), this->threadCount
+      );
+      this->standardPool->Ready(this->threadCount);
+      this->concurrentPool = std::make_unique<ConcurrentConnectionPool<>>(
+        factory, Nuclex::ThinOrm::Configuration::ConnectionString(), this->threadCount
+      );
+    }
+
+    /// <summary>Called after each sample has been run</summary>
+    public: void tearDown() override {
+      this->concurrentPool.reset();
+      this->standardPool.reset();
+    }
+
+    /// <summary>Lets the configured number of threads borrow and return connections</summary>
+    /// <param name="pool">Connection pool the threads will borrow from</param>
+    protected: void borrowAndReturnConcurrently(
+      Nuclex::ThinOrm::Connections::ConnectionPool &pool
+    ) {
+      std::atomic<bool> go = false;
+
+      std::vector<std::thread> threads;
+      threads.reserve(this->threadCount);
+      for(std::size_t index = 0; index < this->threadCount; ++index) {
+        threads.emplace_back(
+          [&pool, &go]() {
+            while(!go.load(std::memory_order_acquire)) {
+              std::this_thread::yield();
+            }
+            for(std::size_t iteration = 0; iteration < BorrowsPerThread; ++iteration) {
+              std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> connection = (
+                pool.BorrowConnection()
+              );
+              celero::DoNotOptimizeAway(connection.get());
+              pool.ReturnConnection(connection);
+            }
+          }
+        );
+      }
+
+      go.store(true, std::memory_order_release);
+      for(std::thread &thread : threads) {
+        thread.join();
+      }
+    }
+
+    /// <summary>Number of threads that will borrow connections at the same time</summary>
+    protected: std::size_t threadCount;
+    /// <summary>Connection pool using a single mutex</summary>
+    protected: std::unique_ptr<
+      Nuclex::ThinOrm::Connections::StandardConnectionPool<>
+    > standardPool;
+    /// <summary>Connection pool using sharded mutexes with thread affinity</summary>
+    protected: std::unique_ptr<
+      Nuclex::ThinOrm::Connections::ConcurrentConnectionPool<>
+    > concurrentPool;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE_F(ConnectionPool, StandardPool, ConnectionPoolContentionFixture, 10, 10) {
+  borrowAndReturnConcurrently(*this->standardPool);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(ConnectionPool, ConcurrentPool, ConnectionPoolContentionFixture, 10, 10) {
+  borrowAndReturnConcurrently(*this->concurrentPool);
+}
+
+// --------------------------------------------------------------------------------------------- //
@@ -0,0 +1,100 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "../Source/Utilities/Iso8601Converter.h" // for Iso8601Converter
+
+#include <celero/Celero.h>
+
+#include <string_view> // for std::u8string_view
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Date and time in the ISO 8601 extended format as SQLite stores them</summary>
+  const std::u8string_view extendedDateTime(u8"2024-05-17T12:34:56");
+
+  /// <summary>Date and time in the ISO 8601 basic format with a time zone</summary>
+  const std::u8string_view basicDateTimeWithZone(u8"20240517T123456+0200");
+
+  /// <summary>Time of day in the ISO 8601 extended format</summary>
+  const std::u8string_view extendedTime(u8"12:34:56");
+
+  /// <summary>Tick count matching the date and time in the strings above</summary>
+  const std::int64_t dateTimeTicks = 638515460960000000;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(Iso8601Parse, ExtendedDateTime, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::Iso8601Converter;
+  celero::DoNotOptimizeAway(Iso8601Converter::ParseIso8601DateTime(extendedDateTime));
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(Iso8601Parse, BasicDateTimeWithZone, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::Iso8601Converter;
+  celero::DoNotOptimizeAway(Iso8601Converter::ParseIso8601DateTime(basicDateTimeWithZone));
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(Iso8601Parse, ExtendedTime, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::Iso8601Converter;
+  celero::DoNotOptimizeAway(Iso8601Converter::ParseIso8601Time(extendedTime));
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(Iso8601Print, DateTime, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::Iso8601Converter;
+
+  char8_t characters[19];
+  Iso8601Converter::PrintIso8601DateTime(characters, dateTimeTicks);
+  celero::DoNotOptimizeAway(characters[18]);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(Iso8601Print, Date, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::Iso8601Converter;
+
+  char8_t characters[10];
+  Iso8601Converter::PrintIso8601Date(characters, dateTimeTicks);
+  celero::DoNotOptimizeAway(characters[9]);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(Iso8601Print, Time, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::Iso8601Converter;
+
+  char8_t characters[8];
+  Iso8601Converter::PrintIso8601Time(characters, dateTimeTicks);
+  celero::DoNotOptimizeAway(characters[7]);
+}
+
+// --------------------------------------------------------------------------------------------- //
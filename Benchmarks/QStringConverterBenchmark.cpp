@@ -0,0 +1,92 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "../Source/Utilities/QStringConverter.h" // for QStringConverter
+
+#if defined(NUCLEX_THINORM_ENABLE_QT)
+
+#include <celero/Celero.h>
+
+#include <string> // for std::u8string
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Short ASCII-only text such as a typical name or identifier</summary>
+  const std::u8string shortAsciiText(u8"jane.doe@example.com");
+
+  /// <summary>Short text containing characters outside of the ASCII range</summary>
+  const std::u8string shortInternationalText(u8"Grüße aus Köln, ¡olé! 日本語");
+
+  /// <summary>Longer ASCII-only text such as a description column</summary>
+  const std::u8string longAsciiText(
+    u8"The quick brown fox jumps over the lazy dog. The quick brown fox jumps over "
+    u8"the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox "
+    u8"jumps over the lazy dog. The quick brown fox jumps over the lazy dog."
+  );
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Converts a UTF-8 string into a QString and back</summary>
+  /// <param name="text">Text that will be converted back and forth</param>
+  /// <returns>The length of the text after its round trip</returns>
+  std::size_t roundTrip(const std::u8string &text) {
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+    return QStringConverter::ToU8(QStringConverter::FromU8(text)).length();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(QStringRoundTrip, ShortAscii, 30, 100000) {
+  celero::DoNotOptimizeAway(roundTrip(shortAsciiText));
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(QStringRoundTrip, ShortInternational, 30, 100000) {
+  celero::DoNotOptimizeAway(roundTrip(shortInternationalText));
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(QStringRoundTrip, LongAscii, 30, 100000) {
+  celero::DoNotOptimizeAway(roundTrip(longAsciiText));
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(QStringRoundTrip, AppendToExisting, 30, 100000) {
+  using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+  QString target(QStringLiteral("SELECT "));
+  QStringConverter::AppendU8(target, shortAsciiText.data(), shortAsciiText.length());
+  celero::DoNotOptimizeAway(target.length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+#endif // defined(NUCLEX_THINORM_ENABLE_QT)
@@ -0,0 +1,108 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Query.h"
+#include "Nuclex/ThinOrm/Value.h"
+
+#include <celero/Celero.h>
+
+#include <string> // for std::u8string
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>SQL statement of a typical size with a handful of parameters</summary>
+  const std::u8string insertStatement(
+    u8"INSERT INTO customers (id, name, email, phone, created) "
+    u8"VALUES ({id}, {name}, {email}, {phone}, {created})"
+  );
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixture that provides a query whose parameters can be assigned</summary>
+  class QueryParameterFixture : public celero::TestFixture {
+
+    /// <summary>Initializes a new query parameter fixture</summary>
+    public: QueryParameterFixture() :
+      query(insertStatement),
+      customerName(std::u8string(u8"Jane Doe")) {
+      this->query.SetParameterValue(1, this->customerName);
+    }
+
+    /// <summary>Query whose parameters will be assigned and read</summary>
+    protected: Nuclex::ThinOrm::Query query;
+    /// <summary>Value that will be assigned to the name parameter</summary>
+    protected: Nuclex::ThinOrm::Value customerName;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(QueryConstruction, ParseStatement, 30, 10000) {
+  Nuclex::ThinOrm::Query query(insertStatement);
+  celero::DoNotOptimizeAway(query.CountParameters());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(QueryConstruction, InternedStatement, 30, 10000) {
+  Nuclex::ThinOrm::Query query = Nuclex::ThinOrm::Query::FromInternedStatement(insertStatement);
+  celero::DoNotOptimizeAway(query.CountParameters());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(QueryConstruction, CopyQuery, QueryParameterFixture, 30, 10000) {
+  Nuclex::ThinOrm::Query copy(this->query);
+  celero::DoNotOptimizeAway(copy.CountParameters());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE_F(QueryParameters, SetByIndex, QueryParameterFixture, 30, 100000) {
+  this->query.SetParameterValue(1, this->customerName);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(QueryParameters, SetByName, QueryParameterFixture, 30, 100000) {
+  this->query.SetParameterValue(u8"name", this->customerName);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(QueryParameters, GetByIndex, QueryParameterFixture, 30, 100000) {
+  celero::DoNotOptimizeAway(this->query.GetParameterValue(1).GetType());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(QueryParameters, GetByName, QueryParameterFixture, 30, 100000) {
+  celero::DoNotOptimizeAway(this->query.GetParameterValue(u8"name").GetType());
+}
+
+// --------------------------------------------------------------------------------------------- //
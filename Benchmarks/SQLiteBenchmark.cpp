@@ -0,0 +1,357 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "../Source/Connections/SQLite/SQLiteConnection.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "../Source/Platform/SQLite3Api.h" // for SQLite3Api
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Value.h" // for Value
+#include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+#include "Nuclex/ThinOrm/RowBatch.h" // for RowBatch
+#include "Nuclex/ThinOrm/ParameterRowSource.h" // for ParameterRowSource
+#include "Nuclex/ThinOrm/Fluent/BulkInsertBuilder.h" // for BulkInsertBuilder
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+#include "Nuclex/ThinOrm/Fluent/Table.h" // for Table
+#include "Nuclex/ThinOrm/DataContext.h" // for DataContext
+
+#include <celero/Celero.h>
+
+#include <memory> // for std::shared_ptr
+#include <optional> // for std::optional
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Number of rows the table is filled with before each sample</summary>
+  const std::int32_t PrefilledRowCount = 1000;
+
+  /// <summary>Number of rows each select benchmark reads per iteration</summary>
+  const std::int32_t SelectedRowCount = 100;
+
+  /// <summary>Number of rows each bulk insert benchmark writes per iteration</summary>
+  const std::int32_t BulkInsertedRowCount = 100;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Entity class the customers table is mapped to</summary>
+  class Customer {
+
+    /// <summary>Unique id of the customer</summary>
+    public: std::int32_t Id;
+    /// <summary>Full name of the customer</summary>
+    public: std::u8string Name;
+    /// <summary>Email address through which the customer can be contacted</summary>
+    public: std::optional<std::u8string> Email;
+    /// <summary>Amount of money in the customer's account</summary>
+    public: double Balance;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides an entity registry in which the customer entity is mapped</summary>
+  /// <returns>The entity registry holding the customer mapping</returns>
+  Nuclex::ThinOrm::Fluent::GlobalEntityRegistry &getCustomerRegistry() {
+    static Nuclex::ThinOrm::Fluent::GlobalEntityRegistry registry;
+    static bool isRegistered = false;
+    if(!isRegistered) {
+      registry.RegisterTable<Customer>(u8"customers").
+        WithColumn<&Customer::Id>(u8"id").NotNull().PrimaryKey().
+        WithColumn<&Customer::Name>(u8"name").NotNull().
+        WithColumn<&Customer::Email>(u8"email").
+        WithColumn<&Customer::Balance>(u8"balance").NotNull();
+      isRegistered = true;
+    }
+
+    return registry;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides a fixed number of generated customer rows</summary>
+  class CustomerRowSource : public Nuclex::ThinOrm::ParameterRowSource {
+
+    /// <summary>Initializes a new customer row source</summary>
+    /// <param name="firstId">Id that will be assigned to the first customer</param>
+    /// <param name="rowCount">Number of customer rows that will be provided</param>
+    public: CustomerRowSource(std::int32_t firstId, std::int32_t rowCount) :
+      nextId(firstId),
+      endId(firstId + rowCount) {}
+
+    /// <summary>Assigns the parameter values of the next row to the query</summary>
+    /// <param name="query">Query whose parameter values will be assigned</param>
+    /// <returns>True if a row was assigned, false if there are no more rows</returns>
+    public: bool AssignNextRow(Nuclex::ThinOrm::Query &query) override {
+      using Nuclex::ThinOrm::Value;
+
+      if(this->nextId >= this->endId) {
+        return false;
+      }
+
+      query.SetParameterValue(0, Value(this->nextId));
+      query.SetParameterValue(1, Value(std::u8string_view(u8"Jane Doe")));
+      query.SetParameterValue(2, Value(std::u8string_view(u8"jane.doe@example.com")));
+      query.SetParameterValue(3, Value(1234.5));
+
+      ++this->nextId;
+      return true;
+    }
+
+    /// <summary>Id that will be assigned to the next customer</summary>
+    private: std::int32_t nextId;
+    /// <summary>Id at which the row source stops providing customers</summary>
+    private: std::int32_t endId;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixture that provides an in-memory SQLite database with a filled table</summary>
+  class SQLiteDatabaseFixture : public celero::TestFixture {
+
+    /// <summary>Initializes a new SQLite database fixture</summary>
+    public: SQLiteDatabaseFixture() :
+      connection(),
+      insertQuery(
+        u8"INSERT INTO customers (id, name, email, balance) "
+        u8"VALUES ({id}, {name}, {email}, {balance})"
+      ),
+      selectScalarQuery(u8"SELECT name FROM customers WHERE id = {id}"),
+      selectRowsQuery(
+        u8"SELECT id, name, email, balance FROM customers WHERE id >= {first} LIMIT {count}"
+      ),
+      bulkInsertBuilder(u8"customers", { u8"id", u8"name", u8"email", u8"balance" }),
+      nextId(0) {}
+
+    /// <summary>Called before each sample is run</summary>
+    public: void setUp(const celero::TestFixture::ExperimentValue *const) override {
+      using Nuclex::ThinOrm::Platform::SQLite3Api;
+      using Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection;
+
+      this->connection = std::make_shared<SQLiteConnection>(
+        SQLite3Api::Open(std::u8string(u8":memory:"))
+      );
+      this->connection->RunStatement(
+        Nuclex::ThinOrm::Query(
+          u8"CREATE TABLE customers ("
+          u8"id INTEGER PRIMARY KEY, name TEXT, email TEXT, balance REAL"
+          u8")"
+        )
+      );
+
+      this->nextId = 0;
+      this->connection->RunStatement(Nuclex::ThinOrm::Query(u8"BEGIN"));
+      for(std::int32_t index = 0; index < PrefilledRowCount; ++index) {
+        insertRow(this->insertQuery);
+      }
+      this->connection->RunStatement(Nuclex::ThinOrm::Query(u8"COMMIT"));
+    }
+
+    /// <summary>Called after each sample has been run</summary>
+    public: void tearDown() override {
+      this->connection.reset();
+    }
+
+    /// <summary>Inserts a new row into the customers table</summary>
+    /// <param name="query">Query that will be used to insert the row</param>
+    protected: void insertRow(Nuclex::ThinOrm::Query &query) {
+      using Nuclex::ThinOrm::Value;
+
+      query.SetParameterValue(0, Value(this->nextId));
+      query.SetParameterValue(1, Value(std::u8string_view(u8"Jane Doe")));
+      query.SetParameterValue(2, Value(std::u8string_view(u8"jane.doe@example.com")));
+      query.SetParameterValue(3, Value(1234.5));
+      this->connection->RunUpdateQuery(query);
+
+      ++this->nextId;
+    }
+
+    /// <summary>Connection to the in-memory database</summary>
+    protected: std::shared_ptr<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection> connection;
+    /// <summary>Query that inserts a customer into the database</summary>
+    protected: Nuclex::ThinOrm::Query insertQuery;
+    /// <summary>Query that looks up the name of a single customer</summary>
+    protected: Nuclex::ThinOrm::Query selectScalarQuery;
+    /// <summary>Query that fetches a range of customers</summary>
+    protected: Nuclex::ThinOrm::Query selectRowsQuery;
+    /// <summary>Generates and caches multi-row insert statements for customers</summary>
+    protected: Nuclex::ThinOrm::Fluent::BulkInsertBuilder bulkInsertBuilder;
+    /// <summary>Id that will be assigned to the next inserted customer</summary>
+    protected: std::int32_t nextId;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE_F(SQLiteInsert, ReusedQuery, SQLiteDatabaseFixture, 10, 1000) {
+  insertRow(this->insertQuery);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteInsert, FreshQuery, SQLiteDatabaseFixture, 10, 1000) {
+  // Each new query gets its own statement id, so the connection has to prepare it again
+  Nuclex::ThinOrm::Query query(this->insertQuery.GetSqlStatement());
+  insertRow(query);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE_F(SQLiteBulkInsert, LoopedUpdateQueries, SQLiteDatabaseFixture, 10, 100) {
+  for(std::int32_t index = 0; index < BulkInsertedRowCount; ++index) {
+    insertRow(this->insertQuery);
+  }
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteBulkInsert, RunBatch, SQLiteDatabaseFixture, 10, 100) {
+  CustomerRowSource rowSource(this->nextId, BulkInsertedRowCount);
+  std::vector<std::size_t> affectedRowCounts = (
+    this->connection->RunBatch(this->insertQuery, rowSource)
+  );
+  celero::DoNotOptimizeAway(affectedRowCounts.size());
+
+  this->nextId += BulkInsertedRowCount;
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteBulkInsert, MultiRowInsert, SQLiteDatabaseFixture, 10, 100) {
+  using Nuclex::ThinOrm::Value;
+
+  std::vector<std::vector<Value>> rows;
+  rows.reserve(BulkInsertedRowCount);
+  for(std::int32_t index = 0; index < BulkInsertedRowCount; ++index) {
+    rows.push_back(
+      {
+        Value(this->nextId + index),
+        Value(std::u8string_view(u8"Jane Doe")),
+        Value(std::u8string_view(u8"jane.doe@example.com")),
+        Value(1234.5)
+      }
+    );
+  }
+
+  // All rows go into a single statement since SQLite allows enough parameters
+  std::size_t insertedRowCount = this->bulkInsertBuilder.Insert(*this->connection, rows);
+  celero::DoNotOptimizeAway(insertedRowCount);
+
+  this->nextId += BulkInsertedRowCount;
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE_F(SQLiteSelect, ScalarById, SQLiteDatabaseFixture, 30, 10000) {
+  using Nuclex::ThinOrm::Value;
+
+  this->selectScalarQuery.SetParameterValue(0, Value(this->nextId % PrefilledRowCount));
+  Value name = this->connection->RunScalarQuery(this->selectScalarQuery);
+  celero::DoNotOptimizeAway(name.GetType());
+
+  ++this->nextId;
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteSelect, RowsViaMoveToNext, SQLiteDatabaseFixture, 30, 1000) {
+  using Nuclex::ThinOrm::Value;
+
+  this->selectRowsQuery.SetParameterValue(0, Value(std::int32_t(0)));
+  this->selectRowsQuery.SetParameterValue(1, Value(SelectedRowCount));
+  std::unique_ptr<Nuclex::ThinOrm::RowReader> reader = (
+    this->connection->RunRowQuery(this->selectRowsQuery)
+  );
+
+  // Every cell read here is boxed into a Value
+  double balanceSum = 0.0;
+  while(reader->MoveToNext()) {
+    celero::DoNotOptimizeAway(reader->GetColumnValue(0).GetType());
+    celero::DoNotOptimizeAway(reader->GetColumnValue(1).GetType());
+    celero::DoNotOptimizeAway(reader->GetColumnValue(2).GetType());
+    balanceSum += static_cast<double>(reader->GetColumnValue(3));
+  }
+  celero::DoNotOptimizeAway(balanceSum);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteSelect, RowsViaFetchBatch, SQLiteDatabaseFixture, 30, 1000) {
+  using Nuclex::ThinOrm::Value;
+
+  this->selectRowsQuery.SetParameterValue(0, Value(std::int32_t(0)));
+  this->selectRowsQuery.SetParameterValue(1, Value(SelectedRowCount));
+  std::unique_ptr<Nuclex::ThinOrm::RowReader> reader = (
+    this->connection->RunRowQuery(this->selectRowsQuery)
+  );
+
+  Nuclex::ThinOrm::RowBatch batch;
+  double balanceSum = 0.0;
+  while(reader->FetchBatch(batch, 64) > 0) {
+    for(double balance : batch.GetColumn(3).GetDoubles()) {
+      balanceSum += balance;
+    }
+  }
+  celero::DoNotOptimizeAway(balanceSum);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteSelect, EntitiesViaTable, SQLiteDatabaseFixture, 30, 1000) {
+  Nuclex::ThinOrm::DataContext dataContext(this->connection, getCustomerRegistry());
+  Nuclex::ThinOrm::Fluent::Table<Customer> customers(dataContext);
+
+  // Rows are read straight into the entities, there's no Value per cell
+  std::vector<Customer> selectedCustomers = customers.Take(SelectedRowCount).ToVector();
+
+  double balanceSum = 0.0;
+  for(const Customer &customer : selectedCustomers) {
+    balanceSum += customer.Balance;
+  }
+  celero::DoNotOptimizeAway(balanceSum);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(SQLiteSelect, EntitiesViaEnumerator, SQLiteDatabaseFixture, 30, 1000) {
+  Nuclex::ThinOrm::DataContext dataContext(this->connection, getCustomerRegistry());
+  Nuclex::ThinOrm::Fluent::Table<Customer> customers(dataContext);
+
+  // All rows are read into the same entity, so nothing is allocated per row
+  double balanceSum = 0.0;
+  for(const Customer &customer : customers.Take(SelectedRowCount).Enumerate()) {
+    balanceSum += customer.Balance;
+  }
+  celero::DoNotOptimizeAway(balanceSum);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
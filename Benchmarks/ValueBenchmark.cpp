@@ -0,0 +1,459 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Value.h"
+#include "Nuclex/ThinOrm/Decimal.h"
+#include "Nuclex/ThinOrm/DateTime.h"
+
+#include "./AllocationCounter.h"
+
+#include <celero/Celero.h>
+
+#include <array> // for std::array
+#include <cstddef> // for std::byte
+#include <span> // for std::span
+#include <memory> // for std::shared_ptr
+#include <string_view> // for std::u8string_view
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Text cells of a simulated result row with typical lengths of text columns</summary>
+  const std::array<std::u8string_view, 8> rowCells = {
+    u8"Jane Doe",
+    u8"jane.doe@example.com",
+    u8"+1 555 0100 1234",
+    u8"221B Baker Street",
+    u8"London",
+    u8"United Kingdom",
+    u8"2024-05-17T12:34:56Z",
+    u8"Customer since the very first day"
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixture that tracks how many heap allocations each processed row caused</summary>
+  class RowAllocationFixture : public celero::TestFixture {
+
+    /// <summary>Initializes a new row allocation fixture</summary>
+    public: RowAllocationFixture() :
+      allocationsPerRow(std::make_shared<Nuclex::ThinOrm::Benchmarks::AllocationsPerOperation>()),
+      startAllocationCount(0),
+      rowCount(0),
+      totalLength(0) {}
+
+    /// <summary>Provides the custom measurements this fixture records</summary>
+    /// <returns>A list containing the allocations per row measurement</returns>
+    public: std::vector<std::shared_ptr<celero::UserDefinedMeasurement>>
+    getUserDefinedMeasurements() const override {
+      return { this->allocationsPerRow };
+    }
+
+    /// <summary>Called before each sample is run</summary>
+    public: void setUp(const celero::TestFixture::ExperimentValue *const) override {
+      this->rowCount = 0;
+      this->startAllocationCount = (
+        Nuclex::ThinOrm::Benchmarks::AllocationCounter::GetAllocationCount()
+      );
+    }
+
+    /// <summary>Called after each sample has been run</summary>
+    public: void tearDown() override {
+      std::size_t allocationCount = (
+        Nuclex::ThinOrm::Benchmarks::AllocationCounter::GetAllocationCount() -
+        this->startAllocationCount
+      );
+      if(this->rowCount > 0) {
+        this->allocationsPerRow->addValue(
+          static_cast<double>(allocationCount) / static_cast<double>(this->rowCount)
+        );
+      }
+    }
+
+    /// <summary>Measurement that receives the number of allocations per row</summary>
+    protected: std::shared_ptr<
+      Nuclex::ThinOrm::Benchmarks::AllocationsPerOperation
+    > allocationsPerRow;
+    /// <summary>Number of allocations that had been made when the sample started</summary>
+    protected: std::size_t startAllocationCount;
+    /// <summary>Number of rows that have been processed in the current sample</summary>
+    protected: std::size_t rowCount;
+    /// <summary>Accumulated string lengths, keeps the compiler from skipping work</summary>
+    protected: std::size_t totalLength;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Binary data of a typical length for a small blob column</summary>
+  const std::array<std::byte, 16> blobCell = {
+    std::byte(0x00), std::byte(0x11), std::byte(0x22), std::byte(0x33),
+    std::byte(0x44), std::byte(0x55), std::byte(0x66), std::byte(0x77),
+    std::byte(0x88), std::byte(0x99), std::byte(0xAA), std::byte(0xBB),
+    std::byte(0xCC), std::byte(0xDD), std::byte(0xEE), std::byte(0xFF)
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Tick count of a date with time used for the date and time benchmarks</summary>
+  const std::int64_t dateTimeTicks = 638515460960000000; // 2024-05-17T12:34:56
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE_F(ValueRow, CopyIntoStrings, RowAllocationFixture, 30, 10000) {
+  using Nuclex::ThinOrm::Value;
+
+  // This is how values were filled and read before values could adopt strings or hand
+  // out views: a temporary string is built, copied into the value, then copied out again.
+  for(const std::u8string_view &cell : rowCells) {
+    const std::u8string text(cell);
+    Value value(text);
+    this->totalLength += value.AsString().value().length();
+  }
+
+  ++this->rowCount;
+  celero::DoNotOptimizeAway(this->totalLength);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(ValueRow, MoveIntoStrings, RowAllocationFixture, 30, 10000) {
+  using Nuclex::ThinOrm::Value;
+
+  for(const std::u8string_view &cell : rowCells) {
+    Value value(std::u8string{cell});
+    this->totalLength += value.GetStringView().value().length();
+  }
+
+  ++this->rowCount;
+  celero::DoNotOptimizeAway(this->totalLength);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK_F(ValueRow, ConstructFromViews, RowAllocationFixture, 30, 10000) {
+  using Nuclex::ThinOrm::Value;
+
+  for(const std::u8string_view &cell : rowCells) {
+    Value value(cell);
+    this->totalLength += value.GetStringView().value().length();
+  }
+
+  ++this->rowCount;
+  celero::DoNotOptimizeAway(this->totalLength);
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(ValueConstruction, Int32, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::int32_t(123456));
+  celero::DoNotOptimizeAway(value.AsInt32().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Boolean, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(true);
+  celero::DoNotOptimizeAway(value.AsBool().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, UInt8, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::uint8_t(123));
+  celero::DoNotOptimizeAway(value.AsUInt8().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Int16, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::int16_t(12345));
+  celero::DoNotOptimizeAway(value.AsInt16().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Int64, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::int64_t(1234567890123));
+  celero::DoNotOptimizeAway(value.AsInt64().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Decimal, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(Nuclex::ThinOrm::Decimal(std::int64_t(1234567), 2));
+  celero::DoNotOptimizeAway(value.AsDecimal().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Float, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(1234.5f);
+  celero::DoNotOptimizeAway(value.AsFloat().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Double, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(1234.5678);
+  celero::DoNotOptimizeAway(value.AsDouble().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, String, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(rowCells[1]);
+  celero::DoNotOptimizeAway(value.GetStringView().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Date, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value = Value::FromDate(Nuclex::ThinOrm::DateTime(dateTimeTicks));
+  celero::DoNotOptimizeAway(value.AsDateTime().value().GetTicks());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Time, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value = Value::FromTime(Nuclex::ThinOrm::DateTime(dateTimeTicks));
+  celero::DoNotOptimizeAway(value.AsDateTime().value().GetTicks());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, DateTime, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value = Value::FromDateTime(Nuclex::ThinOrm::DateTime(dateTimeTicks));
+  celero::DoNotOptimizeAway(value.AsDateTime().value().GetTicks());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueConstruction, Blob, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::span<const std::byte>{blobCell});
+  celero::DoNotOptimizeAway(value.GetBlobView().value().size());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(ValueToString, Int32, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::int32_t(123456));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Boolean, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(true);
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, UInt8, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::uint8_t(123));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Int16, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::int16_t(12345));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Int64, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::int64_t(1234567890123));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Float, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(1234.5f);
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Double, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(1234.5678);
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, String, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(rowCells[1]);
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Date, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value = Value::FromDate(Nuclex::ThinOrm::DateTime(dateTimeTicks));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Time, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value = Value::FromTime(Nuclex::ThinOrm::DateTime(dateTimeTicks));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, DateTime, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value = Value::FromDateTime(Nuclex::ThinOrm::DateTime(dateTimeTicks));
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueToString, Blob, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::span<const std::byte>{blobCell});
+  celero::DoNotOptimizeAway(value.AsString().value().length());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BASELINE(ValueFromString, Int32, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"123456"));
+  celero::DoNotOptimizeAway(value.AsInt32().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueFromString, Boolean, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"true"));
+  celero::DoNotOptimizeAway(value.AsBool().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueFromString, UInt8, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"123"));
+  celero::DoNotOptimizeAway(value.AsUInt8().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueFromString, Int16, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"12345"));
+  celero::DoNotOptimizeAway(value.AsInt16().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueFromString, Int64, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"1234567890123"));
+  celero::DoNotOptimizeAway(value.AsInt64().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueFromString, Float, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"1234.5"));
+  celero::DoNotOptimizeAway(value.AsFloat().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
+
+BENCHMARK(ValueFromString, Double, 30, 100000) {
+  using Nuclex::ThinOrm::Value;
+
+  Value value(std::u8string_view(u8"1234.5678"));
+  celero::DoNotOptimizeAway(value.AsDouble().value());
+}
+
+// --------------------------------------------------------------------------------------------- //
@@ -0,0 +1,278 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_CONCURRENTCONNECTIONPOOL_H
+#define NUCLEX_THINORM_CONNECTIONS_CONCURRENTCONNECTIONPOOL_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Configuration/ConnectionString.h"
+#include "Nuclex/ThinOrm/Connections/ContextualConnectionPool.h"
+#include "Nuclex/ThinOrm/Connections/ConnectionFactory.h"
+
+#include <vector> // for std::vector
+#include <memory> // for std::unique_ptr, std::shared_ptr
+#include <mutex> // for std::mutex
+#include <atomic> // for std::atomic
+#include <thread> // for std::thread::hardware_concurrency()
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Connection pool optimized for many threads borrowing at the same time</summary>
+  /// <typeparam name="TDataContext">
+  ///   Specialization to distinguish the types in C++ dependency injectors.
+  ///   Ignore this if you do not use a dependency injector or if you only
+  ///   access a single database in your application.
+  /// </typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     The <see cref="StandardConnectionPool" /> guards its connections with a single
+  ///     mutex, which becomes a point of contention when dozens of threads run short
+  ///     queries at a high rate. This pool splits its retained connections into shards,
+  ///     each with its own mutex and each on its own cache line.
+  ///   </para>
+  ///   <para>
+  ///     Every thread has an affinity to one shard. It returns connections into that shard
+  ///     and borrows from it first, so in the common case of a thread borrowing and
+  ///     returning in quick succession, no other thread touches the same mutex and the
+  ///     thread tends to get back the very connection it used last. Only when its own
+  ///     shard is empty does a thread look into the other shards before finally
+  ///     establishing a new connection.
+  ///   </para>
+  ///   <para>
+  ///     This pool does not limit the number of open connections or make borrowers wait.
+  ///     If you need back-pressure, use the <see cref="StandardConnectionPool" />.
+  ///   </para>
+  /// </remarks>
+  template<typename TDataContext = void>
+  class NUCLEX_THINORM_TYPE ConcurrentConnectionPool :
+    public ContextualConnectionPool<TDataContext> {
+
+    /// <summary>Initializes a new connection pool with the specified settings</summary>
+    /// <param name="connectionFactory">
+    ///   Factory that should be used when a new connection needs to be established
+    /// </param>
+    /// <param name="connectionProperties">
+    ///   Settings that should be passed to the connection factory when establishing
+    ///   new connections, contains driver name, database hostname or path, etc.
+    /// </param>
+    /// <param name="maximumRetainedConnectionsPerShard">
+    ///   Maximum number of connections each shard will keep ready
+    /// </param>
+    /// <param name="shardCount">
+    ///   Number of shards to split the pool into, zero to use one shard per CPU core
+    /// </param>
+    public: NUCLEX_THINORM_API inline ConcurrentConnectionPool(
+      const std::shared_ptr<ConnectionFactory> &connectionFactory,
+      const Configuration::ConnectionProperties &connectionProperties,
+      const std::size_t maximumRetainedConnectionsPerShard = 2,
+      const std::size_t shardCount = 0
+    );
+
+    /// <summary>Frees all resources owned by the connection pool</summary>
+    public: NUCLEX_THINORM_API inline ~ConcurrentConnectionPool() override = default;
+
+    /// <summary>Counts the number of shards the pool has been split into</summary>
+    /// <returns>The number of shards in the pool</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountShards() const;
+
+    /// <summary>Counts the connections currently retained by the pool</summary>
+    /// <returns>The number of connections waiting to be borrowed</returns>
+    /// <remarks>
+    ///   The shards are counted one after another, so if other threads are borrowing and
+    ///   returning connections at the same time, the result is only an approximation.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::size_t CountRetainedConnections() const;
+
+    /// <summary>Evicts and, thus, closes all pooled connections</summary>
+    public: NUCLEX_THINORM_API inline void EvictAll();
+
+    /// <summary>Borrows a connection from the connection pool</summary>
+    /// <returns>A connection to the database the connection pool has been set up for</returns>
+    /// <remarks>
+    ///   If there is a reusable connection sitting in the connection pool, it will be
+    ///   returned for the exclusive use by the caller. Otherwise, a new connection will
+    ///   be established.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::shared_ptr<Connection> BorrowConnection() override;
+
+    /// <summary>Returns a borrowed connection to the connection pool</summary>
+    /// <param name="connection">Connection to put back into the connection pool</param>
+    /// <remarks>
+    ///   Only return connections that are in a valid state and have no active queries,
+    ///   otherwise you'll prime the next borrower for a nasty surprise that is hard to
+    ///   trace back to the incorrect code that returned a connection in a bad state.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void ReturnConnection(
+      const std::shared_ptr<Connection> &connection
+    ) override;
+
+    /// <summary>Retained connections guarded by their own mutex</summary>
+    /// <remarks>
+    ///   Aligned to a typical cache line so that threads working on neighbouring
+    ///   shards do not invalidate each other's caches (false sharing).
+    /// </remarks>
+    private: struct alignas(64) Shard {
+
+      /// <summary>Mutex that must be held to access the shard's connections</summary>
+      public: std::mutex ConnectionsAccessMutex;
+      /// <summary>Connections retained in the shard, most recently returned last</summary>
+      public: std::vector<std::shared_ptr<Connection>> Connections;
+
+    };
+
+    /// <summary>Looks up the shard the calling thread has an affinity to</summary>
+    /// <returns>The index of the calling thread's shard</returns>
+    private: inline std::size_t getThreadShardIndex() const;
+
+    /// <summary>Connection factory through which new connections are established</summary>
+    private: std::shared_ptr<ConnectionFactory> connectionFactory;
+    /// <summary>Settings to use when establishing a new connection</summary>
+    private: Configuration::ConnectionString connectionProperties;
+    /// <summary>Maximum number of connections each shard will retain</summary>
+    private: std::size_t maximumRetainedConnectionsPerShard;
+    /// <summary>Number of shards, always a power of two</summary>
+    private: std::size_t shardCount;
+    /// <summary>Shards among which the retained connections are distributed</summary>
+    private: std::unique_ptr<Shard[]> shards;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline ConcurrentConnectionPool<TDataContext>::ConcurrentConnectionPool(
+    const std::shared_ptr<ConnectionFactory> &connectionFactory,
+    const Configuration::ConnectionProperties &connectionProperties,
+    const std::size_t maximumRetainedConnectionsPerShard /* = 2 */,
+    const std::size_t shardCount /* = 0 */
+  ) :
+    connectionFactory(connectionFactory),
+    connectionProperties(connectionProperties),
+    maximumRetainedConnectionsPerShard(maximumRetainedConnectionsPerShard),
+    shardCount(1),
+    shards() {
+
+    // Round the shard count up to a power of two so the thread's shard can be picked
+    // with a bit mask instead of a division
+    std::size_t requestedShardCount = shardCount;
+    if(requestedShardCount == 0) {
+      requestedShardCount = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    }
+    while(this->shardCount < requestedShardCount) {
+      this->shardCount <<= 1;
+    }
+
+    this->shards = std::make_unique<Shard[]>(this->shardCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::size_t ConcurrentConnectionPool<TDataContext>::CountShards() const {
+    return this->shardCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::size_t ConcurrentConnectionPool<TDataContext>::CountRetainedConnections() const {
+    std::size_t retainedConnectionCount = 0;
+    for(std::size_t index = 0; index < this->shardCount; ++index) {
+      Shard &shard = this->shards[index];
+      std::unique_lock<std::mutex> connectionsAccessScope(shard.ConnectionsAccessMutex);
+      retainedConnectionCount += shard.Connections.size();
+    }
+
+    return retainedConnectionCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void ConcurrentConnectionPool<TDataContext>::EvictAll() {
+    for(std::size_t index = 0; index < this->shardCount; ++index) {
+      std::vector<std::shared_ptr<Connection>> evictedConnections;
+      {
+        Shard &shard = this->shards[index];
+        std::unique_lock<std::mutex> connectionsAccessScope(shard.ConnectionsAccessMutex);
+        evictedConnections.swap(shard.Connections);
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::shared_ptr<Connection> ConcurrentConnectionPool<TDataContext>::BorrowConnection() {
+    std::size_t shardMask = this->shardCount - 1;
+    std::size_t ownShardIndex = getThreadShardIndex();
+
+    // Try the thread's own shard first, then walk through the other shards. Since
+    // threads are spread evenly across shards, this only happens when the own shard
+    // ran dry, i.e. when the thread is borrowing more than one connection at a time.
+    for(std::size_t offset = 0; offset < this->shardCount; ++offset) {
+      Shard &shard = this->shards[(ownShardIndex + offset) & shardMask];
+      std::unique_lock<std::mutex> connectionsAccessScope(shard.ConnectionsAccessMutex);
+      if(!shard.Connections.empty()) {
+        std::shared_ptr<Connection> result = std::move(shard.Connections.back());
+        shard.Connections.pop_back();
+        return result;
+      }
+    }
+
+    return this->connectionFactory->Connect(this->connectionProperties);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void ConcurrentConnectionPool<TDataContext>::ReturnConnection(
+    const std::shared_ptr<Connection> &connection
+  ) {
+    Shard &shard = this->shards[getThreadShardIndex()];
+    {
+      std::unique_lock<std::mutex> connectionsAccessScope(shard.ConnectionsAccessMutex);
+      if(shard.Connections.size() < this->maximumRetainedConnectionsPerShard) {
+        shard.Connections.push_back(connection);
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::size_t ConcurrentConnectionPool<TDataContext>::getThreadShardIndex() const {
+    static std::atomic<std::size_t> nextThreadNumber(0);
+
+    // Threads are numbered in the order in which they first use any concurrent
+    // connection pool, which spreads them evenly across the shards
+    thread_local std::size_t threadNumber = (
+      nextThreadNumber.fetch_add(1, std::memory_order_relaxed)
+    );
+
+    return threadNumber & (this->shardCount - 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // NUCLEX_THINORM_CONNECTIONS_CONCURRENTCONNECTIONPOOL_H
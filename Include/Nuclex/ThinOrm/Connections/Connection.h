@@ -21,14 +21,27 @@ limitations under the License.
 #define NUCLEX_THINORM_CONNECTIONS_CONNECTION_H
 
 #include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Connections/StatementCacheStatistics.h"
+#include "Nuclex/ThinOrm/Transactions/IsolationLevel.h"
+#include "Nuclex/ThinOrm/Transactions/Transaction.h"
+#include "Nuclex/ThinOrm/Dialects/UpsertStyle.h"
+#include "Nuclex/ThinOrm/Dialects/QuoteStyle.h"
 
+#include <cstdint> // for std::uint64_t
 #include <memory> // for std::unique_ptr<>
 #include <string> // for std::u8string
+#include <vector> // for std::vector<>
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+  #include <stop_token> // for std::stop_token
+  #include <asyncpp/task.h> // for asyncpp::task
+#endif
 
 namespace Nuclex::ThinOrm {
   class Value;
   class Query;
   class RowReader;
+  class ParameterRowSource;
 }
 
 namespace Nuclex::ThinOrm::Connections {
@@ -38,6 +51,9 @@ namespace Nuclex::ThinOrm::Connections {
   /// <summary>Connection to a database on which queries can be run</summary>
   class NUCLEX_THINORM_TYPE Connection {
 
+    /// <summary>Initializes the connection's transaction bookkeeping</summary>
+    protected: NUCLEX_THINORM_API Connection();
+
     /// <summary>Frees all resources owned by the command</summary>
     public: NUCLEX_THINORM_API virtual ~Connection() = default;
 
@@ -82,6 +98,38 @@ namespace Nuclex::ThinOrm::Connections {
     /// <returns>A reader that can be used to fetch individual rows</returns>
     public: virtual std::unique_ptr<RowReader> RunRowQuery(const Query &rowQuery) = 0;
 
+    /// <summary>Executes an SQL statement once for each row of parameter values</summary>
+    /// <param name="batchQuery">Query that will be executed for each parameter row</param>
+    /// <param name="parameterRows">Provides the parameter values for each execution</param>
+    /// <returns>The number of rows affected by each execution, in order</returns>
+    /// <remarks>
+    ///   <para>
+    ///     The statement is prepared once and then re-run with each row of parameters,
+    ///     which avoids the lookup and binding overhead of calling
+    ///     <see cref="RunUpdateQuery" /> in a loop. Combine it with a transaction to
+    ///     also avoid committing each row on its own.
+    ///   </para>
+    ///   <para>
+    ///     Drivers that send the whole batch to the server in one go may not know how
+    ///     many rows each individual execution affected. These report the total for
+    ///     the batch on its final row and zero for the others, so the sum is always right.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual std::vector<std::size_t> RunBatch(
+      const Query &batchQuery, ParameterRowSource &parameterRows
+    );
+
+    /// <summary>Executes an SQL statement once for each row of parameter values</summary>
+    /// <param name="batchQuery">Query that will be executed for each parameter row</param>
+    /// <param name="parameterRows">
+    ///   Parameter values for each execution, each row needs to provide exactly as many
+    ///   values as the query has parameters
+    /// </param>
+    /// <returns>The number of rows affected by each execution, in order</returns>
+    public: NUCLEX_THINORM_API std::vector<std::size_t> RunBatch(
+      const Query &batchQuery, const std::vector<std::vector<Value>> &parameterRows
+    );
+
     /// <summary>Checks if the specified table exists</summary>
     /// <param name="tableName">Table or view whose existence will be checked</param>
     /// <returns>True if a table or view with the given exists</returns>
@@ -94,6 +142,161 @@ namespace Nuclex::ThinOrm::Connections {
     /// </remarks>
     public: virtual bool DoesTableOrViewExist(const std::u8string &tableName) = 0;
 
+    /// <summary>Checks whether the connection is still usable</summary>
+    /// <returns>True if the connection responded, false if it appears to be dead</returns>
+    /// <remarks>
+    ///   Connection pools use this to weed out connections that the database server has
+    ///   closed while they sat idle in the pool. The default implementation runs a trivial
+    ///   <code>SELECT 1</code>, drivers are free to do something cheaper.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual bool CheckHealth();
+
+    /// <summary>Reports the counters of the connection's prepared statement cache</summary>
+    /// <returns>The current statement cache counters of the connection</returns>
+    /// <remarks>
+    ///   Connections that do not cache prepared statements report all counters as zero.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline virtual StatementCacheStatistics
+    GetStatementCacheStatistics() const { return StatementCacheStatistics(); }
+
+    /// <summary>Reports how many parameters a single statement may contain at most</summary>
+    /// <returns>The maximum number of bound parameters the database accepts</returns>
+    /// <remarks>
+    ///   Statement generators that pack multiple rows into one statement use this to size
+    ///   their statements. The default implementation returns 999, the historical limit of
+    ///   SQLite, which is lower than the limit of any other popular database engine.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual std::size_t GetMaximumParameterCount() const;
+
+    /// <summary>Reports the syntax the database uses for inserts that update on conflict</summary>
+    /// <returns>The upsert syntax understood by the database</returns>
+    /// <remarks>
+    ///   Used by statement generators to write insert-or-update statements. The default
+    ///   implementation returns the ON CONFLICT syntax used by SQLite and PostgreSQL.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual Dialects::UpsertStyle GetUpsertStyle() const;
+
+    /// <summary>Reports the quotes the database expects around table and column names</summary>
+    /// <returns>The identifier quote style understood by the database</returns>
+    /// <remarks>
+    ///   Used by statement generators to quote identifiers. The default implementation
+    ///   returns the ANSI SQL double quotes used by SQLite and PostgreSQL.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual Dialects::QuoteStyle GetQuoteStyle() const;
+
+    /// <summary>Aborts the query currently running on the connection, if any</summary>
+    /// <remarks>
+    ///   <para>
+    ///     Unlike all other methods, this one may be called from a different thread while
+    ///     the connection is busy running a query. The interrupted query will fail with
+    ///     whatever error the database driver reports for aborted queries.
+    ///   </para>
+    ///   <para>
+    ///     The asynchronous methods call this when their stop token is triggered while
+    ///     the query is running. The default implementation does nothing, leaving running
+    ///     queries to complete, for drivers that have no way of aborting them.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual void Interrupt();
+
+    /// <summary>Begins a transaction that lasts until the returned scope ends it</summary>
+    /// <param name="isolationLevel">
+    ///   How strongly the transaction should be isolated from other transactions
+    /// </param>
+    /// <returns>The transaction scope through which the transaction can be committed</returns>
+    /// <remarks>
+    ///   If a transaction is already active on the connection, a nested transaction is
+    ///   created via a savepoint. The isolation level can only be chosen for the outermost
+    ///   transaction, nested transactions always run at the level of their parent.
+    /// </remarks>
+    public: NUCLEX_THINORM_API Transactions::Transaction BeginTransaction(
+      Transactions::IsolationLevel isolationLevel = Transactions::IsolationLevel::Default
+    );
+
+    /// <summary>Counts how many transactions are currently active on the connection</summary>
+    /// <returns>Zero if no transaction is active, otherwise the nesting depth</returns>
+    public: NUCLEX_THINORM_API inline std::size_t GetTransactionDepth() const noexcept {
+      return this->transactionDepth;
+    }
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+    /// <summary>Executes an SQL query that has no results without blocking</summary>
+    /// <param name="statement">Statement that will be executed</param>
+    /// <param name="stopToken">Token by which the statement can be cancelled</param>
+    /// <returns>A task that completes when the statement has been executed</returns>
+    /// <remarks>
+    ///   <para>
+    ///     The blocking driver call is carried out on a shared pool of I/O threads, so
+    ///     the coroutine awaiting the task does not tie up its thread in the meantime.
+    ///     If the awaiting coroutine runs on an asyncpp dispatcher, it will be resumed
+    ///     through that dispatcher.
+    ///   </para>
+    ///   <para>
+    ///     The query is copied, but the task does not keep the connection alive. It must
+    ///     outlive the task (so it must not be destroyed or handed back to its connection
+    ///     pool before the task has been awaited) and, like with the blocking methods,
+    ///     must not be used by anyone else in the meantime.
+    ///   </para>
+    ///   <para>
+    ///     A stop requested before the statement begins executing will cancel it with
+    ///     an <see cref="OperationCancelledError" />. A stop requested while it executes
+    ///     will <see cref="Interrupt" /> the connection, which also fails the task with
+    ///     an <see cref="OperationCancelledError" /> if the driver supports aborting
+    ///     running queries.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API asyncpp::task<void> RunStatementAsync(
+      const Query &statement, const std::stop_token &stopToken = std::stop_token()
+    );
+
+    /// <summary>Executes an SQL query that has a single result without blocking</summary>
+    /// <param name="scalarQuery">Query that will be executed</param>
+    /// <param name="stopToken">Token by which the query can be cancelled</param>
+    /// <returns>A task that provides the result of the query</returns>
+    /// <remarks>
+    ///   See <see cref="RunStatementAsync" /> for the threading and lifetime rules.
+    /// </remarks>
+    public: NUCLEX_THINORM_API asyncpp::task<Value> RunScalarQueryAsync(
+      const Query &scalarQuery, const std::stop_token &stopToken = std::stop_token()
+    );
+
+    /// <summary>Executes an SQL query that updates rows without blocking</summary>
+    /// <param name="updateQuery">Query that will be executed</param>
+    /// <param name="stopToken">Token by which the query can be cancelled</param>
+    /// <returns>A task that provides the number of affected rows</returns>
+    /// <remarks>
+    ///   See <see cref="RunStatementAsync" /> for the threading and lifetime rules.
+    /// </remarks>
+    public: NUCLEX_THINORM_API asyncpp::task<std::size_t> RunUpdateQueryAsync(
+      const Query &updateQuery, const std::stop_token &stopToken = std::stop_token()
+    );
+
+    /// <summary>Executes an SQL query that has result rows without blocking</summary>
+    /// <param name="rowQuery">Query that will be executed</param>
+    /// <param name="stopToken">Token by which the query can be cancelled</param>
+    /// <returns>A task that provides a reader for the result rows</returns>
+    /// <remarks>
+    ///   <para>
+    ///     Only running the query (which, depending on the driver, may include fetching
+    ///     the first row) is done on the I/O threads. The returned reader is the same
+    ///     blocking reader <see cref="RunRowQuery" /> provides, so each
+    ///     <see cref="RowReader.MoveToNext" /> call blocks the calling thread while
+    ///     the driver fetches the next row and the stop token has no effect on it.
+    ///     For large result sets, either page through them with multiple queries or
+    ///     consume the reader from a thread that is allowed to block.
+    ///   </para>
+    ///   <para>
+    ///     See <see cref="RunStatementAsync" /> for the threading and lifetime rules,
+    ///     which apply to the returned reader as well.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API asyncpp::task<std::unique_ptr<RowReader>> RunRowQueryAsync(
+      const Query &rowQuery, const std::stop_token &stopToken = std::stop_token()
+    );
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
     // Dialect tags?
     //
     // Could be used by query formatters to decide what to do in a controlled way
@@ -102,6 +305,59 @@ namespace Nuclex::ThinOrm::Connections {
     //
     //const SqlDialect &GetDialect() const;
 
+    /// <summary>Begins a transaction at the outermost level</summary>
+    /// <param name="isolationLevel">Isolation level the transaction should use</param>
+    /// <remarks>
+    ///   The default implementation runs a plain <code>BEGIN</code> and ignores
+    ///   the isolation level. Drivers override this to use the database's own mechanism
+    ///   and to translate the isolation level.
+    /// </remarks>
+    protected: NUCLEX_THINORM_API virtual void BeginTopLevelTransaction(
+      Transactions::IsolationLevel isolationLevel
+    );
+
+    /// <summary>Commits the outermost transaction</summary>
+    /// <remarks>
+    ///   The default implementation runs a plain <code>COMMIT</code>.
+    /// </remarks>
+    protected: NUCLEX_THINORM_API virtual void CommitTopLevelTransaction();
+
+    /// <summary>Rolls back the outermost transaction</summary>
+    /// <remarks>
+    ///   The default implementation runs a plain <code>ROLLBACK</code>.
+    /// </remarks>
+    protected: NUCLEX_THINORM_API virtual void RollbackTopLevelTransaction();
+
+    /// <summary>Commits or rolls back the transaction at the specified depth</summary>
+    /// <param name="depth">Nesting depth of the transaction that will be ended</param>
+    /// <param name="commit">True to commit the transaction, false to roll it back</param>
+    private: void endTransaction(std::size_t depth, bool commit);
+
+    /// <summary>Checks whether a transaction begun on the connection is still active</summary>
+    /// <param name="depth">Nesting depth the transaction was begun at</param>
+    /// <param name="serial">Serial number the transaction was assigned when begun</param>
+    /// <returns>True if the transaction has not been ended yet</returns>
+    private: bool isTransactionActive(std::size_t depth, std::uint64_t serial) const noexcept;
+
+    /// <summary>Transaction scopes need to end the transactions they control</summary>
+    friend class Transactions::Transaction;
+
+    /// <summary>Number of transactions currently active on the connection</summary>
+    private: std::size_t transactionDepth;
+    /// <summary>Serial number of the transaction at each depth, outermost first</summary>
+    /// <remarks>
+    ///   Only the entries up to the current transaction depth are meaningful. Entries
+    ///   beyond that belong to transactions that have ended and are overwritten when
+    ///   a new transaction is begun at their depth.
+    /// </remarks>
+    private: std::vector<std::uint64_t> transactionSerials;
+    /// <summary>Serial number that will be assigned to the next transaction</summary>
+    /// <remarks>
+    ///   Serial numbers tell apart transactions begun at the same depth, so the scope of
+    ///   a transaction that has ended can't mistake a later transaction for its own.
+    /// </remarks>
+    private: std::uint64_t nextTransactionSerial;
+
     /*
     public: virtual const std::u8string &GetDatabaseProductName() = 0;
 
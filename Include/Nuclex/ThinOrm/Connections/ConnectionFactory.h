@@ -24,6 +24,11 @@ limitations under the License.
 
 #include <memory> // for std::shared_ptr
 
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+  #include <stop_token> // for std::stop_token
+  #include <asyncpp/task.h> // for asyncpp::task
+#endif
+
 namespace Nuclex::ThinOrm::Configuration {
   class ConnectionProperties;
 }
@@ -58,6 +63,27 @@ namespace Nuclex::ThinOrm::Connections {
       const Configuration::ConnectionProperties &connectionProperties
     ) const = 0;
 
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+    /// <summary>Establishes a new connection without blocking the calling thread</summary>
+    /// <param name="connectionProperties">
+    ///   Specifies the driver, data source and other parameters to reach the database
+    /// </param>
+    /// <param name="stopToken">Token by which connecting can be cancelled</param>
+    /// <returns>A task that provides the new database connection</returns>
+    /// <remarks>
+    ///   This runs <see cref="Connect" /> on a shared pool of I/O threads. The connection
+    ///   properties are copied, but the factory itself must stay alive until the task has
+    ///   completed. A stop requested before the connection attempt begins will cancel it
+    ///   with an <see cref="OperationCancelledError" />.
+    /// </remarks>
+    public: NUCLEX_THINORM_API asyncpp::task<std::shared_ptr<Connection>> ConnectAsync(
+      const Configuration::ConnectionProperties &connectionProperties,
+      const std::stop_token &stopToken = std::stop_token()
+    ) const;
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
   };
 
   // ------------------------------------------------------------------------------------------- //
@@ -0,0 +1,184 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_CONNECTIONLEASE_H
+#define NUCLEX_THINORM_CONNECTIONS_CONNECTIONLEASE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <memory> // for std::shared_ptr
+
+namespace Nuclex::ThinOrm::Connections {
+  class Connection;
+  class ConnectionPool;
+}
+namespace Nuclex::ThinOrm {
+  class DataContext;
+}
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Holds a connection borrowed from a pool and returns it when destroyed</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Obtain a lease via <see cref="ConnectionPool.LeaseConnection" />. When the lease
+  ///     goes out of scope, including by an exception unwinding the stack, the connection
+  ///     is handed back to the pool, so it doesn't need to be re-established by the next
+  ///     borrower.
+  ///   </para>
+  ///   <para>
+  ///     If you notice that the connection has become unusable (for example, the server
+  ///     dropped it), call <see cref="MarkBroken" /> and the connection will be discarded
+  ///     rather than returned to the pool.
+  ///   </para>
+  ///   <para>
+  ///     Leases can be moved but not copied. The pool the lease came from must stay
+  ///     alive until the lease has been destroyed or released.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE ConnectionLease {
+
+    /// <summary>Initializes an empty lease that holds no connection</summary>
+    public: NUCLEX_THINORM_API ConnectionLease() noexcept;
+
+    /// <summary>Takes over the connection held by another lease</summary>
+    /// <param name="other">Lease whose connection will be taken over</param>
+    public: NUCLEX_THINORM_API ConnectionLease(ConnectionLease &&other) noexcept;
+
+    /// <summary>Leases can not be copied since they hold exclusive ownership</summary>
+    public: ConnectionLease(const ConnectionLease &other) = delete;
+
+    /// <summary>Returns or discards the connection held by the lease</summary>
+    /// <remarks>
+    ///   Exceptions thrown by the pool while taking back the connection are swallowed.
+    ///   Call <see cref="Release" /> explicitly to find out about them.
+    /// </remarks>
+    public: NUCLEX_THINORM_API ~ConnectionLease();
+
+    /// <summary>Accesses the leased connection</summary>
+    /// <returns>The connection held by the lease</returns>
+    public: NUCLEX_THINORM_API inline const std::shared_ptr<Connection> &Get() const noexcept;
+
+    /// <summary>Marks the connection as unusable so it will be discarded</summary>
+    public: NUCLEX_THINORM_API inline void MarkBroken() noexcept;
+
+    /// <summary>Checks whether the connection has been marked as unusable</summary>
+    /// <returns>True if the connection will be discarded rather than returned</returns>
+    public: NUCLEX_THINORM_API inline bool IsBroken() const noexcept;
+
+    /// <summary>Returns or discards the connection before the lease is destroyed</summary>
+    /// <remarks>
+    ///   After this call, the lease is empty, even if the pool threw an exception while
+    ///   taking back the connection. Such exceptions are passed on to the caller.
+    ///   Calling it on an empty lease does nothing.
+    /// </remarks>
+    public: NUCLEX_THINORM_API void Release();
+
+    /// <summary>Accesses the members of the leased connection</summary>
+    /// <returns>The connection held by the lease</returns>
+    public: NUCLEX_THINORM_API inline Connection *operator ->() const noexcept;
+
+    /// <summary>Accesses the leased connection</summary>
+    /// <returns>The connection held by the lease</returns>
+    public: NUCLEX_THINORM_API inline Connection &operator *() const noexcept;
+
+    /// <summary>Checks whether the lease is holding a connection</summary>
+    /// <returns>True if the lease holds a connection, false if it is empty</returns>
+    public: NUCLEX_THINORM_API inline explicit operator bool() const noexcept;
+
+    /// <summary>Returns the currently held connection and takes over another's</summary>
+    /// <param name="other">Lease whose connection will be taken over</param>
+    /// <returns>The lease itself</returns>
+    public: NUCLEX_THINORM_API ConnectionLease &operator =(ConnectionLease &&other);
+
+    /// <summary>Leases can not be copied since they hold exclusive ownership</summary>
+    public: ConnectionLease &operator =(const ConnectionLease &other) = delete;
+
+    /// <summary>Initializes a lease holding a freshly borrowed connection</summary>
+    /// <param name="pool">Pool the connection has been borrowed from</param>
+    /// <param name="connection">Connection that has been borrowed</param>
+    private: ConnectionLease(
+      ConnectionPool &pool, std::shared_ptr<Connection> &&connection
+    ) noexcept;
+
+    /// <summary>Initializes a lease that shares a connection not owned by any pool</summary>
+    /// <param name="connection">Connection the lease will provide access to</param>
+    /// <remarks>
+    ///   Used by data contexts that were set up with a single, exclusive connection.
+    ///   Releasing such a lease merely drops the lease's reference to the connection.
+    /// </remarks>
+    private: explicit ConnectionLease(const std::shared_ptr<Connection> &connection) noexcept;
+
+    /// <summary>Only the pool can create leases holding a connection</summary>
+    friend class ConnectionPool;
+    /// <summary>Data contexts hand out unpooled leases for their exclusive connection</summary>
+    friend class Nuclex::ThinOrm::DataContext;
+
+    /// <summary>Pool from which the connection has been borrowed</summary>
+    private: ConnectionPool *pool;
+    /// <summary>Connection that has been borrowed from the pool</summary>
+    private: std::shared_ptr<Connection> connection;
+    /// <summary>Whether the connection should be discarded instead of returned</summary>
+    private: bool isBroken;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline const std::shared_ptr<Connection> &ConnectionLease::Get() const noexcept {
+    return this->connection;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void ConnectionLease::MarkBroken() noexcept {
+    this->isBroken = true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool ConnectionLease::IsBroken() const noexcept {
+    return this->isBroken;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline Connection *ConnectionLease::operator ->() const noexcept {
+    return this->connection.get();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline Connection &ConnectionLease::operator *() const noexcept {
+    return *this->connection;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline ConnectionLease::operator bool() const noexcept {
+    return static_cast<bool>(this->connection);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // NUCLEX_THINORM_CONNECTIONS_CONNECTIONLEASE_H
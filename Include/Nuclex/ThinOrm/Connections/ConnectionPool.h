@@ -23,9 +23,11 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Config.h"
 
 #include <memory> // for std::shared_ptr
+#include <atomic> // for std::atomic
 
 namespace Nuclex::ThinOrm::Connections {
   class Connection;
+  class ConnectionLease;
 }
 
 namespace Nuclex::ThinOrm::Connections {
@@ -47,12 +49,37 @@ namespace Nuclex::ThinOrm::Connections {
   ///     it behind a level of indirection tha returns an internal connection when some
   ///     exposed connection object gets destroyed or similar.
   ///   </para>
+  ///   <para>
+  ///     To make sure borrowed connections always find their way back, even when
+  ///     an exception is thrown, prefer <see cref="LeaseConnection" /> over calling
+  ///     <see cref="BorrowConnection" /> and <see cref="ReturnConnection" /> yourself.
+  ///   </para>
   /// </remarks>
   class NUCLEX_THINORM_TYPE ConnectionPool {
 
+    /// <summary>Initializes the connection pool's lease bookkeeping</summary>
+    protected: NUCLEX_THINORM_API ConnectionPool();
+
     /// <summary>Frees all resources owned by the connection pool</summary>
     public: NUCLEX_THINORM_API virtual ~ConnectionPool() = default;
 
+    /// <summary>Borrows a connection that is automatically returned when done</summary>
+    /// <returns>A lease that holds the borrowed connection until it is destroyed</returns>
+    /// <remarks>
+    ///   The lease returns its connection to the pool when it goes out of scope. If the
+    ///   connection turned out to be unusable, mark the lease as broken and the connection
+    ///   will be discarded instead. The pool must outlive all leases handed out by it.
+    /// </remarks>
+    public: NUCLEX_THINORM_API ConnectionLease LeaseConnection();
+
+    /// <summary>Counts the leases that are currently holding a borrowed connection</summary>
+    /// <returns>The number of leases that have not been returned yet</returns>
+    /// <remarks>
+    ///   This is for diagnostic purposes, i.e. to find code that holds on to connections
+    ///   for too long. Connections borrowed without a lease are not included in the count.
+    /// </remarks>
+    public: NUCLEX_THINORM_API std::size_t CountOutstandingLeases() const;
+
     /// <summary>Borrows a connection from the connection pool</summary>
     /// <returns>A connection to the database the connection pool has been set up for</returns>
     /// <remarks>
@@ -71,6 +98,23 @@ namespace Nuclex::ThinOrm::Connections {
     /// </remarks>
     public: virtual void ReturnConnection(const std::shared_ptr<Connection> &connection) = 0;
 
+    /// <summary>Tells the pool that a borrowed connection will not be returned</summary>
+    /// <param name="connection">Connection that has been closed or broken</param>
+    /// <remarks>
+    ///   Use this instead of <see cref="ReturnConnection" /> if a connection is no longer
+    ///   usable. The default implementation simply lets the connection go, pools that keep
+    ///   track of their open connections override it to update their bookkeeping.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual void DiscardConnection(
+      const std::shared_ptr<Connection> &connection
+    );
+
+    /// <summary>Leases need to update the outstanding lease count</summary>
+    friend class ConnectionLease;
+
+    /// <summary>Number of leases that are currently holding a borrowed connection</summary>
+    private: std::atomic<std::size_t> outstandingLeaseCount;
+
   };
 
   // ------------------------------------------------------------------------------------------- //
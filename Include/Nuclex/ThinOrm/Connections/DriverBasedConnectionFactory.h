@@ -23,11 +23,6 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Connections/ConnectionFactory.h"
 
-#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
-  #include <stop_token>
-  #include <asyncpp/task.h> // for asyncpp::task
-#endif
-
 namespace Nuclex::ThinOrm::Connections {
 
   // ------------------------------------------------------------------------------------------- //
@@ -57,15 +52,6 @@ namespace Nuclex::ThinOrm::Connections {
       const Configuration::ConnectionProperties &connectionProperties
     ) const override;
 
-#if 0 && defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
-
-    public: NUCLEX_THINORM_API asyncpp::task<std::shared_ptr<Connection>> ConnectAsync(
-      const Configuration::ConnectionProperties &connectionProperties,
-      const std::stop_token &stopToken
-    ) const;
-
-#endif
-
   };
 
   // ------------------------------------------------------------------------------------------- //
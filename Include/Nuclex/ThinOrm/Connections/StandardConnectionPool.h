@@ -24,9 +24,18 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Configuration/ConnectionString.h"
 #include "Nuclex/ThinOrm/Connections/ContextualConnectionPool.h"
 #include "Nuclex/ThinOrm/Connections/ConnectionFactory.h"
+#include "Nuclex/ThinOrm/Connections/Connection.h"
+#include "Nuclex/ThinOrm/Errors/ConnectionPoolTimeoutError.h"
 
-#include <queue> // for std::queue
+#include <deque> // for std::deque
+#include <vector> // for std::vector
+#include <thread> // for std::thread
 #include <mutex> // for std::mutex
+#include <condition_variable> // for std::condition_variable
+#include <chrono> // for std::chrono::steady_clock, std::chrono::milliseconds
+#include <limits> // for std::numeric_limits
+#include <exception> // for std::exception
+#include <algorithm> // for std::find(), std::upper_bound()
 
 namespace Nuclex::ThinOrm::Connections {
 
@@ -39,10 +48,24 @@ namespace Nuclex::ThinOrm::Connections {
   ///   access a single database in your application.
   /// </typeparam>
   /// <remarks>
-  ///   Default implementation that uses a connection factory as well as a stored
-  ///   <see cref="ConnectionProperties" /> instance to establish new connections as needed,
-  ///   with a simple pool and a limit on how many active connections to keep ready.
-  ///   connection
+  ///   <para>
+  ///     Default implementation that uses a connection factory as well as a stored
+  ///     <see cref="ConnectionProperties" /> instance to establish new connections as needed,
+  ///     with a simple pool and a limit on how many active connections to keep ready.
+  ///   </para>
+  ///   <para>
+  ///     Optionally, the pool can enforce a hard limit on the number of connections that
+  ///     are open at the same time (borrowed plus retained). Once the limit is reached,
+  ///     borrowers queue up and are served in the order they arrived as soon as another
+  ///     borrower returns its connection, so under load the pool applies back-pressure to
+  ///     its callers instead of flooding the database server with new connections.
+  ///   </para>
+  ///   <para>
+  ///     A maintenance thread can be started to close connections that sat idle for too
+  ///     long, keep a minimum number of connections ready and probe retained connections
+  ///     so that borrowers neither pay for connection setup nor receive connections which
+  ///     the server has already dropped.
+  ///   </para>
   /// </remarks>
   template<typename TDataContext = void>
   class NUCLEX_THINORM_TYPE StandardConnectionPool :
@@ -59,20 +82,27 @@ namespace Nuclex::ThinOrm::Connections {
     /// <param name="maximumRetainedConnectionCount">
     ///   Maximum number of connections to keep ready in the connection pool.
     /// </param>
+    /// <param name="maximumConnectionCount">
+    ///   Maximum number of connections that can be open at the same time, including
+    ///   both connections that are borrowed and connections retained in the pool.
+    /// </param>
     /// <remarks>
     ///   The maximum retained connection count is not a limit on the total number of
     ///   connections that might exists if there are many borrowers, just a limit after
     ///   which the connection pool will close returned connections if the pool already
-    ///   contains this many active connections waiting to be borrowed.
+    ///   contains this many active connections waiting to be borrowed. The total number
+    ///   of connections is limited by the maximum connection count, which by default
+    ///   is unlimited.
     /// </remarks>
     public: NUCLEX_THINORM_API inline StandardConnectionPool(
       const std::shared_ptr<ConnectionFactory> &connectionFactory,
       const Configuration::ConnectionProperties &connectionProperties,
-      const std::size_t maximumRetainedConnectionCount = 3
+      const std::size_t maximumRetainedConnectionCount = 3,
+      const std::size_t maximumConnectionCount = std::numeric_limits<std::size_t>::max()
     );
 
     /// <summary>Frees all resources owned by the connection pool</summary>
-    public: NUCLEX_THINORM_API inline ~StandardConnectionPool() override = default;
+    public: NUCLEX_THINORM_API inline ~StandardConnectionPool() override;
 
     /// <summary>Retrieves the current number of connections that the pool will retain</summary>
     /// <returns>The maximum number of connections the pool currently retains</summary>
@@ -94,6 +124,119 @@ namespace Nuclex::ThinOrm::Connections {
       std::size_t newMaximumRetainedConnectionCount
     );
 
+    /// <summary>Retrieves the maximum number of connections that can be open</summary>
+    /// <returns>The maximum number of connections, borrowed or retained</returns>
+    public: NUCLEX_THINORM_API inline std::size_t GetMaximumConnectionCount() const;
+
+    /// <summary>Updates the maximum number of connections that can be open</summary>
+    /// <param name="newMaximumConnectionCount">
+    ///   The new maximum number of connections, borrowed or retained
+    /// </param>
+    /// <remarks>
+    ///   Lowering the limit will not close any borrowed connections, instead the pool
+    ///   will make new borrowers wait until enough connections have been returned to get
+    ///   under the limit. Retained connections beyond the new limit are closed right away.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void SetMaximumConnectionCount(
+      std::size_t newMaximumConnectionCount
+    );
+
+    /// <summary>Retrieves the time a borrower will wait for a connection</summary>
+    /// <returns>The time <see cref="BorrowConnection" /> will wait at most</returns>
+    public: NUCLEX_THINORM_API inline std::chrono::milliseconds GetBorrowTimeout() const;
+
+    /// <summary>Changes the time a borrower will wait for a connection</summary>
+    /// <param name="newBorrowTimeout">
+    ///   Time <see cref="BorrowConnection" /> will wait at most before failing
+    /// </param>
+    /// <remarks>
+    ///   This only matters if the pool has a maximum connection count. If all connections
+    ///   are borrowed, <see cref="BorrowConnection" /> will wait this long for another
+    ///   borrower to return a connection before throwing a
+    ///   <see cref="Errors::ConnectionPoolTimeoutError" />.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void SetBorrowTimeout(
+      std::chrono::milliseconds newBorrowTimeout
+    );
+
+    /// <summary>Counts the connections that are currently open</summary>
+    /// <returns>The number of connections that are borrowed or retained</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountOpenConnections() const;
+
+    /// <summary>Retrieves the time after which idle connections are closed</summary>
+    /// <returns>The time a retained connection can stay unused before it is closed</returns>
+    public: NUCLEX_THINORM_API inline std::chrono::milliseconds GetMaximumIdleTime() const;
+
+    /// <summary>Changes the time after which idle connections are closed</summary>
+    /// <param name="newMaximumIdleTime">
+    ///   Time a retained connection can stay unused before it is closed, zero to keep
+    ///   idle connections around forever
+    /// </param>
+    /// <remarks>
+    ///   Idle connections are only closed by <see cref="PerformMaintenance" />, so either
+    ///   start the maintenance thread or call it yourself at regular intervals.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void SetMaximumIdleTime(
+      std::chrono::milliseconds newMaximumIdleTime
+    );
+
+    /// <summary>Retrieves the number of connections that are kept ready at all times</summary>
+    /// <returns>The minimum number of retained connections maintenance will ensure</returns>
+    public: NUCLEX_THINORM_API inline std::size_t GetMinimumIdleConnectionCount() const;
+
+    /// <summary>Changes the number of connections that are kept ready at all times</summary>
+    /// <param name="newMinimumIdleConnectionCount">
+    ///   Minimum number of retained connections maintenance will ensure
+    /// </param>
+    /// <remarks>
+    ///   Idle connections will not be closed for their age if that would bring the pool
+    ///   below this number and <see cref="PerformMaintenance" /> establishes new connections
+    ///   when there are fewer, so borrowers find a connection waiting for them.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void SetMinimumIdleConnectionCount(
+      std::size_t newMinimumIdleConnectionCount
+    );
+
+    /// <summary>Retrieves the interval in which retained connections are probed</summary>
+    /// <returns>The time after which a retained connection will be checked again</returns>
+    public: NUCLEX_THINORM_API inline std::chrono::milliseconds GetHealthCheckInterval() const;
+
+    /// <summary>Changes the interval in which retained connections are probed</summary>
+    /// <param name="newHealthCheckInterval">
+    ///   Time after which a retained connection will be checked again, zero to disable
+    ///   health checks
+    /// </param>
+    /// <remarks>
+    ///   A retained connection that has not been checked for this long will be probed via
+    ///   <see cref="Connection.CheckHealth" /> before it is handed out. The maintenance
+    ///   thread also probes such connections in the background, so borrowers will rarely
+    ///   have to wait for a probe themselves. Connections failing the probe are closed.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void SetHealthCheckInterval(
+      std::chrono::milliseconds newHealthCheckInterval
+    );
+
+    /// <summary>Starts a background thread that maintains the pool periodically</summary>
+    /// <param name="interval">Time between two maintenance passes</param>
+    /// <remarks>
+    ///   The thread runs <see cref="PerformMaintenance" /> in the specified interval until
+    ///   <see cref="StopMaintenance" /> is called or the connection pool is destroyed.
+    ///   Errors (such as the database being unreachable while trying to establish idle
+    ///   connections) are ignored, the next pass will simply try again.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void StartMaintenance(std::chrono::milliseconds interval);
+
+    /// <summary>Stops the background maintenance thread if it is running</summary>
+    public: NUCLEX_THINORM_API inline void StopMaintenance();
+
+    /// <summary>Performs a single maintenance pass on the calling thread</summary>
+    /// <remarks>
+    ///   Closes connections that have been idle longer than the maximum idle time, probes
+    ///   retained connections that are due for a health check and establishes connections
+    ///   until the minimum idle connection count is reached.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void PerformMaintenance();
+
     /// <summary>
     ///   Establishes the specified number of connections and puts them into the pool
     /// </summary>
@@ -116,10 +259,36 @@ namespace Nuclex::ThinOrm::Connections {
     /// <remarks>
     ///   If there is a reusable connection sitting in the connection pool, it will be
     ///   returned for the exclusive use by the caller. Otherwise, a new connection will
-    ///   be established.
+    ///   be established. If the maximum connection count has been reached, this waits up
+    ///   to the configured borrow timeout for a connection to be returned and throws
+    ///   a <see cref="Errors::ConnectionPoolTimeoutError" /> if none was.
     /// </remarks>
     public: NUCLEX_THINORM_API inline std::shared_ptr<Connection> BorrowConnection() override;
 
+    /// <summary>Borrows a connection, waiting up to the specified time if needed</summary>
+    /// <param name="timeout">Time to wait for a connection to become available</param>
+    /// <returns>A connection to the database the connection pool has been set up for</returns>
+    /// <remarks>
+    ///   Borrowers that have to wait are served strictly in the order they began waiting.
+    ///   If no connection becomes available within the timeout,
+    ///   a <see cref="Errors::ConnectionPoolTimeoutError" /> is thrown.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::shared_ptr<Connection> BorrowConnection(
+      std::chrono::milliseconds timeout
+    );
+
+    /// <summary>Borrows a connection if one is available without waiting</summary>
+    /// <returns>
+    ///   A connection to the database the connection pool has been set up for or
+    ///   an empty pointer if the maximum number of connections are all borrowed
+    /// </returns>
+    /// <remarks>
+    ///   This will still establish a new connection if the pool has no connection ready
+    ///   but is below its maximum connection count. It will not jump ahead of borrowers
+    ///   that are already waiting.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::shared_ptr<Connection> TryBorrowConnection();
+
     /// <summary>Returns a borrowed connection to the connection pool</summary>
     /// <param name="connection">Connection to put back into the connection pool</param>
     /// <remarks>
@@ -131,16 +300,131 @@ namespace Nuclex::ThinOrm::Connections {
       const std::shared_ptr<Connection> &connection
     ) override;
 
+    /// <summary>Tells the pool that a borrowed connection will not be returned</summary>
+    /// <param name="connection">Connection that has been closed or broken</param>
+    /// <remarks>
+    ///   Use this instead of <see cref="ReturnConnection" /> if a connection is no longer
+    ///   usable, for example because the server dropped it. The pool will no longer count
+    ///   it as open, allowing a waiting borrower to establish a new connection in its place.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void DiscardConnection(
+      const std::shared_ptr<Connection> &connection
+    ) override;
+
+    /// <summary>Borrower waiting for a connection to become available</summary>
+    private: struct Waiter {
+
+      /// <summary>Initializes a new waiter that has not been served yet</summary>
+      public: Waiter() : Served(false), HandedConnection(), Signal() {}
+
+      /// <summary>Whether the waiter has been given a connection or permission</summary>
+      /// <remarks>
+      ///   When served without a connection, the waiter has been granted permission
+      ///   to establish a new connection, which is already counted as open.
+      /// </remarks>
+      public: bool Served;
+      /// <summary>Connection that was handed to the waiter, if any</summary>
+      public: std::shared_ptr<Connection> HandedConnection;
+      /// <summary>Used to wake up the waiting thread once it has been served</summary>
+      public: std::condition_variable Signal;
+
+    };
+
+    /// <summary>Connection that is retained by the pool, waiting to be borrowed</summary>
+    private: struct RetainedConnection {
+
+      /// <summary>The connection itself</summary>
+      public: std::shared_ptr<Connection> Instance;
+      /// <summary>When the connection was last returned to the pool</summary>
+      public: std::chrono::steady_clock::time_point ReturnTime;
+      /// <summary>When the connection was last known to be healthy</summary>
+      public: std::chrono::steady_clock::time_point CheckTime;
+
+    };
+
+    /// <summary>Borrows a connection, waiting until the specified point in time</summary>
+    /// <param name="deadline">Point in time until which the borrower will wait</param>
+    /// <param name="wait">Whether to wait at all (false makes this a TryBorrow)</param>
+    /// <returns>The borrowed connection or an empty pointer if the time ran out</returns>
+    private: std::shared_ptr<Connection> borrowConnection(
+      std::chrono::steady_clock::time_point deadline, bool wait
+    );
+
+    /// <summary>Establishes a new connection for which a slot has been reserved</summary>
+    /// <returns>The new connection</returns>
+    private: std::shared_ptr<Connection> connectReserved();
+
+    /// <summary>Closes a slot and lets the next waiter, if any, take its place</summary>
+    /// <remarks>The connections access mutex must be held when calling this</remarks>
+    private: void releaseSlot();
+
+    /// <summary>
+    ///   Lets waiting borrowers establish new connections while there is room
+    /// </summary>
+    /// <remarks>The connections access mutex must be held when calling this</remarks>
+    private: void grantSlotsToWaiters();
+
+    /// <summary>Closes retained connections that exceed the current limits</summary>
+    /// <remarks>The connections access mutex must be held when calling this</remarks>
+    private: void trimRetainedConnections();
+
+    /// <summary>Hands a connection to a waiting borrower or retains it in the pool</summary>
+    /// <param name="connection">Connection that will be handed out or retained</param>
+    /// <param name="lastCheckTime">When the connection was last known to be healthy</param>
+    /// <param name="enforceRetainLimit">
+    ///   Whether to close the connection if the pool already retains the maximum number
+    /// </param>
+    /// <remarks>The connections access mutex must be held when calling this</remarks>
+    private: void handOverOrRetain(
+      const std::shared_ptr<Connection> &connection,
+      std::chrono::steady_clock::time_point lastCheckTime,
+      bool enforceRetainLimit
+    );
+
+    /// <summary>Closes retained connections that have been idle for too long</summary>
+    private: void evictIdleConnections();
+
+    /// <summary>Probes retained connections that are due for a health check</summary>
+    private: void checkRetainedConnections();
+
+    /// <summary>Runs maintenance passes until asked to stop</summary>
+    /// <param name="interval">Time between two maintenance passes</param>
+    private: void runMaintenanceThread(std::chrono::milliseconds interval);
+
     /// <summary>Connection factory through which new connections are established</summary>
     private: std::shared_ptr<ConnectionFactory> connectionFactory;
     /// <summary>>Settings to use when establishing a new connection</summary>
     private: Configuration::ConnectionString connectionProperties;
     /// <summary>Mutex that must be held to access the connections</summary>
-    private: std::mutex connectionsAccessMutex;
+    private: mutable std::mutex connectionsAccessMutex;
     /// <summary>Maximum number of connections the pool should retain</summary>
     private: std::size_t maximumRetainedConnectionCount;
+    /// <summary>Maximum number of connections that can be open at the same time</summary>
+    private: std::size_t maximumConnectionCount;
+    /// <summary>Time BorrowConnection() will wait for a connection at most</summary>
+    private: std::chrono::milliseconds borrowTimeout;
+    /// <summary>Number of connections that are borrowed, retained or being established</summary>
+    private: std::size_t openConnectionCount;
+    /// <summary>Time after which unused retained connections are closed</summary>
+    private: std::chrono::milliseconds maximumIdleTime;
+    /// <summary>Number of retained connections maintenance will keep ready</summary>
+    private: std::size_t minimumIdleConnectionCount;
+    /// <summary>Time after which retained connections are probed again</summary>
+    private: std::chrono::milliseconds healthCheckInterval;
     /// <summary>Connections currently retained in the connection pool</summary>
-    private: std::queue<std::shared_ptr<Connection>> connections;
+    /// <remarks>
+    ///   Ordered by the time they were returned. Borrowers take the most recently returned
+    ///   connection from the back, so rarely needed connections age out at the front.
+    /// </remarks>
+    private: std::deque<RetainedConnection> connections;
+    /// <summary>Borrowers waiting for a connection, in the order they arrived</summary>
+    private: std::deque<Waiter *> waiters;
+    /// <summary>Thread that performs periodic maintenance, if started</summary>
+    private: std::thread maintenanceThread;
+    /// <summary>Wakes up the maintenance thread when it should stop</summary>
+    private: std::condition_variable maintenanceStopSignal;
+    /// <summary>Whether the maintenance thread has been asked to stop</summary>
+    private: bool maintenanceStopRequested;
 
   };
 
@@ -150,13 +434,31 @@ namespace Nuclex::ThinOrm::Connections {
   inline StandardConnectionPool<TDataContext>::StandardConnectionPool(
     const std::shared_ptr<ConnectionFactory> &connectionFactory,
     const Configuration::ConnectionProperties &connectionProperties,
-    const std::size_t maximumRetainedConnectionCount /* = 3 */
+    const std::size_t maximumRetainedConnectionCount /* = 3 */,
+    const std::size_t maximumConnectionCount /* = std::numeric_limits<std::size_t>::max() */
   ) :
     connectionFactory(connectionFactory),
     connectionProperties(connectionProperties),
     connectionsAccessMutex(),
     maximumRetainedConnectionCount(maximumRetainedConnectionCount),
-    connections() {}
+    maximumConnectionCount(maximumConnectionCount),
+    borrowTimeout(std::chrono::seconds(30)),
+    openConnectionCount(0),
+    maximumIdleTime(std::chrono::milliseconds::zero()),
+    minimumIdleConnectionCount(0),
+    healthCheckInterval(std::chrono::milliseconds::zero()),
+    connections(),
+    waiters(),
+    maintenanceThread(),
+    maintenanceStopSignal(),
+    maintenanceStopRequested(false) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline StandardConnectionPool<TDataContext>::~StandardConnectionPool() {
+    StopMaintenance();
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -176,35 +478,187 @@ namespace Nuclex::ThinOrm::Connections {
     std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
 
     this->maximumRetainedConnectionCount = maximumRetainedConnectionCount;
-    while(maximumRetainedConnectionCount < this->connections.size()) {
-      this->connections.pop();
+    trimRetainedConnections();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::size_t StandardConnectionPool<TDataContext>::GetMaximumConnectionCount() const {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    return this->maximumConnectionCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::SetMaximumConnectionCount(
+    std::size_t maximumConnectionCount
+  ) {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+
+    this->maximumConnectionCount = maximumConnectionCount;
+    trimRetainedConnections();
+    grantSlotsToWaiters(); // In case the limit was raised
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::chrono::milliseconds StandardConnectionPool<TDataContext>::GetBorrowTimeout() const {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    return this->borrowTimeout;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::SetBorrowTimeout(
+    std::chrono::milliseconds newBorrowTimeout
+  ) {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    this->borrowTimeout = newBorrowTimeout;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::size_t StandardConnectionPool<TDataContext>::CountOpenConnections() const {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    return this->openConnectionCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::chrono::milliseconds StandardConnectionPool<
+    TDataContext
+  >::GetMaximumIdleTime() const {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    return this->maximumIdleTime;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::SetMaximumIdleTime(
+    std::chrono::milliseconds newMaximumIdleTime
+  ) {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    this->maximumIdleTime = newMaximumIdleTime;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::size_t StandardConnectionPool<TDataContext>::GetMinimumIdleConnectionCount() const {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    return this->minimumIdleConnectionCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::SetMinimumIdleConnectionCount(
+    std::size_t newMinimumIdleConnectionCount
+  ) {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    this->minimumIdleConnectionCount = newMinimumIdleConnectionCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::chrono::milliseconds StandardConnectionPool<
+    TDataContext
+  >::GetHealthCheckInterval() const {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    return this->healthCheckInterval;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::SetHealthCheckInterval(
+    std::chrono::milliseconds newHealthCheckInterval
+  ) {
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    this->healthCheckInterval = newHealthCheckInterval;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::StartMaintenance(
+    std::chrono::milliseconds interval
+  ) {
+    StopMaintenance();
+
+    this->maintenanceStopRequested = false;
+    this->maintenanceThread = std::thread(
+      &StandardConnectionPool<TDataContext>::runMaintenanceThread, this, interval
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::StopMaintenance() {
+    if(!this->maintenanceThread.joinable()) {
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+      this->maintenanceStopRequested = true;
     }
+    this->maintenanceStopSignal.notify_one();
+    this->maintenanceThread.join();
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   template<typename TDataContext>
-  inline void StandardConnectionPool<TDataContext>::Ready(std::size_t connectionCount) {
-    std::size_t actualConnectionCount;
+  inline void StandardConnectionPool<TDataContext>::PerformMaintenance() {
+    evictIdleConnections();
+    checkRetainedConnections();
+
+    std::size_t minimumIdleConnectionCount;
     {
       std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
-      actualConnectionCount = this->connections.size();
+      minimumIdleConnectionCount = this->minimumIdleConnectionCount;
+    }
+    if(minimumIdleConnectionCount > 0) {
+      Ready(minimumIdleConnectionCount);
     }
+  }
 
-    while(actualConnectionCount < connectionCount) {
-      std::shared_ptr<Connection> newConnection = (
-        this->connectionFactory->Connect(this->connectionProperties)
-      );
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::Ready(std::size_t connectionCount) {
+    for(;;) {
+
+      // Reserve a slot for the new connection so that the maximum connection count
+      // cannot be exceeded by concurrent borrowers while the connection is established
+      {
+        std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+        if(this->connections.size() >= connectionCount) {
+          return;
+        }
+        if(this->openConnectionCount >= this->maximumConnectionCount) {
+          return;
+        }
+        ++this->openConnectionCount;
+      }
 
       // Small optimization, we don't keep the locked while establishing a connection
       // so that potential borrowers aren't blocked for the entire duration it takes to
       // add a new connection to the pool.
+      std::shared_ptr<Connection> newConnection = connectReserved();
       {
         std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
-        actualConnectionCount = this->connections.size();
-        if(actualConnectionCount < connectionCount) {
-          this->connections.push(std::move(newConnection));
-        }
+        handOverOrRetain(newConnection, std::chrono::steady_clock::now(), false);
       }
     }
   }
@@ -215,24 +669,49 @@ namespace Nuclex::ThinOrm::Connections {
   inline void StandardConnectionPool<TDataContext>::EvictAll() {
     std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
     while(!this->connections.empty()) {
-      this->connections.pop();
+      this->connections.pop_front();
+      --this->openConnectionCount;
     }
+
+    grantSlotsToWaiters();
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   template<typename TDataContext>
   inline std::shared_ptr<Connection> StandardConnectionPool<TDataContext>::BorrowConnection() {
+    std::chrono::milliseconds timeout;
     {
       std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
-      if(!this->connections.empty()) {
-        std::shared_ptr<Connection> result = this->connections.front();
-        this->connections.pop();
-        return result;
-      }
+      timeout = this->borrowTimeout;
     }
 
-    return this->connectionFactory->Connect(this->connectionProperties);
+    return BorrowConnection(timeout);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::shared_ptr<Connection> StandardConnectionPool<TDataContext>::BorrowConnection(
+    std::chrono::milliseconds timeout
+  ) {
+    std::shared_ptr<Connection> connection = borrowConnection(
+      std::chrono::steady_clock::now() + timeout, true
+    );
+    if(!connection) [[unlikely]] {
+      throw Errors::ConnectionPoolTimeoutError(
+        u8"Timed out waiting for a connection, all connections in the pool are borrowed"
+      );
+    }
+
+    return connection;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline std::shared_ptr<Connection> StandardConnectionPool<TDataContext>::TryBorrowConnection() {
+    return borrowConnection(std::chrono::steady_clock::time_point(), false);
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -242,11 +721,298 @@ namespace Nuclex::ThinOrm::Connections {
     const std::shared_ptr<Connection> &connection
   ) {
     std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
-    if(this->connections.size() < this->maximumRetainedConnectionCount) {
-      this->connections.push(std::move(connection));
+
+    // If the limit was lowered while the connection was borrowed, close it
+    if(this->openConnectionCount > this->maximumConnectionCount) [[unlikely]] {
+      releaseSlot();
+      return;
+    }
+
+    // The connection was just in use, so it counts as freshly checked
+    handOverOrRetain(connection, std::chrono::steady_clock::now(), true);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  inline void StandardConnectionPool<TDataContext>::DiscardConnection(
+    const std::shared_ptr<Connection> &connection
+  ) {
+    (void)connection; // Only the count of open connections needs updating
+    std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+    releaseSlot();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  std::shared_ptr<Connection> StandardConnectionPool<TDataContext>::borrowConnection(
+    std::chrono::steady_clock::time_point deadline, bool wait
+  ) {
+    for(;;) {
+      std::shared_ptr<Connection> retainedConnection;
+      bool needsHealthCheck = false;
+      {
+        Waiter waiter;
+        std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+
+        // Only take the quick route if nobody else is waiting, otherwise we would
+        // be stealing connections from borrowers that have been waiting longer
+        bool mustWait = true;
+        if(this->waiters.empty()) {
+          if(!this->connections.empty()) {
+            RetainedConnection &newest = this->connections.back();
+            if(this->healthCheckInterval > std::chrono::milliseconds::zero()) {
+              needsHealthCheck = (
+                (std::chrono::steady_clock::now() - newest.CheckTime) >= this->healthCheckInterval
+              );
+            }
+            retainedConnection = std::move(newest.Instance);
+            this->connections.pop_back();
+            mustWait = false;
+          } else if(this->openConnectionCount < this->maximumConnectionCount) {
+            ++this->openConnectionCount;
+            mustWait = false;
+          }
+        }
+
+        if(mustWait) {
+          if(!wait) {
+            return std::shared_ptr<Connection>();
+          }
+
+          this->waiters.push_back(&waiter);
+          bool wasServed = waiter.Signal.wait_until(
+            connectionsAccessScope, deadline, [&waiter] { return waiter.Served; }
+          );
+          if(!wasServed) {
+            this->waiters.erase(std::find(this->waiters.begin(), this->waiters.end(), &waiter));
+            return std::shared_ptr<Connection>();
+          }
+
+          // If we were handed a connection, we're done. Otherwise we've been granted
+          // a slot (already counted as open) and need to establish the connection.
+          if(waiter.HandedConnection) {
+            return std::move(waiter.HandedConnection);
+          }
+        }
+      } // connections access scope
+
+      if(!retainedConnection) {
+        return connectReserved();
+      }
+      if(!needsHealthCheck || retainedConnection->CheckHealth()) {
+        return retainedConnection;
+      }
+
+      // The connection failed its health check. Give up its slot and try again,
+      // the connection itself is closed outside of the lock when it goes out of scope.
+      {
+        std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+        releaseSlot();
+      }
+    } // for(;;)
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  std::shared_ptr<Connection> StandardConnectionPool<TDataContext>::connectReserved() {
+    try {
+      return this->connectionFactory->Connect(this->connectionProperties);
+    }
+    catch(...) {
+      std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+      releaseSlot();
+      throw;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::releaseSlot() {
+    --this->openConnectionCount;
+    grantSlotsToWaiters();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::grantSlotsToWaiters() {
+    while(!this->waiters.empty() && (this->openConnectionCount < this->maximumConnectionCount)) {
+      Waiter *firstWaiter = this->waiters.front();
+      this->waiters.pop_front();
+      ++this->openConnectionCount;
+      firstWaiter->Served = true;
+      firstWaiter->Signal.notify_one();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::trimRetainedConnections() {
+    while(!this->connections.empty()) {
+      bool tooManyRetained = (this->connections.size() > this->maximumRetainedConnectionCount);
+      bool tooManyOpen = (this->openConnectionCount > this->maximumConnectionCount);
+      if(!tooManyRetained && !tooManyOpen) {
+        break;
+      }
+
+      this->connections.pop_front();
+      --this->openConnectionCount;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::handOverOrRetain(
+    const std::shared_ptr<Connection> &connection,
+    std::chrono::steady_clock::time_point lastCheckTime,
+    bool enforceRetainLimit
+  ) {
+
+    // Waiting borrowers get the connection directly, in the order they arrived
+    if(!this->waiters.empty()) {
+      Waiter *firstWaiter = this->waiters.front();
+      this->waiters.pop_front();
+      firstWaiter->HandedConnection = connection;
+      firstWaiter->Served = true;
+      firstWaiter->Signal.notify_one();
+      return;
+    }
+
+    bool canRetain = (
+      (!enforceRetainLimit) ||
+      (this->connections.size() < this->maximumRetainedConnectionCount)
+    );
+    if(canRetain) {
+      this->connections.push_back(
+        RetainedConnection { connection, std::chrono::steady_clock::now(), lastCheckTime }
+      );
+    } else {
+      releaseSlot();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::evictIdleConnections() {
+    std::vector<std::shared_ptr<Connection>> evictedConnections;
+    {
+      std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+      if(this->maximumIdleTime <= std::chrono::milliseconds::zero()) {
+        return;
+      }
+
+      // The oldest connections are at the front, so we can stop at the first one
+      // that is still young enough
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      while(this->connections.size() > this->minimumIdleConnectionCount) {
+        RetainedConnection &oldest = this->connections.front();
+        if((now - oldest.ReturnTime) < this->maximumIdleTime) {
+          break;
+        }
+
+        evictedConnections.push_back(std::move(oldest.Instance));
+        this->connections.pop_front();
+        --this->openConnectionCount;
+      }
+
+      grantSlotsToWaiters();
     }
+
+    // The evicted connections are closed here, outside of the lock, because closing
+    // a network connection can take a while
   }
-  
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::checkRetainedConnections() {
+    std::chrono::steady_clock::time_point passStartTime = std::chrono::steady_clock::now();
+
+    for(;;) {
+      RetainedConnection candidate;
+      {
+        std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+        if(this->healthCheckInterval <= std::chrono::milliseconds::zero()) {
+          return;
+        }
+
+        // Look for a connection that hasn't been checked recently. Connections checked
+        // during this pass have a check time after the pass began and will be skipped.
+        typename std::deque<RetainedConnection>::iterator iterator = this->connections.begin();
+        while(iterator != this->connections.end()) {
+          if((passStartTime - iterator->CheckTime) >= this->healthCheckInterval) {
+            break;
+          }
+          ++iterator;
+        }
+        if(iterator == this->connections.end()) {
+          return;
+        }
+
+        // Take the connection out of the pool while it is being probed so no borrower
+        // can pick it up in the meantime
+        candidate = std::move(*iterator);
+        this->connections.erase(iterator);
+      }
+
+      bool isHealthy = candidate.Instance->CheckHealth();
+      {
+        std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+        if(!isHealthy) {
+          releaseSlot();
+        } else if(!this->waiters.empty()) {
+          handOverOrRetain(candidate.Instance, std::chrono::steady_clock::now(), false);
+        } else { // Put it back where it was so its idle time keeps counting
+          candidate.CheckTime = std::chrono::steady_clock::now();
+          this->connections.insert(
+            std::upper_bound(
+              this->connections.begin(), this->connections.end(), candidate,
+              [](const RetainedConnection &left, const RetainedConnection &right) {
+                return left.ReturnTime < right.ReturnTime;
+              }
+            ),
+            std::move(candidate)
+          );
+        }
+      }
+    } // for(;;)
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TDataContext>
+  void StandardConnectionPool<TDataContext>::runMaintenanceThread(
+    std::chrono::milliseconds interval
+  ) {
+    for(;;) {
+      {
+        std::unique_lock<std::mutex> connectionsAccessScope(this->connectionsAccessMutex);
+        bool stopRequested = this->maintenanceStopSignal.wait_for(
+          connectionsAccessScope, interval, [this] { return this->maintenanceStopRequested; }
+        );
+        if(stopRequested) {
+          return;
+        }
+      }
+
+      // Failures are not fatal here, if the database is unreachable right now,
+      // the next pass will try again.
+      try {
+        PerformMaintenance();
+      }
+      catch(const std::exception &) {
+        // Ignore
+      }
+    }
+  }
+
   // ------------------------------------------------------------------------------------------- //
 
 } // namespace Nuclex::ThinOrm::Connections
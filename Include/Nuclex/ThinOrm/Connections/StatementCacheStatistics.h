@@ -0,0 +1,58 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_STATEMENTCACHESTATISTICS_H
+#define NUCLEX_THINORM_CONNECTIONS_STATEMENTCACHESTATISTICS_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <cstddef> // for std::size_t
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Counters reported by a connection's prepared statement cache</summary>
+  /// <remarks>
+  ///   Connections keep recently used statements prepared so that running the same query
+  ///   again doesn't have to parse and plan it on the database side again. These counters
+  ///   can be used to judge whether the cache is sized adequately for an application:
+  ///   if evictions are frequent compared to hits, the working set of statements is
+  ///   larger than the cache.
+  /// </remarks>
+  struct NUCLEX_THINORM_TYPE StatementCacheStatistics {
+
+    /// <summary>Number of statements currently held in the cache</summary>
+    public: std::size_t CachedStatementCount;
+    /// <summary>Maximum number of statements the cache will retain</summary>
+    public: std::size_t Capacity;
+    /// <summary>Number of times a prepared statement could be taken from the cache</summary>
+    public: std::size_t HitCount;
+    /// <summary>Number of times a statement had to be prepared from scratch</summary>
+    public: std::size_t MissCount;
+    /// <summary>Number of prepared statements that were dropped to make room</summary>
+    public: std::size_t EvictionCount;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // NUCLEX_THINORM_CONNECTIONS_STATEMENTCACHESTATISTICS_H
@@ -21,6 +21,7 @@ limitations under the License.
 #define NUCLEX_THINORM_DATACONTEXT_H
 
 #include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Connections/ConnectionLease.h" // for ConnectionLease
 
 #include <memory> // for std::shared_ptr<>
 
@@ -28,6 +29,9 @@ namespace Nuclex::ThinOrm::Connections {
   class Connection;
   class ConnectionPool;
 }
+namespace Nuclex::ThinOrm::Fluent {
+  class GlobalEntityRegistry;
+}
 
 namespace Nuclex::ThinOrm {
 
@@ -72,9 +76,58 @@ namespace Nuclex::ThinOrm {
       const std::shared_ptr<Connections::ConnectionPool> &pool
     );
 
+    /// <summary>
+    ///   Initializes a data context on an already established connection that looks up
+    ///   entity mappings in the specified registry
+    /// </summary>
+    /// <param name="connection">Database connection the data context will be using</param>
+    /// <param name="entityRegistry">
+    ///   Registry holding the table mappings of the entity classes used in fluent queries
+    /// </param>
+    /// <remarks>
+    ///   The entity registry must stay alive for as long as the data context exists.
+    /// </remarks>
+    public: NUCLEX_THINORM_API DataContext(
+      const std::shared_ptr<Connections::Connection> &connection,
+      Fluent::GlobalEntityRegistry &entityRegistry
+    );
+
+    /// <summary>
+    ///   Initializes a data context that is able to borrow connections on demand and
+    ///   looks up entity mappings in the specified registry
+    /// </summary>
+    /// <param name="pool">Pool from which connections will be borrowed as needed</param>
+    /// <param name="entityRegistry">
+    ///   Registry holding the table mappings of the entity classes used in fluent queries
+    /// </param>
+    /// <remarks>
+    ///   The entity registry must stay alive for as long as the data context exists.
+    /// </remarks>
+    public: NUCLEX_THINORM_API DataContext(
+      const std::shared_ptr<Connections::ConnectionPool> &pool,
+      Fluent::GlobalEntityRegistry &entityRegistry
+    );
+
     /// <summary>Frees all resources owned by the context</summary>
     public: NUCLEX_THINORM_API virtual ~DataContext();
 
+    /// <summary>Provides a connection through which queries can be run</summary>
+    /// <returns>A lease that grants access to a connection until it is destroyed</returns>
+    /// <remarks>
+    ///   If the data context was constructed with a connection pool, a connection is
+    ///   borrowed from the pool and returned when the lease is destroyed. Otherwise,
+    ///   the lease simply refers to the data context's exclusive connection.
+    /// </remarks>
+    public: NUCLEX_THINORM_API Connections::ConnectionLease LeaseConnection();
+
+    /// <summary>Accesses the registry in which the entity classes are mapped</summary>
+    /// <returns>The entity registry used to look up table mappings</returns>
+    /// <remarks>
+    ///   Unless a different registry was passed to the constructor, this is
+    ///   the registry returned by <see cref="GlobalEntityRegistry.GetDefault" />.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline Fluent::GlobalEntityRegistry &GetEntityRegistry() const;
+
     /// <summary>Connection that should be exclusively used for all data access</summary>
     /// <remarks>
     ///   If this is set, only this one connection will be used. When a data context is
@@ -84,11 +137,19 @@ namespace Nuclex::ThinOrm {
     private: std::shared_ptr<Connections::Connection> connection;
     /// <summary>Connection pool from which connections should be borrowed as needed</summary>
     private: std::shared_ptr<Connections::ConnectionPool> pool;
+    /// <summary>Registry holding the table mappings of the entity classes</summary>
+    private: Fluent::GlobalEntityRegistry *entityRegistry;
 
   };
 
   // ------------------------------------------------------------------------------------------- //
 
+  inline Fluent::GlobalEntityRegistry &DataContext::GetEntityRegistry() const {
+    return *this->entityRegistry;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm
 
 #endif // NUCLEX_THINORM_DATACONTEXT_H
@@ -23,6 +23,7 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Dialects/QuoteStyle.h"
 #include "Nuclex/ThinOrm/Dialects/DateTimeDialect.h"
+#include "Nuclex/ThinOrm/Dialects/UpsertStyle.h"
 
 namespace Nuclex::ThinOrm::Dialects {
 
@@ -42,6 +43,9 @@ namespace Nuclex::ThinOrm::Dialects {
     /// </remarks>
     public: QuoteStyle IdentifierQuoteStyle;
 
+    /// <summary>How rows are inserted or updated if their key already exists</summary>
+    public: UpsertStyle UpsertSyntax;
+
     // Should we even expose this? It should be the user's job to match the casing and
     // otherwise, they messed up. We might actually verify casing rather than add crudges
     // that grant the user the ability to be lax about casing.
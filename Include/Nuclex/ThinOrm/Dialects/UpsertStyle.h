@@ -0,0 +1,56 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_DIALECTS_UPSERTSTYLE_H
+#define NUCLEX_THINORM_DIALECTS_UPSERTSTYLE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+namespace Nuclex::ThinOrm::Dialects {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Syntax by which a row can be inserted or, if its key already exists, updated
+  /// </summary>
+  enum class UpsertStyle {
+
+    /// <summary>Conflicts are handled via ON CONFLICT (...) DO UPDATE SET ...</summary>
+    /// <remarks>
+    ///   Understood by PostgreSQL (since 9.5) and SQLite (since 3.24). The key columns
+    ///   are named explicitly and the values of the rejected row are available through
+    ///   the <code>excluded</code> pseudo-table.
+    /// </remarks>
+    OnConflictDoUpdate,
+
+    /// <summary>Conflicts are handled via ON DUPLICATE KEY UPDATE ...</summary>
+    /// <remarks>
+    ///   Understood by MySQL and MariaDB. The database picks whichever unique key caused
+    ///   the conflict and the values of the rejected row are available through
+    ///   the <code>VALUES()</code> function.
+    /// </remarks>
+    OnDuplicateKeyUpdate
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Dialects
+
+#endif // NUCLEX_THINORM_DIALECTS_UPSERTSTYLE_H
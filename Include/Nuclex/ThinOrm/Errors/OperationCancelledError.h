@@ -0,0 +1,58 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_ERRORS_OPERATIONCANCELLEDERROR_H
+#define NUCLEX_THINORM_ERRORS_OPERATIONCANCELLEDERROR_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <string> // for std::u8string
+#include <stdexcept> // for std::runtime_error
+
+namespace Nuclex::ThinOrm::Errors {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Indicates that an asynchronous operation was cancelled before it ran</summary>
+  /// <remarks>
+  ///   Asynchronous database operations accept a stop token. If a stop is requested
+  ///   before the operation got its turn on an I/O thread, it will not be carried out
+  ///   and this error is thrown to the awaiting coroutine instead.
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE OperationCancelledError : public std::runtime_error {
+
+    /// <summary>Initializes an operation cancelled error</summary>
+    /// <param name="message">Message that describes the error</param>
+    public: NUCLEX_THINORM_API explicit OperationCancelledError(
+      const std::u8string &message
+    ) noexcept;
+
+    /// <summary>Initializes an operation cancelled error</summary>
+    /// <param name="message">Message that describes the error</param>
+    public: NUCLEX_THINORM_API explicit OperationCancelledError(
+      const char8_t *message
+    ) noexcept;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Errors
+
+#endif // NUCLEX_THINORM_ERRORS_OPERATIONCANCELLEDERROR_H
@@ -0,0 +1,59 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_ERRORS_UNEXPECTEDRESULTCOUNTERROR_H
+#define NUCLEX_THINORM_ERRORS_UNEXPECTEDRESULTCOUNTERROR_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <string> // for std::u8string
+#include <stdexcept> // for std::runtime_error
+
+namespace Nuclex::ThinOrm::Errors {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Indicates that a query returned fewer or more rows than the caller expected
+  /// </summary>
+  /// <remarks>
+  ///   Thrown by fluent queries when <code>First()</code> finds no rows or when
+  ///   <code>Single()</code> finds no rows or more than one row.
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE UnexpectedResultCountError : public std::runtime_error {
+
+    /// <summary>Initializes an unexpected result count error</summary>
+    /// <param name="message">Message that describes the error</param>
+    public: NUCLEX_THINORM_API explicit UnexpectedResultCountError(
+      const std::u8string &message
+    ) noexcept;
+
+    /// <summary>Initializes an unexpected result count error</summary>
+    /// <param name="message">Message that describes the error</param>
+    public: NUCLEX_THINORM_API explicit UnexpectedResultCountError(
+      const char8_t *message
+    ) noexcept;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Errors
+
+#endif // NUCLEX_THINORM_ERRORS_UNEXPECTEDRESULTCOUNTERROR_H
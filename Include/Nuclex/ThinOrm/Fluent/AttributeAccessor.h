@@ -22,8 +22,15 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Value.h"
+#include "Nuclex/ThinOrm/RowReader.h"
 
 #include <string> // for std::u8string
+#include <optional> // for std::optional<>
+#include <vector> // for std::vector<>
+#include <cstddef> // for std::byte
+#include <cstdint> // for std::int64_t
+#include <stdexcept> // for std::runtime_error
+#include <type_traits> // for std::is_same_v, std::is_integral_v, etc.
 
 namespace Nuclex::ThinOrm::Fluent {
 
@@ -59,6 +66,39 @@ namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
+  /// <summary>Helper to detect whether an attribute type is optional</summary>
+  /// <typeparam name="TAttribute">Attribute type that will be checked</typeparam>
+  template<typename TAttribute>
+  class OptionalAttributeTraits {
+
+    /// <summary>Whether the attribute type is an std::optional</summary>
+    public: static constexpr bool IsOptional = false;
+
+    /// <summary>The type of the value stored in the attribute</summary>
+    public: typedef TAttribute ValueType;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Helper to detect whether an attribute type is optional, partial specialized version
+  ///   that detects std::optional and unwraps its value type
+  /// </summary>
+  /// <typeparam name="TValue">Type of the value stored in the std::optional</typeparam>
+  template<typename TValue>
+  class OptionalAttributeTraits<std::optional<TValue>> {
+
+    /// <summary>Whether the attribute type is an std::optional</summary>
+    public: static constexpr bool IsOptional = true;
+
+    /// <summary>The type of the value stored in the attribute</summary>
+    public: typedef TValue ValueType;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
   /// <summary>
   ///   Provides accessors by which registered attributes of an entity class can be
   ///   read and written
@@ -89,7 +129,35 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <param name="value">
     ///   Value that will be written into the attribute, wrapped in a <see cref="Value" />
     /// </param>
-    public: static inline void Set(void *entityAsVoid, const Value &value) noexcept;
+    public: static inline void Set(void *entityAsVoid, const Value &value);
+
+    /// <summary>Helper that reads an attribute directly from a result row</summary>
+    /// <param name="entityAsVoid">
+    ///   Instance of the entity class (type is TAttribute) into which the attribute
+    ///   value will be stored
+    /// </param>
+    /// <param name="reader">Row reader positioned on the row that will be read</param>
+    /// <param name="columnIndex">Index of the column holding the attribute's value</param>
+    /// <remarks>
+    ///   This is compiled separately for each attribute type. Integers, floating point
+    ///   values, strings and blobs are read through the row reader's typed methods with
+    ///   no <see cref="Value" /> involved and strings and blobs reuse the memory already
+    ///   held by the attribute. Only decimals and dates/times go through a Value.
+    /// </remarks>
+    public: static inline void Read(
+      void *entityAsVoid, const RowReader &reader, std::size_t columnIndex
+    );
+
+    /// <summary>Reads a non-NULL column into the value of an attribute</summary>
+    /// <typeparam name="TValue">Type of the attribute's value</typeparam>
+    /// <param name="reader">Row reader positioned on the row that will be read</param>
+    /// <param name="columnIndex">Index of the column that will be read</param>
+    /// <param name="target">Attribute value that will receive the column's value</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    private: template<typename TValue>
+    static inline bool readColumn(
+      const RowReader &reader, std::size_t columnIndex, TValue &target
+    );
 
   };
 
@@ -115,7 +183,7 @@ namespace Nuclex::ThinOrm::Fluent {
   template<auto AttributePointer>
   void AttributeAccessor<AttributePointer>::Set(
     void *entityAsVoid, const Value &value
-  ) noexcept {
+  ) {
     using TEntity = typename AttributePointerTraits<decltype(AttributePointer)>::EntityType;
     using TAttribute = typename AttributePointerTraits<decltype(AttributePointer)>::AttributeType;
 
@@ -125,7 +193,85 @@ namespace Nuclex::ThinOrm::Fluent {
     // that says that a 'Value' cannot be converted to whatever type 'TAttribute' is, that
     // means your entity class uses an attribute of a type that this ORM system does not
     // support. Please check the constructors of the 'Value' class to see supported types.
-    entity.*AttributePointer = static_cast<TAttribute>(value); // uses type conversion operator
+    //
+    // The conversion operator is called explicitly because a static_cast to std::optional<T>
+    // would pick std::optional's converting constructor and fail on NULL values.
+    entity.*AttributePointer = value.operator TAttribute();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<auto AttributePointer>
+  void AttributeAccessor<AttributePointer>::Read(
+    void *entityAsVoid, const RowReader &reader, std::size_t columnIndex
+  ) {
+    using TEntity = typename AttributePointerTraits<decltype(AttributePointer)>::EntityType;
+    using TAttribute = typename AttributePointerTraits<decltype(AttributePointer)>::AttributeType;
+
+    TAttribute &attribute = static_cast<TEntity *>(entityAsVoid)->*AttributePointer;
+
+    if constexpr(OptionalAttributeTraits<TAttribute>::IsOptional) {
+      if(!attribute.has_value()) {
+        attribute.emplace();
+      }
+      if(!readColumn(reader, columnIndex, attribute.value())) {
+        attribute.reset();
+      }
+    } else {
+      if(!readColumn(reader, columnIndex, attribute)) {
+        throw std::runtime_error(
+          reinterpret_cast<const char *>(
+            u8"Column contained NULL but the entity attribute it is mapped to is not optional"
+          )
+        );
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<auto AttributePointer>
+  template<typename TValue>
+  inline bool AttributeAccessor<AttributePointer>::readColumn(
+    const RowReader &reader, std::size_t columnIndex, TValue &target
+  ) {
+    if constexpr(std::is_same_v<TValue, bool>) {
+      std::int64_t integer;
+      if(!reader.TryReadColumnInt64(columnIndex, integer)) {
+        return false;
+      }
+      target = (integer != 0);
+      return true;
+    } else if constexpr(std::is_integral_v<TValue>) {
+      std::int64_t integer;
+      if(!reader.TryReadColumnInt64(columnIndex, integer)) {
+        return false;
+      }
+      target = static_cast<TValue>(integer);
+      return true;
+    } else if constexpr(std::is_floating_point_v<TValue>) {
+      double floatingPoint;
+      if(!reader.TryReadColumnDouble(columnIndex, floatingPoint)) {
+        return false;
+      }
+      target = static_cast<TValue>(floatingPoint);
+      return true;
+    } else if constexpr(std::is_same_v<TValue, std::u8string>) {
+      return reader.TryReadColumnString(columnIndex, target);
+    } else if constexpr(std::is_same_v<TValue, std::vector<std::byte>>) {
+      return reader.TryReadColumnBlob(columnIndex, target);
+    } else {
+      Value value = reader.GetColumnValue(columnIndex);
+      if(value.IsEmpty()) {
+        return false;
+      }
+
+      // Note: if you are binding your own entity class and your compiler shows an error
+      // here, your entity class uses an attribute of a type that this ORM system does not
+      // support. Please check the constructors of the 'Value' class to see supported types.
+      target = value.operator TValue();
+      return true;
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
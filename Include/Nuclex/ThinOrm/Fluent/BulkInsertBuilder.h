@@ -0,0 +1,279 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_BULKINSERTBUILDER_H
+#define NUCLEX_THINORM_FLUENT_BULKINSERTBUILDER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Dialects/QuoteStyle.h" // for QuoteStyle
+#include "Nuclex/ThinOrm/Fluent/EntityMappingConfigurator.h" // for GetAttributeValueFunction
+
+#include <cstddef> // for std::size_t, std::byte
+#include <span> // for std::span<>
+#include <string> // for std::u8string
+#include <map> // for std::map<>
+#include <typeinfo> // for std::type_info
+#include <utility> // for std::pair<>
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm::Connections {
+  class Connection;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+  class EntityLayout;
+  class GlobalEntityRegistry;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Generates multi-row INSERT statements to write many rows at once</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Inserting rows one by one costs a round-trip to the database server per row.
+  ///     This builder packs as many rows as the database allows into a single
+  ///     <code>INSERT INTO table (...) VALUES (...), (...), ...</code> statement, so
+  ///     inserting N rows only needs about N / chunk size round-trips.
+  ///   </para>
+  ///   <para>
+  ///     The generated statements are cached by the number of rows they hold and by
+  ///     the identifier quotes of the database they were generated for, which is taken
+  ///     from the connection. A bulk insert usually only needs two of them (full chunks
+  ///     and the remainder), and since the same <see cref="Query" /> instances are handed
+  ///     to the connection each time, they also hit the connection's prepared statement
+  ///     cache.
+  ///   </para>
+  ///   <para>
+  ///     Each statement is run on its own, so wrap the insert in a transaction if either
+  ///     all or none of the rows should be inserted. Instances are not thread-safe.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE BulkInsertBuilder {
+
+    /// <summary>Maximum number of rows that are put into a single statement</summary>
+    /// <remarks>
+    ///   Microsoft SQL Server refuses VALUES lists with more than 1000 rows. For other
+    ///   databases, statements beyond this size no longer make a measurable difference.
+    /// </remarks>
+    public: static const std::size_t MaximumRowsPerStatement;
+
+    /// <summary>Initializes a new bulk insert builder for the specified columns</summary>
+    /// <param name="tableName">Name of the table the rows will be inserted into</param>
+    /// <param name="columnNames">Names of the columns each row provides values for</param>
+    public: NUCLEX_THINORM_API BulkInsertBuilder(
+      const std::u8string_view &tableName,
+      const std::vector<std::u8string> &columnNames
+    );
+
+    /// <summary>Initializes a new bulk insert builder that can insert entities</summary>
+    /// <param name="entityType">Type of entity the builder will insert</param>
+    /// <param name="tableName">Name of the table the rows will be inserted into</param>
+    /// <param name="columnNames">Names of the columns each row provides values for</param>
+    /// <param name="getters">
+    ///   Functions that read the attribute value for each column from an entity
+    /// </param>
+    /// <remarks>
+    ///   Usually, you'd let <see cref="GlobalEntityRegistry.CreateBulkInsertBuilder" />
+    ///   set up a bulk insert builder for a registered entity instead.
+    /// </remarks>
+    public: NUCLEX_THINORM_API BulkInsertBuilder(
+      const std::type_info &entityType,
+      const std::u8string_view &tableName,
+      const std::vector<std::u8string> &columnNames,
+      const std::vector<EntityMappingConfigurator::GetAttributeValueFunction *> &getters
+    );
+
+    /// <summary>Takes over the generated statements of another bulk insert builder</summary>
+    /// <param name="other">Bulk insert builder that will be taken over</param>
+    public: NUCLEX_THINORM_API BulkInsertBuilder(BulkInsertBuilder &&other);
+
+    /// <summary>Frees all resources owned by the bulk insert builder</summary>
+    public: NUCLEX_THINORM_API ~BulkInsertBuilder();
+
+    /// <summary>Counts the columns each inserted row provides values for</summary>
+    /// <returns>The number of columns in each inserted row</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountColumns() const noexcept;
+
+    /// <summary>Calculates how many rows can be inserted by a single statement</summary>
+    /// <param name="maximumParameterCount">
+    ///   Maximum number of parameters the database accepts in a single statement
+    /// </param>
+    /// <returns>The number of rows that fit into a single statement</returns>
+    public: NUCLEX_THINORM_API std::size_t GetMaximumRowsPerStatement(
+      std::size_t maximumParameterCount
+    ) const;
+
+    /// <summary>Looks up or generates the statement inserting the specified rows</summary>
+    /// <param name="rowCount">Number of rows the statement should insert</param>
+    /// <param name="quoteStyle">Quotes to put around table and column names</param>
+    /// <returns>
+    ///   A query whose parameters are the column values of all rows, row by row
+    /// </returns>
+    public: NUCLEX_THINORM_API Query &GetStatement(
+      std::size_t rowCount, Dialects::QuoteStyle quoteStyle = Dialects::QuoteStyle::DoubleQuotes
+    );
+
+    /// <summary>Inserts the specified rows into the table</summary>
+    /// <param name="connection">Connection on which the statements will be run</param>
+    /// <param name="rows">
+    ///   Rows that will be inserted, each needs to provide one value per column
+    /// </param>
+    /// <returns>The number of rows the database reported as inserted</returns>
+    public: NUCLEX_THINORM_API std::size_t Insert(
+      Connections::Connection &connection, const std::vector<std::vector<Value>> &rows
+    );
+
+    /// <summary>Inserts the specified entities into the table</summary>
+    /// <typeparam name="TEntity">Type of entity that will be inserted</typeparam>
+    /// <param name="connection">Connection on which the statements will be run</param>
+    /// <param name="entities">Entities that will be inserted</param>
+    /// <returns>The number of rows the database reported as inserted</returns>
+    /// <remarks>
+    ///   Only works if the builder was created for the entity type, either via
+    ///   the <see cref="GlobalEntityRegistry" /> or by providing the getters.
+    /// </remarks>
+    public: template<typename TEntity>
+    inline std::size_t Insert(
+      Connections::Connection &connection, std::span<const TEntity> entities
+    );
+
+    /// <summary>Inserts the entities in a vector into the table</summary>
+    /// <typeparam name="TEntity">Type of entity that will be inserted</typeparam>
+    /// <param name="connection">Connection on which the statements will be run</param>
+    /// <param name="entities">Entities that will be inserted</param>
+    /// <returns>The number of rows the database reported as inserted</returns>
+    /// <remarks>
+    ///   Convenience overload, the entity type can not be deduced when a vector is
+    ///   passed to the overload taking a span.
+    /// </remarks>
+    public: template<typename TEntity>
+    inline std::size_t Insert(
+      Connections::Connection &connection, const std::vector<TEntity> &entities
+    );
+
+    /// <summary>Takes over the generated statements of another bulk insert builder</summary>
+    /// <param name="other">Bulk insert builder that will be taken over</param>
+    /// <returns>The bulk insert builder itself</returns>
+    public: NUCLEX_THINORM_API BulkInsertBuilder &operator =(BulkInsertBuilder &&other);
+
+    /// <summary>Initializes a new bulk insert builder for a registered entity</summary>
+    /// <param name="entityType">Type of entity the builder will insert</param>
+    /// <param name="layout">Layout of the entity in the frozen entity registry</param>
+    /// <remarks>
+    ///   The statements are generated by the entity layout, which has its table and
+    ///   column names quoted already. Auto-generated columns are left out.
+    /// </remarks>
+    private: BulkInsertBuilder(const std::type_info &entityType, const EntityLayout &layout);
+
+    /// <summary>Inserts entities whose memory layout is known</summary>
+    /// <param name="connection">Connection on which the statements will be run</param>
+    /// <param name="entityType">Type of the entities that will be inserted</param>
+    /// <param name="firstEntity">Address of the first entity that will be inserted</param>
+    /// <param name="entitySize">Distance from one entity to the next in bytes</param>
+    /// <param name="entityCount">Number of entities that will be inserted</param>
+    /// <returns>The number of rows the database reported as inserted</returns>
+    private: NUCLEX_THINORM_API std::size_t insertEntities(
+      Connections::Connection &connection,
+      const std::type_info &entityType,
+      const std::byte *firstEntity,
+      std::size_t entitySize,
+      std::size_t entityCount
+    );
+
+    /// <summary>Runs the statements inserting rows in chunks</summary>
+    /// <typeparam name="TAssignRowFunction">
+    ///   Function that assigns a row's values to the query starting at a parameter index
+    /// </typeparam>
+    /// <param name="connection">Connection on which the statements will be run</param>
+    /// <param name="rowCount">Total number of rows that will be inserted</param>
+    /// <param name="assignRow">Called to assign each row's values to a query</param>
+    /// <returns>The number of rows the database reported as inserted</returns>
+    private: template<typename TAssignRowFunction>
+    std::size_t insertInChunks(
+      Connections::Connection &connection,
+      std::size_t rowCount,
+      const TAssignRowFunction &assignRow
+    );
+
+    /// <summary>Identifies a statement by its identifier quotes and row count</summary>
+    private: typedef std::pair<Dialects::QuoteStyle, std::size_t> StatementKey;
+    /// <summary>Maps quote styles and row counts to the statements inserting the rows</summary>
+    private: typedef std::map<StatementKey, Query> StatementMap;
+
+    /// <summary>The registry sets up bulk insert builders for registered entities</summary>
+    friend class GlobalEntityRegistry;
+
+    /// <summary>Name of the table the rows will be inserted into</summary>
+    private: std::u8string tableName;
+    /// <summary>Names of the columns each row provides values for</summary>
+    private: std::vector<std::u8string> columnNames;
+    /// <summary>Layout of the registered entity, null if the builder was set up by hand</summary>
+    /// <remarks>
+    ///   Entity layouts are part of the frozen entity registry and live as long as it does
+    /// </remarks>
+    private: const EntityLayout *layout;
+    /// <summary>Number of columns each inserted row provides values for</summary>
+    private: std::size_t columnCount;
+    /// <summary>Type of entity the getters read from, null if none were provided</summary>
+    private: const std::type_info *entityType;
+    /// <summary>Reads the value for each column from an entity</summary>
+    private: std::vector<EntityMappingConfigurator::GetAttributeValueFunction *> getters;
+    /// <summary>Statements that have been generated so far</summary>
+    private: StatementMap statements;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::size_t BulkInsertBuilder::CountColumns() const noexcept {
+    return this->columnCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t BulkInsertBuilder::Insert(
+    Connections::Connection &connection, std::span<const TEntity> entities
+  ) {
+    return insertEntities(
+      connection,
+      typeid(TEntity),
+      reinterpret_cast<const std::byte *>(entities.data()),
+      sizeof(TEntity),
+      entities.size()
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t BulkInsertBuilder::Insert(
+    Connections::Connection &connection, const std::vector<TEntity> &entities
+  ) {
+    return Insert(connection, std::span<const TEntity>(entities));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_BULKINSERTBUILDER_H
@@ -0,0 +1,199 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_CHANGETRACKER_H
+#define NUCLEX_THINORM_FLUENT_CHANGETRACKER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Fluent/EntityTracker.h" // for EntityTracker
+
+#include <cstddef> // for std::size_t
+#include <span> // for std::span<>
+#include <typeinfo> // for typeid
+
+namespace Nuclex::ThinOrm {
+  class DataContext;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Detects changes to loaded entities and writes only the changed columns</summary>
+  /// <typeparam name="TEntity">Entity class type whose instances will be tracked</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Change tracking is opt-in. Entities are tracked by loading them through
+  ///     <see cref="Queryable.ToVector" /> with a change tracker or by handing them to
+  ///     <see cref="Track" />. Updating a tracked entity then generates an UPDATE statement
+  ///     that only assigns the columns whose values differ from the time the entity was
+  ///     tracked, or sends nothing at all if the entity is unchanged:
+  ///   </para>
+  ///   <code>
+  ///     ChangeTracker&lt;User&gt; tracker(context);
+  ///     std::vector&lt;User&gt; users = context.Users.Take(10).ToVector(tracker);
+  ///     users[0].Email = u8"new@example.com";
+  ///     tracker.Update(users[0]); // UPDATE "users" SET "email" = ... WHERE "id" = ...
+  ///   </code>
+  ///   <para>
+  ///     A statement is generated once for each combination of changed columns and then
+  ///     reused by all trackers. Entities are identified by their primary key, which must
+  ///     not be changed while the entity is tracked. Trackers are not thread-safe.
+  ///   </para>
+  /// </remarks>
+  template<typename TEntity>
+  class NUCLEX_THINORM_TYPE ChangeTracker {
+
+    /// <summary>Initializes a new change tracker</summary>
+    /// <param name="dataContext">Data context through which entities will be updated</param>
+    public: NUCLEX_THINORM_API inline ChangeTracker(DataContext &dataContext);
+
+    /// <summary>Remembers the current state of an entity</summary>
+    /// <param name="entity">Entity that will be tracked</param>
+    /// <remarks>
+    ///   Tracking an entity that is already tracked makes its current state the state
+    ///   changes are detected against.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void Track(const TEntity &entity);
+
+    /// <summary>Remembers the current state of multiple entities</summary>
+    /// <param name="entities">Entities that will be tracked</param>
+    public: NUCLEX_THINORM_API inline void Track(std::span<const TEntity> entities);
+
+    /// <summary>Stops tracking an entity</summary>
+    /// <param name="entity">Entity that will no longer be tracked</param>
+    public: NUCLEX_THINORM_API inline void Forget(const TEntity &entity);
+
+    /// <summary>Stops tracking all entities</summary>
+    public: NUCLEX_THINORM_API inline void Clear() noexcept;
+
+    /// <summary>Counts the number of entities currently being tracked</summary>
+    /// <returns>The number of entities the change tracker knows the state of</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountTrackedEntities() const noexcept;
+
+    /// <summary>Checks whether an entity is being tracked</summary>
+    /// <param name="entity">Entity that will be checked</param>
+    /// <returns>True if an entity with the same primary key is being tracked</returns>
+    public: NUCLEX_THINORM_API inline bool IsTracked(const TEntity &entity) const;
+
+    /// <summary>Checks whether a tracked entity has been modified</summary>
+    /// <param name="entity">Tracked entity that will be checked</param>
+    /// <returns>True if any of the entity's updatable columns has changed</returns>
+    public: NUCLEX_THINORM_API inline bool HasChanges(const TEntity &entity) const;
+
+    /// <summary>Writes the changed columns of a tracked entity into its row</summary>
+    /// <param name="entity">Tracked entity that will be updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    public: NUCLEX_THINORM_API inline std::size_t Update(const TEntity &entity);
+
+    /// <summary>Writes the changed columns of multiple tracked entities</summary>
+    /// <param name="entities">Tracked entities that will be updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   Each changed entity is updated with its own statement and unchanged entities
+    ///   are skipped. Wrap the call in a transaction if either all or none of
+    ///   the entities should be written.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::size_t Update(std::span<const TEntity> entities);
+
+    /// <summary>Type-erased engine that holds the snapshots</summary>
+    private: EntityTracker tracker;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline ChangeTracker<TEntity>::ChangeTracker(DataContext &dataContext) :
+    tracker(dataContext, typeid(TEntity)) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline void ChangeTracker<TEntity>::Track(const TEntity &entity) {
+    this->tracker.Track(&entity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline void ChangeTracker<TEntity>::Track(std::span<const TEntity> entities) {
+    for(const TEntity &entity : entities) {
+      this->tracker.Track(&entity);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline void ChangeTracker<TEntity>::Forget(const TEntity &entity) {
+    this->tracker.Forget(&entity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline void ChangeTracker<TEntity>::Clear() noexcept {
+    this->tracker.Clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t ChangeTracker<TEntity>::CountTrackedEntities() const noexcept {
+    return this->tracker.CountTrackedEntities();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline bool ChangeTracker<TEntity>::IsTracked(const TEntity &entity) const {
+    return this->tracker.IsTracked(&entity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline bool ChangeTracker<TEntity>::HasChanges(const TEntity &entity) const {
+    return this->tracker.HasChanges(&entity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t ChangeTracker<TEntity>::Update(const TEntity &entity) {
+    return this->tracker.Update(&entity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t ChangeTracker<TEntity>::Update(std::span<const TEntity> entities) {
+    std::size_t affectedRowCount = 0;
+    for(const TEntity &entity : entities) {
+      affectedRowCount += this->tracker.Update(&entity);
+    }
+    return affectedRowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_CHANGETRACKER_H
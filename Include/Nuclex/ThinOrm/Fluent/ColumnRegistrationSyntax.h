@@ -121,6 +121,7 @@ namespace Nuclex::ThinOrm::Fluent {
       columnName,
       &AttributeAccessor<AttributePointer>::Get,
       &AttributeAccessor<AttributePointer>::Set,
+      &AttributeAccessor<AttributePointer>::Read,
       typeid(typename AttributePointerTraits<TAttributePointer>::AttributeType)
     );
 
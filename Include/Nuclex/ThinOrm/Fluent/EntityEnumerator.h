@@ -0,0 +1,216 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_ENTITYENUMERATOR_H
+#define NUCLEX_THINORM_FLUENT_ENTITYENUMERATOR_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Fluent/QueryShape.h" // for QueryShape
+#include "Nuclex/ThinOrm/Fluent/EntityReader.h" // for EntityReader
+
+#include <cstddef> // for std::ptrdiff_t
+#include <iterator> // for std::input_iterator_tag, std::default_sentinel_t
+#include <memory> // for std::unique_ptr<>
+#include <typeinfo> // for typeid
+
+namespace Nuclex::ThinOrm {
+  class DataContext;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Steps through the results of a query one entity at a time</summary>
+  /// <typeparam name="TEntity">Type of entity the query is returning</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     The enumerator keeps a single entity and a single row reader for the whole
+  ///     query. Each step reads the next row into that same entity, so memory use stays
+  ///     flat no matter how many rows the query returns and strings in the entity keep
+  ///     reusing the memory they have already allocated.
+  ///   </para>
+  ///   <para>
+  ///     It can be used with a range-based for loop or any algorithm accepting an input
+  ///     range. Like any input range, it can only be iterated once and the entity an
+  ///     iterator refers to is overwritten when the iterator advances - copy or move it
+  ///     out if you need it for longer.
+  ///   </para>
+  ///   <para>
+  ///     The enumerator holds on to a connection from the data context until it is
+  ///     destroyed, so don't keep it around longer than needed.
+  ///   </para>
+  /// </remarks>
+  template<typename TEntity>
+  class NUCLEX_THINORM_TYPE EntityEnumerator {
+
+    #pragma region class Iterator
+
+    /// <summary>Input iterator advancing the enumerator</summary>
+    public: class Iterator {
+
+      /// <summary>Iterator category for the C++20 iterator concepts</summary>
+      public: typedef std::input_iterator_tag iterator_concept;
+      /// <summary>Iterator category for pre-C++20 algorithms</summary>
+      public: typedef std::input_iterator_tag iterator_category;
+      /// <summary>Type of the entities the iterator provides</summary>
+      public: typedef TEntity value_type;
+      /// <summary>Type used to express distances between iterators</summary>
+      public: typedef std::ptrdiff_t difference_type;
+
+      /// <summary>Initializes an iterator that is not attached to any enumerator</summary>
+      public: Iterator() noexcept : enumerator(nullptr) {}
+
+      /// <summary>Initializes an iterator advancing the specified enumerator</summary>
+      /// <param name="enumerator">Enumerator that will be advanced by the iterator</param>
+      public: explicit Iterator(EntityEnumerator &enumerator) noexcept :
+        enumerator(&enumerator) {}
+
+      /// <summary>Accesses the entity holding the current row</summary>
+      /// <returns>The entity holding the current row</returns>
+      public: TEntity &operator *() const noexcept { return this->enumerator->current; }
+
+      /// <summary>Accesses the entity holding the current row</summary>
+      /// <returns>The entity holding the current row</returns>
+      public: TEntity *operator ->() const noexcept { return &this->enumerator->current; }
+
+      /// <summary>Advances to the next row</summary>
+      /// <returns>The iterator itself</returns>
+      public: Iterator &operator ++() {
+        this->enumerator->MoveToNext();
+        return *this;
+      }
+
+      /// <summary>Advances to the next row</summary>
+      public: void operator ++(int) { this->enumerator->MoveToNext(); }
+
+      /// <summary>Checks whether the iterator has moved past the last row</summary>
+      /// <returns>True if there are no more rows, false otherwise</returns>
+      public: bool operator ==(std::default_sentinel_t) const noexcept {
+        return !this->enumerator->hasCurrent;
+      }
+
+      /// <summary>Enumerator that is being advanced by the iterator</summary>
+      private: EntityEnumerator *enumerator;
+
+    };
+
+    #pragma endregion // class Iterator
+
+    /// <summary>Initializes a new enumerator and runs its query</summary>
+    /// <param name="dataContext">Data context through which the query will be run</param>
+    /// <param name="shape">Modifiers that have been applied to the query</param>
+    public: NUCLEX_THINORM_API inline EntityEnumerator(
+      DataContext &dataContext, const QueryShape &shape
+    );
+
+    /// <summary>Takes over the query of another enumerator</summary>
+    /// <param name="other">Enumerator whose query will be taken over</param>
+    /// <remarks>
+    ///   Iterators obtained from the other enumerator can no longer be used afterwards
+    /// </remarks>
+    public: EntityEnumerator(EntityEnumerator &&other) = default;
+
+    /// <summary>Closes the query and gives back the connection</summary>
+    public: ~EntityEnumerator() = default;
+
+    /// <summary>Reads the next row into the current entity</summary>
+    /// <returns>True if there was a next row, false if the end was reached</returns>
+    public: NUCLEX_THINORM_API inline bool MoveToNext();
+
+    /// <summary>Accesses the entity holding the current row</summary>
+    /// <returns>The entity holding the current row</returns>
+    /// <remarks>
+    ///   Only valid after <see cref="MoveToNext" /> has returned true
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline TEntity &GetCurrent() noexcept;
+
+    /// <summary>Returns an iterator positioned on the first row</summary>
+    /// <returns>An iterator on the first row of the result</returns>
+    /// <remarks>
+    ///   The enumerator can only be stepped through once. If rows have already been read
+    ///   via <see cref="MoveToNext" />, the iterator starts at the current row.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline Iterator begin();
+
+    /// <summary>Returns a sentinel that iterators past the last row compare equal to</summary>
+    /// <returns>The end-of-result sentinel</returns>
+    public: constexpr std::default_sentinel_t end() const noexcept {
+      return std::default_sentinel;
+    }
+
+    /// <summary>Runs the query and reads the result rows</summary>
+    private: std::unique_ptr<EntityReader> reader;
+    /// <summary>Entity the current row is read into</summary>
+    private: TEntity current;
+    /// <summary>Whether the enumerator has moved to the first row yet</summary>
+    private: bool hasStarted;
+    /// <summary>Whether the current entity holds a row</summary>
+    private: bool hasCurrent;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline EntityEnumerator<TEntity>::EntityEnumerator(
+    DataContext &dataContext, const QueryShape &shape
+  ) :
+    reader(std::make_unique<EntityReader>(dataContext, typeid(TEntity), shape)),
+    current(),
+    hasStarted(false),
+    hasCurrent(false) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline bool EntityEnumerator<TEntity>::MoveToNext() {
+    this->hasStarted = true;
+
+    this->hasCurrent = this->reader->MoveToNext();
+    if(this->hasCurrent) {
+      this->reader->ReadCurrentRow(&this->current);
+    }
+
+    return this->hasCurrent;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline TEntity &EntityEnumerator<TEntity>::GetCurrent() noexcept {
+    return this->current;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline typename EntityEnumerator<TEntity>::Iterator EntityEnumerator<TEntity>::begin() {
+    if(!this->hasStarted) {
+      MoveToNext();
+    }
+
+    return Iterator(*this);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_ENTITYENUMERATOR_H
@@ -24,6 +24,11 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Value.h" // for Value
 
 #include <typeinfo> // for std::type_info
+#include <cstddef> // for std::size_t
+
+namespace Nuclex::ThinOrm {
+  class RowReader;
+}
 
 namespace Nuclex::ThinOrm::Fluent {
 
@@ -54,6 +59,18 @@ namespace Nuclex::ThinOrm::Fluent {
     /// </param>
     public: typedef void SetAttributeValueFunction(void *entity, const Value &value);
 
+    /// <summary
+    ///   >Signature for a function that reads an attribute directly from a result row
+    /// </summary>
+    /// <param name="entity">
+    ///   Instance of an entity class in which an attribute will be set
+    /// </param>
+    /// <param name="reader">Row reader positioned on the row that will be read</param>
+    /// <param name="columnIndex">Index of the column holding the attribute's value</param>
+    public: typedef void ReadAttributeFunction(
+      void *entity, const RowReader &reader, std::size_t columnIndex
+    );
+
     /// <summary>Registers an entity class that maps to a specific table</summary>
     /// <param name="entityType">Type information </param>
     /// <param name="tableName">Name of the table in the database</param>
@@ -66,12 +83,14 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <param name="columnName">Name of the column in the database table</param>
     /// <param name="getter">Getter through which the attribute can be read</param>
     /// <param name="setter">Getter through which the attribute can be updated</param>
+    /// <param name="reader">Reads the attribute straight from a result row</param>
     /// <param name="attributeType">RTTI type of the attribute in the entity class</param>
     public: NUCLEX_THINORM_API virtual void AddEntityAttribute(
       const std::type_info &entityType,
       const std::u8string_view &columnName,
       GetAttributeValueFunction *getter,
       SetAttributeValueFunction *setter,
+      ReadAttributeFunction *reader,
       const std::type_info &attributeType
     ) = 0;
 
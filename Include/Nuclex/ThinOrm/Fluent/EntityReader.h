@@ -0,0 +1,127 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_ENTITYREADER_H
+#define NUCLEX_THINORM_FLUENT_ENTITYREADER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Connections/ConnectionLease.h" // for ConnectionLease
+#include "Nuclex/ThinOrm/Fluent/QueryShape.h" // for QueryShape
+
+#include <memory> // for std::unique_ptr<>
+#include <optional> // for std::optional<>
+#include <cstddef> // for std::size_t
+#include <vector> // for std::vector<>
+#include <typeinfo> // for std::type_info
+
+namespace Nuclex::ThinOrm {
+  class DataContext;
+  class RowReader;
+}
+namespace Nuclex::ThinOrm::Fluent {
+  class EntityLayout;
+  class SelectPlan;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Runs a generated SELECT query and copies the result rows into entities</summary>
+  /// <remarks>
+  ///   <para>
+  ///     This is the type-erased engine behind <see cref="Queryable" />. The SELECT
+  ///     statement for each entity type and query shape is generated only once, when
+  ///     the <see cref="GlobalEntityRegistry" /> is frozen, together with a list of attribute
+  ///     readers in result column order, so reading a row into an entity does not involve
+  ///     any column name lookups or intermediate <see cref="Value" /> instances.
+  ///   </para>
+  ///   <para>
+  ///     The reader holds on to a connection from the data context until it is destroyed.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE EntityReader {
+
+    /// <summary>Initializes a new entity reader and runs its query</summary>
+    /// <param name="dataContext">Data context through which the query will be run</param>
+    /// <param name="entityType">Type of entity class the query returns</param>
+    /// <param name="shape">Modifiers that have been applied to the query</param>
+    public: NUCLEX_THINORM_API EntityReader(
+      DataContext &dataContext, const std::type_info &entityType, const QueryShape &shape
+    );
+
+    /// <summary>Entity readers own their connection and can not be copied</summary>
+    public: EntityReader(const EntityReader &other) = delete;
+
+    /// <summary>Closes the query and gives back the connection</summary>
+    public: NUCLEX_THINORM_API ~EntityReader();
+
+    /// <summary>Tries to move to the next row in the result</summary>
+    /// <returns>True if there was a next row, false if the end was reached</returns>
+    public: NUCLEX_THINORM_API bool MoveToNext();
+
+    /// <summary>Reports the total number of rows in the result if it is known</summary>
+    /// <returns>The number of rows in the result or nothing if it isn't known</returns>
+    public: NUCLEX_THINORM_API std::optional<std::size_t> GetRowCountHint() const;
+
+    /// <summary>Copies the values of the current row into an entity</summary>
+    /// <param name="entity">
+    ///   Entity that will receive the values, must be an instance of the entity class
+    ///   the reader has been constructed for
+    /// </param>
+    public: NUCLEX_THINORM_API void ReadCurrentRow(void *entity) const;
+
+    /// <summary>Reads the primary key of an entity the reader has filled</summary>
+    /// <param name="entity">Entity whose primary key will be read</param>
+    /// <param name="key">
+    ///   Receives one value per primary key column, in the order the columns were registered
+    /// </param>
+    public: NUCLEX_THINORM_API void GetPrimaryKey(
+      const void *entity, std::vector<Value> &key
+    ) const;
+
+    /// <summary>Entity readers own their connection and can not be copied</summary>
+    public: EntityReader &operator =(const EntityReader &other) = delete;
+
+    /// <summary>Layout of the entity class in the frozen entity registry</summary>
+    private: const EntityLayout *layout;
+    /// <summary>Connection through which the query is run</summary>
+    /// <remarks>
+    ///   Leased before the select plan is picked because the plan has to use
+    ///   the identifier quotes of the connection's database
+    /// </remarks>
+    private: Connections::ConnectionLease lease;
+    /// <summary>Generated statement and readers used to fill the entities</summary>
+    /// <remarks>
+    ///   Select plans are part of the frozen entity registry and live as long as it does
+    /// </remarks>
+    private: const SelectPlan *plan;
+    /// <summary>Query with the parameter values of this particular run</summary>
+    private: Query query;
+    /// <summary>Reads the result rows of the query</summary>
+    private: std::unique_ptr<RowReader> reader;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_ENTITYREADER_H
@@ -0,0 +1,129 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_ENTITYTRACKER_H
+#define NUCLEX_THINORM_FLUENT_ENTITYTRACKER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <string> // for std::u8string
+#include <typeinfo> // for std::type_info
+#include <unordered_map> // for std::unordered_map<>
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm {
+  class DataContext;
+}
+namespace Nuclex::ThinOrm::Fluent {
+  class EntityLayout;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Remembers the state of entities to find out which columns have changed</summary>
+  /// <remarks>
+  ///   <para>
+  ///     This is the type-erased engine behind <see cref="ChangeTracker" />. When an entity
+  ///     is tracked, the values of its updatable columns are read through the getters
+  ///     registered in the <see cref="GlobalEntityRegistry" /> and stored as a snapshot.
+  ///     Updating the entity later compares its current values against the snapshot and
+  ///     only writes the columns that differ.
+  ///   </para>
+  ///   <para>
+  ///     Snapshots are looked up by primary key, so the entity passed to an update does not
+  ///     have to be the same instance that was tracked, but it must have the same primary key.
+  ///     The tracker is not thread-safe.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE EntityTracker {
+
+    /// <summary>Initializes a new entity tracker</summary>
+    /// <param name="dataContext">Data context through which the entities are updated</param>
+    /// <param name="entityType">Type of entity class that will be tracked</param>
+    public: NUCLEX_THINORM_API EntityTracker(
+      DataContext &dataContext, const std::type_info &entityType
+    );
+
+    /// <summary>Frees all resources owned by the entity tracker</summary>
+    public: NUCLEX_THINORM_API ~EntityTracker();
+
+    /// <summary>Takes a snapshot of an entity's current state</summary>
+    /// <param name="entity">Entity that will be tracked</param>
+    /// <remarks>
+    ///   If the entity is already tracked, its snapshot is replaced, so the entity's
+    ///   current state becomes the state changes are detected against.
+    /// </remarks>
+    public: NUCLEX_THINORM_API void Track(const void *entity);
+
+    /// <summary>Discards the snapshot of an entity</summary>
+    /// <param name="entity">Entity that will no longer be tracked</param>
+    public: NUCLEX_THINORM_API void Forget(const void *entity);
+
+    /// <summary>Discards the snapshots of all tracked entities</summary>
+    public: NUCLEX_THINORM_API void Clear() noexcept;
+
+    /// <summary>Counts the number of entities currently being tracked</summary>
+    /// <returns>The number of entities for which the tracker holds snapshots</returns>
+    public: NUCLEX_THINORM_API std::size_t CountTrackedEntities() const noexcept;
+
+    /// <summary>Checks whether an entity is being tracked</summary>
+    /// <param name="entity">Entity that will be checked</param>
+    /// <returns>True if the tracker holds a snapshot for the entity's primary key</returns>
+    public: NUCLEX_THINORM_API bool IsTracked(const void *entity) const;
+
+    /// <summary>Checks whether any updatable column of an entity has changed</summary>
+    /// <param name="entity">Tracked entity that will be checked</param>
+    /// <returns>True if the entity differs from its snapshot, false otherwise</returns>
+    public: NUCLEX_THINORM_API bool HasChanges(const void *entity) const;
+
+    /// <summary>Writes the changed columns of an entity into its row</summary>
+    /// <param name="entity">Tracked entity that will be updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   If nothing has changed, no statement is sent to the database at all. Afterwards,
+    ///   the snapshot matches the entity again.
+    /// </remarks>
+    public: NUCLEX_THINORM_API std::size_t Update(const void *entity);
+
+    /// <summary>Map of primary keys to the column values of the tracked entities</summary>
+    /// <remarks>
+    ///   Both the keys and the column values are stored as byte strings that compare equal
+    ///   if and only if the values they were formed from are equal.
+    /// </remarks>
+    private: typedef std::unordered_map<
+      std::u8string, std::vector<std::u8string>
+    > SnapshotMap;
+
+    /// <summary>Data context through which the entities are updated</summary>
+    private: DataContext *dataContext;
+    /// <summary>Layout of the entity class in the frozen entity registry</summary>
+    private: const EntityLayout *layout;
+    /// <summary>Snapshots of all tracked entities</summary>
+    private: SnapshotMap snapshots;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_ENTITYTRACKER_H
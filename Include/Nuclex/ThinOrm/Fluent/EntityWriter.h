@@ -0,0 +1,105 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_ENTITYWRITER_H
+#define NUCLEX_THINORM_FLUENT_ENTITYWRITER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <cstddef> // for std::size_t, std::byte
+#include <typeinfo> // for std::type_info
+
+namespace Nuclex::ThinOrm {
+  class DataContext;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+  class EntityLayout;
+}
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Writes entities into their table via generated statements</summary>
+  /// <remarks>
+  ///   This is the type-erased engine behind the modifying methods of <see cref="Table" />.
+  ///   It works on entities through the getters registered in the
+  ///   <see cref="GlobalEntityRegistry" />, so it only needs to know where the entities
+  ///   are in memory and how far apart they are.
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE EntityWriter {
+
+    /// <summary>Initializes a new entity writer</summary>
+    /// <param name="dataContext">Data context through which the entities are written</param>
+    /// <param name="entityType">Type of entity class that will be written</param>
+    public: NUCLEX_THINORM_API EntityWriter(
+      DataContext &dataContext, const std::type_info &entityType
+    );
+
+    /// <summary>Frees all resources owned by the entity writer</summary>
+    public: NUCLEX_THINORM_API ~EntityWriter();
+
+    /// <summary>Inserts entities or updates them if their primary key already exists</summary>
+    /// <param name="firstEntity">Address of the first entity that will be upserted</param>
+    /// <param name="entitySize">Distance from one entity to the next in bytes</param>
+    /// <param name="entityCount">Number of entities that will be upserted</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   <para>
+    ///     As many entities as the database accepts parameters for are packed into each
+    ///     statement, so upserting a batch of entities needs only one round-trip per
+    ///     <see cref="BulkInsertBuilder.MaximumRowsPerStatement" /> entities.
+    ///   </para>
+    ///   <para>
+    ///     Entities whose auto-generated primary key is still empty, zero or an empty
+    ///     string are new and get inserted with the key left out, so the database
+    ///     generates it.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API std::size_t Upsert(
+      const std::byte *firstEntity, std::size_t entitySize, std::size_t entityCount
+    );
+
+    /// <summary>Writes all columns of entities into their existing rows</summary>
+    /// <param name="firstEntity">Address of the first entity that will be updated</param>
+    /// <param name="entitySize">Distance from one entity to the next in bytes</param>
+    /// <param name="entityCount">Number of entities that will be updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   Rows are matched by primary key. Every column except the primary key and
+    ///   the auto-generated columns is written, use a <see cref="ChangeTracker" /> to
+    ///   only write the columns that have actually changed.
+    /// </remarks>
+    public: NUCLEX_THINORM_API std::size_t Update(
+      const std::byte *firstEntity, std::size_t entitySize, std::size_t entityCount
+    );
+
+    /// <summary>Data context through which the entities are written</summary>
+    private: DataContext *dataContext;
+    /// <summary>Layout of the entity class in the frozen entity registry</summary>
+    private: const EntityLayout *layout;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_ENTITYWRITER_H
@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Fluent/TableRegistrationSyntax.h"
+#include "Nuclex/ThinOrm/Fluent/BulkInsertBuilder.h"
 
 #include <memory> // for std::unique_ptr<>
 
@@ -38,6 +39,35 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <summary>Frees all resources owned by the entity registry</summary>
     public: NUCLEX_THINORM_API ~GlobalEntityRegistry();
 
+    /// <summary>Accesses the process-wide default entity registry</summary>
+    /// <returns>The default entity registry</returns>
+    /// <remarks>
+    ///   Data contexts look up their entity mappings in this registry unless they are
+    ///   constructed with a different one. Register your entity classes here before
+    ///   running any fluent queries.
+    /// </remarks>
+    public: NUCLEX_THINORM_API static GlobalEntityRegistry &GetDefault();
+
+    /// <summary>Compiles the registered entities for querying and ends registration</summary>
+    /// <remarks>
+    ///   <para>
+    ///     Freezing turns the registered mappings into an immutable, compact layout (columns
+    ///     in declaration order, pre-quoted names and generated statements) that all query
+    ///     threads can read at once without taking any locks. After the registry has been
+    ///     frozen, registering entities or changing mappings throws an exception.
+    ///   </para>
+    ///   <para>
+    ///     The registry freezes itself when it is first used by a query, so calling this
+    ///     is optional. Doing it explicitly at the end of your application's setup code
+    ///     catches late registrations early and moves the work out of the first query.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API void Freeze();
+
+    /// <summary>Checks whether the registry has been frozen</summary>
+    /// <returns>True if the registry has been frozen, false otherwise</returns>
+    public: NUCLEX_THINORM_API bool IsFrozen() const noexcept;
+
     /// <summary>Registers an entity class that maps to a specific table</summary>
     /// <typeparam name="TEntity">Entity class that will be registered</typeparam>
     /// <param name="tableName">Name of the table in the database</param>
@@ -62,12 +92,14 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <param name="columnName">Name of the column in the database table</param>
     /// <param name="getter">Getter through which the attribute can be read</param>
     /// <param name="setter">Getter through which the attribute can be updated</param>
+    /// <param name="reader">Reads the attribute straight from a result row</param>
     /// <param name="attributeType">RTTI type of the attribute in the entity class</param>
     public: NUCLEX_THINORM_API void AddEntityAttribute(
       const std::type_info &entityType,
       const std::u8string_view &columnName,
       GetAttributeValueFunction *getter,
       SetAttributeValueFunction *setter,
+      ReadAttributeFunction *reader,
       const std::type_info &attributeType
     ) override;
 
@@ -101,9 +133,33 @@ namespace Nuclex::ThinOrm::Fluent {
       bool isAutoGenerated = true
     ) override;
 
+    /// <summary>Sets up a bulk insert builder for the specified entity type</summary>
+    /// <param name="entityType">Type information identifying the entity</param>
+    /// <returns>A bulk insert builder that can insert entities of the specified type</returns>
+    /// <remarks>
+    ///   Auto-generated columns are left out of the insert so the database fills them.
+    ///   This freezes the registry if it hasn't been frozen yet.
+    /// </remarks>
+    public: NUCLEX_THINORM_API BulkInsertBuilder CreateBulkInsertBuilder(
+      const std::type_info &entityType
+    ) const;
+
+    /// <summary>Sets up a bulk insert builder for the specified entity type</summary>
+    /// <typeparam name="TEntity">Entity class the bulk insert builder will insert</typeparam>
+    /// <returns>A bulk insert builder that can insert entities of the specified type</returns>
+    public: template<typename TEntity>
+    NUCLEX_THINORM_API inline BulkInsertBuilder CreateBulkInsertBuilder() const;
+
     /// <summary>Internal data stored in the class (i.e. basic pImpl idiom)</summary>
     private: class Implementation;
 
+    /// <summary>Entity readers fetch their generated SQL from the registry</summary>
+    friend class EntityReader;
+    /// <summary>Entity writers fetch their generated SQL from the registry</summary>
+    friend class EntityWriter;
+    /// <summary>Entity trackers fetch their generated SQL from the registry</summary>
+    friend class EntityTracker;
+
     /// <summary>Holds the registered types, look-up tables and other internal things</summary>
     private: std::unique_ptr<Implementation> implementation;
 
@@ -121,6 +177,13 @@ namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
+  template<typename TEntity>
+  inline BulkInsertBuilder GlobalEntityRegistry::CreateBulkInsertBuilder() const {
+    return CreateBulkInsertBuilder(typeid(TEntity));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm::Fluent
 
 #endif // NUCLEX_THINORM_FLUENT_GLOBALENTITYREGISTRY_H
@@ -0,0 +1,108 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_KEYSETCURSOR_H
+#define NUCLEX_THINORM_FLUENT_KEYSETCURSOR_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Value.h" // for Value
+
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity> class Queryable;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Remembers the position of a keyset (seek) pagination</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Paging with <see cref="Queryable.Skip" /> makes the database produce and throw
+  ///     away all rows before the requested page, so the cost of a page grows with its
+  ///     number. Keyset pagination instead remembers the primary key of the last row
+  ///     that was returned and asks for the rows with a greater key, which the database
+  ///     can look up through the primary key index at a constant cost per page.
+  ///   </para>
+  ///   <para>
+  ///     The cursor only holds the last primary key, so it can be stored (for example
+  ///     in a web request's continuation token) and used to resume pagination later.
+  ///     Rows that were inserted or deleted in the meantime are picked up or skipped
+  ///     correctly as long as their primary key doesn't change.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE KeysetCursor {
+
+    /// <summary>Initializes a cursor that starts at the beginning of the table</summary>
+    public: NUCLEX_THINORM_API KeysetCursor();
+
+    /// <summary>Initializes a cursor that resumes after the specified primary key</summary>
+    /// <param name="lastKey">
+    ///   Primary key of the last row that was returned, one value per primary key column
+    ///   in the order the columns were registered in
+    /// </param>
+    public: NUCLEX_THINORM_API explicit KeysetCursor(const std::vector<Value> &lastKey);
+
+    /// <summary>Frees all resources owned by the cursor</summary>
+    public: NUCLEX_THINORM_API ~KeysetCursor();
+
+    /// <summary>Retrieves the primary key of the last row that was returned</summary>
+    /// <returns>
+    ///   The primary key of the last row, one value per primary key column, or an empty
+    ///   list if the cursor is still at the beginning of the table
+    /// </returns>
+    public: NUCLEX_THINORM_API inline const std::vector<Value> &GetLastKey() const noexcept;
+
+    /// <summary>Whether the most recent page was not filled up completely</summary>
+    /// <returns>True if the last page reached the end of the table</returns>
+    /// <remarks>
+    ///   Fetching another page is still possible and will return rows that have been
+    ///   added behind the last key since then.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline bool IsAtEnd() const noexcept;
+
+    /// <summary>Queryables advance the cursor when they fetch a page</summary>
+    template<typename TResultEntity> friend class Queryable;
+
+    /// <summary>Primary key of the last row that was returned</summary>
+    private: std::vector<Value> lastKey;
+    /// <summary>Whether the last page was returned incomplete</summary>
+    private: bool isAtEnd;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline const std::vector<Value> &KeysetCursor::GetLastKey() const noexcept {
+    return this->lastKey;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool KeysetCursor::IsAtEnd() const noexcept {
+    return this->isAtEnd;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_KEYSETCURSOR_H
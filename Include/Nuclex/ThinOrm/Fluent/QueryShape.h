@@ -0,0 +1,71 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_QUERYSHAPE_H
+#define NUCLEX_THINORM_FLUENT_QUERYSHAPE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Value.h" // for Value
+
+#include <cstddef> // for std::size_t
+#include <optional> // for std::optional<>
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Modifiers that have been applied to a fluent query</summary>
+  /// <remarks>
+  ///   The generated SQL only depends on which modifiers are in use, not on their values,
+  ///   which are passed to the database as query parameters. That way, all queries of
+  ///   the same shape share a single generated statement and prepared statement.
+  /// </remarks>
+  class QueryShape {
+
+    /// <summary>Initializes a query shape that returns all rows</summary>
+    public: QueryShape() :
+      Offset(0),
+      Limit(),
+      IsOrderedByKey(false),
+      AfterKey() {}
+
+    /// <summary>Number of result rows that will be skipped</summary>
+    public: std::size_t Offset;
+
+    /// <summary>Maximum number of result rows that will be returned, if limited</summary>
+    public: std::optional<std::size_t> Limit;
+
+    /// <summary>Whether the rows are returned in primary key order</summary>
+    public: bool IsOrderedByKey;
+
+    /// <summary>Primary key after which rows will be returned for keyset pagination</summary>
+    /// <remarks>
+    ///   Only used when the rows are ordered by primary key. If empty, the rows are
+    ///   returned from the start of the table.
+    /// </remarks>
+    public: std::vector<Value> AfterKey;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_QUERYSHAPE_H
@@ -21,43 +21,167 @@ limitations under the License.
 #define NUCLEX_THINORM_FLUENT_QUERYABLE_H
 
 #include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Fluent/QueryShape.h" // for QueryShape
+#include "Nuclex/ThinOrm/Fluent/EntityReader.h" // for EntityReader
+#include "Nuclex/ThinOrm/Fluent/KeysetCursor.h" // for KeysetCursor
+#include "Nuclex/ThinOrm/Fluent/EntityEnumerator.h" // for EntityEnumerator
+#include "Nuclex/ThinOrm/Fluent/ChangeTracker.h" // for ChangeTracker
+#include "Nuclex/ThinOrm/Errors/UnexpectedResultCountError.h" // for UnexpectedResultCountError
 
 #include <cstddef> // for std::size_t
 #include <vector> // for std::vector<>
+#include <span> // for std::span<>
+#include <stdexcept> // for std::invalid_argument, std::logic_error
 #include <optional> // for std::optional<>
+#include <algorithm> // for std::min()
+#include <utility> // for std::move(), std::in_place
+#include <typeinfo> // for typeid
+
+namespace Nuclex::ThinOrm {
+  class DataContext;
+}
 
 namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
-  /// <summary>Interface by which queries can be built</summary>
+  /// <summary>Query on the rows of a table that is being built</summary>
   /// <typeparam name="TResultEntity">Type of entity the query is returning</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Queryables are small, copyable values. Each modifier returns a new queryable
+  ///     and leaves the one it was called on unchanged, so a <see cref="Table" /> can be
+  ///     used as the starting point for any number of queries.
+  ///   </para>
+  ///   <para>
+  ///     Nothing is sent to the database until one of the methods returning entities
+  ///     is called. The SQL statement for each kind of query is generated once and then
+  ///     reused, with the row counts for <see cref="Skip" /> and <see cref="Take" />
+  ///     passed as query parameters.
+  ///   </para>
+  /// </remarks>
   template<typename TResultEntity>
   class NUCLEX_THINORM_TYPE Queryable {
 
+    /// <summary>Initializes a new query that returns all rows of a table</summary>
+    /// <param name="dataContext">Data context through which the query will be run</param>
+    public: NUCLEX_THINORM_API inline Queryable(DataContext &dataContext);
+
     /// <summary>Immediately frees all resources owned by the Queryable</summary>
     public: NUCLEX_THINORM_API virtual inline ~Queryable();
 
     /// <summary>Filters the results by the specified criteria</summary>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API virtual Queryable &Where(
+    /// <returns>A new queryable that only returns the matching rows</returns>
+    public: NUCLEX_THINORM_API Queryable Where(
       // TODO: Figure out convenient syntax to construct where conditions
-    ) const = 0;
+    ) const;
 
-    /// <summary>Skips the specified number of rows from the result returned</summary>>
+    /// <summary>Skips the specified number of rows from the result returned</summary>
     /// <param name="count">Number of result rows that will be skipped</param>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API virtual Queryable &Skip(std::size_t count) const = 0;
+    /// <returns>A new queryable that skips the specified number of rows</returns>
+    /// <remarks>
+    ///   Rows are ordered by the entity's primary key when skipping or limiting them.
+    ///   If the entity has no primary key registered, the database is free to return
+    ///   the rows in any order, so which rows are skipped is undefined.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline Queryable Skip(std::size_t count) const;
 
-    /// <summary>Limits the number of result rows to the specified count</summary>>
+    /// <summary>Limits the number of result rows to the specified count</summary>
     /// <param name="count">Maximum number of result rows that will be returned</param>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API virtual Queryable &Take(std::size_t count) const = 0;
+    /// <returns>A new queryable that returns at most the specified number of rows</returns>
+    /// <remarks>
+    ///   Rows are ordered by the entity's primary key when skipping or limiting them.
+    ///   If the entity has no primary key registered, the database is free to return
+    ///   the rows in any order, so which rows are returned is undefined.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline Queryable Take(std::size_t count) const;
 
-    /// <summary>Limits the number of result rows to the specified count</summary>>
-    /// <param name="count">Maximum number of result rows that will be returned</param>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API virtual std::vector<TResultEntity> ToVector() const = 0;
+    /// <summary>Runs the query and returns all result rows</summary>
+    /// <returns>A vector containing an entity for each result row</returns>
+    public: NUCLEX_THINORM_API inline std::vector<TResultEntity> ToVector() const;
+
+    /// <summary>Runs the query, returns all result rows and tracks them for changes</summary>
+    /// <param name="tracker">Change tracker that will take a snapshot of each entity</param>
+    /// <returns>A vector containing an entity for each result row</returns>
+    /// <remarks>
+    ///   After modifying the returned entities, pass them to the change tracker's
+    ///   <see cref="ChangeTracker.Update" /> method to write only the columns that
+    ///   have actually changed.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::vector<TResultEntity> ToVector(
+      ChangeTracker<TResultEntity> &tracker
+    ) const;
+
+    /// <summary>Runs the query and steps through the result rows one by one</summary>
+    /// <returns>An enumerator that reads one result row at a time</returns>
+    /// <remarks>
+    ///   Use this to process results of any size in constant memory, for example when
+    ///   exporting a large table into a file. A single entity is reused for all rows:
+    ///   <code>for(const User &amp;user : context.Users.Enumerate()) { ... }</code>
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline EntityEnumerator<TResultEntity> Enumerate() const;
+
+    /// <summary>Runs the query and appends all result rows to an existing vector</summary>
+    /// <param name="entities">Vector to which the result entities will be appended</param>
+    /// <remarks>
+    ///   <para>
+    ///     The entities are constructed in place at the end of the vector and filled
+    ///     directly from the database's row buffers. If the database reports the size
+    ///     of the result up front, the vector's capacity is reserved accordingly.
+    ///   </para>
+    ///   <para>
+    ///     When the same vector is loaded repeatedly (i.e. periodic cache rebuilds), clear
+    ///     it instead of creating a new one to keep the memory it has already allocated.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline void AppendTo(std::vector<TResultEntity> &entities) const;
+
+    /// <summary>Runs the query and hands the result rows to a callback in chunks</summary>
+    /// <typeparam name="TCallback">
+    ///   Callable that will be invoked with a <code>std::span&lt;TResultEntity&gt;</code>
+    /// </typeparam>
+    /// <param name="chunkSize">Maximum number of entities handed over per call</param>
+    /// <param name="callback">Callback that will receive each chunk of entities</param>
+    /// <remarks>
+    ///   <para>
+    ///     This can process results of any size in constant memory. Only a single chunk
+    ///     of entities is kept and it is refilled for each call to the callback, so
+    ///     strings and blobs in the entities can reuse the memory from earlier chunks.
+    ///   </para>
+    ///   <para>
+    ///     The callback may modify the entities or move their contents out, but must not
+    ///     hold on to the span after it returns. Attributes that are not mapped to a column
+    ///     are left as they were, so they can still contain values from an earlier chunk.
+    ///   </para>
+    /// </remarks>
+    public: template<typename TCallback>
+    NUCLEX_THINORM_API inline void ForEachChunk(
+      std::size_t chunkSize, TCallback &&callback
+    ) const;
+
+    /// <summary>Fetches the next page of rows in primary key order</summary>
+    /// <param name="cursor">
+    ///   Cursor remembering where the previous page ended. It will be advanced to the end
+    ///   of the returned page.
+    /// </param>
+    /// <param name="pageSize">Maximum number of rows that will be returned</param>
+    /// <returns>The entities on the next page, empty if there were no more rows</returns>
+    /// <remarks>
+    ///   <para>
+    ///     This implements keyset (or seek) pagination, generating a statement like
+    ///     <code>WHERE (pk) &gt; (last pk) ORDER BY pk LIMIT n</code> from the columns
+    ///     that were registered as the entity's primary key. Unlike paging with
+    ///     <see cref="Skip" />, each page costs the same no matter how deep into the
+    ///     table it is. The entity needs to have a primary key registered for this.
+    ///   </para>
+    ///   <para>
+    ///     Keyset pagination determines the row order itself, so it can not be combined
+    ///     with <see cref="Skip" /> or <see cref="Take" />.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::vector<TResultEntity> NextPage(
+      KeysetCursor &cursor, std::size_t pageSize
+    ) const;
 
     /// <summary>Returns the first result row of the query</summary>
     /// <returns>The first result row returned by the query</returns>
@@ -69,7 +193,7 @@ namespace Nuclex::ThinOrm::Fluent {
     ///   queries early instead of risking mixed-up data by picking whatever row happened
     ///   to be returned first.
     /// </remarks>
-    public: NUCLEX_THINORM_API virtual TResultEntity First() const = 0;
+    public: NUCLEX_THINORM_API inline TResultEntity First() const;
 
     /// <summary>Returns the first result row of the query or a default value</summary>
     /// <param name="defaultResult">Value to return if the query returns no result</param>
@@ -82,9 +206,9 @@ namespace Nuclex::ThinOrm::Fluent {
     ///   you know your query has either one result of none - if that's the case, prefer
     ///   the <see cref="SingleOrDefault" /> method).
     /// </remarks>
-    public: NUCLEX_THINORM_API virtual std::optional<TResultEntity> FirstOrDefault(
-      const std::optional<TResultEntity> &defaultResultis
-    ) const = 0;
+    public: NUCLEX_THINORM_API inline std::optional<TResultEntity> FirstOrDefault(
+      const std::optional<TResultEntity> &defaultResult = std::optional<TResultEntity>()
+    ) const;
 
     /// <summary>Returns the only result row of the query</summary>
     /// <returns>The only result row generated by the query</returns>
@@ -93,7 +217,7 @@ namespace Nuclex::ThinOrm::Fluent {
     ///   will be returned. For example, if you fetch an item by its id. If the result is
     ///   empty or if there is more than one result row, an exception will be thrown.
     /// </remarks>
-    public: NUCLEX_THINORM_API virtual TResultEntity Single() const = 0;
+    public: NUCLEX_THINORM_API inline TResultEntity Single() const;
 
     /// <summary>Returns the only result row of the query or a default value</summary>
     /// <param name="defaultResult">Value to return if the query returns no result</param>
@@ -104,19 +228,282 @@ namespace Nuclex::ThinOrm::Fluent {
     ///   and the item may be either there or missing. If the result If there is more than
     ///   one result row, an exception will be thrown.
     /// </remarks>
-    public: NUCLEX_THINORM_API virtual std::optional<TResultEntity> SingleOrDefault(
-      const std::optional<TResultEntity> &defaultResult
-    ) const = 0;
+    public: NUCLEX_THINORM_API inline std::optional<TResultEntity> SingleOrDefault(
+      const std::optional<TResultEntity> &defaultResult = std::optional<TResultEntity>()
+    ) const;
+
+    /// <summary>Initializes a new query with the specified modifiers</summary>
+    /// <param name="dataContext">Data context through which the query will be run</param>
+    /// <param name="shape">Modifiers that have been applied to the query</param>
+    protected: NUCLEX_THINORM_API inline Queryable(
+      DataContext &dataContext, const QueryShape &shape
+    );
+
+    /// <summary>Runs the query and reads the first result row, if any</summary>
+    /// <param name="requireSingle">
+    ///   Whether to throw an exception if the query returns more than one row
+    /// </param>
+    /// <returns>The first result row or an empty optional if there were no results</returns>
+    private: std::optional<TResultEntity> readFirst(bool requireSingle) const;
+
+    /// <summary>Data context through which queries will be run</summary>
+    protected: DataContext *dataContext;
+    /// <summary>Modifiers that have been applied to the query</summary>
+    protected: QueryShape shape;
 
   };
 
   // ------------------------------------------------------------------------------------------- //
 
+  template<typename TResultEntity>
+  inline Queryable<TResultEntity>::Queryable(DataContext &dataContext) :
+    dataContext(&dataContext),
+    shape() {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline Queryable<TResultEntity>::Queryable(
+    DataContext &dataContext, const QueryShape &shape
+  ) :
+    dataContext(&dataContext),
+    shape(shape) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
   template<typename TResultEntity>
   inline Queryable<TResultEntity>::~Queryable() = default;
 
   // ------------------------------------------------------------------------------------------- //
 
+  template<typename TResultEntity>
+  inline Queryable<TResultEntity> Queryable<TResultEntity>::Skip(std::size_t count) const {
+    QueryShape skippedShape(this->shape);
+    skippedShape.Offset += count;
+    if(skippedShape.Limit.has_value()) {
+      skippedShape.Limit = skippedShape.Limit.value() - std::min(skippedShape.Limit.value(), count);
+    }
+
+    return Queryable(*this->dataContext, skippedShape);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline Queryable<TResultEntity> Queryable<TResultEntity>::Take(std::size_t count) const {
+    QueryShape limitedShape(this->shape);
+    if(limitedShape.Limit.has_value()) {
+      limitedShape.Limit = std::min(limitedShape.Limit.value(), count);
+    } else {
+      limitedShape.Limit = count;
+    }
+
+    return Queryable(*this->dataContext, limitedShape);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline std::vector<TResultEntity> Queryable<TResultEntity>::ToVector() const {
+    std::vector<TResultEntity> entities;
+    AppendTo(entities);
+    return entities;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline std::vector<TResultEntity> Queryable<TResultEntity>::ToVector(
+    ChangeTracker<TResultEntity> &tracker
+  ) const {
+    std::vector<TResultEntity> entities;
+    AppendTo(entities);
+    tracker.Track(std::span<const TResultEntity>(entities));
+    return entities;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline EntityEnumerator<TResultEntity> Queryable<TResultEntity>::Enumerate() const {
+    return EntityEnumerator<TResultEntity>(*this->dataContext, this->shape);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline void Queryable<TResultEntity>::AppendTo(std::vector<TResultEntity> &entities) const {
+    EntityReader reader(*this->dataContext, typeid(TResultEntity), this->shape);
+
+    std::optional<std::size_t> rowCount = reader.GetRowCountHint();
+    if(rowCount.has_value()) {
+      entities.reserve(entities.size() + rowCount.value());
+    }
+
+    while(reader.MoveToNext()) {
+      reader.ReadCurrentRow(&entities.emplace_back());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  template<typename TCallback>
+  inline void Queryable<TResultEntity>::ForEachChunk(
+    std::size_t chunkSize, TCallback &&callback
+  ) const {
+    if(chunkSize == 0) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Chunk size must be at least one entity")
+      );
+    }
+
+    EntityReader reader(*this->dataContext, typeid(TResultEntity), this->shape);
+
+    // Entities are only constructed as needed, so a small result doesn't pay for
+    // a large chunk size. After the first chunk, the same entities are reused.
+    std::vector<TResultEntity> chunk;
+    chunk.reserve(std::min(chunkSize, reader.GetRowCountHint().value_or(chunkSize)));
+
+    std::size_t count = 0;
+    while(reader.MoveToNext()) {
+      if(count == chunk.size()) {
+        chunk.emplace_back();
+      }
+      reader.ReadCurrentRow(&chunk[count]);
+
+      ++count;
+      if(count == chunkSize) {
+        callback(std::span<TResultEntity>(chunk.data(), count));
+        count = 0;
+      }
+    }
+
+    if(count > 0) {
+      callback(std::span<TResultEntity>(chunk.data(), count));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline std::vector<TResultEntity> Queryable<TResultEntity>::NextPage(
+    KeysetCursor &cursor, std::size_t pageSize
+  ) const {
+    if(pageSize == 0) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Page size must be at least one entity")
+      );
+    }
+    if((this->shape.Offset != 0) || this->shape.Limit.has_value()) {
+      throw std::logic_error(
+        reinterpret_cast<const char *>(
+          u8"Keyset pagination can not be combined with Skip() or Take()"
+        )
+      );
+    }
+
+    QueryShape pageShape(this->shape);
+    pageShape.Limit = pageSize;
+    pageShape.IsOrderedByKey = true;
+    pageShape.AfterKey = cursor.lastKey;
+
+    EntityReader reader(*this->dataContext, typeid(TResultEntity), pageShape);
+
+    std::vector<TResultEntity> entities;
+    while(reader.MoveToNext()) {
+      reader.ReadCurrentRow(&entities.emplace_back());
+    }
+
+    // If the page came back empty, the cursor stays where it was so that rows
+    // added to the table later on can still be picked up from there
+    if(!entities.empty()) {
+      reader.GetPrimaryKey(&entities.back(), cursor.lastKey);
+    }
+    cursor.isAtEnd = (entities.size() < pageSize);
+
+    return entities;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline TResultEntity Queryable<TResultEntity>::First() const {
+    std::optional<TResultEntity> first = Take(1).readFirst(false);
+    if(!first.has_value()) {
+      throw Errors::UnexpectedResultCountError(
+        u8"Query was expected to return at least one row but its result was empty"
+      );
+    }
+
+    return std::move(first.value());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline std::optional<TResultEntity> Queryable<TResultEntity>::FirstOrDefault(
+    const std::optional<TResultEntity> &defaultResult /* = std::optional<TResultEntity>() */
+  ) const {
+    std::optional<TResultEntity> first = Take(1).readFirst(false);
+    if(first.has_value()) {
+      return first;
+    } else {
+      return defaultResult;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline TResultEntity Queryable<TResultEntity>::Single() const {
+    std::optional<TResultEntity> single = Take(2).readFirst(true);
+    if(!single.has_value()) {
+      throw Errors::UnexpectedResultCountError(
+        u8"Query was expected to return exactly one row but its result was empty"
+      );
+    }
+
+    return std::move(single.value());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  inline std::optional<TResultEntity> Queryable<TResultEntity>::SingleOrDefault(
+    const std::optional<TResultEntity> &defaultResult /* = std::optional<TResultEntity>() */
+  ) const {
+    std::optional<TResultEntity> single = Take(2).readFirst(true);
+    if(single.has_value()) {
+      return single;
+    } else {
+      return defaultResult;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResultEntity>
+  std::optional<TResultEntity> Queryable<TResultEntity>::readFirst(bool requireSingle) const {
+    EntityReader reader(*this->dataContext, typeid(TResultEntity), this->shape);
+    if(!reader.MoveToNext()) {
+      return std::optional<TResultEntity>();
+    }
+
+    std::optional<TResultEntity> entity(std::in_place);
+    reader.ReadCurrentRow(&entity.value());
+
+    if(requireSingle && reader.MoveToNext()) {
+      throw Errors::UnexpectedResultCountError(
+        u8"Query was expected to return at most one row but returned multiple rows"
+      );
+    }
+
+    return entity;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm::Fluent
 
 #endif // NUCLEX_THINORM_FLUENT_QUERYABLE_H
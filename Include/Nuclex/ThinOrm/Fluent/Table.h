@@ -22,6 +22,11 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Fluent/Queryable.h"
+#include "Nuclex/ThinOrm/Fluent/EntityWriter.h" // for EntityWriter
+
+#include <cstddef> // for std::size_t, std::byte
+#include <span> // for std::span<>
+#include <typeinfo> // for typeid
 
 namespace Nuclex::ThinOrm {
   class DataContext;
@@ -38,7 +43,7 @@ namespace Nuclex::ThinOrm::Fluent {
 
     /// <summary>Initializes a new exposed table</summary>
     /// <param name="dataContext">Data context through which the database is accesed</param>
-    public: NUCLEX_THINORM_API Table(DataContext &dataContext);
+    public: NUCLEX_THINORM_API inline Table(DataContext &dataContext);
 
     /// <summary>Deletes rows from the table</summary>
     /// <returns>A syntax helper by which the delete statement can be limited</returns>
@@ -52,72 +57,101 @@ namespace Nuclex::ThinOrm::Fluent {
       // TODO: Figure out convenient syntax to specify rows to insert
     );
 
-    /// <summary>Updates rows in the table</summary>
-    /// <returns>
-    ///   A syntax helper by which the columns to update can be specified and by which
-    ///   the affected rows update can be limited
-    /// </returns>
-    public: NUCLEX_THINORM_API std::size_t Update(
-      // TODO: Figure out convenient syntax to construct where conditions
-      // TODO: Figure out convenient syntax to specify columns to update
-    );
+    /// <summary>Writes an entity into its existing row</summary>
+    /// <param name="entity">Entity whose row will be updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   The row is matched by the entity's primary key and all other columns except
+    ///   the auto-generated ones are written. To only write the columns that have changed
+    ///   since the entity was loaded, use a <see cref="ChangeTracker" /> instead.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::size_t Update(const TEntity &entity);
+
+    /// <summary>Writes entities into their existing rows</summary>
+    /// <param name="entities">Entities whose rows will be updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   Each entity is updated with its own statement, but all of them are run through
+    ///   the same connection. Wrap the call in a transaction if either all or none of
+    ///   the entities should be written.
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::size_t Update(std::span<const TEntity> entities);
+
+    /// <summary>Inserts an entity or updates its row if its primary key exists</summary>
+    /// <param name="entity">Entity that will be inserted or updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   <para>
+    ///     The row is matched by the columns registered as the entity's primary key. This
+    ///     replaces checking for the row with a SELECT and then running either an INSERT
+    ///     or an UPDATE, doing the whole job in a single statement instead.
+    ///   </para>
+    ///   <para>
+    ///     If the primary key is auto-generated and has not been assigned yet (it is
+    ///     zero or empty), the entity is inserted and the database generates its key.
+    ///     The generated key is not written back into the entity.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::size_t Upsert(const TEntity &entity);
+
+    /// <summary>Inserts entities or updates their rows if their primary keys exist</summary>
+    /// <param name="entities">Entities that will be inserted or updated</param>
+    /// <returns>The number of rows the database reported as affected</returns>
+    /// <remarks>
+    ///   <para>
+    ///     The entities are packed into multi-row statements, so synchronizing a batch of
+    ///     entities only takes one round-trip per few hundred entities. Each statement is
+    ///     run on its own, wrap the call in a transaction if either all or none of
+    ///     the entities should be written.
+    ///   </para>
+    ///   <para>
+    ///     The number of affected rows follows the database's own rules. MySQL and MariaDB,
+    ///     for example, count an updated row twice.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API inline std::size_t Upsert(std::span<const TEntity> entities);
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline Table<TEntity>::Table(DataContext &dataContext) :
+    Queryable<TEntity>(dataContext) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t Table<TEntity>::Update(const TEntity &entity) {
+    return Update(std::span<const TEntity>(&entity, 1));
+  }
 
-    /// <summary>Updates rows in the table</summary>
-    /// <returns>
-    ///   A syntax helper by which the columns to update can be specified and by which
-    ///   the affected rows update can be limited
-    /// </returns>
-    public: NUCLEX_THINORM_API std::size_t Upsert(
-      // TODO: Figure out convenient syntax to specify columns to update-insert
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t Table<TEntity>::Update(std::span<const TEntity> entities) {
+    EntityWriter writer(*this->dataContext, typeid(TEntity));
+    return writer.Update(
+      reinterpret_cast<const std::byte *>(entities.data()), sizeof(TEntity), entities.size()
     );
+  }
 
-    /// <summary>Filters the results by the specified criteria</summary>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API Queryable<TEntity> &Where(
-      // TODO: Figure out convenient syntax to construct where conditions
-    ) const override;
-
-    /// <summary>Skips the specified number of rows from the result returned</summary>>
-    /// <param name="count">Number of result rows that will be skipped</param>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API Queryable<TEntity> &Skip(std::size_t count) const override;
-
-    /// <summary>Limits the number of result rows to the specified count</summary>>
-    /// <param name="count">Maximum number of result rows that will be returned</param>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API Queryable<TEntity> &Take(std::size_t count) const override;
-
-    /// <summary>Limits the number of result rows to the specified count</summary>>
-    /// <param name="count">Maximum number of result rows that will be returned</param>
-    /// <returns>The Queryable itself to allow further modifiers to be chained</returns>
-    public: NUCLEX_THINORM_API std::vector<TEntity> ToVector() const override;
-
-    /// <summary>Returns the first result row of the query</summary>
-    /// <returns>The first result row returned by the query</returns>
-    public: NUCLEX_THINORM_API TEntity First() const override;
-
-    /// <summary>Returns the first result row of the query or a default value</summary>
-    /// <param name="defaultResult">Value to return if the query returns no result</param>
-    /// <returns>The first result row returned by the query or the default value</returns>
-    public: NUCLEX_THINORM_API std::optional<TEntity> FirstOrDefault(
-      const std::optional<TEntity> &defaultResultis
-    ) const override;
-
-    /// <summary>Returns the only result row of the query</summary>
-    /// <returns>The only result row generated by the query</returns>
-    public: NUCLEX_THINORM_API TEntity Single() const override;
-
-    /// <summary>Returns the only result row of the query or a default value</summary>
-    /// <param name="defaultResult">Value to return if the query returns no result</param>
-    /// <returns>The only result row generated by the query or the default value</returns>
-    public: NUCLEX_THINORM_API std::optional<TEntity> SingleOrDefault(
-      const std::optional<TEntity> &defaultResult
-    ) const override;
-
-    /// <summary>Data context through which queries will be run</summary>
-    private: DataContext &dataContext;
+  // ------------------------------------------------------------------------------------------- //
 
-  };
+  template<typename TEntity>
+  inline std::size_t Table<TEntity>::Upsert(const TEntity &entity) {
+    return Upsert(std::span<const TEntity>(&entity, 1));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TEntity>
+  inline std::size_t Table<TEntity>::Upsert(std::span<const TEntity> entities) {
+    EntityWriter writer(*this->dataContext, typeid(TEntity));
+    return writer.Upsert(
+      reinterpret_cast<const std::byte *>(entities.data()), sizeof(TEntity), entities.size()
+    );
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -0,0 +1,59 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_PARAMETERROWSOURCE_H
+#define NUCLEX_THINORM_PARAMETERROWSOURCE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+namespace Nuclex::ThinOrm {
+  class Query;
+}
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides the parameter values for each execution of a batched query</summary>
+  /// <remarks>
+  ///   Implementations are called once per row and write that row's values into the query
+  ///   via <see cref="Query.SetParameterValue" />. This lets rows be produced on the fly,
+  ///   for example while parsing an import file, without ever holding all of them in memory.
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE ParameterRowSource {
+
+    /// <summary>Frees all resources owned by the parameter row source</summary>
+    public: NUCLEX_THINORM_API virtual ~ParameterRowSource() = default;
+
+    /// <summary>Assigns the parameter values of the next row to the query</summary>
+    /// <param name="query">Query whose parameter values will be assigned</param>
+    /// <returns>True if a row was assigned, false if there are no more rows</returns>
+    /// <remarks>
+    ///   The query keeps the values assigned for the previous row, so parameters that
+    ///   stay the same for all rows only need to be assigned once.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual bool AssignNextRow(Query &query) = 0;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
+
+#endif // NUCLEX_THINORM_PARAMETERROWSOURCE_H
@@ -24,12 +24,15 @@ limitations under the License.
 #include "Nuclex/ThinOrm/QueryParameterView.h"
 
 #include <string> // for std::u8string
+#include <string_view> // for std::u8string_view
 #include <memory> // for std::unique_ptr
 #include <vector> // for std::vector
 #include <cstddef> // for std::size_t
 
 namespace Nuclex::ThinOrm {
   class Value;
+  template<std::size_t TLength> class SqlLiteral;
+  template<SqlLiteral TSqlStatement> class StaticQuery;
 }
 
 namespace Nuclex::ThinOrm {
@@ -54,6 +57,27 @@ namespace Nuclex::ThinOrm {
     /// <summary>Frees all resources owned by the query</summary>
     public: NUCLEX_THINORM_API ~Query();
 
+    /// <summary>Creates a query sharing its parsed SQL statement process-wide</summary>
+    /// <param name="sqlStatement">SQL statement the query should run</param>
+    /// <returns>A new query for the specified SQL statement</returns>
+    /// <remarks>
+    ///   <para>
+    ///     Normally, each query constructed from an SQL statement parses the statement
+    ///     anew and receives its own SQL statement id, so database connections cannot
+    ///     reuse prepared statements between two queries built in different places.
+    ///   </para>
+    ///   <para>
+    ///     Queries created through this method look up the SQL statement in a global
+    ///     intern table instead. All queries created from identical SQL statements this way
+    ///     share the parsed statement and its SQL statement id. Interned statements are kept
+    ///     for the lifetime of the process, so only use this for a fixed set of statements,
+    ///     not for SQL that is assembled dynamically with varying contents.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API static Query FromInternedStatement(
+      const std::u8string &sqlStatement
+    );
+
     /// <summary>Retrieves the SQL statement the query was build for</summary>
     /// <returns>The SQL statement the query will execute</returns>
     public: NUCLEX_THINORM_API const std::u8string &GetSqlStatement() const;
@@ -125,6 +149,27 @@ namespace Nuclex::ThinOrm {
 
     /// <summary>The part of the query that remains the same when the query is copied</summary>
     private: class ImmutableState;
+
+    /// <summary>Initializes a new query using an already parsed SQL statement</summary>
+    /// <param name="immutableState">Parsed SQL statement the query will share</param>
+    private: NUCLEX_THINORM_API Query(
+      const std::shared_ptr<const ImmutableState> &immutableState
+    );
+
+    /// <summary>Creates the shared state for an SQL statement parsed ahead of time</summary>
+    /// <param name="sqlStatement">SQL statement the parameters were found in</param>
+    /// <param name="parameters">Names and locations of the parameters</param>
+    /// <param name="parameterCount">Number of parameters in the SQL statement</param>
+    /// <returns>The shared state for the pre-parsed SQL statement</returns>
+    private: NUCLEX_THINORM_API static std::shared_ptr<const ImmutableState> adoptParsedStatement(
+      const std::u8string_view &sqlStatement,
+      const QueryParameterView *parameters,
+      std::size_t parameterCount
+    );
+
+    // Static queries are parsed at compile time and provide their own parameter list
+    template<SqlLiteral> friend class StaticQuery;
+
     /// <summary>The part of the query that can change (i.e. basic pImpl idiom)</summary>
     private: class Implementation;
 
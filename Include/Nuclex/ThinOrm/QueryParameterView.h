@@ -23,6 +23,7 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Config.h"
 
 #include <string> // for std::u8string
+#include <cstddef> // for std::size_t
 
 namespace Nuclex::ThinOrm {
 
@@ -55,6 +56,14 @@ namespace Nuclex::ThinOrm {
     /// <summary>Length of the segment in characters</summary>
     public: std::u8string::size_type Length;
 
+    /// <summary>Index of the value slot the parameter reads its value from</summary>
+    /// <remarks>
+    ///   Each distinct parameter name is assigned one slot. If the same parameter appears
+    ///   multiple times in an SQL statement, all of its occurrences share the same slot,
+    ///   so engines that support numbered placeholders can bind the value only once.
+    /// </remarks>
+    public: std::size_t SlotIndex;
+
   };
 
   // ------------------------------------------------------------------------------------------- //
@@ -0,0 +1,342 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_ROWBATCH_H
+#define NUCLEX_THINORM_ROWBATCH_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Value.h"
+#include "Nuclex/ThinOrm/ValueType.h"
+#include "Nuclex/ThinOrm/Decimal.h"
+#include "Nuclex/ThinOrm/DateTime.h"
+
+#include <cstddef> // for std::size_t, std::byte
+#include <cstdint> // for std::uint64_t, std::int64_t, etc.
+#include <string> // for std::u8string
+#include <string_view> // for std::u8string_view
+#include <span> // for std::span
+#include <vector> // for std::vector
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Stores the values of a single result column for a batch of rows</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Values are kept in one contiguous array of the column's native type (for example,
+  ///     an <code>Int32</code> column stores its values in a plain array of 32 bit
+  ///     integers), which allows aggregations to run over the values without touching
+  ///     a <see cref="Value" /> per cell. Strings and blobs are packed back-to-back into
+  ///     a single buffer and located through an offset array.
+  ///   </para>
+  ///   <para>
+  ///     Null cells are recorded in a bitmap (one bit per row, set if the cell is null).
+  ///     The typed array still receives a zero / empty placeholder for null cells so
+  ///     that a row index always addresses the same element in every array.
+  ///   </para>
+  ///   <para>
+  ///     Resetting a column keeps all allocated memory around, so a batch that is reused
+  ///     for the next fetch from the same query will not allocate again.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE RowBatchColumn {
+
+    /// <summary>Initializes a new, empty column holding strings</summary>
+    public: NUCLEX_THINORM_API RowBatchColumn();
+
+    /// <summary>Removes all values from the column and changes its type</summary>
+    /// <param name="type">Type of the values the column will store</param>
+    /// <param name="name">Name of the column in the query result</param>
+    public: NUCLEX_THINORM_API void Reset(ValueType type, const std::u8string_view &name);
+
+    /// <summary>Retrieves the type of values stored in the column</summary>
+    /// <returns>The type of the values in the column</returns>
+    public: NUCLEX_THINORM_API inline ValueType GetType() const noexcept;
+
+    /// <summary>Retrieves the name of the column in the query result</summary>
+    /// <returns>The column's name</returns>
+    public: NUCLEX_THINORM_API inline const std::u8string &GetName() const noexcept;
+
+    /// <summary>Counts the number of rows stored in the column</summary>
+    /// <returns>The number of rows the column holds values for</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountRows() const noexcept;
+
+    /// <summary>Checks whether the cell in the specified row is null</summary>
+    /// <param name="rowIndex">Index of the row that will be checked</param>
+    /// <returns>True if the cell in the specified row is null</returns>
+    public: NUCLEX_THINORM_API inline bool IsNull(std::size_t rowIndex) const noexcept;
+
+    /// <summary>Provides the bitmap in which null cells are marked</summary>
+    /// <returns>
+    ///   The null bitmap, bit (row % 64) of element (row / 64) is set if the row is null
+    /// </returns>
+    public: NUCLEX_THINORM_API inline std::span<const std::uint64_t> GetNullBitmap(
+    ) const noexcept;
+
+    /// <summary>Provides the values of a boolean column, 0 for false, 1 for true</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const std::uint8_t> GetBooleans() const;
+    /// <summary>Provides the values of an 8 bit unsigned integer column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const std::uint8_t> GetUInt8s() const;
+    /// <summary>Provides the values of a 16 bit integer column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const std::int16_t> GetInt16s() const;
+    /// <summary>Provides the values of a 32 bit integer column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const std::int32_t> GetInt32s() const;
+    /// <summary>Provides the values of a 64 bit integer column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const std::int64_t> GetInt64s() const;
+    /// <summary>Provides the values of a decimal column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const Decimal> GetDecimals() const;
+    /// <summary>Provides the values of a 32 bit floating point column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const float> GetFloats() const;
+    /// <summary>Provides the values of a 64 bit floating point column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const double> GetDoubles() const;
+    /// <summary>Provides the values of a date, time or date/time column</summary>
+    /// <returns>The values of the column as a contiguous array</returns>
+    public: NUCLEX_THINORM_API std::span<const DateTime> GetDateTimes() const;
+
+    /// <summary>Looks up the string stored in the specified row of a string column</summary>
+    /// <param name="rowIndex">Index of the row whose string will be returned</param>
+    /// <returns>A view of the string, valid until the column is reset</returns>
+    public: NUCLEX_THINORM_API std::u8string_view GetString(std::size_t rowIndex) const;
+
+    /// <summary>Looks up the bytes stored in the specified row of a blob column</summary>
+    /// <param name="rowIndex">Index of the row whose bytes will be returned</param>
+    /// <returns>A view of the bytes, valid until the column is reset</returns>
+    public: NUCLEX_THINORM_API std::span<const std::byte> GetBlob(std::size_t rowIndex) const;
+
+    /// <summary>Boxes the value in the specified row into a generic value</summary>
+    /// <param name="rowIndex">Index of the row whose value will be returned</param>
+    /// <returns>The value in the specified row</returns>
+    /// <remarks>
+    ///   This is a convenience method. When processing larger amounts of rows, use
+    ///   the typed accessors, they avoid constructing a <see cref="Value" /> per cell.
+    /// </remarks>
+    public: NUCLEX_THINORM_API Value GetValue(std::size_t rowIndex) const;
+
+    /// <summary>Appends a null cell to the column</summary>
+    public: NUCLEX_THINORM_API void AppendNull();
+    /// <summary>Appends a boolean to the column, which must be a boolean column</summary>
+    /// <param name="value">Value that will be appended</param>
+    public: NUCLEX_THINORM_API void AppendBoolean(bool value);
+    /// <summary>Appends an integer to the column, which must be an integer column</summary>
+    /// <param name="value">Value that will be appended</param>
+    /// <remarks>
+    ///   The integer is narrowed to the column's integer type. This matches how database
+    ///   APIs hand out integers: always as the widest type, regardless of the column.
+    /// </remarks>
+    public: NUCLEX_THINORM_API void AppendInteger(std::int64_t value);
+    /// <summary>Appends a decimal to the column, which must be a decimal column</summary>
+    /// <param name="value">Value that will be appended</param>
+    public: NUCLEX_THINORM_API void AppendDecimal(const Decimal &value);
+    /// <summary>
+    ///   Appends a floating point value to the column, which must be a float or double column
+    /// </summary>
+    /// <param name="value">Value that will be appended</param>
+    public: NUCLEX_THINORM_API void AppendFloatingPoint(double value);
+    /// <summary>Appends a date and/or time to the column</summary>
+    /// <param name="value">Value that will be appended</param>
+    public: NUCLEX_THINORM_API void AppendDateTime(const DateTime &value);
+    /// <summary>Appends a string to the column, which must be a string column</summary>
+    /// <param name="value">String that will be copied into the column</param>
+    public: NUCLEX_THINORM_API void AppendString(const std::u8string_view &value);
+    /// <summary>Appends binary data to the column, which must be a blob column</summary>
+    /// <param name="value">Bytes that will be copied into the column</param>
+    public: NUCLEX_THINORM_API void AppendBlob(const std::span<const std::byte> &value);
+    /// <summary>Appends a generic value, converting it to the column's type</summary>
+    /// <param name="value">Value that will be appended</param>
+    public: NUCLEX_THINORM_API void AppendValue(const Value &value);
+
+    /// <summary>Records whether the cell that is about to be appended is null</summary>
+    /// <param name="isNull">Whether the new cell is null</param>
+    private: inline void appendNullBit(bool isNull);
+    /// <summary>Throws an exception if the column is not of the specified type</summary>
+    /// <param name="requiredType">Type the column is required to have</param>
+    private: void require(ValueType requiredType) const;
+    /// <summary>Copies a string or blob into the packed byte buffer</summary>
+    /// <param name="bytes">Bytes that will be copied into the buffer</param>
+    /// <param name="byteCount">Number of bytes that will be copied</param>
+    private: void appendBytes(const std::byte *bytes, std::size_t byteCount);
+
+    /// <summary>Type of the values stored in the column</summary>
+    private: ValueType type;
+    /// <summary>Name of the column in the query result</summary>
+    private: std::u8string name;
+    /// <summary>Number of rows currently stored in the column</summary>
+    private: std::size_t rowCount;
+    /// <summary>Bits marking null cells, one bit per row</summary>
+    private: std::vector<std::uint64_t> nullBits;
+    /// <summary>Values of boolean and 8 bit integer columns</summary>
+    private: std::vector<std::uint8_t> bytes8;
+    /// <summary>Values of 16 bit integer columns</summary>
+    private: std::vector<std::int16_t> int16s;
+    /// <summary>Values of 32 bit integer columns</summary>
+    private: std::vector<std::int32_t> int32s;
+    /// <summary>Values of 64 bit integer columns</summary>
+    private: std::vector<std::int64_t> int64s;
+    /// <summary>Values of decimal columns</summary>
+    private: std::vector<Decimal> decimals;
+    /// <summary>Values of 32 bit floating point columns</summary>
+    private: std::vector<float> floats;
+    /// <summary>Values of 64 bit floating point columns</summary>
+    private: std::vector<double> doubles;
+    /// <summary>Values of date, time and date/time columns</summary>
+    private: std::vector<DateTime> dateTimes;
+    /// <summary>Characters of strings or bytes of blobs, packed back-to-back</summary>
+    private: std::vector<std::byte> packedBytes;
+    /// <summary>End offset of each row's string or blob in the packed byte buffer</summary>
+    private: std::vector<std::size_t> packedEnds;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Reusable columnar buffer that receives a batch of rows from a row reader</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Instead of stepping through a query result row by row and fetching each cell as
+  ///     a <see cref="Value" />, <see cref="RowReader.FetchBatch" /> can fill a row batch
+  ///     with many rows at once. Each result column ends up in a typed, contiguous array
+  ///     (see <see cref="RowBatchColumn" />), ready for vectorized processing.
+  ///   </para>
+  ///   <para>
+  ///     Keep the row batch around and pass it to the next FetchBatch() call. Its arrays
+  ///     will be reused, so once the batch has grown to its working size, fetching rows
+  ///     no longer causes any memory allocations aside from what the database needs.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE RowBatch {
+
+    /// <summary>Initializes a new, empty row batch</summary>
+    public: NUCLEX_THINORM_API RowBatch();
+
+    /// <summary>Removes all rows and sets the number of columns</summary>
+    /// <param name="columnCount">Number of columns the row batch will have</param>
+    /// <remarks>
+    ///   The columns still need to be reset to their respective types by the caller.
+    /// </remarks>
+    public: NUCLEX_THINORM_API void Reset(std::size_t columnCount);
+
+    /// <summary>Counts the number of columns in the row batch</summary>
+    /// <returns>The number of columns the row batch holds</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountColumns() const noexcept;
+
+    /// <summary>Counts the number of rows in the row batch</summary>
+    /// <returns>The number of rows the row batch holds</returns>
+    public: NUCLEX_THINORM_API inline std::size_t CountRows() const noexcept;
+
+    /// <summary>Accesses the column with the specified index</summary>
+    /// <param name="columnIndex">Index of the column that will be accessed</param>
+    /// <returns>The column with the specified index</returns>
+    public: NUCLEX_THINORM_API inline const RowBatchColumn &GetColumn(
+      std::size_t columnIndex
+    ) const noexcept;
+
+    /// <summary>Accesses the column with the specified index</summary>
+    /// <param name="columnIndex">Index of the column that will be accessed</param>
+    /// <returns>The column with the specified index</returns>
+    public: NUCLEX_THINORM_API inline RowBatchColumn &GetColumn(
+      std::size_t columnIndex
+    ) noexcept;
+
+    /// <summary>Number of columns currently in use</summary>
+    /// <remarks>
+    ///   The columns vector is never shrunk so that columns keep their buffers even if
+    ///   the batch is temporarily used for a query with fewer columns.
+    /// </remarks>
+    private: std::size_t columnCount;
+    /// <summary>Columns storing the actual values</summary>
+    private: std::vector<RowBatchColumn> columns;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline ValueType RowBatchColumn::GetType() const noexcept { return this->type; }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline const std::u8string &RowBatchColumn::GetName() const noexcept { return this->name; }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::size_t RowBatchColumn::CountRows() const noexcept { return this->rowCount; }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool RowBatchColumn::IsNull(std::size_t rowIndex) const noexcept {
+    return (this->nullBits[rowIndex / 64] & (std::uint64_t(1) << (rowIndex % 64))) != 0;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::span<const std::uint64_t> RowBatchColumn::GetNullBitmap() const noexcept {
+    return std::span<const std::uint64_t>(this->nullBits.data(), (this->rowCount + 63) / 64);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void RowBatchColumn::appendNullBit(bool isNull) {
+    if((this->rowCount % 64) == 0) {
+      this->nullBits.push_back(0);
+    }
+    if(isNull) {
+      this->nullBits.back() |= (std::uint64_t(1) << (this->rowCount % 64));
+    }
+    ++this->rowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::size_t RowBatch::CountColumns() const noexcept { return this->columnCount; }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::size_t RowBatch::CountRows() const noexcept {
+    if(this->columnCount == 0) {
+      return 0;
+    } else {
+      return this->columns[0].CountRows();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline const RowBatchColumn &RowBatch::GetColumn(std::size_t columnIndex) const noexcept {
+    return this->columns[columnIndex];
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline RowBatchColumn &RowBatch::GetColumn(std::size_t columnIndex) noexcept {
+    return this->columns[columnIndex];
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
+
+#endif // NUCLEX_THINORM_ROWBATCH_H
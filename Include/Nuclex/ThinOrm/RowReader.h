@@ -22,9 +22,13 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Value.h"
+#include "Nuclex/ThinOrm/RowBatch.h"
 
 #include <cstdint> // for std::int16_t, std::int32_t, etc.
 #include <string> // for std::u8string
+#include <vector> // for std::vector<>
+#include <cstddef> // for std::byte
+#include <optional> // for std::optional<>
 
 namespace Nuclex::ThinOrm {
 
@@ -50,6 +54,16 @@ namespace Nuclex::ThinOrm {
     /// <returns>The number of columns in the result</returns>
     public: NUCLEX_THINORM_API virtual std::size_t CountColumns() const = 0;
 
+    /// <summary>Reports the total number of rows in the result if it is known</summary>
+    /// <returns>The number of rows in the result or nothing if it isn't known</returns>
+    /// <remarks>
+    ///   Many databases stream their results and only learn the number of rows once the
+    ///   last one has been read. Others (such as MySQL with its buffered results) know it
+    ///   up front. This is only a hint that lets callers reserve memory ahead of time,
+    ///   the default implementation never knows the row count.
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual std::optional<std::size_t> GetRowCountHint() const;
+
     /// <summary>Retrieves the name of the specified column</summary>
     /// <param name="columnIndex">Index of the column whose name will be returned</param>
     /// <returns>The name of the column with the specified index</returns>
@@ -89,6 +103,87 @@ namespace Nuclex::ThinOrm {
       const std::u8string &columnName
     ) const = 0;
 
+    /// <summary>Reads an integer from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    /// <remarks>
+    ///   <para>
+    ///     This and the other typed read methods exist so that entities can be filled
+    ///     straight from the backend's row without a <see cref="Value" /> in between.
+    ///     Values of other types are converted as by the <see cref="Value" /> class.
+    ///   </para>
+    ///   <para>
+    ///     The default implementations go through <see cref="GetColumnValue" />. Database
+    ///     backends override them to read from their native row representation.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual bool TryReadColumnInt64(
+      std::size_t columnIndex, std::int64_t &target
+    ) const;
+
+    /// <summary>Reads a floating point value from the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: NUCLEX_THINORM_API virtual bool TryReadColumnDouble(
+      std::size_t columnIndex, double &target
+    ) const;
+
+    /// <summary>Reads a string from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">
+    ///   Receives the value if the column is not NULL. Its contents are replaced, so
+    ///   any memory it has already allocated can be reused.
+    /// </param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: NUCLEX_THINORM_API virtual bool TryReadColumnString(
+      std::size_t columnIndex, std::u8string &target
+    ) const;
+
+    /// <summary>Reads a binary blob from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">
+    ///   Receives the value if the column is not NULL. Its contents are replaced, so
+    ///   any memory it has already allocated can be reused.
+    /// </param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: NUCLEX_THINORM_API virtual bool TryReadColumnBlob(
+      std::size_t columnIndex, std::vector<std::byte> &target
+    ) const;
+
+    /// <summary>Fetches multiple rows at once into a columnar buffer</summary>
+    /// <param name="batch">
+    ///   Row batch that will receive the rows. Any rows it held before are discarded.
+    /// </param>
+    /// <param name="maximumRowCount">Maximum number of rows that will be fetched</param>
+    /// <returns>
+    ///   The number of rows that were fetched. If this is less than the requested number,
+    ///   the end of the result has been reached.
+    /// </returns>
+    /// <remarks>
+    ///   <para>
+    ///     This behaves as if <see cref="MoveToNext" /> was called up to
+    ///     <paramref name="maximumRowCount" /> times and each row's values were stored in
+    ///     the row batch. Afterwards, the row reader is on the last row that was fetched
+    ///     (or on an invalid row if the end was reached), so fetching rows in batches and
+    ///     stepping through them one by one can be mixed.
+    ///   </para>
+    ///   <para>
+    ///     The column types of the batch are determined from the first row fetched. For
+    ///     database engines with dynamic typing (SQLite), later rows that store a different
+    ///     type are converted to the column's type.
+    ///   </para>
+    ///   <para>
+    ///     The default implementation goes through <see cref="GetColumnValue" /> for each
+    ///     cell. Database backends override this to fill the batch directly, saving
+    ///     a virtual call and a <see cref="Value" /> per cell.
+    ///   </para>
+    /// </remarks>
+    public: NUCLEX_THINORM_API virtual std::size_t FetchBatch(
+      RowBatch &batch, std::size_t maximumRowCount
+    );
+
   };
 
   // ------------------------------------------------------------------------------------------- //
@@ -0,0 +1,267 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_SQLLITERAL_H
+#define NUCLEX_THINORM_SQLLITERAL_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/QueryParameterView.h"
+
+#include <string> // for std::u8string
+#include <string_view> // for std::u8string_view
+#include <array> // for std::array
+#include <cstddef> // for std::size_t
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>SQL statement given as a string literal that can be parsed at compile time</summary>
+  /// <typeparam name="TLength">Length of the string literal including its terminator</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     This type is used as a template argument to the <see cref="StaticQuery" /> class.
+  ///     It holds a copy of the string literal so the compiler can look into it to find
+  ///     the parameters in the SQL statement, as well as to check parameter names passed
+  ///     to the static query's setters, without any work happening at runtime.
+  ///   </para>
+  ///   <para>
+  ///     Parsing follows the same rules as the runtime parser of the <see cref="Query" />
+  ///     class, but is stricter: braces that are never closed and empty parameter names
+  ///     are reported as compile errors rather than being ignored.
+  ///   </para>
+  /// </remarks>
+  template<std::size_t TLength>
+  class SqlLiteral {
+
+    /// <summary>Initializes a new SQL literal from a UTF-8 string literal</summary>
+    /// <param name="sqlStatement">String literal containing the SQL statement</param>
+    public: consteval SqlLiteral(const char8_t (&sqlStatement)[TLength]);
+
+    /// <summary>Number of characters in the SQL statement, without the terminator</summary>
+    public: static constexpr std::size_t Length = TLength - 1;
+
+    /// <summary>Provides the SQL statement as a string view</summary>
+    /// <returns>A string view covering the SQL statement</returns>
+    public: constexpr std::u8string_view GetSqlStatement() const;
+
+    /// <summary>Counts the number of parameter placeholders in the SQL statement</summary>
+    /// <returns>The number of parameter placeholders in the SQL statement</returns>
+    public: consteval std::size_t CountParameters() const;
+
+    /// <summary>Builds the names and locations of all parameter placeholders</summary>
+    /// <typeparam name="TParameterCount">
+    ///   Number of parameters in the SQL statement, obtained from CountParameters()
+    /// </typeparam>
+    /// <returns>The name and location of each parameter in the SQL statement</returns>
+    /// <remarks>
+    ///   Slot indices are assigned using the same rules as the runtime parser: each
+    ///   distinct name receives the next slot, names are compared case-insensitively.
+    /// </remarks>
+    public: template<std::size_t TParameterCount>
+    consteval std::array<QueryParameterView, TParameterCount> ParseParameters() const;
+
+    /// <summary>Looks up the first parameter placeholder with the specified name</summary>
+    /// <param name="name">Name of the parameter that will be looked up</param>
+    /// <returns>
+    ///   The index of the first parameter placeholder with the specified name or
+    ///   std::size_t(-1) if the SQL statement contains no such parameter
+    /// </returns>
+    public: consteval std::size_t FindParameter(std::u8string_view name) const;
+
+    /// <summary>Finds the next parameter placeholder in the SQL statement</summary>
+    /// <param name="startIndex">Index at which the search will begin</param>
+    /// <param name="parameter">Receives the location of the parameter if one is found</param>
+    /// <returns>True if another parameter was found, false if the end was reached</returns>
+    private: consteval bool findNextParameter(
+      std::size_t &startIndex, QueryParameterView &parameter
+    ) const;
+
+    /// <summary>Compares two parameter names using the same rules as the runtime</summary>
+    /// <param name="left">Name that will be compared against the right name</param>
+    /// <param name="right">Name that will be compared against the left name</param>
+    /// <returns>True if both names refer to the same parameter</returns>
+    private: static consteval bool areSameName(std::u8string_view left, std::u8string_view right);
+
+    /// <summary>Characters of the SQL statement, including the terminator</summary>
+    /// <remarks>
+    ///   This must be public because C++ only permits classes with exclusively public
+    ///   members as non-type template arguments.
+    /// </remarks>
+    public: char8_t Characters[TLength];
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  consteval SqlLiteral<TLength>::SqlLiteral(const char8_t (&sqlStatement)[TLength]) :
+    Characters() {
+    for(std::size_t index = 0; index < TLength; ++index) {
+      this->Characters[index] = sqlStatement[index];
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  constexpr std::u8string_view SqlLiteral<TLength>::GetSqlStatement() const {
+    return std::u8string_view(this->Characters, Length);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  consteval std::size_t SqlLiteral<TLength>::CountParameters() const {
+    std::size_t count = 0;
+
+    std::size_t index = 0;
+    QueryParameterView parameter{};
+    while(findNextParameter(index, parameter)) {
+      ++count;
+    }
+
+    return count;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  template<std::size_t TParameterCount>
+  consteval std::array<QueryParameterView, TParameterCount>
+  SqlLiteral<TLength>::ParseParameters() const {
+    std::array<QueryParameterView, TParameterCount> parameters{};
+
+    std::size_t slotCount = 0;
+    std::size_t index = 0;
+    for(std::size_t parameterIndex = 0; parameterIndex < TParameterCount; ++parameterIndex) {
+      findNextParameter(index, parameters[parameterIndex]);
+
+      // Reuse the slot of an earlier parameter with the same name if there is one
+      parameters[parameterIndex].SlotIndex = slotCount;
+      for(std::size_t earlierIndex = 0; earlierIndex < parameterIndex; ++earlierIndex) {
+        if(areSameName(parameters[earlierIndex].Name, parameters[parameterIndex].Name)) {
+          parameters[parameterIndex].SlotIndex = parameters[earlierIndex].SlotIndex;
+          break;
+        }
+      }
+      if(parameters[parameterIndex].SlotIndex == slotCount) {
+        ++slotCount;
+      }
+    }
+
+    return parameters;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  consteval std::size_t SqlLiteral<TLength>::FindParameter(std::u8string_view name) const {
+    std::size_t parameterIndex = 0;
+
+    std::size_t index = 0;
+    QueryParameterView parameter{};
+    while(findNextParameter(index, parameter)) {
+      if(areSameName(parameter.Name, name)) {
+        return parameterIndex;
+      }
+      ++parameterIndex;
+    }
+
+    return std::size_t(-1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  consteval bool SqlLiteral<TLength>::findNextParameter(
+    std::size_t &startIndex, QueryParameterView &parameter
+  ) const {
+    // Plain index loops are used instead of std::u8string_view::find() because some
+    // compilers refuse to evaluate the latter at compile time when sanitizers are enabled
+    for(std::size_t index = startIndex; index < Length; ++index) {
+      if(this->Characters[index] != u8'{') {
+        continue;
+      }
+
+      // Repeated braces are escaped braces meant to appear in the SQL statement literally
+      if((index + 1 < Length) && (this->Characters[index + 1] == u8'{')) {
+        ++index;
+        continue;
+      }
+
+      std::size_t endIndex = index + 1;
+      while((endIndex < Length) && (this->Characters[endIndex] != u8'}')) {
+        ++endIndex;
+      }
+
+      // Compile errors from these throws mean the SQL statement has a malformed parameter
+      if(endIndex >= Length) {
+        throw u8"SQL statement contains an opening brace that is never closed";
+      }
+      if(endIndex == index + 1) {
+        throw u8"SQL statement contains a parameter without a name";
+      }
+
+      parameter.StartIndex = index;
+      parameter.Length = endIndex - index + 1;
+      parameter.Name = std::u8string_view(this->Characters + index + 1, parameter.Length - 2);
+
+      startIndex = endIndex + 1;
+      return true;
+    }
+
+    startIndex = Length;
+    return false;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<std::size_t TLength>
+  consteval bool SqlLiteral<TLength>::areSameName(
+    std::u8string_view left, std::u8string_view right
+  ) {
+    if(left.length() != right.length()) {
+      return false;
+    }
+
+    // Only ASCII letters are folded here. This matches the runtime's case-insensitive
+    // comparison for all parameter names that can reasonably appear in SQL statements.
+    for(std::size_t index = 0; index < left.length(); ++index) {
+      char8_t leftCharacter = left[index];
+      if((leftCharacter >= u8'A') && (leftCharacter <= u8'Z')) {
+        leftCharacter += (u8'a' - u8'A');
+      }
+      char8_t rightCharacter = right[index];
+      if((rightCharacter >= u8'A') && (rightCharacter <= u8'Z')) {
+        rightCharacter += (u8'a' - u8'A');
+      }
+      if(leftCharacter != rightCharacter) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
+
+#endif // NUCLEX_THINORM_SQLLITERAL_H
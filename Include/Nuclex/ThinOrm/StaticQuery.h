@@ -0,0 +1,152 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_STATICQUERY_H
+#define NUCLEX_THINORM_STATICQUERY_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Query.h"
+#include "Nuclex/ThinOrm/SqlLiteral.h"
+
+#include <array> // for std::array
+#include <memory> // for std::shared_ptr
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>SQL query whose SQL statement is parsed and checked at compile time</summary>
+  /// <typeparam name="TSqlStatement">SQL statement the query should run</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Most SQL statements in a program are string literals, so there is no need to
+  ///     scan them for parameters each time a query is constructed. A static query finds
+  ///     its parameters while the program is being compiled. At runtime, all instances of
+  ///     the same static query share a single parsed SQL statement (and thus also share
+  ///     prepared statements cached by database connections).
+  ///   </para>
+  ///   <para>
+  ///     Parameters can additionally be accessed by names that are checked at compile
+  ///     time, so a mistyped parameter name results in a compile error:
+  ///   </para>
+  ///   <code>
+  ///     StaticQuery&lt;u8"SELECT * FROM users WHERE name={userName}"&gt; query;
+  ///     query.SetParameterValue&lt;u8"userName"&gt;(Value(std::u8string(u8"Jane Doe")));
+  ///   </code>
+  ///   <para>
+  ///     Static queries are normal queries and can be passed to anything that accepts
+  ///     a <see cref="Query" />.
+  ///   </para>
+  /// </remarks>
+  template<SqlLiteral TSqlStatement>
+  class StaticQuery : public Query {
+
+    /// <summary>Number of parameter placeholders in the SQL statement</summary>
+    public: static constexpr std::size_t ParameterCount = TSqlStatement.CountParameters();
+
+    /// <summary>Initializes a new static query</summary>
+    public: inline StaticQuery();
+
+    // Keep the index and runtime name based accessors of the query visible
+    using Query::GetParameterValue;
+    using Query::SetParameterValue;
+
+    /// <summary>Retrieves the value assigned to a parameter by its name</summary>
+    /// <typeparam name="TParameterName">Name of the parameter whose value to fetch</typeparam>
+    /// <returns>The current value of the parameter with the specified name</returns>
+    public: template<SqlLiteral TParameterName>
+    inline const Value &GetParameterValue() const;
+
+    /// <summary>Sets the value assigned to a parameter by its name</summary>
+    /// <typeparam name="TParameterName">Name of the parameter whose value to set</typeparam>
+    /// <param name="value">Value to assign to the parameter</param>
+    public: template<SqlLiteral TParameterName>
+    inline void SetParameterValue(const Value &value);
+
+    /// <summary>Looks up the index of a parameter at compile time</summary>
+    /// <typeparam name="TParameterName">Name of the parameter that will be looked up</typeparam>
+    /// <returns>The index of the first parameter with the specified name</returns>
+    private: template<SqlLiteral TParameterName>
+    static consteval std::size_t getParameterIndex();
+
+    /// <summary>Provides the parsed SQL statement shared by all instances</summary>
+    /// <returns>The parsed SQL statement of the static query</returns>
+    private: static const std::shared_ptr<const ImmutableState> &getImmutableState();
+
+    /// <summary>Names and locations of the parameters, determined at compile time</summary>
+    private: static constexpr std::array<QueryParameterView, ParameterCount> parameters = (
+      TSqlStatement.template ParseParameters<ParameterCount>()
+    );
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<SqlLiteral TSqlStatement>
+  inline StaticQuery<TSqlStatement>::StaticQuery() :
+    Query(getImmutableState()) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<SqlLiteral TSqlStatement>
+  template<SqlLiteral TParameterName>
+  inline const Value &StaticQuery<TSqlStatement>::GetParameterValue() const {
+    return Query::GetParameterValue(getParameterIndex<TParameterName>());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<SqlLiteral TSqlStatement>
+  template<SqlLiteral TParameterName>
+  inline void StaticQuery<TSqlStatement>::SetParameterValue(const Value &value) {
+    Query::SetParameterValue(getParameterIndex<TParameterName>(), value);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<SqlLiteral TSqlStatement>
+  template<SqlLiteral TParameterName>
+  consteval std::size_t StaticQuery<TSqlStatement>::getParameterIndex() {
+    constexpr std::size_t index = TSqlStatement.FindParameter(
+      TParameterName.GetSqlStatement()
+    );
+
+    // If you get this error, you're trying to access a parameter by a name that does not
+    // appear in the SQL statement of the query. Check the parameter name for typos.
+    static_assert(index != std::size_t(-1), "No such parameter in the SQL statement");
+
+    return index;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<SqlLiteral TSqlStatement>
+  const std::shared_ptr<const Query::ImmutableState> &
+  StaticQuery<TSqlStatement>::getImmutableState() {
+    static const std::shared_ptr<const ImmutableState> immutableState = adoptParsedStatement(
+      TSqlStatement.GetSqlStatement(), parameters.data(), ParameterCount
+    );
+    return immutableState;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
+
+#endif // NUCLEX_THINORM_STATICQUERY_H
@@ -0,0 +1,132 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_TRANSACTIONS_TRANSACTION_H
+#define NUCLEX_THINORM_TRANSACTIONS_TRANSACTION_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+
+namespace Nuclex::ThinOrm::Connections {
+  class Connection;
+}
+
+namespace Nuclex::ThinOrm::Transactions {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Scope of a transaction that rolls back unless it was committed</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Obtain a transaction via <see cref="Connection.BeginTransaction" />. All statements
+  ///     run on the connection until the transaction ends become part of the transaction.
+  ///     Call <see cref="Commit" /> to make the changes permanent. If the transaction
+  ///     is destroyed without being committed, for example because an exception is
+  ///     unwinding the stack, its changes are rolled back.
+  ///   </para>
+  ///   <para>
+  ///     Beginning another transaction while one is active creates a nested transaction
+  ///     (using savepoints), which can be rolled back on its own. Nested transactions
+  ///     must be ended before the transaction containing them.
+  ///   </para>
+  ///   <para>
+  ///     Besides atomicity, transactions are the primary tool for fast bulk writes.
+  ///     Outside of a transaction, each statement is committed on its own, which for
+  ///     file-based databases such as SQLite means one disk flush per statement.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_THINORM_TYPE Transaction {
+
+    /// <summary>Initializes an empty transaction scope that controls no transaction</summary>
+    public: NUCLEX_THINORM_API Transaction() noexcept;
+
+    /// <summary>Takes over the transaction controlled by another scope</summary>
+    /// <param name="other">Transaction scope whose transaction will be taken over</param>
+    public: NUCLEX_THINORM_API Transaction(Transaction &&other) noexcept;
+
+    /// <summary>Transaction scopes can not be copied</summary>
+    public: Transaction(const Transaction &other) = delete;
+
+    /// <summary>Rolls the transaction back if it hasn't been committed</summary>
+    public: NUCLEX_THINORM_API ~Transaction();
+
+    /// <summary>Checks whether the transaction is still waiting to be ended</summary>
+    /// <returns>True if the transaction has been neither committed nor rolled back</returns>
+    public: NUCLEX_THINORM_API bool IsActive() const noexcept;
+
+    /// <summary>Checks whether this transaction is nested in another transaction</summary>
+    /// <returns>True if the transaction is nested, false if it is the outermost one</returns>
+    public: NUCLEX_THINORM_API inline bool IsNested() const noexcept;
+
+    /// <summary>Makes the changes done within the transaction permanent</summary>
+    /// <remarks>
+    ///   For a nested transaction, its changes become part of the enclosing transaction
+    ///   and will only be permanent when the outermost transaction is committed.
+    ///   If the commit fails, the transaction stays active and will be rolled back
+    ///   when the scope is destroyed.
+    /// </remarks>
+    public: NUCLEX_THINORM_API void Commit();
+
+    /// <summary>Discards all changes done within the transaction</summary>
+    /// <remarks>
+    ///   Any transactions nested within this one are rolled back as well.
+    /// </remarks>
+    public: NUCLEX_THINORM_API void Rollback();
+
+    /// <summary>Rolls back the current transaction and takes over another</summary>
+    /// <param name="other">Transaction scope whose transaction will be taken over</param>
+    /// <returns>The transaction scope itself</returns>
+    public: NUCLEX_THINORM_API Transaction &operator =(Transaction &&other);
+
+    /// <summary>Transaction scopes can not be copied</summary>
+    public: Transaction &operator =(const Transaction &other) = delete;
+
+    /// <summary>Initializes a transaction scope for a freshly begun transaction</summary>
+    /// <param name="connection">Connection on which the transaction was begun</param>
+    /// <param name="depth">Nesting depth of the transaction, one being the outermost</param>
+    /// <param name="serial">Serial number the connection assigned to the transaction</param>
+    private: Transaction(
+      Connections::Connection &connection, std::size_t depth, std::uint64_t serial
+    ) noexcept;
+
+    /// <summary>Only connections can begin transactions</summary>
+    friend class Connections::Connection;
+
+    /// <summary>Connection on which the transaction is running</summary>
+    private: Connections::Connection *connection;
+    /// <summary>Nesting depth of the transaction, one being the outermost</summary>
+    private: std::size_t depth;
+    /// <summary>Serial number the connection assigned to the transaction</summary>
+    private: std::uint64_t serial;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool Transaction::IsNested() const noexcept {
+    return (this->depth > 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Transactions
+
+#endif // NUCLEX_THINORM_TRANSACTIONS_TRANSACTION_H
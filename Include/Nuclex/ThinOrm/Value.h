@@ -28,6 +28,10 @@ limitations under the License.
 #include <optional> // for std::optional
 #include <ctime> // for std::tm
 #include <vector> // for std::vector
+#include <string> // for std::u8string
+#include <string_view> // for std::u8string_view
+#include <span> // for std::span
+#include <cstdint> // for std::uint8_t
 
 namespace Nuclex::ThinOrm {
 
@@ -75,9 +79,26 @@ namespace Nuclex::ThinOrm {
     /// <summary>Initializes a new value as container of a string value</summary>
     /// <param name="stringValue">String value to assume</param>
     public: NUCLEX_THINORM_API Value(const std::u8string &stringValue) noexcept;
+    /// <summary>Initializes a new value by taking over a string value</summary>
+    /// <param name="stringValue">String value that will be adopted</param>
+    public: NUCLEX_THINORM_API Value(std::u8string &&stringValue) noexcept;
+    /// <summary>Initializes a new value as container of a string value</summary>
+    /// <param name="stringValue">String value to assume</param>
+    /// <remarks>
+    ///   Short strings are stored directly in the value container without any heap
+    ///   allocation, so this is the cheapest way to construct a value from text that
+    ///   isn't already held in an std::u8string.
+    /// </remarks>
+    public: NUCLEX_THINORM_API Value(const std::u8string_view &stringValue) noexcept;
     /// <summary>Initializes a new value as container of a blob value</summary>
     /// <param name="blobValue">Blob value to assume</param>
     public: NUCLEX_THINORM_API Value(const std::vector<std::byte> &blobValue) noexcept;
+    /// <summary>Initializes a new value by taking over a blob value</summary>
+    /// <param name="blobValue">Blob value that will be adopted</param>
+    public: NUCLEX_THINORM_API Value(std::vector<std::byte> &&blobValue) noexcept;
+    /// <summary>Initializes a new value as container of a blob value</summary>
+    /// <param name="blobValue">Blob value to assume</param>
+    public: NUCLEX_THINORM_API Value(const std::span<const std::byte> &blobValue) noexcept;
     /// <summary>Initializes a new value as container of a boolean value</summary>
     /// <param name="booleanValue">Boolean value to assume</param>
     public: NUCLEX_THINORM_API Value(const std::optional<bool> &booleanValue) noexcept;
@@ -105,11 +126,17 @@ namespace Nuclex::ThinOrm {
     /// <summary>Initializes a new value as container of a string value</summary>
     /// <param name="stringValue">String value to assume</param>
     public: NUCLEX_THINORM_API Value(const std::optional<std::u8string> &stringValue) noexcept;
+    /// <summary>Initializes a new value by taking over a string value</summary>
+    /// <param name="stringValue">String value that will be adopted</param>
+    public: NUCLEX_THINORM_API Value(std::optional<std::u8string> &&stringValue) noexcept;
     /// <summary>Initializes a new value as container of a blob value</summary>
     /// <param name="blobValue">Blob value to assume</param>
     public: NUCLEX_THINORM_API Value(
       const std::optional<std::vector<std::byte>> &blobValue
     ) noexcept;
+    /// <summary>Initializes a new value by taking over a blob value</summary>
+    /// <param name="blobValue">Blob value that will be adopted</param>
+    public: NUCLEX_THINORM_API Value(std::optional<std::vector<std::byte>> &&blobValue) noexcept;
     /// <summary>Frees all memory owned by the value</summary>
     public: NUCLEX_THINORM_API ~Value() noexcept;
 
@@ -195,6 +222,27 @@ namespace Nuclex::ThinOrm {
     /// <returns>The container's stored value as a binary blob</returns>
     public: NUCLEX_THINORM_API std::optional<std::vector<std::byte>> AsBlob() const;
 
+    /// <summary>Provides direct access to the characters of a string value</summary>
+    /// <returns>
+    ///   A view of the stored string or an empty optional if the value is empty
+    /// </returns>
+    /// <remarks>
+    ///   Unlike <see cref="AsString" />, this does not copy the string, but it also does
+    ///   not perform any type coercion. The value must be of type ValueType::String.
+    ///   The returned view is only valid for as long as the value remains unchanged.
+    /// </remarks>
+    public: NUCLEX_THINORM_API std::optional<std::u8string_view> GetStringView() const;
+    /// <summary>Provides direct access to the bytes of a blob value</summary>
+    /// <returns>
+    ///   A span covering the stored blob or an empty optional if the value is empty
+    /// </returns>
+    /// <remarks>
+    ///   Unlike <see cref="AsBlob" />, this does not copy the blob, but it also does
+    ///   not perform any type coercion. The value must be of type ValueType::Blob.
+    ///   The returned span is only valid for as long as the value remains unchanged.
+    /// </remarks>
+    public: NUCLEX_THINORM_API std::optional<std::span<const std::byte>> GetBlobView() const;
+
     /// <summary>Clones the value assumed by another value container</summary>
     /// <param name="other">Other value container whose contents will be cloned</param>
     public: NUCLEX_THINORM_API Value &operator =(const Value &other) noexcept;
@@ -301,10 +349,35 @@ namespace Nuclex::ThinOrm {
     /// <returns>The stored value as a blob</returns>
     public: NUCLEX_THINORM_API explicit operator std::optional<std::vector<std::byte>>() const;
 
+    /// <summary>Accesses the stored string, regardless of how it is stored</summary>
+    /// <returns>A view of the stored string</returns>
+    /// <remarks>
+    ///   Must only be called if the value is a non-empty string.
+    /// </remarks>
+    private: inline std::u8string_view getStringView() const noexcept;
+
+    /// <summary>Stores a string in the value container</summary>
+    /// <param name="stringValue">String value that will be stored</param>
+    /// <remarks>
+    ///   The value container must not hold any non-trivial type when this is called.
+    ///   Only the string storage is set up, type and empty flag are left unchanged.
+    /// </remarks>
+    private: void constructString(const std::u8string_view &stringValue) noexcept;
+
+    /// <summary>Inline storage for short strings that avoids a heap allocation</summary>
+    private: struct ShortStringStorage {
+      /// <summary>Number of characters stored in the buffer</summary>
+      public: std::uint8_t Length;
+      /// <summary>Characters of the string, not zero-terminated</summary>
+      public: char8_t Characters[sizeof(std::u8string) - 1];
+    };
+
     /// <summary>Current type of value stored in the value container</summary>
     private: ValueType type;
     /// <summary>Whether the value currently stored is empty (NULL)</summary>
     private: bool empty;
+    /// <summary>Whether a string is held in the short string storage</summary>
+    private: bool shortString;
     /// <summary>Actual value as a union</summary>
     private: union ValueContainer {
       /// <summary>Do-nothing constructor, needed because of the non-trivial types</summary>
@@ -329,6 +402,8 @@ namespace Nuclex::ThinOrm {
       public: double Double;
       /// <summary>UTF-8 string value if the container stores a UTF-8 string</summary>
       public: std::u8string String;
+      /// <summary>UTF-8 string value if the container stores a short UTF-8 string</summary>
+      public: ShortStringStorage ShortString;
       /// <summary>Blob value if the container stores a blob</summary>
       public: std::vector<std::byte> Blob;
     } value;
@@ -345,6 +420,16 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  inline std::u8string_view Value::getStringView() const noexcept {
+    if(this->shortString) {
+      return std::u8string_view(this->value.ShortString.Characters, this->value.ShortString.Length);
+    } else {
+      return std::u8string_view(this->value.String);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm
 
 #endif // NUCLEX_THINORM_VALUE_H
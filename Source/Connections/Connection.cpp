@@ -22,13 +22,290 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Connections/Connection.h"
 
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Value.h" // for Value
+#include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+#include "Nuclex/ThinOrm/ParameterRowSource.h" // for ParameterRowSource
+
+#include "./IoThreadPool.h" // for IoThreadPool
+
+#include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append()
+
+#include <exception> // for std::exception
+#include <stdexcept> // for std::logic_error
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Forms the savepoint statement for a nested transaction</summary>
+  /// <param name="prefix">SQL command that goes before the savepoint name</param>
+  /// <param name="depth">Nesting depth of the transaction the savepoint is for</param>
+  /// <returns>A query that runs the savepoint command for the nested transaction</returns>
+  Nuclex::ThinOrm::Query formSavepointQuery(const char8_t *prefix, std::size_t depth) {
+    std::u8string statement(prefix);
+    statement.append(u8" nested_transaction_", 20);
+    Nuclex::Support::Text::lexical_append(statement, depth);
+    return Nuclex::ThinOrm::Query(statement);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides parameter rows from a vector of value vectors</summary>
+  class ValueVectorRowSource : public Nuclex::ThinOrm::ParameterRowSource {
+
+    /// <summary>Initializes a new parameter row source over the specified rows</summary>
+    /// <param name="rows">Rows of parameter values that will be provided</param>
+    public: ValueVectorRowSource(
+      const std::vector<std::vector<Nuclex::ThinOrm::Value>> &rows
+    ) :
+      rows(rows),
+      nextRowIndex(0) {}
+
+    /// <summary>Frees all resources owned by the parameter row source</summary>
+    public: ~ValueVectorRowSource() override = default;
+
+    /// <summary>Assigns the parameter values of the next row to the query</summary>
+    /// <param name="query">Query whose parameter values will be assigned</param>
+    /// <returns>True if a row was assigned, false if there are no more rows</returns>
+    public: bool AssignNextRow(Nuclex::ThinOrm::Query &query) override {
+      if(this->nextRowIndex >= this->rows.size()) {
+        return false;
+      }
+
+      const std::vector<Nuclex::ThinOrm::Value> &row = this->rows[this->nextRowIndex];
+      for(std::size_t index = 0; index < row.size(); ++index) {
+        query.SetParameterValue(index, row[index]);
+      }
+
+      ++this->nextRowIndex;
+      return true;
+    }
+
+    /// <summary>Rows of parameter values being provided</summary>
+    private: const std::vector<std::vector<Nuclex::ThinOrm::Value>> &rows;
+    /// <summary>Index of the row that will be provided next</summary>
+    private: std::size_t nextRowIndex;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
 namespace Nuclex::ThinOrm::Connections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  // This file is only here to guarantee that its associated header has no hidden
-  // dependencies and can be included on its own
+  Connection::Connection() :
+    transactionDepth(0),
+    transactionSerials(),
+    nextTransactionSerial(1) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool Connection::CheckHealth() {
+    static const Query probeQuery(u8"SELECT 1");
+    try {
+      RunScalarQuery(probeQuery);
+      return true;
+    }
+    catch(const std::exception &) {
+      return false;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t Connection::GetMaximumParameterCount() const {
+    return 999;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Dialects::UpsertStyle Connection::GetUpsertStyle() const {
+    return Dialects::UpsertStyle::OnConflictDoUpdate;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Dialects::QuoteStyle Connection::GetQuoteStyle() const {
+    return Dialects::QuoteStyle::DoubleQuotes;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void Connection::Interrupt() {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::vector<std::size_t> Connection::RunBatch(
+    const Query &batchQuery, ParameterRowSource &parameterRows
+  ) {
+    Query rowQuery(batchQuery);
+
+    std::vector<std::size_t> affectedRowCounts;
+    while(parameterRows.AssignNextRow(rowQuery)) {
+      affectedRowCounts.push_back(RunUpdateQuery(rowQuery));
+    }
+
+    return affectedRowCounts;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::vector<std::size_t> Connection::RunBatch(
+    const Query &batchQuery, const std::vector<std::vector<Value>> &parameterRows
+  ) {
+    ValueVectorRowSource rowSource(parameterRows);
+    return RunBatch(batchQuery, rowSource);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Transactions::Transaction Connection::BeginTransaction(
+    Transactions::IsolationLevel isolationLevel /* = Transactions::IsolationLevel::Default */
+  ) {
+    std::size_t depth = this->transactionDepth + 1;
+
+    // Make room for the serial number up front so nothing can fail after the
+    // transaction has been begun on the database
+    if(this->transactionSerials.size() < depth) {
+      this->transactionSerials.resize(depth);
+    }
+
+    if(depth == 1) {
+      BeginTopLevelTransaction(isolationLevel);
+    } else {
+      RunStatement(formSavepointQuery(u8"SAVEPOINT", depth));
+    }
+
+    std::uint64_t serial = this->nextTransactionSerial;
+    ++this->nextTransactionSerial;
+    this->transactionSerials[depth - 1] = serial;
+    this->transactionDepth = depth;
+
+    return Transactions::Transaction(*this, depth, serial);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void Connection::BeginTopLevelTransaction(Transactions::IsolationLevel) {
+    static const Query beginQuery(u8"BEGIN");
+    RunStatement(beginQuery);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void Connection::CommitTopLevelTransaction() {
+    static const Query commitQuery(u8"COMMIT");
+    RunStatement(commitQuery);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void Connection::RollbackTopLevelTransaction() {
+    static const Query rollbackQuery(u8"ROLLBACK");
+    RunStatement(rollbackQuery);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool Connection::isTransactionActive(std::size_t depth, std::uint64_t serial) const noexcept {
+    return (
+      (depth >= 1) &&
+      (depth <= this->transactionDepth) &&
+      (this->transactionSerials[depth - 1] == serial)
+    );
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
+  void Connection::endTransaction(std::size_t depth, bool commit) {
+    if(commit) {
+      if(depth < this->transactionDepth) {
+        throw std::logic_error(
+          reinterpret_cast<const char *>(
+            u8"Transaction can not be committed while a nested transaction is still active"
+          )
+        );
+      }
+
+      // If the commit fails, the transaction remains active so it can be rolled back
+      if(depth == 1) {
+        CommitTopLevelTransaction();
+      } else {
+        RunStatement(formSavepointQuery(u8"RELEASE SAVEPOINT", depth));
+      }
+
+      this->transactionDepth = depth - 1;
+    } else {
+
+      // A failed rollback still ends the transaction (and any nested in it) because
+      // there is nothing else the caller could do with it that might succeed.
+      this->transactionDepth = depth - 1;
+
+      if(depth == 1) {
+        RollbackTopLevelTransaction();
+      } else {
+        RunStatement(formSavepointQuery(u8"ROLLBACK TO SAVEPOINT", depth));
+        RunStatement(formSavepointQuery(u8"RELEASE SAVEPOINT", depth));
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+  asyncpp::task<void> Connection::RunStatementAsync(
+    const Query &statement, const std::stop_token &stopToken /* = std::stop_token() */
+  ) {
+    return IoThreadPool::RunBlockingCall<void>(
+      [this, statement]() { RunStatement(statement); },
+      [this]() { Interrupt(); },
+      stopToken
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  asyncpp::task<Value> Connection::RunScalarQueryAsync(
+    const Query &scalarQuery, const std::stop_token &stopToken /* = std::stop_token() */
+  ) {
+    return IoThreadPool::RunBlockingCall<Value>(
+      [this, scalarQuery]() { return RunScalarQuery(scalarQuery); },
+      [this]() { Interrupt(); },
+      stopToken
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  asyncpp::task<std::size_t> Connection::RunUpdateQueryAsync(
+    const Query &updateQuery, const std::stop_token &stopToken /* = std::stop_token() */
+  ) {
+    return IoThreadPool::RunBlockingCall<std::size_t>(
+      [this, updateQuery]() { return RunUpdateQuery(updateQuery); },
+      [this]() { Interrupt(); },
+      stopToken
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  asyncpp::task<std::unique_ptr<RowReader>> Connection::RunRowQueryAsync(
+    const Query &rowQuery, const std::stop_token &stopToken /* = std::stop_token() */
+  ) {
+    return IoThreadPool::RunBlockingCall<std::unique_ptr<RowReader>>(
+      [this, rowQuery]() { return RunRowQuery(rowQuery); },
+      [this]() { Interrupt(); },
+      stopToken
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
 } // namespace Nuclex::ThinOrm::Connections
@@ -22,13 +22,32 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Connections/ConnectionFactory.h"
 
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+#include "Nuclex/ThinOrm/Configuration/ConnectionString.h" // for ConnectionString
+#include "Nuclex/ThinOrm/Connections/Connection.h" // for Connection
+
+#include "./IoThreadPool.h" // for IoThreadPool
+
 namespace Nuclex::ThinOrm::Connections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  // This file is only here to guarantee that its associated header has no hidden
-  // dependencies and can be included on its own
+  asyncpp::task<std::shared_ptr<Connection>> ConnectionFactory::ConnectAsync(
+    const Configuration::ConnectionProperties &connectionProperties,
+    const std::stop_token &stopToken /* = std::stop_token() */
+  ) const {
+    Configuration::ConnectionString copiedProperties(connectionProperties);
+    return IoThreadPool::RunBlockingCall<std::shared_ptr<Connection>>(
+      [this, copiedProperties = std::move(copiedProperties)]() {
+        return Connect(copiedProperties);
+      },
+      stopToken
+    );
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
 } // namespace Nuclex::ThinOrm::Connections
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
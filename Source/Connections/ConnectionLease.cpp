@@ -0,0 +1,117 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Connections/ConnectionLease.h"
+#include "Nuclex/ThinOrm/Connections/ConnectionPool.h"
+
+#include <utility> // for std::move()
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease::ConnectionLease() noexcept :
+    pool(nullptr),
+    connection(),
+    isBroken(false) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease::ConnectionLease(
+    ConnectionPool &pool, std::shared_ptr<Connection> &&connection
+  ) noexcept :
+    pool(&pool),
+    connection(std::move(connection)),
+    isBroken(false) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease::ConnectionLease(const std::shared_ptr<Connection> &connection) noexcept :
+    pool(nullptr),
+    connection(connection),
+    isBroken(false) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease::ConnectionLease(ConnectionLease &&other) noexcept :
+    pool(other.pool),
+    connection(std::move(other.connection)),
+    isBroken(other.isBroken) {
+    other.pool = nullptr;
+    other.isBroken = false;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease::~ConnectionLease() {
+    try {
+      Release();
+    }
+    catch(...) {
+      // Destructors must not throw, least of all while the stack is being unwound
+      // because a query failed. The lease has let go of the connection either way.
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void ConnectionLease::Release() {
+    if(this->pool == nullptr) {
+      this->connection.reset(); // Unpooled leases have nothing to return the connection to
+      this->isBroken = false;
+      return;
+    }
+
+    // Clear the lease first so it is empty even if the pool throws
+    ConnectionPool *releasedPool = this->pool;
+    std::shared_ptr<Connection> releasedConnection = std::move(this->connection);
+    bool wasBroken = this->isBroken;
+    this->pool = nullptr;
+    this->isBroken = false;
+
+    releasedPool->outstandingLeaseCount.fetch_sub(1, std::memory_order_relaxed);
+    if(wasBroken) {
+      releasedPool->DiscardConnection(releasedConnection);
+    } else {
+      releasedPool->ReturnConnection(releasedConnection);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease &ConnectionLease::operator =(ConnectionLease &&other) {
+    if(this != &other) {
+      Release();
+
+      this->pool = other.pool;
+      this->connection = std::move(other.connection);
+      this->isBroken = other.isBroken;
+      other.pool = nullptr;
+      other.isBroken = false;
+    }
+
+    return *this;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
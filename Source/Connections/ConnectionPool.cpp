@@ -21,13 +21,35 @@ limitations under the License.
 #define NUCLEX_THINORM_SOURCE 1
 
 #include "Nuclex/ThinOrm/Connections/ConnectionPool.h"
+#include "Nuclex/ThinOrm/Connections/ConnectionLease.h"
+#include "Nuclex/ThinOrm/Connections/Connection.h"
 
 namespace Nuclex::ThinOrm::Connections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  // This file is only here to guarantee that its associated header has no hidden
-  // dependencies and can be included on its own
+  ConnectionPool::ConnectionPool() :
+    outstandingLeaseCount(0) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ConnectionLease ConnectionPool::LeaseConnection() {
+    ConnectionLease lease(*this, BorrowConnection());
+    this->outstandingLeaseCount.fetch_add(1, std::memory_order_relaxed);
+    return lease;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t ConnectionPool::CountOutstandingLeases() const {
+    return this->outstandingLeaseCount.load(std::memory_order_relaxed);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void ConnectionPool::DiscardConnection(const std::shared_ptr<Connection> &connection) {
+    (void)connection; // Nothing to do, the connection closes when the last reference goes
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
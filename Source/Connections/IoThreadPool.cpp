@@ -0,0 +1,139 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./IoThreadPool.h"
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+#include <algorithm> // for std::max()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Minimum number of threads the shared I/O thread pool will have</summary>
+  /// <remarks>
+  ///   The I/O threads spend most of their time waiting for the database server,
+  ///   so there is no reason to limit them to the number of CPU cores.
+  /// </remarks>
+  const std::size_t MinimumIoThreadCount = 8;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  IoThreadPool::IoThreadPool(std::size_t threadCount) :
+    queueAccessMutex(),
+    workAvailable(),
+    queue(),
+    threads() {
+    this->threads.reserve(threadCount);
+    for(std::size_t index = 0; index < threadCount; ++index) {
+      this->threads.emplace_back(
+        [this](std::stop_token stopToken) { runWorkerThread(stopToken); }
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  IoThreadPool::~IoThreadPool() {
+    for(std::jthread &thread : this->threads) {
+      thread.request_stop();
+    }
+    this->threads.clear(); // Joins all threads
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  IoThreadPool &IoThreadPool::GetInstance() {
+    static IoThreadPool instance(
+      std::max<std::size_t>(MinimumIoThreadCount, std::thread::hardware_concurrency() * 2)
+    );
+    return instance;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void IoThreadPool::Post(std::function<void()> &&work) {
+    {
+      std::unique_lock<std::mutex> queueAccessScope(this->queueAccessMutex);
+      this->queue.push_back(std::move(work));
+    }
+    this->workAvailable.notify_one();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void IoThreadPool::throwIfStopRequested(const std::stop_token &stopToken) {
+    if(stopToken.stop_requested()) {
+      throw Errors::OperationCancelledError(
+        u8"Asynchronous database operation was cancelled before it could run"
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::exception_ptr IoThreadPool::captureCurrentError(const std::stop_token &stopToken) {
+    if(stopToken.stop_requested()) {
+      return std::make_exception_ptr(
+        Errors::OperationCancelledError(
+          u8"Asynchronous database operation was cancelled while it was running"
+        )
+      );
+    } else {
+      return std::current_exception();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void IoThreadPool::runWorkerThread(std::stop_token stopToken) {
+    for(;;) {
+      std::function<void()> work;
+      {
+        std::unique_lock<std::mutex> queueAccessScope(this->queueAccessMutex);
+        bool hasWork = this->workAvailable.wait(
+          queueAccessScope, stopToken, [this]() { return !this->queue.empty(); }
+        );
+        if(!hasWork) {
+          return; // Stop was requested
+        }
+
+        work = std::move(this->queue.front());
+        this->queue.pop_front();
+      }
+
+      work();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
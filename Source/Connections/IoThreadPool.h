@@ -0,0 +1,228 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_IOTHREADPOOL_H
+#define NUCLEX_THINORM_CONNECTIONS_IOTHREADPOOL_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+#include "Nuclex/ThinOrm/Errors/OperationCancelledError.h"
+
+#include <asyncpp/task.h> // for asyncpp::task
+#include <asyncpp/dispatcher.h> // for asyncpp::dispatcher
+
+#include <coroutine> // for std::coroutine_handle
+#include <stop_token> // for std::stop_token, std::stop_callback
+#include <functional> // for std::function
+#include <exception> // for std::exception_ptr
+#include <optional> // for std::optional
+#include <type_traits> // for std::is_void_v
+#include <thread> // for std::jthread
+#include <mutex> // for std::mutex
+#include <condition_variable> // for std::condition_variable
+#include <deque> // for std::deque
+#include <vector> // for std::vector
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Threads on which blocking database driver calls are carried out</summary>
+  /// <remarks>
+  ///   None of the database drivers offer a non-blocking API we could integrate with
+  ///   coroutines, so the asynchronous methods hand their blocking calls to these threads
+  ///   instead. That keeps the threads running the caller's coroutines free to do other
+  ///   work while many queries are in flight.
+  /// </remarks>
+  class IoThreadPool {
+
+    /// <summary>Initializes a new I/O thread pool</summary>
+    /// <param name="threadCount">Number of threads that will run blocking calls</param>
+    public: explicit IoThreadPool(std::size_t threadCount);
+
+    /// <summary>Stops all threads, abandoning any calls that are still queued</summary>
+    public: ~IoThreadPool();
+
+    /// <summary>Accesses the I/O thread pool shared by all connections</summary>
+    /// <returns>The shared I/O thread pool</returns>
+    public: static IoThreadPool &GetInstance();
+
+    /// <summary>Queues a piece of work to be done by one of the I/O threads</summary>
+    /// <param name="work">Work that will be carried out on an I/O thread</param>
+    public: void Post(std::function<void()> &&work);
+
+    /// <summary>Awaitable that resumes the awaiting coroutine on an I/O thread</summary>
+    public: class Switch {
+
+      /// <summary>Initializes a new awaitable for a switch to the I/O threads</summary>
+      /// <param name="threadPool">I/O thread pool on which to resume the coroutine</param>
+      public: explicit Switch(IoThreadPool &threadPool) : threadPool(threadPool) {}
+
+      /// <summary>Reports that the coroutine always has to be suspended</summary>
+      /// <returns>Always false</returns>
+      public: bool await_ready() const noexcept { return false; }
+
+      /// <summary>Queues the coroutine for resumption on an I/O thread</summary>
+      /// <param name="handle">Coroutine that will be resumed on the I/O thread</param>
+      public: void await_suspend(std::coroutine_handle<> handle) {
+        this->threadPool.Post([handle]() { handle.resume(); });
+      }
+
+      /// <summary>Called when the coroutine resumes, nothing to do here</summary>
+      public: void await_resume() const noexcept {}
+
+      /// <summary>I/O thread pool the coroutine will be resumed on</summary>
+      private: IoThreadPool &threadPool;
+
+    };
+
+    /// <summary>Awaitable that resumes the awaiting coroutine through a dispatcher</summary>
+    public: class Return {
+
+      /// <summary>Initializes a new awaitable for a switch back to the caller's threads</summary>
+      /// <param name="dispatcher">Dispatcher on which to resume the coroutine</param>
+      public: explicit Return(asyncpp::dispatcher *dispatcher) : dispatcher(dispatcher) {}
+
+      /// <summary>Checks whether the coroutine can simply continue on this thread</summary>
+      /// <returns>True if there was no dispatcher to go back to</returns>
+      public: bool await_ready() const noexcept { return (this->dispatcher == nullptr); }
+
+      /// <summary>Hands the coroutine to the dispatcher for resumption</summary>
+      /// <param name="handle">Coroutine that will be resumed by the dispatcher</param>
+      public: void await_suspend(std::coroutine_handle<> handle) {
+        this->dispatcher->push([handle]() { handle.resume(); });
+      }
+
+      /// <summary>Called when the coroutine resumes, nothing to do here</summary>
+      public: void await_resume() const noexcept {}
+
+      /// <summary>Dispatcher that will resume the coroutine</summary>
+      private: asyncpp::dispatcher *dispatcher;
+
+    };
+
+    /// <summary>Carries out a blocking call on an I/O thread</summary>
+    /// <typeparam name="TResult">Type of value the blocking call returns</typeparam>
+    /// <typeparam name="TCall">Function object that will do the blocking call</typeparam>
+    /// <typeparam name="TInterrupt">Function object that aborts the blocking call</typeparam>
+    /// <param name="call">Blocking call that will be carried out</param>
+    /// <param name="interrupt">
+    ///   Invoked from the thread requesting the stop if that happens while the blocking
+    ///   call is running, should make the blocking call return as soon as possible
+    /// </param>
+    /// <param name="stopToken">Token by which the call can be cancelled</param>
+    /// <returns>A task that provides the result of the call when awaited</returns>
+    /// <remarks>
+    ///   If the caller was running on an asyncpp dispatcher, the coroutine will be resumed
+    ///   through that dispatcher once the call completes, otherwise it continues on the I/O
+    ///   thread. A stop requested before the call starts skips the call, a stop requested
+    ///   while it runs invokes the interrupt function. Either way, the task fails with
+    ///   an <see cref="Errors::OperationCancelledError" /> (unless the call managed to
+    ///   complete successfully before noticing the interruption).
+    /// </remarks>
+    public: template<typename TResult, typename TCall, typename TInterrupt>
+    static asyncpp::task<TResult> RunBlockingCall(
+      TCall call, TInterrupt interrupt, std::stop_token stopToken
+    );
+
+    /// <summary>Throws an error if a stop has been requested through the stop token</summary>
+    /// <param name="stopToken">Stop token that will be checked</param>
+    private: static void throwIfStopRequested(const std::stop_token &stopToken);
+
+    /// <summary>Captures the exception currently being handled for later rethrowing</summary>
+    /// <param name="stopToken">Stop token through which the call could be cancelled</param>
+    /// <returns>The captured exception</returns>
+    /// <remarks>
+    ///   If a stop has been requested, the error was most likely caused by the database
+    ///   driver aborting the interrupted call, so it is replaced with a cancellation error.
+    ///   Must only be called from within a catch block.
+    /// </remarks>
+    private: static std::exception_ptr captureCurrentError(const std::stop_token &stopToken);
+
+    /// <summary>Keeps taking work from the queue and carrying it out</summary>
+    /// <param name="stopToken">Token that signals when the thread should shut down</param>
+    private: void runWorkerThread(std::stop_token stopToken);
+
+    /// <summary>Must be held when accessing the work queue</summary>
+    private: std::mutex queueAccessMutex;
+    /// <summary>Signalled when work is queued or the threads should shut down</summary>
+    private: std::condition_variable_any workAvailable;
+    /// <summary>Work waiting to be carried out by the I/O threads</summary>
+    private: std::deque<std::function<void()>> queue;
+    /// <summary>Threads carrying out the blocking calls</summary>
+    private: std::vector<std::jthread> threads;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TResult, typename TCall, typename TInterrupt>
+  asyncpp::task<TResult> IoThreadPool::RunBlockingCall(
+    TCall call, TInterrupt interrupt, std::stop_token stopToken
+  ) {
+    asyncpp::dispatcher *callerDispatcher = asyncpp::dispatcher::current();
+    throwIfStopRequested(stopToken);
+
+    co_await Switch(GetInstance());
+
+    // Exceptions are captured so that they can be rethrown on the caller's threads
+    std::exception_ptr error;
+    if constexpr(std::is_void_v<TResult>) {
+      try {
+        throwIfStopRequested(stopToken);
+        std::stop_callback interruptOnStop(stopToken, std::move(interrupt));
+        call();
+      }
+      catch(...) {
+        error = captureCurrentError(stopToken);
+      }
+
+      co_await Return(callerDispatcher);
+      if(static_cast<bool>(error)) {
+        std::rethrow_exception(error);
+      }
+    } else {
+      std::optional<TResult> result;
+      try {
+        throwIfStopRequested(stopToken);
+        std::stop_callback interruptOnStop(stopToken, std::move(interrupt));
+        result.emplace(call());
+      }
+      catch(...) {
+        error = captureCurrentError(stopToken);
+      }
+
+      co_await Return(callerDispatcher);
+      if(static_cast<bool>(error)) {
+        std::rethrow_exception(error);
+      }
+
+      co_return std::move(result).value();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+#endif // NUCLEX_THINORM_CONNECTIONS_IOTHREADPOOL_H
@@ -25,11 +25,14 @@ limitations under the License.
 #if defined(NUCLEX_THINORM_ENABLE_QT)
 
 #include "Nuclex/ThinOrm/Configuration/ConnectionProperties.h" // for ConnectionProperties
+#include "Nuclex/ThinOrm/Query.h" // for Query
 #include "Nuclex/ThinOrm/Value.h" // for Value
 #include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+#include "Nuclex/ThinOrm/ParameterRowSource.h" // for ParameterRowSource
 
 #include "../../Utilities/QStringConverter.h" // for QStringConverter
 #include "./QtSqlMaterializedQuery.h" // for QtSqlMaterializedQuery
+#include "./QtSqlMaterializedQueryCache.h" // for QtSqlMaterializedQueryCache
 
 #include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append<>
 #include <Nuclex/Support/ScopeGuard.h> // for ON_SCOPE_EXIT_TRANSACTION
@@ -59,6 +62,33 @@ namespace {
   }
 
   // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Looks up the SQL statement that selects the specified isolation level</summary>
+  /// <param name="isolationLevel">Isolation level whose statement will be looked up</param>
+  /// <returns>The statement selecting the isolation level or null for the default</returns>
+  const char8_t *getIsolationLevelStatement(
+    Nuclex::ThinOrm::Transactions::IsolationLevel isolationLevel
+  ) {
+    using Nuclex::ThinOrm::Transactions::IsolationLevel;
+
+    switch(isolationLevel) {
+      case IsolationLevel::CommittedReads_FailConflictingWrites: {
+        return u8"SET TRANSACTION ISOLATION LEVEL READ COMMITTED";
+      }
+      case IsolationLevel::RepeatableReads_FailConflictingWrites: {
+        return u8"SET TRANSACTION ISOLATION LEVEL REPEATABLE READ";
+      }
+      case IsolationLevel::PinnedReads_BlockConcurrentWrites:
+      case IsolationLevel::Isolated_BlockConcurrentWrites: {
+        return u8"SET TRANSACTION ISOLATION LEVEL SERIALIZABLE";
+      }
+      default: {
+        return nullptr;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
   
 } // anonymous namespace
 
@@ -66,17 +96,25 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
 
   // ------------------------------------------------------------------------------------------- //
 
+  const std::size_t QtSqlConnection::DefaultMaterializedQueryCacheCapacity = 64;
+
+  // ------------------------------------------------------------------------------------------- //
+
   QtSqlConnection::QtSqlConnection(
     std::u8string connectionBaseName, std::uint64_t uniqueId, QSqlDatabase database
   ) :
     connectionBaseName(connectionBaseName),
     uniqueId(uniqueId),
     database(database),
-    uniqueConnectionName(makeUniqueConnectionName(connectionBaseName, uniqueId)) {}
+    uniqueConnectionName(makeUniqueConnectionName(connectionBaseName, uniqueId)),
+    materializedQueryCache(
+      std::make_shared<QtSqlMaterializedQueryCache>(DefaultMaterializedQueryCacheCapacity)
+    ) {}
 
   // ------------------------------------------------------------------------------------------- //
 
   QtSqlConnection::~QtSqlConnection() {
+    this->materializedQueryCache->Clear();
     QtSqlConnection::uniqueNameGenerator.ReturnUniqueId(this->connectionBaseName);
   }
 
@@ -174,50 +212,83 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   // ------------------------------------------------------------------------------------------- //
 
   void QtSqlConnection::Prepare(const Query &query) {
-    QtSqlMaterializedQuery materializedQuery(this->database, query);
-    // TODO: Put the materialized query in an MRU cache once that is implemented!
+    std::shared_ptr<QtSqlMaterializedQuery> materializedQuery = (
+      this->materializedQueryCache->Checkout(this->database, query)
+    );
+    this->materializedQueryCache->Return(std::move(materializedQuery));
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   void QtSqlConnection::RunStatement(const Query &statement) {
-    QtSqlMaterializedQuery materializedQuery(this->database, statement);
-    materializedQuery.BindParameters(statement);
-    materializedQuery.RunWithoutResult();
+    std::shared_ptr<QtSqlMaterializedQuery> materializedQuery = (
+      this->materializedQueryCache->Checkout(this->database, statement)
+    );
+    materializedQuery->BindParameters(statement);
+    materializedQuery->RunWithoutResult();
+
+    // Only queries that executed successfully go back into the cache. If an exception
+    // is thrown, the materialized query is dropped, so a broken QSqlQuery can't linger.
+    this->materializedQueryCache->Return(std::move(materializedQuery));
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   Value QtSqlConnection::RunScalarQuery(const Query &scalarQuery) {
-    QtSqlMaterializedQuery materializedQuery(this->database, scalarQuery);
-    materializedQuery.BindParameters(scalarQuery);
-    return materializedQuery.RunWithScalarResult();
+    std::shared_ptr<QtSqlMaterializedQuery> materializedQuery = (
+      this->materializedQueryCache->Checkout(this->database, scalarQuery)
+    );
+    materializedQuery->BindParameters(scalarQuery);
+    Value result = materializedQuery->RunWithScalarResult();
+
+    this->materializedQueryCache->Return(std::move(materializedQuery));
+    return result;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   std::size_t QtSqlConnection::RunUpdateQuery(const Query &updateQuery) {
-    QtSqlMaterializedQuery materializedQuery(this->database, updateQuery);
-    materializedQuery.BindParameters(updateQuery);
-    return materializedQuery.RunWithRowCountResult();
+    std::shared_ptr<QtSqlMaterializedQuery> materializedQuery = (
+      this->materializedQueryCache->Checkout(this->database, updateQuery)
+    );
+    materializedQuery->BindParameters(updateQuery);
+    std::size_t affectedRowCount = materializedQuery->RunWithRowCountResult();
+
+    this->materializedQueryCache->Return(std::move(materializedQuery));
+    return affectedRowCount;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   std::unique_ptr<RowReader> QtSqlConnection::RunRowQuery(const Query &rowQuery) {
-
-    // TODO: Implement query cache
-    //   For testing, this currently naively returns a fresh materialization each time
     std::shared_ptr<QtSqlMaterializedQuery> materializedQuery = (
-      std::make_shared<QtSqlMaterializedQuery>(this->database, rowQuery)
+      this->materializedQueryCache->Checkout(this->database, rowQuery)
     );
     materializedQuery->BindParameters(rowQuery);
 
-    // TODO: Do *not* keep this query in the cache here.
-    //   The QSqlQuery also acts as the enumerator, so the QSqlReader must keep our
-    //   our materialized query exclusively to itself until the enumeraiton is complete.
-    return materializedQuery->RunWithMultiRowResult(materializedQuery);
+    // The QSqlQuery also acts as the enumerator, so the row reader keeps the materialized
+    // query checked out exclusively until it is destroyed and only then returns it.
+    return materializedQuery->RunWithMultiRowResult(
+      materializedQuery, this->materializedQueryCache
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::vector<std::size_t> QtSqlConnection::RunBatch(
+    const Query &batchQuery, ParameterRowSource &parameterRows
+  ) {
+    std::shared_ptr<QtSqlMaterializedQuery> materializedQuery = (
+      this->materializedQueryCache->Checkout(this->database, batchQuery)
+    );
+
+    Query rowQuery(batchQuery);
+    std::vector<std::size_t> affectedRowCounts = materializedQuery->RunBatch(
+      rowQuery, parameterRows
+    );
 
+    this->materializedQueryCache->Return(std::move(materializedQuery));
+    return affectedRowCounts;
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -230,6 +301,130 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
 
   // ------------------------------------------------------------------------------------------- //
 
+  StatementCacheStatistics QtSqlConnection::GetStatementCacheStatistics() const {
+    return this->materializedQueryCache->GetStatistics();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t QtSqlConnection::GetMaximumParameterCount() const {
+
+    // Qt SQL has no way to query the limit, so it is taken from the documentation
+    // of each database. The wire protocols of PostgreSQL and MySQL / MariaDB use 16 bit
+    // parameter counts, Microsoft SQL Server (usually reached via ODBC) allows 2100.
+    QString driverName = this->database.driverName();
+    if((driverName == QStringLiteral("QPSQL")) || (driverName == QStringLiteral("QMYSQL"))) {
+      return 65535;
+    } else if(driverName == QStringLiteral("QODBC")) {
+      return 2100;
+    } else {
+      return Connection::GetMaximumParameterCount();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Dialects::UpsertStyle QtSqlConnection::GetUpsertStyle() const {
+
+    // Qt's MySQL driver also serves MariaDB, everything else that Qt talks to
+    // either uses the ON CONFLICT syntax or has no upsert syntax at all
+    if(this->database.driverName() == QStringLiteral("QMYSQL")) {
+      return Dialects::UpsertStyle::OnDuplicateKeyUpdate;
+    } else {
+      return Connection::GetUpsertStyle();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Dialects::QuoteStyle QtSqlConnection::GetQuoteStyle() const {
+
+    // MySQL and MariaDB only accept double-quoted identifiers in ANSI mode,
+    // which can't be assumed, but backticks work in every mode
+    if(this->database.driverName() == QStringLiteral("QMYSQL")) {
+      return Dialects::QuoteStyle::Backticks;
+    } else {
+      return Connection::GetQuoteStyle();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlConnection::BeginTopLevelTransaction(Transactions::IsolationLevel isolationLevel) {
+    using Transactions::IsolationLevel;
+
+    // SQLite knows no isolation levels, but can take the write lock right away, which
+    // is the closest equivalent to blocking concurrent writes. QSqlDatabase::transaction()
+    // can't do that, so here the transaction is begun by hand.
+    QString driverName = this->database.driverName();
+    if(driverName == QStringLiteral("QSQLITE")) {
+      static const Query deferredBeginQuery(u8"BEGIN");
+      static const Query immediateBeginQuery(u8"BEGIN IMMEDIATE");
+
+      bool blockConcurrentWrites = (
+        (isolationLevel == IsolationLevel::PinnedReads_BlockConcurrentWrites) ||
+        (isolationLevel == IsolationLevel::Isolated_BlockConcurrentWrites)
+      );
+      RunStatement(blockConcurrentWrites ? immediateBeginQuery : deferredBeginQuery);
+      return;
+    }
+
+    // PostgreSQL only accepts the isolation level as the first statement inside
+    // a transaction, all other databases want it before the transaction begins.
+    const char8_t *isolationLevelStatement = getIsolationLevelStatement(isolationLevel);
+    bool isPostgres = (driverName == QStringLiteral("QPSQL"));
+    if((isolationLevelStatement != nullptr) && !isPostgres) {
+      RunStatement(Query(isolationLevelStatement));
+    }
+
+    if(!this->database.transaction()) {
+      throwLastError(u8"Could not begin transaction");
+    }
+
+    if((isolationLevelStatement != nullptr) && isPostgres) {
+      auto rollbackScope = ON_SCOPE_EXIT_TRANSACTION {
+        this->database.rollback();
+      };
+      RunStatement(Query(isolationLevelStatement));
+      rollbackScope.Commit();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlConnection::CommitTopLevelTransaction() {
+    if(this->database.driverName() == QStringLiteral("QSQLITE")) {
+      Connection::CommitTopLevelTransaction();
+    } else if(!this->database.commit()) {
+      throwLastError(u8"Could not commit transaction");
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlConnection::RollbackTopLevelTransaction() {
+    if(this->database.driverName() == QStringLiteral("QSQLITE")) {
+      Connection::RollbackTopLevelTransaction();
+    } else if(!this->database.rollback()) {
+      throwLastError(u8"Could not roll back transaction");
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlConnection::throwLastError(const char8_t *action) {
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+    std::u8string message(action);
+    message.append(u8": ", 2);
+    message.append(QStringConverter::ToU8(this->database.lastError().text()));
+    throw std::runtime_error(
+      std::string(reinterpret_cast<const char *>(message.data()), message.length())
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   void QtSqlConnection::configureQSqlDatabase(
     QSqlDatabase &database,
     const Configuration::ConnectionProperties &properties,
@@ -36,6 +36,10 @@ namespace Nuclex::ThinOrm::Configuration {
   class ConnectionProperties;
 }
 
+namespace Nuclex::ThinOrm::Connections::QtSql {
+  class QtSqlMaterializedQueryCache;
+}
+
 namespace Nuclex::ThinOrm::Connections::QtSql {
 
   // ------------------------------------------------------------------------------------------- //
@@ -43,6 +47,9 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   /// <summary>Database connection using Qt's SQL module</summary>
   class QtSqlConnection : public Connection {
 
+    /// <summary>Number of materialized queries each connection keeps around</summary>
+    public: static const std::size_t DefaultMaterializedQueryCacheCapacity;
+
     /// <summary>Initializes a new QtSql-based database connection</summary>
     /// <param name="databaseName">
     ///   Name of the database, can be user-defined or use the connection target as name
@@ -98,11 +105,64 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     /// <returns>A reader that can be used to fetch individual rows</returns>
     public: std::unique_ptr<RowReader> RunRowQuery(const Query &rowQuery) override;
 
+    /// <summary>Executes an SQL statement once for each row of parameter values</summary>
+    /// <param name="batchQuery">Query that will be executed for each parameter row</param>
+    /// <param name="parameterRows">Provides the parameter values for each execution</param>
+    /// <returns>The number of rows affected by each execution, in order</returns>
+    /// <remarks>
+    ///   Keeps the materialized query checked out for the whole batch. If the Qt driver
+    ///   supports batch operations natively, the rows are sent in chunks via
+    ///   <code>QSqlQuery::execBatch()</code>.
+    /// </remarks>
+    public: std::vector<std::size_t> RunBatch(
+      const Query &batchQuery, ParameterRowSource &parameterRows
+    ) override;
+    using Connection::RunBatch;
+
     /// <summary>Checks if the specified table exists</summary>
     /// <param name="tableName">Table or view whose existence will be checked</param>
     /// <returns>True if a table or view with the given exists</returns>
     public: bool DoesTableOrViewExist(const std::u8string &tableName) override;
 
+    /// <summary>Reports the counters of the materialized query cache</summary>
+    /// <returns>The current counters of the connection's materialized query cache</returns>
+    public: StatementCacheStatistics GetStatementCacheStatistics() const override;
+
+    /// <summary>Reports how many parameters a single statement may contain at most</summary>
+    /// <returns>The parameter limit of the database behind the Qt SQL driver</returns>
+    public: std::size_t GetMaximumParameterCount() const override;
+
+    /// <summary>Reports the syntax the database uses for inserts that update on conflict</summary>
+    /// <returns>The upsert syntax understood by the database</returns>
+    public: Dialects::UpsertStyle GetUpsertStyle() const override;
+
+    /// <summary>Reports the quotes the database expects around table and column names</summary>
+    /// <returns>The identifier quote style understood by the database</returns>
+    public: Dialects::QuoteStyle GetQuoteStyle() const override;
+
+    /// <summary>Begins a transaction at the outermost level</summary>
+    /// <param name="isolationLevel">Isolation level the transaction should use</param>
+    /// <remarks>
+    ///   Uses <code>QSqlDatabase::transaction()</code> so the Qt driver is aware of
+    ///   the transaction. Isolation levels are applied via the standard
+    ///   <code>SET TRANSACTION ISOLATION LEVEL</code> statement. For SQLite, which has
+    ///   no such statement, <code>BEGIN IMMEDIATE</code> is issued instead if
+    ///   concurrent writes should be blocked.
+    /// </remarks>
+    protected: void BeginTopLevelTransaction(
+      Transactions::IsolationLevel isolationLevel
+    ) override;
+
+    /// <summary>Commits the outermost transaction</summary>
+    protected: void CommitTopLevelTransaction() override;
+
+    /// <summary>Rolls back the outermost transaction</summary>
+    protected: void RollbackTopLevelTransaction() override;
+
+    /// <summary>Throws an exception describing the last error that occurred</summary>
+    /// <param name="action">Action that failed, will be used in the error message</param>
+    private: [[noreturn]] void throwLastError(const char8_t *action);
+
     /// <summary>Applies the connection properties to the Qt database</summary>
     /// <param name="database">Qt database instance that will be configured</param>
     /// <param name="properties">Connection properties that will be applied</param>
@@ -127,6 +187,12 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     private: QSqlDatabase database;
     /// <summary>Unique connection name the connection is registered under to Qt</summary>
     private: QString uniqueConnectionName;
+    /// <summary>Recently used queries that have already been prepared</summary>
+    /// <remarks>
+    ///   Declared after the database so that all cached QSqlQuery instances are destroyed
+    ///   before the database they belong to.
+    /// </remarks>
+    private: std::shared_ptr<QtSqlMaterializedQueryCache> materializedQueryCache;
 
   };
 
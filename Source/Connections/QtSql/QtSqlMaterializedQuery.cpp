@@ -29,6 +29,7 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Errors/BadSqlStatementError.h" // for BadSqlStatementError
 #include "Nuclex/ThinOrm/Value.h" // for Value
+#include "Nuclex/ThinOrm/ParameterRowSource.h" // for ParameterRowSource
 #include "./QtSqlRowReader.h" // for QtSqlRowReader
 
 #include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append<>()
@@ -36,6 +37,7 @@ limitations under the License.
 
 #include <QSqlQuery> // for QSqlQuery
 #include <QSqlError> // for QSqlError
+#include <QSqlDriver> // for QSqlDriver
 #include <QSqlRecord> // for QSqlRecord
 #include <QSqlField> // for QSqlField
 #include <QDate> // for QDate
@@ -48,6 +50,15 @@ namespace {
 
   // ------------------------------------------------------------------------------------------- //
 
+  /// <summary>Maximum number of parameter rows sent to the driver in one batch</summary>
+  /// <remarks>
+  ///   Limits the memory taken by the collected QVariantLists when a huge number of rows
+  ///   is fed into a batch. Beyond a few hundred rows, the per-batch overhead is negligible.
+  /// </remarks>
+  const std::size_t maximumBatchChunkRowCount = 1024;
+
+  // ------------------------------------------------------------------------------------------- //
+
   /// <summary>Throws an exception if a query has not returned exactly one result</summary>
   /// <param name="record">Record that reports the number of result columns</param>
   /// <param name="qtSqlStatement">
@@ -89,6 +100,7 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     QSqlDatabase &database, const Query &query
   ) :
     qtSqlStatement(transformSqlStatement(query.GetSqlStatement(), query.GetParameterInfo())),
+    sqlStatementId(query.GetSqlStatementId()),
     qtQuery(database) {
     prepareSqlStatement();
   }
@@ -99,6 +111,7 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     QSqlDatabase &database, const QtSqlMaterializedQuery &other
   ) :
     qtSqlStatement(other.qtSqlStatement),
+    sqlStatementId(other.sqlStatementId),
     qtQuery(database) {
     prepareSqlStatement();
   }
@@ -196,11 +209,79 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
 
   // ------------------------------------------------------------------------------------------- //
 
+  std::vector<std::size_t> QtSqlMaterializedQuery::RunBatch(
+    Query &rowQuery, ParameterRowSource &parameterRows
+  ) {
+    using Nuclex::ThinOrm::Utilities::QVariantConverter;
+
+    std::vector<std::size_t> affectedRowCounts;
+
+    // Without native support, QSqlQuery::execBatch() would run the query for each row
+    // and lose the individual row counts, so in that case, just run it row by row.
+    const QSqlDriver *driver = this->qtQuery.driver();
+    bool supportsBatches = (
+      (driver != nullptr) && driver->hasFeature(QSqlDriver::DriverFeature::BatchOperations)
+    );
+    if(!supportsBatches) {
+      while(parameterRows.AssignNextRow(rowQuery)) {
+        BindParameters(rowQuery);
+        affectedRowCounts.push_back(RunWithRowCountResult());
+      }
+
+      return affectedRowCounts;
+    }
+
+    // Collect the parameter rows column-wise, which is what QSqlQuery::execBatch() expects
+    std::size_t parameterCount = rowQuery.CountParameters();
+    std::vector<QVariantList> parameterColumns(parameterCount);
+    for(;;) {
+      std::size_t rowCount = 0;
+      while(rowCount < maximumBatchChunkRowCount) {
+        if(!parameterRows.AssignNextRow(rowQuery)) {
+          break;
+        }
+        for(std::size_t index = 0; index < parameterCount; ++index) {
+          parameterColumns[index].append(
+            QVariantConverter::QVariantFromValue(rowQuery.GetParameterValue(index))
+          );
+        }
+        ++rowCount;
+      }
+      if(rowCount == 0) {
+        return affectedRowCounts;
+      }
+
+      for(std::size_t index = 0; index < parameterCount; ++index) {
+        this->qtQuery.bindValue(index, QVariant(parameterColumns[index]));
+        parameterColumns[index].clear();
+      }
+
+      executeQueryBatch();
+      {
+        ON_SCOPE_EXIT { this->qtQuery.finish(); };
+
+        // Drivers only report a total for the batch, it is credited to its last row
+        int batchAffectedRowCount = this->qtQuery.numRowsAffected();
+        affectedRowCounts.resize(affectedRowCounts.size() + rowCount, 0);
+        if(batchAffectedRowCount > 0) {
+          affectedRowCounts.back() = static_cast<std::size_t>(batchAffectedRowCount);
+        }
+      }
+
+      if(rowCount < maximumBatchChunkRowCount) {
+        return affectedRowCounts;
+      }
+    } // for each chunk
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   std::unique_ptr<RowReader> QtSqlMaterializedQuery::RunWithMultiRowResult(
-    const std::shared_ptr<QtSqlMaterializedQuery> &self
+    const std::shared_ptr<QtSqlMaterializedQuery> &self,
+    const std::weak_ptr<QtSqlMaterializedQueryCache> &cache
   ) {
     executeQuery();
-    return std::make_unique<QtSqlRowReader>(self);
+    return std::make_unique<QtSqlRowReader>(self, cache);
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -267,24 +348,39 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   // ------------------------------------------------------------------------------------------- //
 
   void QtSqlMaterializedQuery::executeQuery() {
-    using Nuclex::ThinOrm::Utilities::QStringConverter;
-
     bool successfullyExecuted = this->qtQuery.exec();
     if(!successfullyExecuted) [[unlikely]] {
-      std::u8string message(u8"Error executing SQL statement:\n", 31);
-      message.append(QStringConverter::ToU8(this->qtSqlStatement));
-      message.append(u8"\nReason provided by Qt SQL:\n", 28);
+      throwExecutionError();
+    }
+  }
 
-      QSqlError lastError = this->qtQuery.lastError();
-      if(lastError.type() == QSqlError::ErrorType::NoError) [[unlikely]] {
-        message.append(u8"unknown QtSql error ", 20);
-        message.append(u8"(.prepare() returned false, yet .lastError() was 'NoError')", 59);
-      } else {
-        message.append(QStringConverter::ToU8(lastError.text()));
-      }
+  // ------------------------------------------------------------------------------------------- //
 
-      throw Errors::BadSqlStatementError(message);
-    } // if query failed
+  void QtSqlMaterializedQuery::executeQueryBatch() {
+    bool successfullyExecuted = this->qtQuery.execBatch();
+    if(!successfullyExecuted) [[unlikely]] {
+      throwExecutionError();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlMaterializedQuery::throwExecutionError() {
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+    std::u8string message(u8"Error executing SQL statement:\n", 31);
+    message.append(QStringConverter::ToU8(this->qtSqlStatement));
+    message.append(u8"\nReason provided by Qt SQL:\n", 28);
+
+    QSqlError lastError = this->qtQuery.lastError();
+    if(lastError.type() == QSqlError::ErrorType::NoError) [[unlikely]] {
+      message.append(u8"unknown QtSql error ", 20);
+      message.append(u8"(.exec() returned false, yet .lastError() was 'NoError')", 56);
+    } else {
+      message.append(QStringConverter::ToU8(lastError.text()));
+    }
+
+    throw Errors::BadSqlStatementError(message);
   }
 
   // ------------------------------------------------------------------------------------------- //
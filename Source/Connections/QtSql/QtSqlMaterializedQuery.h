@@ -32,14 +32,17 @@ limitations under the License.
 #include <QString> // for QString
 
 #include <memory> // for std::unique_ptr
+#include <vector> // for std::vector<>
 
 namespace Nuclex::ThinOrm {
   class RowReader;
+  class ParameterRowSource;
   enum class ValueType;
 }
 
 namespace Nuclex::ThinOrm::Connections::QtSql {
   class QtSqlRowReader;
+  class QtSqlMaterializedQueryCache;
 }
 
 namespace Nuclex::ThinOrm::Connections::QtSql {
@@ -61,6 +64,10 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     /// <summary>Destroys the materialized query and frees all resources</summary>
     public: ~QtSqlMaterializedQuery();
 
+    /// <summary>Retrieves the id of the SQL statement that was materialized</summary>
+    /// <returns>The statement id of the query the materialization was built from</returns>
+    public: inline std::size_t GetSqlStatementId() const;
+
     /// <summary>Binds the parameter values from the specified query</summary>
     /// <param name="query">Query whose parameter values will be bound</param>
     /// <remarks>
@@ -85,16 +92,37 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     /// </remarks>
     public: std::size_t RunWithRowCountResult();
 
+    /// <summary>Executes the query once for each row of parameter values</summary>
+    /// <param name="rowQuery">
+    ///   Query into which the parameter values of each row are assigned
+    /// </param>
+    /// <param name="parameterRows">Provides the parameter values for each execution</param>
+    /// <returns>The number of rows affected by each execution, in order</returns>
+    /// <remarks>
+    ///   If the Qt SQL driver can execute batches natively, the parameter rows are
+    ///   collected into one <code>QVariantList</code> per parameter and sent in chunks
+    ///   via <see cref="QSqlQuery.execBatch()" />. Otherwise, Qt would emulate the batch
+    ///   by executing the query for each row anyway, so that is done directly in order
+    ///   to keep the affected row count of each row.
+    /// </remarks>
+    public: std::vector<std::size_t> RunBatch(
+      Query &rowQuery, ParameterRowSource &parameterRows
+    );
+
     /// <summary>Executes the query, assuming it returns zero or more result rows</summary>
     /// <param name="self">
     ///   Essentially the this pointer, provided by the connection rather than through
     ///   <code>std::shared_from_this&lt;&gt;</code> in order for
     ///   the <see cref="RowReader" /> to take temporary ownership of the materialized query.
     /// </param>
+    /// <param name="cache">
+    ///   Cache the materialized query will be returned to once the row reader is done
+    ///   with it. If the cache no longer exists by then, the query is simply destroyed.
+    /// </param>
     /// <returns>A row reader which acts as an enumerator and row metadata provider</returns>
     public: std::unique_ptr<RowReader> RunWithMultiRowResult(
-      // TODO: This will also needs a materialized query cache return callback
-      const std::shared_ptr<QtSqlMaterializedQuery> &self
+      const std::shared_ptr<QtSqlMaterializedQuery> &self,
+      const std::weak_ptr<QtSqlMaterializedQueryCache> &cache
     );
 
     /// <summary>Accesses the Qt SQL query managed by the materialized query wrapper</summary>
@@ -128,10 +156,21 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     /// </remarks>
     private: void executeQuery();
 
+    /// <summary>Executes the SQL statement in batch mode via Qt's QSqlQuery</summary>
+    /// <remarks>
+    ///   Like <see cref="executeQuery" />, but wrapping <see cref="QSqlQuery.execBatch()" />.
+    /// </remarks>
+    private: void executeQueryBatch();
+
+    /// <summary>Throws an exception describing why the SQL statement failed to run</summary>
+    private: [[noreturn]] void throwExecutionError();
+
     /// <summary>
     ///   The SQL statement as it has been passed to the <see cref="QSqlQuery" />
     /// </summary>
     private: QString qtSqlStatement;
+    /// <summary>Unique id of the SQL statement the materialization was built from</summary>
+    private: std::size_t sqlStatementId;
     /// <summary>Prepared Qt SQL query awaiting execution</summary>
     private: QSqlQuery qtQuery;
 
@@ -139,6 +178,12 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
 
   // ------------------------------------------------------------------------------------------- //
 
+  inline std::size_t QtSqlMaterializedQuery::GetSqlStatementId() const {
+    return this->sqlStatementId;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   inline QSqlQuery &QtSqlMaterializedQuery::GetQtQuery() {
     return this->qtQuery;
   }
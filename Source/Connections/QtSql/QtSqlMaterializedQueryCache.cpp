@@ -0,0 +1,54 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./QtSqlMaterializedQueryCache.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_QT)
+
+#include "./QtSqlMaterializedQuery.h" // for QtSqlMaterializedQuery
+
+namespace Nuclex::ThinOrm::Connections::QtSql {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  QtSqlMaterializedQueryCache::QtSqlMaterializedQueryCache(std::size_t capacity) :
+    StatementCache<QtSqlMaterializedQuery>(capacity) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::shared_ptr<QtSqlMaterializedQuery> QtSqlMaterializedQueryCache::Checkout(
+    QSqlDatabase &database, const Query &query
+  ) {
+    // The cache invokes this outside of its lock only if the query was not cached,
+    // so the round trip to the database will not block row readers returning theirs
+    return StatementCache<QtSqlMaterializedQuery>::Checkout(
+      query, [&database, &query]() {
+        return std::make_shared<QtSqlMaterializedQuery>(database, query);
+      }
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::QtSql
+
+#endif // defined(NUCLEX_THINORM_ENABLE_QT)
@@ -0,0 +1,83 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_QTSQL_QTSQLMATERIALIZEDQUERYCACHE_H
+#define NUCLEX_THINORM_CONNECTIONS_QTSQL_QTSQLMATERIALIZEDQUERYCACHE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_QT)
+
+#include "../StatementCache.h" // for StatementCache
+
+#include <QSqlDatabase> // for QSqlDatabase
+
+#include <memory> // for std::shared_ptr<>
+
+namespace Nuclex::ThinOrm::Connections::QtSql {
+  class QtSqlMaterializedQuery;
+}
+
+namespace Nuclex::ThinOrm::Connections::QtSql {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Keeps the most recently used materialized queries of a connection</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Materializing a query means translating its SQL statement into the format Qt
+  ///     expects and letting the database prepare it, which is quite a bit of work to
+  ///     repeat for every execution of the same query. This cache retains a bounded number
+  ///     of materialized queries, keyed by the statement id of the query they were built
+  ///     from, and evicts the least recently used one when it grows beyond its capacity.
+  ///   </para>
+  ///   <para>
+  ///     Because a QSqlQuery doubles as the enumerator for its result rows, materialized
+  ///     queries are checked out of the cache while in use and returned afterwards. A row
+  ///     reader thus holds its materialized query exclusively until it is destroyed and
+  ///     another execution of the same query in the meantime will materialize a second
+  ///     instance (only one of which will be retained when both are returned).
+  ///   </para>
+  /// </remarks>
+  class QtSqlMaterializedQueryCache : public StatementCache<QtSqlMaterializedQuery> {
+
+    /// <summary>Initializes a new materialized query cache</summary>
+    /// <param name="capacity">Maximum number of materialized queries to retain</param>
+    public: QtSqlMaterializedQueryCache(std::size_t capacity);
+
+    /// <summary>Takes a materialized query out of the cache or materializes it</summary>
+    /// <param name="database">Qt database the query will be materialized for if needed</param>
+    /// <param name="query">Query for which a materialized query will be provided</param>
+    /// <returns>
+    ///   A materialized query for the specified query that is exclusively owned by
+    ///   the caller until it is handed back via <see cref="Return" />
+    /// </returns>
+    public: std::shared_ptr<QtSqlMaterializedQuery> Checkout(
+      QSqlDatabase &database, const Query &query
+    );
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::QtSql
+
+#endif // defined(NUCLEX_THINORM_ENABLE_QT)
+
+#endif // NUCLEX_THINORM_CONNECTIONS_QTSQL_QTSQLMATERIALIZEDQUERYCACHE_H
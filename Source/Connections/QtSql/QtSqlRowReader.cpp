@@ -25,6 +25,7 @@ limitations under the License.
 #if defined(NUCLEX_THINORM_ENABLE_QT)
 
 #include "./QtSqlMaterializedQuery.h" // for QtSqlMaterializedQuery
+#include "./QtSqlMaterializedQueryCache.h" // for QtSqlMaterializedQueryCache
 
 #include "../../Utilities/QStringConverter.h"
 #include "../../Utilities/QVariantConverter.h"
@@ -34,7 +35,11 @@ limitations under the License.
 #include <QSqlError> // for QSqlError
 #include <QSqlField> // for QSqlField
 
-#include <stdexcept> // for std::runtime_error
+#include <stdexcept> // for std::runtime_error, std::out_of_range
+#include <string> // for std::string
+#include <utility> // for std::pair
+#include <span> // for std::span
+#include <cstddef> // for std::byte
 
 namespace {
 
@@ -48,10 +53,17 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   // ------------------------------------------------------------------------------------------- //
 
   QtSqlRowReader::QtSqlRowReader(
-    const std::shared_ptr<QtSqlMaterializedQuery> &materializedQuery
+    const std::shared_ptr<QtSqlMaterializedQuery> &materializedQuery,
+    const std::weak_ptr<QtSqlMaterializedQueryCache> &cache
   ) :
     materializedQuery(materializedQuery),
-    isFinished(false) {}
+    cache(cache),
+    isFinished(false),
+    columnNames(),
+    columnTypes(),
+    columnIndices() {
+    snapshotSchema();
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -59,7 +71,14 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     if(!this->isFinished) {
       this->materializedQuery->GetQtQuery().finish();
     }
-    // TODO: Return ownership of the QtSqlMaterializedQuery to the connection
+
+    // Hand the materialized query back to the connection's cache so the next execution
+    // of the same query can skip the preparation step. If the connection has already
+    // been destroyed, the materialized query will simply die with the row reader.
+    std::shared_ptr<QtSqlMaterializedQueryCache> owningCache = this->cache.lock();
+    if(owningCache) [[likely]] {
+      owningCache->Return(std::move(this->materializedQuery));
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -87,27 +106,32 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   // ------------------------------------------------------------------------------------------- //
 
   std::size_t QtSqlRowReader::CountColumns() const {
-    return static_cast<std::size_t>(
-      this->materializedQuery->GetQtQuery().record().count()
-    );
+    return this->columnNames.size();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::optional<std::size_t> QtSqlRowReader::GetRowCountHint() const {
+
+    // Qt reports -1 if the driver doesn't know the size of the result set
+    int rowCount = this->materializedQuery->GetQtQuery().size();
+    if(rowCount < 0) {
+      return std::optional<std::size_t>();
+    } else {
+      return static_cast<std::size_t>(rowCount);
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   const std::u8string QtSqlRowReader::GetColumnName(std::size_t columnIndex) const {
-    return Utilities::QStringConverter::ToU8(
-      this->materializedQuery->GetQtQuery().record().fieldName(columnIndex)
-    );
+    return this->columnNames.at(columnIndex);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   ValueType QtSqlRowReader::GetColumnType(std::size_t columnIndex) const {
-    using Nuclex::ThinOrm::Utilities::QVariantConverter;
-
-    const QSqlRecord &record = this->materializedQuery->GetQtQuery().record();
-    QVariant::Type fieldType = record.field(static_cast<int>(columnIndex)).type();
-    return QVariantConverter::ValueTypeFromType(fieldType);
+    return this->columnTypes.at(columnIndex);
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -124,14 +148,209 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   Value QtSqlRowReader::GetColumnValue(const std::u8string &columnName) const {
     using Nuclex::ThinOrm::Utilities::QVariantConverter;
 
-    QVariant value = this->materializedQuery->GetQtQuery().value(
-      Utilities::QStringConverter::FromU8(columnName)
-    );
+    QVariant value = this->materializedQuery->GetQtQuery().value(getColumnIndex(columnName));
     return QVariantConverter::ValueFromQVariant(value);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
+  bool QtSqlRowReader::TryReadColumnInt64(
+    std::size_t columnIndex, std::int64_t &target
+  ) const {
+    QVariant value = this->materializedQuery->GetQtQuery().value(static_cast<int>(columnIndex));
+    if(value.isNull()) {
+      return false;
+    }
+
+    target = static_cast<std::int64_t>(value.toLongLong());
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool QtSqlRowReader::TryReadColumnDouble(std::size_t columnIndex, double &target) const {
+    QVariant value = this->materializedQuery->GetQtQuery().value(static_cast<int>(columnIndex));
+    if(value.isNull()) {
+      return false;
+    }
+
+    target = value.toDouble();
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool QtSqlRowReader::TryReadColumnString(
+    std::size_t columnIndex, std::u8string &target
+  ) const {
+    QVariant value = this->materializedQuery->GetQtQuery().value(static_cast<int>(columnIndex));
+    if(value.isNull()) {
+      return false;
+    }
+
+    // Qt stores strings as UTF-16, so this needs a conversion either way, but at least
+    // it skips the detour through a Value
+    const QByteArray utf8Bytes = value.toString().toUtf8();
+    target.assign(
+      reinterpret_cast<const char8_t *>(utf8Bytes.constData()),
+      static_cast<std::size_t>(utf8Bytes.size())
+    );
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool QtSqlRowReader::TryReadColumnBlob(
+    std::size_t columnIndex, std::vector<std::byte> &target
+  ) const {
+    QVariant value = this->materializedQuery->GetQtQuery().value(static_cast<int>(columnIndex));
+    if(value.isNull()) {
+      return false;
+    }
+
+    const QByteArray bytes = value.toByteArray();
+    const std::byte *data = reinterpret_cast<const std::byte *>(bytes.constData());
+    target.assign(data, data + bytes.size());
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t QtSqlRowReader::FetchBatch(RowBatch &batch, std::size_t maximumRowCount) {
+    if((maximumRowCount == 0) || this->isFinished || !MoveToNext()) {
+      batch.Reset(0);
+      return 0;
+    }
+
+    std::size_t columnCount = this->columnNames.size();
+    batch.Reset(columnCount);
+    for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+      batch.GetColumn(columnIndex).Reset(
+        this->columnTypes[columnIndex], this->columnNames[columnIndex]
+      );
+    }
+
+    std::size_t rowCount = 0;
+    for(;;) {
+      appendCurrentRow(batch);
+
+      ++rowCount;
+      if(rowCount >= maximumRowCount) {
+        return rowCount;
+      }
+      if(!MoveToNext()) [[unlikely]] {
+        return rowCount;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlRowReader::appendCurrentRow(RowBatch &batch) const {
+    using Nuclex::ThinOrm::Utilities::QVariantConverter;
+
+    QSqlQuery &query = this->materializedQuery->GetQtQuery();
+
+    std::size_t columnCount = batch.CountColumns();
+    for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+      RowBatchColumn &column = batch.GetColumn(columnIndex);
+
+      QVariant value = query.value(static_cast<int>(columnIndex));
+      if(value.isNull()) {
+        column.AppendNull();
+        continue;
+      }
+
+      // Pull the primitive types straight out of the QVariant. Only the types that
+      // need parsing or special treatment go through the QVariantConverter.
+      switch(column.GetType()) {
+        case ValueType::Boolean: { column.AppendBoolean(value.toBool()); break; }
+        case ValueType::UInt8:
+        case ValueType::Int16:
+        case ValueType::Int32:
+        case ValueType::Int64: {
+          column.AppendInteger(static_cast<std::int64_t>(value.toLongLong()));
+          break;
+        }
+        case ValueType::Float:
+        case ValueType::Double: { column.AppendFloatingPoint(value.toDouble()); break; }
+        case ValueType::String: {
+          column.AppendString(Utilities::QStringConverter::ToU8(value.toString()));
+          break;
+        }
+        case ValueType::Blob: {
+          const QByteArray bytes = value.toByteArray();
+          column.AppendBlob(
+            std::span<const std::byte>(
+              reinterpret_cast<const std::byte *>(bytes.constData()),
+              static_cast<std::size_t>(bytes.size())
+            )
+          );
+          break;
+        }
+        default: {
+          column.AppendValue(QVariantConverter::ValueFromQVariant(value));
+          break;
+        }
+      } // switch on column type
+    } // for each column
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void QtSqlRowReader::snapshotSchema() {
+    using Nuclex::ThinOrm::Utilities::QVariantConverter;
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+    // Only a single QSqlRecord is built here. After this, all metadata is served from
+    // the snapshot, which also keeps it available after the query has been finished.
+    const QSqlRecord record = this->materializedQuery->GetQtQuery().record();
+
+    std::size_t columnCount = static_cast<std::size_t>(record.count());
+    this->columnNames.reserve(columnCount);
+    this->columnTypes.reserve(columnCount);
+    this->columnIndices.reserve(columnCount);
+
+    for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+      const QSqlField field = record.field(static_cast<int>(columnIndex));
+      this->columnNames.push_back(QStringConverter::ToU8(field.name()));
+      this->columnTypes.push_back(QVariantConverter::ValueTypeFromType(field.type()));
+
+      std::pair<ColumnIndexMap::iterator, bool> result = this->columnIndices.emplace(
+        this->columnNames.back(), columnIndex
+      );
+      if(!result.second) { // Name appeared before, make lookups by this name fail
+        result.first->second = std::size_t(-1);
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  int QtSqlRowReader::getColumnIndex(const std::u8string &columnName) const {
+    ColumnIndexMap::const_iterator iterator = this->columnIndices.find(columnName);
+    if(iterator == this->columnIndices.end()) [[unlikely]] {
+      std::u8string message(u8"No such column in query result: '", 33);
+      message.append(columnName);
+      message.push_back(u8'\'');
+      throw std::out_of_range(
+        std::string(reinterpret_cast<const char *>(message.data()), message.length())
+      );
+    }
+    if(iterator->second == std::size_t(-1)) [[unlikely]] {
+      std::u8string message(u8"Column name is ambiguous in query result: '", 43);
+      message.append(columnName);
+      message.push_back(u8'\'');
+      throw std::out_of_range(
+        std::string(reinterpret_cast<const char *>(message.data()), message.length())
+      );
+    }
+
+    return static_cast<int>(iterator->second);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm::Connections::QtSql
 
 #endif // defined(NUCLEX_THINORM_ENABLE_QT)
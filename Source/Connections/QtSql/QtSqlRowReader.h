@@ -26,10 +26,16 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/RowReader.h" // for RowReader
 
+#include <Nuclex/Support/Text/StringMatcher.h> // for CaseInsensitiveUtf8Hash
+
 #include <memory> // for std::shared_ptr<>
+#include <string> // for std::u8string
+#include <vector> // for std::vector
+#include <unordered_map> // for std::unordered_map
 
 namespace Nuclex::ThinOrm::Connections::QtSql {
   class QtSqlMaterializedQuery;
+  class QtSqlMaterializedQueryCache;
 }
 
 namespace Nuclex::ThinOrm::Connections::QtSql {
@@ -37,6 +43,12 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
   // ------------------------------------------------------------------------------------------- //
 
   /// <summary>Reads rows from a query that results in multiple rows</summary>
+  /// <remarks>
+  ///   The column names and types are captured once when the row reader is created.
+  ///   Asking the QSqlQuery for its record would construct a new QSqlRecord each time
+  ///   and looking up columns by name via Qt would convert the name to UTF-16 and do
+  ///   a linear search through the fields, both of which add up when done per row.
+  /// </remarks>
   class QtSqlRowReader : public RowReader {
 
     /// <summary>Initializes a new row reader based on a Qt SQL query</summary>
@@ -44,7 +56,13 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     ///   Query the row reader will take temporary ownership of to prevent sharing of
     ///   its QSqlQuery whilst rows are still being enumerated
     /// </param>
-    public: QtSqlRowReader(const std::shared_ptr<QtSqlMaterializedQuery> &materializedQuery);
+    /// <param name="cache">
+    ///   Cache the materialized query will be returned to when the row reader is destroyed
+    /// </param>
+    public: QtSqlRowReader(
+      const std::shared_ptr<QtSqlMaterializedQuery> &materializedQuery,
+      const std::weak_ptr<QtSqlMaterializedQueryCache> &cache
+    );
 
     /// <summary>Frees all resources owned by the reader and closes the query</summary>
     public: ~QtSqlRowReader() override;
@@ -57,6 +75,10 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     /// <returns>The number of columns in the result</returns>
     public: std::size_t CountColumns() const override;
 
+    /// <summary>Reports the total number of rows in the result if it is known</summary>
+    /// <returns>The number of rows in the result or nothing if it isn't known</returns>
+    public: std::optional<std::size_t> GetRowCountHint() const override;
+
     /// <summary>Retrieves the name of the specified column</summary>
     /// <param name="columnIndex">Index of the column whose name will be returned</param>
     /// <returns>The name of the column with the specified index</returns>
@@ -77,15 +99,77 @@ namespace Nuclex::ThinOrm::Connections::QtSql {
     /// <returns>The value of the specified column in the current row</returns>
     public: Value GetColumnValue(const std::u8string &columnName) const override;
 
-    //private: struct ParameterInfo {
-    //  public: std::u8string Name;
-    //  public: ValueType Type;
-    //};
+    /// <summary>Reads an integer from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnInt64(
+      std::size_t columnIndex, std::int64_t &target
+    ) const override;
+
+    /// <summary>Reads a floating point value from the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnDouble(std::size_t columnIndex, double &target) const override;
+
+    /// <summary>Reads a string from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnString(
+      std::size_t columnIndex, std::u8string &target
+    ) const override;
+
+    /// <summary>Reads a binary blob from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnBlob(
+      std::size_t columnIndex, std::vector<std::byte> &target
+    ) const override;
+
+    /// <summary>Fetches multiple rows at once into a columnar buffer</summary>
+    /// <param name="batch">Row batch that will receive the rows</param>
+    /// <param name="maximumRowCount">Maximum number of rows that will be fetched</param>
+    /// <returns>The number of rows that were fetched</returns>
+    public: std::size_t FetchBatch(RowBatch &batch, std::size_t maximumRowCount) override;
+
+    /// <summary>Appends the values in the query's current row to a row batch</summary>
+    /// <param name="batch">Row batch the values will be appended to</param>
+    private: void appendCurrentRow(RowBatch &batch) const;
+
+    /// <summary>Captures the names and types of the result columns</summary>
+    private: void snapshotSchema();
+
+    /// <summary>Looks up the index of the column with the specified name</summary>
+    /// <param name="columnName">Name of the column whose index will be looked up</param>
+    /// <returns>The index of the column with the specified name</returns>
+    private: int getColumnIndex(const std::u8string &columnName) const;
+
+    /// <summary>Map of column indices by case-insensitive column name</summary>
+    private: typedef std::unordered_map<
+      std::u8string, std::size_t,
+      Nuclex::Support::Text::CaseInsensitiveUtf8Hash,
+      Nuclex::Support::Text::CaseInsensitiveUtf8EqualTo
+    > ColumnIndexMap;
 
     /// <summary>Materialized query the row reader has temporary ownership of</summary>
     private: std::shared_ptr<QtSqlMaterializedQuery> materializedQuery;
+    /// <summary>Cache to which the materialized query will be returned</summary>
+    private: std::weak_ptr<QtSqlMaterializedQueryCache> cache;
     /// <summary>Whether the query has been finalized yet</summary>
     private: bool isFinished;
+    /// <summary>Names of the result columns in UTF-8</summary>
+    private: std::vector<std::u8string> columnNames;
+    /// <summary>Types of the result columns</summary>
+    private: std::vector<ValueType> columnTypes;
+    /// <summary>Indices of the result columns by name</summary>
+    /// <remarks>
+    ///   Names that appear more than once in the result are stored with the index
+    ///   <code>std::size_t(-1)</code> so that looking them up can report the ambiguity.
+    /// </remarks>
+    private: ColumnIndexMap columnIndices;
 
   };
 
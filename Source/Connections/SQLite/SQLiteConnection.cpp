@@ -24,73 +24,190 @@ limitations under the License.
 
 #if defined(NUCLEX_THINORM_ENABLE_SQLITE)
 
-#include "Nuclex/ThinOrm/Configuration/ConnectionProperties.h" // for ConnectionProperties
+#include "Nuclex/ThinOrm/Query.h" // for Query
 #include "Nuclex/ThinOrm/Value.h" // for Value
 #include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+#include "Nuclex/ThinOrm/ParameterRowSource.h" // for ParameterRowSource
 
-#include <stdexcept> // for std::runtime_error
+#include "./SQLitePreparedStatement.h" // for SQLitePreparedStatement
+#include "./SQLitePreparedStatementCache.h" // for SQLitePreparedStatementCache
 
 namespace {
 
   // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>SQL statement used to check whether a table or view exists</summary>
+  const std::u8string_view tableOrViewExistsSqlStatement(
+    u8"SELECT COUNT(*) FROM sqlite_master "
+    u8"WHERE type IN ('table', 'view') AND name = {tableName}"
+  );
+
   // ------------------------------------------------------------------------------------------- //
-  
+
 } // anonymous namespace
 
 namespace Nuclex::ThinOrm::Connections::SQLite {
 
   // ------------------------------------------------------------------------------------------- //
 
-  SQLiteConnection::SQLiteConnection(const std::filesystem::path &databasePath) :
-    databasePath(databasePath) {}
+  const std::size_t SQLiteConnection::DefaultPreparedStatementCacheCapacity = 64;
 
   // ------------------------------------------------------------------------------------------- //
 
-  SQLiteConnection::~SQLiteConnection() {
-  }
+  SQLiteConnection::SQLiteConnection(const std::shared_ptr<::sqlite3> &database) :
+    database(database),
+    preparedStatementCache(
+      std::make_shared<SQLitePreparedStatementCache>(DefaultPreparedStatementCacheCapacity)
+    ) {}
 
   // ------------------------------------------------------------------------------------------- //
 
-  std::shared_ptr<SQLiteConnection> SQLiteConnection::Connect(
-    const std::filesystem::path& databasePath
-  ) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+  SQLiteConnection::~SQLiteConnection() {
+    this->preparedStatementCache->Clear();
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   void SQLiteConnection::Prepare(const Query &query) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    std::shared_ptr<SQLitePreparedStatement> preparedStatement = (
+      this->preparedStatementCache->Checkout(this->database, query)
+    );
+    this->preparedStatementCache->Return(std::move(preparedStatement));
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   void SQLiteConnection::RunStatement(const Query &statement) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    std::shared_ptr<SQLitePreparedStatement> preparedStatement = (
+      this->preparedStatementCache->Checkout(this->database, statement)
+    );
+    preparedStatement->BindParameters(statement);
+    preparedStatement->RunWithoutResult();
+
+    this->preparedStatementCache->Return(std::move(preparedStatement));
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   Value SQLiteConnection::RunScalarQuery(const Query &scalarQuery) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    std::shared_ptr<SQLitePreparedStatement> preparedStatement = (
+      this->preparedStatementCache->Checkout(this->database, scalarQuery)
+    );
+    preparedStatement->BindParameters(scalarQuery);
+    Value result = preparedStatement->RunWithScalarResult();
+
+    this->preparedStatementCache->Return(std::move(preparedStatement));
+    return result;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   std::size_t SQLiteConnection::RunUpdateQuery(const Query &updateQuery) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    std::shared_ptr<SQLitePreparedStatement> preparedStatement = (
+      this->preparedStatementCache->Checkout(this->database, updateQuery)
+    );
+    preparedStatement->BindParameters(updateQuery);
+    std::size_t affectedRowCount = preparedStatement->RunWithRowCountResult();
+
+    this->preparedStatementCache->Return(std::move(preparedStatement));
+    return affectedRowCount;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   std::unique_ptr<RowReader> SQLiteConnection::RunRowQuery(const Query &rowQuery) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    std::shared_ptr<SQLitePreparedStatement> preparedStatement = (
+      this->preparedStatementCache->Checkout(this->database, rowQuery)
+    );
+    preparedStatement->BindParameters(rowQuery);
+
+    // The statement's current row is what the row reader reads from, so the row reader
+    // keeps the statement checked out exclusively until it is destroyed.
+    return preparedStatement->RunWithMultiRowResult(
+      preparedStatement, this->preparedStatementCache
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::vector<std::size_t> SQLiteConnection::RunBatch(
+    const Query &batchQuery, ParameterRowSource &parameterRows
+  ) {
+    std::shared_ptr<SQLitePreparedStatement> preparedStatement = (
+      this->preparedStatementCache->Checkout(this->database, batchQuery)
+    );
+
+    // The query only serves as a container for the parameter values here. Since the
+    // statement is already prepared, it is just rebound and run again for each row.
+    Query rowQuery(batchQuery);
+    std::vector<std::size_t> affectedRowCounts;
+    while(parameterRows.AssignNextRow(rowQuery)) {
+      preparedStatement->BindParameters(rowQuery);
+      affectedRowCounts.push_back(preparedStatement->RunWithRowCountResult());
+    }
+
+    this->preparedStatementCache->Return(std::move(preparedStatement));
+    return affectedRowCounts;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   bool SQLiteConnection::DoesTableOrViewExist(const std::u8string &tableName) {
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    // Copies of a query share its statement id, so by keeping the parsed query around,
+    // the prepared statement cache will be able to reuse the prepared statement.
+    static const Query tableOrViewExistsQuery{std::u8string(tableOrViewExistsSqlStatement)};
+
+    Query query(tableOrViewExistsQuery);
+    query.SetParameterValue(u8"tableName", Value(tableName));
+
+    std::optional<std::int64_t> count = RunScalarQuery(query).AsInt64();
+    return (count.has_value() && (count.value() > 0));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLiteConnection::CheckHealth() {
+    return true; // There is no server that could have dropped the connection
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  StatementCacheStatistics SQLiteConnection::GetStatementCacheStatistics() const {
+    return this->preparedStatementCache->GetStatistics();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t SQLiteConnection::GetMaximumParameterCount() const {
+    int variableLimit = ::sqlite3_limit(
+      this->database.get(), SQLITE_LIMIT_VARIABLE_NUMBER, -1
+    );
+    return static_cast<std::size_t>(variableLimit);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLiteConnection::Interrupt() {
+    ::sqlite3_interrupt(this->database.get()); // Safe to call from any thread
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLiteConnection::BeginTopLevelTransaction(Transactions::IsolationLevel isolationLevel) {
+    static const Query deferredBeginQuery(u8"BEGIN");
+    static const Query immediateBeginQuery(u8"BEGIN IMMEDIATE");
+
+    switch(isolationLevel) {
+      case Transactions::IsolationLevel::PinnedReads_BlockConcurrentWrites:
+      case Transactions::IsolationLevel::Isolated_BlockConcurrentWrites: {
+        RunStatement(immediateBeginQuery);
+        break;
+      }
+      default: {
+        RunStatement(deferredBeginQuery);
+        break;
+      }
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
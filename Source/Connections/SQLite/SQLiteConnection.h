@@ -26,7 +26,13 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Connections/Connection.h"
 
-#include <filesystem> // for std::filesystem::path
+#include <sqlite3.h> // for ::sqlite3
+
+#include <memory> // for std::shared_ptr<>
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+  class SQLitePreparedStatementCache;
+}
 
 namespace Nuclex::ThinOrm::Connections::SQLite {
 
@@ -37,23 +43,17 @@ namespace Nuclex::ThinOrm::Connections::SQLite {
   /// </summary>
   class SQLiteConnection : public Connection {
 
+    /// <summary>Number of prepared statements each connection keeps around</summary>
+    public: static const std::size_t DefaultPreparedStatementCacheCapacity;
+
     /// <summary>Initializes a new native SQLite database connection</summary>
-    /// <param name="databasePath">
-    ///   Path of the database file on the local file system
+    /// <param name="database">
+    ///   SQLite database handle as returned by <see cref="Platform::SQLite3Api::Open" />
     /// </param>
-    public: SQLiteConnection(const std::filesystem::path &databasePath);
+    public: SQLiteConnection(const std::shared_ptr<::sqlite3> &database);
     /// <summary>Frees all resources owned by the database connection</summary>
     public: ~SQLiteConnection() override;
 
-    /// <summary>Establishes a new connection to a database via QtSql</summary>
-    /// <param name="databasePath">
-    ///   Path of the database file on the local file system
-    /// </param>
-    /// <returns>A new database connection estblashed with the provided parameters</returns>
-    public: static std::shared_ptr<SQLiteConnection> Connect(
-      const std::filesystem::path &databasePath
-    );
-
     /// <summary>Prepares the specified query for execution</summary>
     /// <param name="query">Query that will be prepared for execution</param>
     public: void Prepare(const Query &query) override;
@@ -77,13 +77,59 @@ namespace Nuclex::ThinOrm::Connections::SQLite {
     /// <returns>A reader that can be used to fetch individual rows</returns>
     public: std::unique_ptr<RowReader> RunRowQuery(const Query &rowQuery) override;
 
+    /// <summary>Executes an SQL statement once for each row of parameter values</summary>
+    /// <param name="batchQuery">Query that will be executed for each parameter row</param>
+    /// <param name="parameterRows">Provides the parameter values for each execution</param>
+    /// <returns>The number of rows affected by each execution, in order</returns>
+    /// <remarks>
+    ///   Keeps the prepared statement checked out for the whole batch and only resets
+    ///   and rebinds it between rows.
+    /// </remarks>
+    public: std::vector<std::size_t> RunBatch(
+      const Query &batchQuery, ParameterRowSource &parameterRows
+    ) override;
+    using Connection::RunBatch;
+
     /// <summary>Checks if the specified table exists</summary>
     /// <param name="tableName">Table or view whose existence will be checked</param>
     /// <returns>True if a table or view with the given exists</returns>
     public: bool DoesTableOrViewExist(const std::u8string &tableName) override;
 
-    /// <summary>Path of the opened database on the local file system</summary>
-    private: std::filesystem::path databasePath;
+    /// <summary>Checks whether the connection is still usable</summary>
+    /// <returns>Always true, SQLite databases are opened in-process</returns>
+    public: bool CheckHealth() override;
+
+    /// <summary>Reports the counters of the prepared statement cache</summary>
+    /// <returns>The current counters of the connection's prepared statement cache</returns>
+    public: StatementCacheStatistics GetStatementCacheStatistics() const override;
+
+    /// <summary>Reports how many parameters a single statement may contain at most</summary>
+    /// <returns>The parameter limit SQLite has been compiled with</returns>
+    public: std::size_t GetMaximumParameterCount() const override;
+
+    /// <summary>Aborts the query currently running on the connection, if any</summary>
+    /// <remarks>
+    ///   The running query will fail with <code>SQLITE_INTERRUPT</code>. If a transaction
+    ///   was active, SQLite may have rolled it back.
+    /// </remarks>
+    public: void Interrupt() override;
+
+    /// <summary>Begins a transaction at the outermost level</summary>
+    /// <param name="isolationLevel">Isolation level the transaction should use</param>
+    /// <remarks>
+    ///   SQLite transactions are always serializable. The isolation level only decides
+    ///   whether the write lock is acquired lazily (<code>BEGIN</code>) or right away
+    ///   (<code>BEGIN IMMEDIATE</code>), the latter avoiding busy errors when a reading
+    ///   transaction later tries to upgrade to a writing one.
+    /// </remarks>
+    protected: void BeginTopLevelTransaction(
+      Transactions::IsolationLevel isolationLevel
+    ) override;
+
+    /// <summary>Opened database connection from the SQLite library</summary>
+    private: std::shared_ptr<::sqlite3> database;
+    /// <summary>Recently used statements that have already been prepared</summary>
+    private: std::shared_ptr<SQLitePreparedStatementCache> preparedStatementCache;
 
   };
 
@@ -31,6 +31,7 @@ limitations under the License.
 #include <Nuclex/Support/Text/StringMatcher.h> // for StringMatcher
 
 #include "../../Platform/SQLite3Api.h" // for SQLite3Api
+#include "./SQLiteConnection.h" // for SQLiteConnection
 
 #include <stdexcept> // for std::runtime_error
 
@@ -100,7 +101,7 @@ namespace {
         return Nuclex::ThinOrm::Value::BooleanFromString(optionValue.value());
       }
     } else {
-      return valueOnMissing
+      return valueOnMissing;
     }
   }
 
@@ -221,20 +222,36 @@ namespace Nuclex::ThinOrm::Connections::SQLite {
       std::u8string hostnameOrPath = connectionProperties.GetHostnameOrPath();
       std::optional<std::u8string> databaseName = connectionProperties.GetDatabaseName();
 
+      // In-memory databases are identified by name rather than by a path (which is
+      // needed to let multiple connections share one via the shared cache), so for
+      // those, the name is passed through as a URI instead of being treated as a path.
       if(databaseName.has_value()) {
         if(hostnameOrPath.empty()) {
-          connection = Platform::SQLite3Api::Open(databaseName.value(), flags);
+          if(shouldStoreDatabaseInMemory) {
+            connection = Platform::SQLite3Api::Open(
+              databaseName.value(), flags | SQLITE_OPEN_URI
+            );
+          } else {
+            connection = Platform::SQLite3Api::Open(
+              std::filesystem::path(databaseName.value()), flags
+            );
+          }
         } else { // ^^ only database name present ^^ // vv path and name present vv
           std::filesystem::path path = hostnameOrPath;
           connection = Platform::SQLite3Api::Open(path / databaseName.value(), flags);
         }
       } else { // ^^ database name present ^^ // vv database name absent vv
-        connection = Platform::SQLite3Api::Open(hostnameOrPath, flags);
+        if(shouldStoreDatabaseInMemory) {
+          connection = Platform::SQLite3Api::Open(hostnameOrPath, flags | SQLITE_OPEN_URI);
+        } else {
+          connection = Platform::SQLite3Api::Open(
+            std::filesystem::path(hostnameOrPath), flags
+          );
+        }
       }
     }
 
-    (void)connectionProperties;
-    throw std::runtime_error(reinterpret_cast<const char *>(u8"Not implemented yet"));
+    return std::make_shared<SQLiteConnection>(connection);
   }
 
   // ------------------------------------------------------------------------------------------- //
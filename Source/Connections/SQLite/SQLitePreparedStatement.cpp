@@ -0,0 +1,298 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./SQLitePreparedStatement.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "../../Utilities/SQLiteValueConverter.h" // for SQLiteValueConverter
+
+#include "Nuclex/ThinOrm/Errors/BadSqlStatementError.h" // for BadSqlStatementError
+#include "Nuclex/ThinOrm/Value.h" // for Value
+#include "./SQLiteRowReader.h" // for SQLiteRowReader
+
+#include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append<>()
+#include <Nuclex/Support/ScopeGuard.h> // for ON_SCOPE_EXIT
+
+#include <cassert> // for assert()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Builds the first line of an error message about a scalar query</summary>
+  /// <param name="sqlStatement">SQL statement that was executed</param>
+  /// <returns>The start of an error message that explains the scalar query's problem</returns>
+  std::u8string beginScalarQueryErrorMessage(const std::u8string &sqlStatement) {
+    std::u8string message(
+      u8"Expected scalar (single value) result from SQL statement:\n", 58
+    );
+    message.append(sqlStatement);
+    return message;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  SQLitePreparedStatement::SQLitePreparedStatement(
+    const std::shared_ptr<::sqlite3> &database, const Query &query
+  ) :
+    database(database),
+    sqliteSqlStatement(
+      transformSqlStatement(query.GetSqlStatement(), query.GetParameterInfo())
+    ),
+    sqlStatementId(query.GetSqlStatementId()),
+    slotParameterIndices(findFirstParameterPerSlot(query.GetParameterInfo())),
+    statement(nullptr) {
+
+    // The persistent flag tells SQLite that the statement will be kept around and
+    // reused many times, so it will allocate its memory from the heap rather than
+    // from the lookaside pool meant for short-lived statements.
+    int resultCode = ::sqlite3_prepare_v3(
+      this->database.get(),
+      reinterpret_cast<const char *>(this->sqliteSqlStatement.c_str()),
+      static_cast<int>(this->sqliteSqlStatement.length() + 1),
+      SQLITE_PREPARE_PERSISTENT,
+      &this->statement,
+      nullptr
+    );
+    if(resultCode != SQLITE_OK) [[unlikely]] {
+      throwSqlError(u8"preparing", resultCode);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  SQLitePreparedStatement::~SQLitePreparedStatement() {
+    if(this->statement != nullptr) [[likely]] {
+      ::sqlite3_finalize(this->statement);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLitePreparedStatement::BindParameters(const Query &query) {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    // Re-using a prepared statement only requires resetting it and clearing the bindings
+    // left over from its previous execution, no recompilation is needed.
+    Reset();
+    ::sqlite3_clear_bindings(this->statement);
+
+    // Parameters that appear multiple times share the same numbered placeholder,
+    // so each slot only needs to be bound once
+    std::size_t slotCount = this->slotParameterIndices.size();
+    for(std::size_t slotIndex = 0; slotIndex < slotCount; ++slotIndex) {
+      int resultCode = SQLiteValueConverter::BindValue(
+        this->statement,
+        static_cast<int>(slotIndex + 1),
+        query.GetParameterValue(this->slotParameterIndices[slotIndex])
+      );
+      if(resultCode != SQLITE_OK) [[unlikely]] {
+        throwSqlError(u8"binding parameters for", resultCode);
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLitePreparedStatement::RunWithoutResult() {
+    ON_SCOPE_EXIT { Reset(); };
+    Step();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value SQLitePreparedStatement::RunWithScalarResult() {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    ON_SCOPE_EXIT { Reset(); };
+
+    // The result should only have one column. If not, we refuse to just pick a column
+    // because the query is clearly incorrect and it's better to fail early.
+    int columnCount = ::sqlite3_column_count(this->statement);
+    if(columnCount < 1) [[unlikely]] {
+      std::u8string message = beginScalarQueryErrorMessage(this->sqliteSqlStatement);
+      message.append(u8"\nBut it returned no results at all", 34);
+      throw Errors::BadSqlStatementError(message);
+    }
+    if(columnCount >= 2) [[unlikely]] {
+      std::u8string message = beginScalarQueryErrorMessage(this->sqliteSqlStatement);
+      message.append(u8"\nBut it returned ", 17);
+      Nuclex::Support::Text::lexical_append(message, columnCount);
+      message.append(u8" columns instead.", 17);
+      throw Errors::BadSqlStatementError(message);
+    }
+
+    bool hasFirstResultRow = Step();
+    if(!hasFirstResultRow) [[unlikely]] {
+      std::u8string message = beginScalarQueryErrorMessage(this->sqliteSqlStatement);
+      message.append(u8"\nBut it returned no results", 27);
+      throw Errors::BadSqlStatementError(message);
+    }
+
+    Value result = SQLiteValueConverter::ValueFromColumn(this->statement, 0);
+
+    bool hasSecondResultRow = Step();
+    if(hasSecondResultRow) [[unlikely]] {
+      std::u8string message = beginScalarQueryErrorMessage(this->sqliteSqlStatement);
+      message.append(u8"\nBut it returned multiple rows of results", 41);
+      throw Errors::BadSqlStatementError(message);
+    }
+
+    return result;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t SQLitePreparedStatement::RunWithRowCountResult() {
+    ON_SCOPE_EXIT { Reset(); };
+    Step();
+    return static_cast<std::size_t>(::sqlite3_changes64(this->database.get()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::unique_ptr<RowReader> SQLitePreparedStatement::RunWithMultiRowResult(
+    const std::shared_ptr<SQLitePreparedStatement> &self,
+    const std::weak_ptr<SQLitePreparedStatementCache> &cache
+  ) {
+    assert((self.get() == this) && u8"Self pointer must point to the prepared statement");
+
+    // Step onto the first row right away. This way, errors in the query surface here
+    // rather than on the first call to RowReader::MoveToNext().
+    bool hasFirstRow;
+    {
+      auto resetScope = ON_SCOPE_EXIT_TRANSACTION { Reset(); };
+      hasFirstRow = Step();
+      if(hasFirstRow) [[likely]] {
+        resetScope.Commit();
+      }
+    }
+
+    return std::make_unique<SQLiteRowReader>(self, cache, hasFirstRow);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLitePreparedStatement::Step() {
+    int resultCode = ::sqlite3_step(this->statement);
+    if(resultCode == SQLITE_ROW) [[likely]] {
+      return true;
+    } else if(resultCode == SQLITE_DONE) {
+      return false;
+    } else {
+      throwSqlError(u8"executing", resultCode);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLitePreparedStatement::Reset() noexcept {
+    // The result code of sqlite3_reset() merely repeats the error of the last
+    // sqlite3_step() call, which has already been reported by Step() at that point.
+    ::sqlite3_reset(this->statement);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::u8string SQLitePreparedStatement::transformSqlStatement(
+    const std::u8string &sqlStatement, const std::vector<QueryParameterView> &parameters
+  ) {
+    std::u8string sqliteSqlStatement;
+
+    // Each parameter will be turned from {parameter} into ?n, which may end up longer
+    // or shorter, but the length of the original statement is a good estimate.
+    std::u8string::size_type length = sqlStatement.length();
+    sqliteSqlStatement.reserve(length);
+
+    // Skip ahead to each parameter, then append the placeholder numbered after its value
+    // slot. SQLite's parameter numbers are one-based, so the first slot becomes ?1.
+    std::u8string::size_type start = 0;
+    for(std::size_t index = 0; index < parameters.size(); ++index) {
+      std::u8string::size_type end = parameters[index].StartIndex;
+
+      sqliteSqlStatement.append(sqlStatement, start, end - start);
+      sqliteSqlStatement.push_back(u8'?');
+      Nuclex::Support::Text::lexical_append(sqliteSqlStatement, parameters[index].SlotIndex + 1);
+
+      start = end + parameters[index].Length;
+    }
+    if(start < length) {
+      sqliteSqlStatement.append(sqlStatement, start, length - start);
+    }
+
+    return sqliteSqlStatement;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::vector<std::size_t> SQLitePreparedStatement::findFirstParameterPerSlot(
+    const std::vector<QueryParameterView> &parameters
+  ) {
+    std::vector<std::size_t> result;
+
+    // Slots are numbered in order of the first appearance of each parameter name,
+    // so a new slot always comes up exactly when the slot count is reached
+    for(std::size_t index = 0; index < parameters.size(); ++index) {
+      if(parameters[index].SlotIndex == result.size()) {
+        result.push_back(index);
+      }
+    }
+
+    return result;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLitePreparedStatement::throwSqlError(
+    const std::u8string_view &action, int resultCode
+  ) const {
+    std::u8string message(u8"Error ", 6);
+    message.append(action);
+    message.append(u8" SQL statement:\n", 16);
+    message.append(this->sqliteSqlStatement);
+    message.append(u8"\nReason provided by SQLite:\n", 28);
+
+    const char *errorMessage = ::sqlite3_errmsg(this->database.get());
+    if(errorMessage == nullptr) [[unlikely]] {
+      message.append(u8"unknown SQLite error ", 21);
+      message.push_back(u8'(');
+      Nuclex::Support::Text::lexical_append(message, resultCode);
+      message.push_back(u8')');
+    } else {
+      message.append(reinterpret_cast<const char8_t *>(errorMessage));
+    }
+
+    throw Errors::BadSqlStatementError(message);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::SQLite
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
@@ -0,0 +1,173 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEPREPAREDSTATEMENT_H
+#define NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEPREPAREDSTATEMENT_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "Nuclex/ThinOrm/Query.h" // for Query
+
+#include <sqlite3.h> // for ::sqlite3, ::sqlite3_stmt
+
+#include <memory> // for std::shared_ptr<>, std::unique_ptr<>
+#include <string> // for std::u8string
+
+namespace Nuclex::ThinOrm {
+  class RowReader;
+}
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+  class SQLiteRowReader;
+  class SQLitePreparedStatementCache;
+}
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Query that has been compiled into a prepared SQLite statement</summary>
+  /// <remarks>
+  ///   Parameters are bound by their index in the query, so the statement text handed to
+  ///   SQLite uses numbered placeholders (<code>?1</code>, <code>?2</code>, ...) in place of
+  ///   the named ones. Re-running the statement only resets it and clears its bindings,
+  ///   the statement is never compiled again.
+  /// </remarks>
+  class SQLitePreparedStatement {
+    friend SQLiteRowReader;
+
+    /// <summary>Initializes a new prepared statement</summary>
+    /// <param name="database">SQLite database the statement will be prepared on</param>
+    /// <param name="query">Query describing the SQL statement and parameters</param>
+    public: SQLitePreparedStatement(
+      const std::shared_ptr<::sqlite3> &database, const Query &query
+    );
+    /// <summary>Finalizes the prepared statement and frees all resources</summary>
+    public: ~SQLitePreparedStatement();
+
+    /// <summary>Retrieves the id of the SQL statement that was prepared</summary>
+    /// <returns>The statement id of the query the statement was prepared from</returns>
+    public: inline std::size_t GetSqlStatementId() const;
+
+    /// <summary>Binds the parameter values from the specified query</summary>
+    /// <param name="query">Query whose parameter values will be bound</param>
+    /// <remarks>
+    ///   This also resets the statement and clears any previous bindings, so it should
+    ///   be called before each execution of the statement.
+    /// </remarks>
+    public: void BindParameters(const Query &query);
+
+    /// <summary>Executes the statement, assuming it returns nothing</summary>
+    public: void RunWithoutResult();
+
+    /// <summary>Executes the statement, assuming it returns a scalar value as result</summary>
+    /// <returns>The result of the query</returns>
+    public: Value RunWithScalarResult();
+
+    /// <summary>Executes the statement, assuming it affects zero or more rows</summary>
+    /// <returns>The number of rows SQLite reported as changed by the statement</returns>
+    public: std::size_t RunWithRowCountResult();
+
+    /// <summary>Executes the statement, assuming it returns zero or more result rows</summary>
+    /// <param name="self">
+    ///   Essentially the this pointer, provided by the connection so that
+    ///   the <see cref="RowReader" /> can take temporary ownership of the statement.
+    /// </param>
+    /// <param name="cache">
+    ///   Cache the statement will be returned to once the row reader is done with it
+    /// </param>
+    /// <returns>A row reader which acts as an enumerator and row metadata provider</returns>
+    public: std::unique_ptr<RowReader> RunWithMultiRowResult(
+      const std::shared_ptr<SQLitePreparedStatement> &self,
+      const std::weak_ptr<SQLitePreparedStatementCache> &cache
+    );
+
+    /// <summary>Accesses the SQLite statement handle managed by the wrapper</summary>
+    /// <returns>The prepared SQLite statement</returns>
+    protected: inline ::sqlite3_stmt *GetStatement() const;
+
+    /// <summary>Advances the statement to its next result row</summary>
+    /// <returns>True if a result row is available, false if the statement is done</returns>
+    protected: bool Step();
+
+    /// <summary>Resets the statement so it releases its locks and can run again</summary>
+    protected: void Reset() noexcept;
+
+    /// <summary>Transforms the SQL statement into the format expected by SQLite</summary>
+    /// <param name="sqlStatement">SQL statement that will be transformed</param>
+    /// <param name="parameters">Parameters contained in the SQL statement</param>
+    /// <returns>The SQL statement with numbered placeholders for its parameters</returns>
+    private: static std::u8string transformSqlStatement(
+      const std::u8string &sqlStatement, const std::vector<QueryParameterView> &parameters
+    );
+
+    /// <summary>Finds the first occurrence of each parameter slot in the statement</summary>
+    /// <param name="parameters">Parameters contained in the SQL statement</param>
+    /// <returns>
+    ///   The index of the first parameter using each slot, indexed by the slot index
+    /// </returns>
+    private: static std::vector<std::size_t> findFirstParameterPerSlot(
+      const std::vector<QueryParameterView> &parameters
+    );
+
+    /// <summary>Throws an exception describing an error reported by SQLite</summary>
+    /// <param name="action">Description of what was being done when the error occurred</param>
+    /// <param name="resultCode">Result code returned by the failed SQLite call</param>
+    private: [[noreturn]] void throwSqlError(
+      const std::u8string_view &action, int resultCode
+    ) const;
+
+    /// <summary>Database the statement has been prepared on</summary>
+    /// <remarks>
+    ///   Keeps the database alive until the statement is finalized because SQLite refuses
+    ///   to close a database that still has unfinalized statements.
+    /// </remarks>
+    private: std::shared_ptr<::sqlite3> database;
+    /// <summary>The SQL statement as it has been handed to SQLite</summary>
+    private: std::u8string sqliteSqlStatement;
+    /// <summary>Unique id of the SQL statement the prepared statement was built from</summary>
+    private: std::size_t sqlStatementId;
+    /// <summary>Index of a parameter that provides the value for each slot</summary>
+    private: std::vector<std::size_t> slotParameterIndices;
+    /// <summary>Prepared SQLite statement awaiting execution</summary>
+    private: ::sqlite3_stmt *statement;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::size_t SQLitePreparedStatement::GetSqlStatementId() const {
+    return this->sqlStatementId;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline ::sqlite3_stmt *SQLitePreparedStatement::GetStatement() const {
+    return this->statement;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::SQLite
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#endif // NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEPREPAREDSTATEMENT_H
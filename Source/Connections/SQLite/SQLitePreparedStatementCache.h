@@ -0,0 +1,79 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEPREPAREDSTATEMENTCACHE_H
+#define NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEPREPAREDSTATEMENTCACHE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "../StatementCache.h" // for StatementCache
+
+#include <sqlite3.h> // for ::sqlite3
+
+#include <memory> // for std::shared_ptr<>
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+  class SQLitePreparedStatement;
+}
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Keeps the most recently used prepared statements of a connection</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Works just like the materialized query cache of the Qt SQL connection: prepared
+  ///     statements are keyed by the statement id of the query they were prepared from,
+  ///     checked out while executing and returned afterwards, with the least recently
+  ///     used statement being finalized when the cache grows beyond its capacity.
+  ///   </para>
+  ///   <para>
+  ///     A returned statement is only reset and has its bindings cleared before it is
+  ///     run again, which skips SQLite's parsing and query planning entirely.
+  ///   </para>
+  /// </remarks>
+  class SQLitePreparedStatementCache : public StatementCache<SQLitePreparedStatement> {
+
+    /// <summary>Initializes a new prepared statement cache</summary>
+    /// <param name="capacity">Maximum number of prepared statements to retain</param>
+    public: SQLitePreparedStatementCache(std::size_t capacity);
+
+    /// <summary>Takes a prepared statement out of the cache or prepares it</summary>
+    /// <param name="database">SQLite database the query will be prepared on if needed</param>
+    /// <param name="query">Query for which a prepared statement will be provided</param>
+    /// <returns>
+    ///   A prepared statement for the specified query that is exclusively owned by
+    ///   the caller until it is handed back via <see cref="Return" />
+    /// </returns>
+    public: std::shared_ptr<SQLitePreparedStatement> Checkout(
+      const std::shared_ptr<::sqlite3> &database, const Query &query
+    );
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::SQLite
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#endif // NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEPREPAREDSTATEMENTCACHE_H
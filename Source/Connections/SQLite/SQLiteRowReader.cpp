@@ -0,0 +1,371 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./SQLiteRowReader.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "./SQLitePreparedStatement.h" // for SQLitePreparedStatement
+#include "./SQLitePreparedStatementCache.h" // for SQLitePreparedStatementCache
+
+#include "../../Utilities/SQLiteValueConverter.h" // for SQLiteValueConverter
+
+#include "Nuclex/ThinOrm/Value.h" // for Value
+
+#include <Nuclex/Support/Text/StringMatcher.h> // for StringMatcher::AreEqual()
+
+#include <stdexcept> // for std::runtime_error
+#include <string_view> // for std::u8string_view
+#include <span> // for std::span
+#include <cstddef> // for std::byte
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  SQLiteRowReader::SQLiteRowReader(
+    const std::shared_ptr<SQLitePreparedStatement> &preparedStatement,
+    const std::weak_ptr<SQLitePreparedStatementCache> &cache,
+    bool hasFirstRow
+  ) :
+    preparedStatement(preparedStatement),
+    cache(cache),
+    hasPendingFirstRow(hasFirstRow),
+    isFinished(!hasFirstRow) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  SQLiteRowReader::~SQLiteRowReader() {
+    if(!this->isFinished) {
+      this->preparedStatement->Reset();
+    }
+
+    // Hand the statement back to the connection's cache so the next execution of
+    // the same query can skip the preparation step
+    std::shared_ptr<SQLitePreparedStatementCache> owningCache = this->cache.lock();
+    if(owningCache) [[likely]] {
+      owningCache->Return(std::move(this->preparedStatement));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLiteRowReader::MoveToNext() {
+    if(this->isFinished) [[unlikely]] {
+      return false;
+    }
+
+    // The first row was already stepped onto when the query was run, so the first call
+    // only needs to report it.
+    if(this->hasPendingFirstRow) {
+      this->hasPendingFirstRow = false;
+      return true;
+    }
+
+    bool gotAnotherRow = this->preparedStatement->Step();
+
+    // Reset the statement as soon as the end is reached. This releases the read lock
+    // SQLite holds while a statement is active, so another query on the connection
+    // (or a write from another connection) isn't blocked by a lingering row reader.
+    if(!gotAnotherRow) [[unlikely]] {
+      this->preparedStatement->Reset();
+      this->isFinished = true;
+    }
+
+    return gotAnotherRow;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t SQLiteRowReader::CountColumns() const {
+    return static_cast<std::size_t>(
+      ::sqlite3_column_count(this->preparedStatement->GetStatement())
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  const std::u8string SQLiteRowReader::GetColumnName(std::size_t columnIndex) const {
+    const char *name = ::sqlite3_column_name(
+      this->preparedStatement->GetStatement(), static_cast<int>(columnIndex)
+    );
+    if(name == nullptr) [[unlikely]] {
+      throw std::out_of_range(reinterpret_cast<const char *>(u8"Invalid column index"));
+    }
+
+    return std::u8string(reinterpret_cast<const char8_t *>(name));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ValueType SQLiteRowReader::GetColumnType(std::size_t columnIndex) const {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    return SQLiteValueConverter::ValueTypeFromColumn(
+      this->preparedStatement->GetStatement(), static_cast<int>(columnIndex)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value SQLiteRowReader::GetColumnValue(std::size_t columnIndex) const {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    return SQLiteValueConverter::ValueFromColumn(
+      this->preparedStatement->GetStatement(), static_cast<int>(columnIndex)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value SQLiteRowReader::GetColumnValue(const std::u8string &columnName) const {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    return SQLiteValueConverter::ValueFromColumn(
+      this->preparedStatement->GetStatement(), getColumnIndex(columnName)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLiteRowReader::TryReadColumnInt64(
+    std::size_t columnIndex, std::int64_t &target
+  ) const {
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+    int sqliteColumnIndex = static_cast<int>(columnIndex);
+    if(::sqlite3_column_type(statement, sqliteColumnIndex) == SQLITE_NULL) {
+      return false;
+    }
+
+    target = static_cast<std::int64_t>(::sqlite3_column_int64(statement, sqliteColumnIndex));
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLiteRowReader::TryReadColumnDouble(std::size_t columnIndex, double &target) const {
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+    int sqliteColumnIndex = static_cast<int>(columnIndex);
+    if(::sqlite3_column_type(statement, sqliteColumnIndex) == SQLITE_NULL) {
+      return false;
+    }
+
+    target = ::sqlite3_column_double(statement, sqliteColumnIndex);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLiteRowReader::TryReadColumnString(
+    std::size_t columnIndex, std::u8string &target
+  ) const {
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+    int sqliteColumnIndex = static_cast<int>(columnIndex);
+    if(::sqlite3_column_type(statement, sqliteColumnIndex) == SQLITE_NULL) {
+      return false;
+    }
+
+    // Text pointer must be fetched before the length
+    const char8_t *characters = reinterpret_cast<const char8_t *>(
+      ::sqlite3_column_text(statement, sqliteColumnIndex)
+    );
+    target.assign(
+      characters, static_cast<std::size_t>(::sqlite3_column_bytes(statement, sqliteColumnIndex))
+    );
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool SQLiteRowReader::TryReadColumnBlob(
+    std::size_t columnIndex, std::vector<std::byte> &target
+  ) const {
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+    int sqliteColumnIndex = static_cast<int>(columnIndex);
+    if(::sqlite3_column_type(statement, sqliteColumnIndex) == SQLITE_NULL) {
+      return false;
+    }
+
+    // Blob pointer must be fetched before the length
+    const std::byte *bytes = reinterpret_cast<const std::byte *>(
+      ::sqlite3_column_blob(statement, sqliteColumnIndex)
+    );
+    std::size_t byteCount = static_cast<std::size_t>(
+      ::sqlite3_column_bytes(statement, sqliteColumnIndex)
+    );
+    target.assign(bytes, bytes + byteCount);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t SQLiteRowReader::FetchBatch(RowBatch &batch, std::size_t maximumRowCount) {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    if((maximumRowCount == 0) || !MoveToNext()) {
+      batch.Reset(0);
+      return 0;
+    }
+
+    // Without a declared type, SQLite can only tell the type of the value in the current
+    // row, so the first row fetched decides the column types for the whole batch.
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+    int columnCount = ::sqlite3_column_count(statement);
+    batch.Reset(static_cast<std::size_t>(columnCount));
+    for(int columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+      const char *name = ::sqlite3_column_name(statement, columnIndex);
+      batch.GetColumn(static_cast<std::size_t>(columnIndex)).Reset(
+        SQLiteValueConverter::ValueTypeFromColumn(statement, columnIndex),
+        (name == nullptr) ?
+          std::u8string_view() :
+          std::u8string_view(reinterpret_cast<const char8_t *>(name))
+      );
+    }
+
+    // Step through the rows directly rather than via MoveToNext(), the first row has
+    // already been consumed above and the pending first row flag is cleared by now.
+    std::size_t rowCount = 0;
+    for(;;) {
+      appendCurrentRow(batch);
+
+      ++rowCount;
+      if(rowCount >= maximumRowCount) {
+        return rowCount;
+      }
+      if(!this->preparedStatement->Step()) [[unlikely]] {
+        this->preparedStatement->Reset();
+        this->isFinished = true;
+        return rowCount;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SQLiteRowReader::appendCurrentRow(RowBatch &batch) const {
+    using Nuclex::ThinOrm::Utilities::SQLiteValueConverter;
+
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+
+    std::size_t columnCount = batch.CountColumns();
+    for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+      RowBatchColumn &column = batch.GetColumn(columnIndex);
+      int sqliteColumnIndex = static_cast<int>(columnIndex);
+
+      if(::sqlite3_column_type(statement, sqliteColumnIndex) == SQLITE_NULL) {
+        column.AppendNull();
+        continue;
+      }
+
+      // SQLite converts between its storage classes on request, so whatever the row
+      // actually stores can be read in the column's type without going through a Value
+      switch(column.GetType()) {
+        case ValueType::Boolean: {
+          column.AppendBoolean(::sqlite3_column_int64(statement, sqliteColumnIndex) != 0);
+          break;
+        }
+        case ValueType::UInt8:
+        case ValueType::Int16:
+        case ValueType::Int32:
+        case ValueType::Int64: {
+          column.AppendInteger(
+            static_cast<std::int64_t>(::sqlite3_column_int64(statement, sqliteColumnIndex))
+          );
+          break;
+        }
+        case ValueType::Float:
+        case ValueType::Double: {
+          column.AppendFloatingPoint(::sqlite3_column_double(statement, sqliteColumnIndex));
+          break;
+        }
+        case ValueType::String: { // Text pointer must be fetched before the length
+          const char8_t *characters = reinterpret_cast<const char8_t *>(
+            ::sqlite3_column_text(statement, sqliteColumnIndex)
+          );
+          column.AppendString(
+            std::u8string_view(
+              characters,
+              static_cast<std::size_t>(::sqlite3_column_bytes(statement, sqliteColumnIndex))
+            )
+          );
+          break;
+        }
+        case ValueType::Blob: {
+          const std::byte *bytes = reinterpret_cast<const std::byte *>(
+            ::sqlite3_column_blob(statement, sqliteColumnIndex)
+          );
+          column.AppendBlob(
+            std::span<const std::byte>(
+              bytes,
+              static_cast<std::size_t>(::sqlite3_column_bytes(statement, sqliteColumnIndex))
+            )
+          );
+          break;
+        }
+        default: { // Decimals, dates and times are stored as text and need parsing
+          column.AppendValue(SQLiteValueConverter::ValueFromColumn(statement, sqliteColumnIndex));
+          break;
+        }
+      } // switch on column type
+    } // for each column
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  int SQLiteRowReader::getColumnIndex(const std::u8string &columnName) const {
+    using Nuclex::Support::Text::StringMatcher;
+    constexpr const bool CaseSensitive = false;
+
+    ::sqlite3_stmt *statement = this->preparedStatement->GetStatement();
+
+    int columnCount = ::sqlite3_column_count(statement);
+    for(int index = 0; index < columnCount; ++index) {
+      const char8_t *name = reinterpret_cast<const char8_t *>(
+        ::sqlite3_column_name(statement, index)
+      );
+      if(name != nullptr) [[likely]] {
+        if(StringMatcher::AreEqual<CaseSensitive>(std::u8string_view(name), columnName)) {
+          return index;
+        }
+      }
+    }
+
+    std::u8string message(u8"No such column in query result: '", 33);
+    message.append(columnName);
+    message.push_back(u8'\'');
+    throw std::out_of_range(
+      std::string(reinterpret_cast<const char *>(message.data()), message.length())
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::SQLite
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
@@ -0,0 +1,158 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEROWREADER_H
+#define NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEROWREADER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+
+#include <memory> // for std::shared_ptr<>
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+  class SQLitePreparedStatement;
+  class SQLitePreparedStatementCache;
+}
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Reads rows directly from a prepared SQLite statement</summary>
+  /// <remarks>
+  ///   Column values are read straight via the <code>sqlite3_column_*()</code> functions
+  ///   from the statement's current row without any intermediate representation.
+  /// </remarks>
+  class SQLiteRowReader : public RowReader {
+
+    /// <summary>Initializes a new row reader based on a prepared SQLite statement</summary>
+    /// <param name="preparedStatement">
+    ///   Statement the row reader will take temporary ownership of to prevent it from
+    ///   being reset or re-run whilst rows are still being enumerated
+    /// </param>
+    /// <param name="cache">
+    ///   Cache the statement will be returned to when the row reader is destroyed
+    /// </param>
+    /// <param name="hasFirstRow">
+    ///   Whether the statement has already stepped onto its first result row. If not,
+    ///   the statement must already have been reset by the caller.
+    /// </param>
+    public: SQLiteRowReader(
+      const std::shared_ptr<SQLitePreparedStatement> &preparedStatement,
+      const std::weak_ptr<SQLitePreparedStatementCache> &cache,
+      bool hasFirstRow
+    );
+
+    /// <summary>Frees all resources owned by the reader and resets the statement</summary>
+    public: ~SQLiteRowReader() override;
+
+    /// <summary>Tries to move to the next row in the result</summary>
+    /// <returns>True if there was a next row, false if the end was reached</returns>
+    public: bool MoveToNext() override;
+
+    /// <summary>Counts the number of columns the query result returns</summary>
+    /// <returns>The number of columns in the result</returns>
+    public: std::size_t CountColumns() const override;
+
+    /// <summary>Retrieves the name of the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose name will be returned</param>
+    /// <returns>The name of the column with the specified index</returns>
+    public: const std::u8string GetColumnName(std::size_t columnIndex) const override;
+
+    /// <summary>Looks up the data type of the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose data type will be looked up</param>
+    /// <returns>The data type of the specified column</returns>
+    public: ValueType GetColumnType(std::size_t columnIndex) const override;
+
+    /// <summary>Retrieves the value of the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be retrieved</param>
+    /// <returns>The value of the specified column in the current row</returns>
+    public: Value GetColumnValue(std::size_t columnIndex) const override;
+
+    /// <summary>Retrieves the value of the specified column in the current row</summary>
+    /// <param name="columnName">Name of the column whose value will be retrieved</param>
+    /// <returns>The value of the specified column in the current row</returns>
+    public: Value GetColumnValue(const std::u8string &columnName) const override;
+
+    /// <summary>Reads an integer from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnInt64(
+      std::size_t columnIndex, std::int64_t &target
+    ) const override;
+
+    /// <summary>Reads a floating point value from the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnDouble(std::size_t columnIndex, double &target) const override;
+
+    /// <summary>Reads a string from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnString(
+      std::size_t columnIndex, std::u8string &target
+    ) const override;
+
+    /// <summary>Reads a binary blob from the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be read</param>
+    /// <param name="target">Receives the value if the column is not NULL</param>
+    /// <returns>True if the value was read, false if the column was NULL</returns>
+    public: bool TryReadColumnBlob(
+      std::size_t columnIndex, std::vector<std::byte> &target
+    ) const override;
+
+    /// <summary>Fetches multiple rows at once into a columnar buffer</summary>
+    /// <param name="batch">Row batch that will receive the rows</param>
+    /// <param name="maximumRowCount">Maximum number of rows that will be fetched</param>
+    /// <returns>The number of rows that were fetched</returns>
+    public: std::size_t FetchBatch(RowBatch &batch, std::size_t maximumRowCount) override;
+
+    /// <summary>Appends the values in the statement's current row to a row batch</summary>
+    /// <param name="batch">Row batch the values will be appended to</param>
+    private: void appendCurrentRow(RowBatch &batch) const;
+
+    /// <summary>Looks up the index of the column with the specified name</summary>
+    /// <param name="columnName">Name of the column whose index will be looked up</param>
+    /// <returns>The index of the column with the specified name</returns>
+    private: int getColumnIndex(const std::u8string &columnName) const;
+
+    /// <summary>Statement the row reader has temporary ownership of</summary>
+    private: std::shared_ptr<SQLitePreparedStatement> preparedStatement;
+    /// <summary>Cache to which the statement will be returned</summary>
+    private: std::weak_ptr<SQLitePreparedStatementCache> cache;
+    /// <summary>Whether the first row has been stepped onto but not been reported</summary>
+    private: bool hasPendingFirstRow;
+    /// <summary>Whether the statement has run out of rows and been reset</summary>
+    private: bool isFinished;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::SQLite
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#endif // NUCLEX_THINORM_CONNECTIONS_SQLITE_SQLITEROWREADER_H
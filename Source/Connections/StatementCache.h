@@ -0,0 +1,223 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_STATEMENTCACHE_H
+#define NUCLEX_THINORM_CONNECTIONS_STATEMENTCACHE_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Connections/StatementCacheStatistics.h" // for StatementCacheStatistics
+
+#include <memory> // for std::shared_ptr<>
+#include <list> // for std::list<>
+#include <unordered_map> // for std::unordered_map<>
+#include <mutex> // for std::mutex
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Keeps the most recently used prepared statements of a connection</summary>
+  /// <typeparam name="TStatement">
+  ///   Driver-specific prepared statement that is cached, must provide
+  ///   a <code>GetSqlStatementId()</code> method identifying the query it was built from
+  /// </typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Statements are keyed by the statement id of the query they were prepared from,
+  ///     checked out while executing and returned afterwards, with the least recently used
+  ///     statement being dropped when the cache grows beyond its capacity.
+  ///   </para>
+  ///   <para>
+  ///     A checked out statement is exclusively owned by the caller (drivers use them as
+  ///     the enumerator for their result rows, too), so another execution of the same
+  ///     query in the meantime will prepare a second instance, only one of which will be
+  ///     retained when both are returned.
+  ///   </para>
+  /// </remarks>
+  template<typename TStatement>
+  class StatementCache {
+
+    /// <summary>Initializes a new statement cache</summary>
+    /// <param name="capacity">Maximum number of statements to retain</param>
+    public: explicit StatementCache(std::size_t capacity);
+    /// <summary>Destroys all statements still held by the cache</summary>
+    public: ~StatementCache() = default;
+
+    /// <summary>Takes a statement out of the cache or prepares a new one</summary>
+    /// <typeparam name="TFactory">Function object that prepares a new statement</typeparam>
+    /// <param name="query">Query for which a statement will be provided</param>
+    /// <param name="prepareStatement">
+    ///   Invoked to prepare a new statement if none was cached, must return
+    ///   a <code>std::shared_ptr</code> to the new statement
+    /// </param>
+    /// <returns>
+    ///   A statement for the specified query that is exclusively owned by the caller
+    ///   until it is handed back via <see cref="Return" />
+    /// </returns>
+    public: template<typename TFactory>
+    std::shared_ptr<TStatement> Checkout(const Query &query, TFactory &&prepareStatement);
+
+    /// <summary>Hands a previously checked out statement back to the cache</summary>
+    /// <param name="statement">Statement that will be returned</param>
+    /// <remarks>
+    ///   Statements whose execution failed should not be returned, simply
+    ///   dropping them is the safe choice in that case.
+    /// </remarks>
+    public: void Return(std::shared_ptr<TStatement> &&statement);
+
+    /// <summary>Retrieves the hit, miss and eviction counters of the cache</summary>
+    /// <returns>The current counters of the cache</returns>
+    public: StatementCacheStatistics GetStatistics() const;
+
+    /// <summary>Destroys all statements currently held by the cache</summary>
+    public: void Clear();
+
+    /// <summary>List of statements ordered from most to least recently used</summary>
+    private: typedef std::list<std::shared_ptr<TStatement>> StatementList;
+    /// <summary>Map from statement ids to entries in the recently used list</summary>
+    private: typedef std::unordered_map<
+      std::size_t, typename StatementList::iterator
+    > StatementIdIteratorMap;
+
+    /// <summary>Must be held when accessing the cache's state</summary>
+    /// <remarks>
+    ///   Connections are not meant to be used by multiple threads at once, but row readers
+    ///   may be destroyed from a different thread than the one that ran the query.
+    /// </remarks>
+    private: mutable std::mutex stateMutex;
+    /// <summary>Maximum number of statements that will be retained</summary>
+    private: std::size_t capacity;
+    /// <summary>Cached statements, the most recently used one in front</summary>
+    private: StatementList recentlyUsedStatements;
+    /// <summary>Allows looking up the cached statements by statement id</summary>
+    private: StatementIdIteratorMap statementsByStatementId;
+    /// <summary>Number of times a statement could be taken from the cache</summary>
+    private: std::size_t hitCount;
+    /// <summary>Number of times a statement had to be prepared from scratch</summary>
+    private: std::size_t missCount;
+    /// <summary>Number of statements that were evicted to make room</summary>
+    private: std::size_t evictionCount;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TStatement>
+  StatementCache<TStatement>::StatementCache(std::size_t capacity) :
+    stateMutex(),
+    capacity(capacity),
+    recentlyUsedStatements(),
+    statementsByStatementId(),
+    hitCount(0),
+    missCount(0),
+    evictionCount(0) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TStatement>
+  template<typename TFactory>
+  std::shared_ptr<TStatement> StatementCache<TStatement>::Checkout(
+    const Query &query, TFactory &&prepareStatement
+  ) {
+    {
+      std::unique_lock<std::mutex> stateAccessScope(this->stateMutex);
+
+      typename StatementIdIteratorMap::iterator iterator = (
+        this->statementsByStatementId.find(query.GetSqlStatementId())
+      );
+      if(iterator != this->statementsByStatementId.end()) [[likely]] {
+        std::shared_ptr<TStatement> statement = std::move(*iterator->second);
+        this->recentlyUsedStatements.erase(iterator->second);
+        this->statementsByStatementId.erase(iterator);
+        ++this->hitCount;
+        return statement;
+      }
+
+      ++this->missCount;
+    }
+
+    // Preparing the statement means parsing and planning the query, so we don't want
+    // to hold the lock while doing it (though contention should be rare to begin with)
+    return prepareStatement();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TStatement>
+  void StatementCache<TStatement>::Return(std::shared_ptr<TStatement> &&statement) {
+    std::shared_ptr<TStatement> droppedStatement;
+    {
+      std::unique_lock<std::mutex> stateAccessScope(this->stateMutex);
+
+      // If the same query was checked out twice (i.e. by a row reader that is still
+      // enumerating while the query was run again), only one instance is retained
+      std::size_t statementId = statement->GetSqlStatementId();
+      if((this->capacity == 0) || this->statementsByStatementId.contains(statementId)) {
+        droppedStatement = std::move(statement);
+        return;
+      }
+
+      this->recentlyUsedStatements.push_front(std::move(statement));
+      this->statementsByStatementId.emplace(statementId, this->recentlyUsedStatements.begin());
+
+      // If the cache has grown beyond its capacity, kick out the least recently used
+      // statement. It is destroyed outside of the lock since the driver may have to
+      // acquire the database's own mutex to release it.
+      if(this->recentlyUsedStatements.size() > this->capacity) {
+        droppedStatement = std::move(this->recentlyUsedStatements.back());
+        this->statementsByStatementId.erase(droppedStatement->GetSqlStatementId());
+        this->recentlyUsedStatements.pop_back();
+        ++this->evictionCount;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TStatement>
+  StatementCacheStatistics StatementCache<TStatement>::GetStatistics() const {
+    std::unique_lock<std::mutex> stateAccessScope(this->stateMutex);
+
+    StatementCacheStatistics statistics;
+    statistics.CachedStatementCount = this->recentlyUsedStatements.size();
+    statistics.Capacity = this->capacity;
+    statistics.HitCount = this->hitCount;
+    statistics.MissCount = this->missCount;
+    statistics.EvictionCount = this->evictionCount;
+    return statistics;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TStatement>
+  void StatementCache<TStatement>::Clear() {
+    StatementList droppedStatements;
+    {
+      std::unique_lock<std::mutex> stateAccessScope(this->stateMutex);
+      this->statementsByStatementId.clear();
+      droppedStatements.swap(this->recentlyUsedStatements);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // NUCLEX_THINORM_CONNECTIONS_STATEMENTCACHE_H
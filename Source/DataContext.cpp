@@ -0,0 +1,89 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/DataContext.h"
+#include "Nuclex/ThinOrm/Connections/ConnectionPool.h" // for ConnectionPool
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+
+#include <stdexcept> // for std::invalid_argument
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  DataContext::DataContext(const std::shared_ptr<Connections::Connection> &connection) :
+    DataContext(connection, Fluent::GlobalEntityRegistry::GetDefault()) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  DataContext::DataContext(const std::shared_ptr<Connections::ConnectionPool> &pool) :
+    DataContext(pool, Fluent::GlobalEntityRegistry::GetDefault()) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  DataContext::DataContext(
+    const std::shared_ptr<Connections::Connection> &connection,
+    Fluent::GlobalEntityRegistry &entityRegistry
+  ) :
+    connection(connection),
+    pool(),
+    entityRegistry(&entityRegistry) {
+    if(!connection) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Data context requires a valid connection")
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  DataContext::DataContext(
+    const std::shared_ptr<Connections::ConnectionPool> &pool,
+    Fluent::GlobalEntityRegistry &entityRegistry
+  ) :
+    connection(),
+    pool(pool),
+    entityRegistry(&entityRegistry) {
+    if(!pool) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Data context requires a valid connection pool")
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  DataContext::~DataContext() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Connections::ConnectionLease DataContext::LeaseConnection() {
+    if(this->connection) {
+      return Connections::ConnectionLease(this->connection);
+    } else {
+      return this->pool->LeaseConnection();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
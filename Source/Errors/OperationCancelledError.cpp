@@ -0,0 +1,43 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Errors/OperationCancelledError.h"
+
+namespace Nuclex::ThinOrm::Errors {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  OperationCancelledError::OperationCancelledError(const std::u8string &message) noexcept :
+    std::runtime_error(
+      std::string(
+        reinterpret_cast<const char *>(message.data()), message.length()
+      )
+    ) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  OperationCancelledError::OperationCancelledError(const char8_t *message) noexcept :
+    std::runtime_error(reinterpret_cast<const char *>(message)) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Errors
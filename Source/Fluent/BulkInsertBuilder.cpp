@@ -0,0 +1,303 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Fluent/BulkInsertBuilder.h"
+#include "Nuclex/ThinOrm/Connections/Connection.h" // for Connection
+
+#include "./EntityLayout.h" // for EntityLayout
+#include "../Utilities/IdentifierQuoter.h" // for IdentifierQuoter
+
+#include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append()
+
+#include <algorithm> // for std::min()
+#include <stdexcept> // for std::invalid_argument
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Throws an exception if a bulk insert would not provide any columns</summary>
+  /// <param name="columnCount">Number of columns the bulk insert provides values for</param>
+  void requireColumns(std::size_t columnCount) {
+    if(columnCount == 0) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Bulk inserts need at least one column")
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Forms the start of the INSERT statement up to the VALUES keyword</summary>
+  /// <param name="tableName">Name of the table the rows will be inserted into</param>
+  /// <param name="columnNames">Names of the columns each row provides values for</param>
+  /// <param name="quoteStyle">Quotes to put around table and column names</param>
+  /// <returns>The start of the INSERT statement</returns>
+  std::u8string formStatementPrefix(
+    const std::u8string_view &tableName,
+    const std::vector<std::u8string> &columnNames,
+    Nuclex::ThinOrm::Dialects::QuoteStyle quoteStyle
+  ) {
+    using Nuclex::ThinOrm::Utilities::IdentifierQuoter;
+
+    std::u8string statementPrefix(u8"INSERT INTO ", 12);
+    IdentifierQuoter::AppendQuoted(statementPrefix, tableName, quoteStyle);
+    statementPrefix.append(u8" (", 2);
+    for(std::size_t index = 0; index < columnNames.size(); ++index) {
+      if(index > 0) {
+        statementPrefix.append(u8", ", 2);
+      }
+      IdentifierQuoter::AppendQuoted(statementPrefix, columnNames[index], quoteStyle);
+    }
+    statementPrefix.append(u8") VALUES ", 9);
+
+    return statementPrefix;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  const std::size_t BulkInsertBuilder::MaximumRowsPerStatement = 1000;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder::BulkInsertBuilder(
+    const std::u8string_view &tableName,
+    const std::vector<std::u8string> &columnNames
+  ) :
+    tableName(tableName),
+    columnNames(columnNames),
+    layout(nullptr),
+    columnCount(columnNames.size()),
+    entityType(nullptr),
+    getters(),
+    statements() {
+    requireColumns(this->columnCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder::BulkInsertBuilder(
+    const std::type_info &entityType,
+    const std::u8string_view &tableName,
+    const std::vector<std::u8string> &columnNames,
+    const std::vector<EntityMappingConfigurator::GetAttributeValueFunction *> &getters
+  ) :
+    tableName(tableName),
+    columnNames(columnNames),
+    layout(nullptr),
+    columnCount(columnNames.size()),
+    entityType(&entityType),
+    getters(getters),
+    statements() {
+    requireColumns(this->columnCount);
+    if(getters.size() != columnNames.size()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Bulk inserts need exactly one getter per column")
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder::BulkInsertBuilder(
+    const std::type_info &entityType, const EntityLayout &layout
+  ) :
+    tableName(),
+    columnNames(),
+    layout(&layout),
+    columnCount(layout.InsertColumns.Count()),
+    entityType(&entityType),
+    getters(),
+    statements() {
+    requireColumns(this->columnCount);
+
+    std::size_t layoutColumnCount = layout.Columns.size();
+    this->getters.reserve(this->columnCount);
+    for(std::size_t index = 0; index < layoutColumnCount; ++index) {
+      if(layout.InsertColumns.Test(index)) {
+        this->getters.push_back(layout.Columns[index].Getter);
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder::BulkInsertBuilder(BulkInsertBuilder &&other) = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder::~BulkInsertBuilder() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t BulkInsertBuilder::GetMaximumRowsPerStatement(
+    std::size_t maximumParameterCount
+  ) const {
+    std::size_t rowCount = maximumParameterCount / this->columnCount;
+    if(rowCount == 0) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Table has more columns than the database accepts parameters in one statement"
+        )
+      );
+    }
+
+    return std::min(rowCount, MaximumRowsPerStatement);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Query &BulkInsertBuilder::GetStatement(
+    std::size_t rowCount, Dialects::QuoteStyle quoteStyle /* = Dialects::QuoteStyle::DoubleQuotes */
+  ) {
+    StatementKey key(quoteStyle, rowCount);
+    StatementMap::iterator iterator = this->statements.find(key);
+    if(iterator != this->statements.end()) {
+      return iterator->second;
+    }
+
+    // Registered entities have their names quoted already and the layout
+    // generates the same statement shape, so there's no need to repeat it here
+    if(this->layout != nullptr) {
+      return this->statements.emplace(
+        key, Query(this->layout->FormInsertStatement(quoteStyle, rowCount))
+      ).first->second;
+    }
+
+    // Each parameter needs its own name because the query would otherwise bind all
+    // occurrences of a name to the same value. Their order is row by row, column by column.
+    std::u8string statement(formStatementPrefix(this->tableName, this->columnNames, quoteStyle));
+    statement.reserve(statement.length() + rowCount * (this->columnCount * 10 + 4));
+    std::size_t parameterIndex = 0;
+    for(std::size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+      statement.append((rowIndex == 0) ? u8"(" : u8", (");
+      for(std::size_t columnIndex = 0; columnIndex < this->columnCount; ++columnIndex) {
+        if(columnIndex > 0) {
+          statement.append(u8", ", 2);
+        }
+        statement.append(u8"{p", 2);
+        Nuclex::Support::Text::lexical_append(statement, parameterIndex);
+        statement.push_back(u8'}');
+        ++parameterIndex;
+      }
+      statement.push_back(u8')');
+    }
+
+    return this->statements.emplace(key, Query(statement)).first->second;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t BulkInsertBuilder::Insert(
+    Connections::Connection &connection, const std::vector<std::vector<Value>> &rows
+  ) {
+    return insertInChunks(
+      connection, rows.size(),
+      [this, &rows](Query &query, std::size_t rowIndex, std::size_t firstParameterIndex) {
+        const std::vector<Value> &row = rows[rowIndex];
+        if(row.size() != this->columnCount) {
+          throw std::invalid_argument(
+            reinterpret_cast<const char *>(
+              u8"Row provides a different number of values than the table has columns"
+            )
+          );
+        }
+        for(std::size_t columnIndex = 0; columnIndex < this->columnCount; ++columnIndex) {
+          query.SetParameterValue(firstParameterIndex + columnIndex, row[columnIndex]);
+        }
+      }
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder &BulkInsertBuilder::operator =(BulkInsertBuilder &&other) = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t BulkInsertBuilder::insertEntities(
+    Connections::Connection &connection,
+    const std::type_info &entityType,
+    const std::byte *firstEntity,
+    std::size_t entitySize,
+    std::size_t entityCount
+  ) {
+    if((this->entityType == nullptr) || (*this->entityType != entityType)) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Bulk insert builder was not set up for the type of entity being inserted"
+        )
+      );
+    }
+
+    return insertInChunks(
+      connection, entityCount,
+      [&](Query &query, std::size_t rowIndex, std::size_t firstParameterIndex) {
+        const void *entity = firstEntity + (rowIndex * entitySize);
+        for(std::size_t columnIndex = 0; columnIndex < this->columnCount; ++columnIndex) {
+          query.SetParameterValue(
+            firstParameterIndex + columnIndex, this->getters[columnIndex](entity)
+          );
+        }
+      }
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TAssignRowFunction>
+  std::size_t BulkInsertBuilder::insertInChunks(
+    Connections::Connection &connection,
+    std::size_t rowCount,
+    const TAssignRowFunction &assignRow
+  ) {
+    std::size_t maximumChunkRowCount = GetMaximumRowsPerStatement(
+      connection.GetMaximumParameterCount()
+    );
+    Dialects::QuoteStyle quoteStyle = connection.GetQuoteStyle();
+
+    std::size_t insertedRowCount = 0;
+    std::size_t rowIndex = 0;
+    while(rowIndex < rowCount) {
+      std::size_t chunkRowCount = std::min(rowCount - rowIndex, maximumChunkRowCount);
+
+      Query &statement = GetStatement(chunkRowCount, quoteStyle);
+      for(std::size_t chunkRowIndex = 0; chunkRowIndex < chunkRowCount; ++chunkRowIndex) {
+        assignRow(statement, rowIndex + chunkRowIndex, chunkRowIndex * this->columnCount);
+      }
+      insertedRowCount += connection.RunUpdateQuery(statement);
+
+      rowIndex += chunkRowCount;
+    }
+
+    return insertedRowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
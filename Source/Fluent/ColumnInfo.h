@@ -37,11 +37,13 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <param name="type">RTTI type information for the attribute in the entity class</param>
     /// <param name="getter">Function that reads the column as a <see cref="Value /></param>
     /// <param name="setter">Function that sets the column from a <see cref="Value /></param>
+    /// <param name="reader">Function that reads the column from a result row</param>
     public: ColumnInfo(
       const std::u8string name,
       const std::type_info &type,
       EntityMappingConfigurator::GetAttributeValueFunction *getter,
-      EntityMappingConfigurator::SetAttributeValueFunction *setter
+      EntityMappingConfigurator::SetAttributeValueFunction *setter,
+      EntityMappingConfigurator::ReadAttributeFunction *reader
     );
 
     /// <summary>Name of the column in the database</summary>
@@ -52,6 +54,8 @@ namespace Nuclex::ThinOrm::Fluent {
     public: EntityMappingConfigurator::GetAttributeValueFunction *Getter;
     /// <summary>Setter function that sets the column from a <see cref="Value" /></summary>
     public: EntityMappingConfigurator::SetAttributeValueFunction *Setter;
+    /// <summary>Reader function that reads the column directly from a result row</summary>
+    public: EntityMappingConfigurator::ReadAttributeFunction *Reader;
 
     /// <summary>Whether this column's value is auto-generated by the database</summary>
     public: bool IsAutogenerated;
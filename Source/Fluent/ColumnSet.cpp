@@ -0,0 +1,90 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./ColumnSet.h"
+
+#include <algorithm> // for std::max()
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ColumnSet::ColumnSet(std::size_t columnCount) :
+    bits(columnCount, false) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void ColumnSet::Set(std::size_t index, bool value /* = true */) {
+    if(index >= this->bits.size()) {
+      if(!value) {
+        return; // Columns beyond the end are not in the set already
+      }
+      this->bits.resize(index + 1, false);
+    }
+
+    this->bits[index] = value;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t ColumnSet::Count() const noexcept {
+    std::size_t count = 0;
+    for(bool bit : this->bits) {
+      if(bit) {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool ColumnSet::operator ==(const ColumnSet &other) const noexcept {
+    std::size_t bitCount = std::max(this->bits.size(), other.bits.size());
+    for(std::size_t index = 0; index < bitCount; ++index) {
+      if(Test(index) != other.Test(index)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool ColumnSet::operator <(const ColumnSet &other) const noexcept {
+    std::size_t bitCount = std::max(this->bits.size(), other.bits.size());
+    for(std::size_t index = 0; index < bitCount; ++index) {
+      bool bit = Test(index);
+      bool otherBit = other.Test(index);
+      if(bit != otherBit) {
+        return otherBit;
+      }
+    }
+
+    return false;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
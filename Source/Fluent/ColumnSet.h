@@ -0,0 +1,106 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_COLUMNSET_H
+#define NUCLEX_THINORM_FLUENT_COLUMNSET_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Set of column indices, one bit per column</summary>
+  /// <remarks>
+  ///   Grows as needed, so entities can map any number of columns. Bits that were never
+  ///   set count as cleared, two sets compare equal if they contain the same columns no
+  ///   matter how many bits each has allocated.
+  /// </remarks>
+  class ColumnSet {
+
+    /// <summary>Initializes a new, empty column set</summary>
+    public: ColumnSet() = default;
+
+    /// <summary>Initializes a new, empty column set with room for some columns</summary>
+    /// <param name="columnCount">Number of columns the set will have room for</param>
+    public: explicit ColumnSet(std::size_t columnCount);
+
+    /// <summary>Checks whether the set contains the specified column</summary>
+    /// <param name="index">Index of the column that will be checked</param>
+    /// <returns>True if the column is in the set, false otherwise</returns>
+    public: inline bool Test(std::size_t index) const noexcept;
+
+    /// <summary>Adds a column to or removes a column from the set</summary>
+    /// <param name="index">Index of the column that will be added or removed</param>
+    /// <param name="value">True to add the column, false to remove it</param>
+    public: void Set(std::size_t index, bool value = true);
+
+    /// <summary>Counts the number of columns in the set</summary>
+    /// <returns>The number of columns in the set</returns>
+    public: std::size_t Count() const noexcept;
+
+    /// <summary>Checks whether the set contains any columns at all</summary>
+    /// <returns>True if at least one column is in the set</returns>
+    public: inline bool Any() const noexcept;
+
+    /// <summary>Checks whether the set is empty</summary>
+    /// <returns>True if no column is in the set</returns>
+    public: inline bool None() const noexcept;
+
+    /// <summary>Checks whether two column sets contain the same columns</summary>
+    /// <param name="other">Column set that will be compared</param>
+    /// <returns>True if both sets contain the same columns</returns>
+    public: bool operator ==(const ColumnSet &other) const noexcept;
+
+    /// <summary>Orders two column sets so they can be used as map keys</summary>
+    /// <param name="other">Column set that will be compared</param>
+    /// <returns>True if this set is ordered before the other one</returns>
+    public: bool operator <(const ColumnSet &other) const noexcept;
+
+    /// <summary>One flag for each column, columns beyond the end are not in the set</summary>
+    private: std::vector<bool> bits;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool ColumnSet::Test(std::size_t index) const noexcept {
+    return (index < this->bits.size()) && this->bits[index];
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool ColumnSet::Any() const noexcept {
+    return (Count() > 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline bool ColumnSet::None() const noexcept {
+    return (Count() == 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_COLUMNSET_H
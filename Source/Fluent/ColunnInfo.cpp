@@ -37,12 +37,14 @@ namespace Nuclex::ThinOrm::Fluent {
     const std::u8string name,
     const std::type_info &type,
     EntityMappingConfigurator::GetAttributeValueFunction getter,
-    EntityMappingConfigurator::SetAttributeValueFunction setter
+    EntityMappingConfigurator::SetAttributeValueFunction setter,
+    EntityMappingConfigurator::ReadAttributeFunction reader
   ) :
     Name(name),
     Type(type),
     Getter(getter),
     Setter(setter),
+    Reader(reader),
     IsAutogenerated(false),
     IsPrimaryKey(false),
     IsNullable(false) {}
@@ -0,0 +1,517 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./EntityLayout.h"
+
+#include "../Utilities/IdentifierQuoter.h" // for IdentifierQuoter
+
+#include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append()
+
+#include <stdexcept> // for std::invalid_argument
+#include <string> // for std::u8string
+#include <utility> // for std::move()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends a list of an entity's primary key columns to a statement</summary>
+  /// <param name="statement">Statement the primary key columns will be appended to</param>
+  /// <param name="layout">Layout of the entity whose primary key will be listed</param>
+  /// <param name="quoteStyle">Quotes that will be put around the column names</param>
+  void appendKeyColumns(
+    std::u8string &statement,
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout,
+    Nuclex::ThinOrm::Dialects::QuoteStyle quoteStyle
+  ) {
+    bool isFirst = true;
+    for(std::size_t index = 0; index < layout.Columns.size(); ++index) {
+      if(layout.PrimaryKeyColumns.Test(index)) {
+        if(!isFirst) {
+          statement.append(u8", ", 2);
+        }
+        statement.append(layout.GetQuotedColumnName(index, quoteStyle));
+        isFirst = false;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends a WHERE clause selecting rows after a given primary key</summary>
+  /// <param name="statement">Statement the WHERE clause will be appended to</param>
+  /// <param name="layout">Layout of the entity whose primary key will be compared</param>
+  /// <param name="quoteStyle">Quotes that will be put around the column names</param>
+  /// <remarks>
+  ///   Composite keys are compared as row values, i.e. <code>(a, b) &gt; ({key0}, {key1})
+  ///   </code>, which compares the columns lexicographically and matches the order of
+  ///   the ORDER BY clause. SQLite, PostgreSQL and MySQL can all use the primary key
+  ///   index for this comparison.
+  /// </remarks>
+  void appendKeyComparison(
+    std::u8string &statement,
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout,
+    Nuclex::ThinOrm::Dialects::QuoteStyle quoteStyle
+  ) {
+    std::size_t keyColumnCount = layout.PrimaryKeyColumns.Count();
+
+    statement.append(u8" WHERE ", 7);
+    if(keyColumnCount >= 2) {
+      statement.push_back(u8'(');
+    }
+    appendKeyColumns(statement, layout, quoteStyle);
+    if(keyColumnCount >= 2) {
+      statement.append(u8") > (", 5);
+    } else {
+      statement.append(u8" > ", 3);
+    }
+
+    for(std::size_t index = 0; index < keyColumnCount; ++index) {
+      if(index > 0) {
+        statement.append(u8", ", 2);
+      }
+      statement.append(u8"{key", 4);
+      Nuclex::Support::Text::lexical_append(statement, index);
+      statement.push_back(u8'}');
+    }
+    if(keyColumnCount >= 2) {
+      statement.push_back(u8')');
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends an ORDER BY clause sorting by the primary key</summary>
+  /// <param name="statement">Statement the ORDER BY clause will be appended to</param>
+  /// <param name="layout">Layout of the entity whose primary key will be used</param>
+  /// <param name="quoteStyle">Quotes that will be put around the column names</param>
+  void appendKeyOrder(
+    std::u8string &statement,
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout,
+    Nuclex::ThinOrm::Dialects::QuoteStyle quoteStyle
+  ) {
+    statement.append(u8" ORDER BY ", 10);
+    appendKeyColumns(statement, layout, quoteStyle);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends a multi-row INSERT statement for the specified columns</summary>
+  /// <param name="statement">Statement the INSERT will be appended to</param>
+  /// <param name="layout">Layout of the entity whose rows will be inserted</param>
+  /// <param name="columns">Columns the statement provides values for</param>
+  /// <param name="quoteStyle">Quotes that will be put around identifiers</param>
+  /// <param name="rowCount">Number of rows the statement will insert</param>
+  void appendInsert(
+    std::u8string &statement,
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout,
+    const Nuclex::ThinOrm::Fluent::ColumnSet &columns,
+    Nuclex::ThinOrm::Dialects::QuoteStyle quoteStyle,
+    std::size_t rowCount
+  ) {
+    std::size_t columnCount = layout.Columns.size();
+
+    statement.append(u8"INSERT INTO ", 12);
+    statement.append(layout.GetQuotedTableName(quoteStyle));
+    statement.append(u8" (", 2);
+    {
+      bool isFirst = true;
+      for(std::size_t index = 0; index < columnCount; ++index) {
+        if(columns.Test(index)) {
+          if(!isFirst) {
+            statement.append(u8", ", 2);
+          }
+          statement.append(layout.GetQuotedColumnName(index, quoteStyle));
+          isFirst = false;
+        }
+      }
+    }
+    statement.append(u8") VALUES ", 9);
+
+    std::size_t valueCount = columns.Count();
+    std::size_t parameterIndex = 0;
+    for(std::size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+      statement.append((rowIndex == 0) ? u8"(" : u8", (");
+      for(std::size_t valueIndex = 0; valueIndex < valueCount; ++valueIndex) {
+        if(valueIndex > 0) {
+          statement.append(u8", ", 2);
+        }
+        statement.append(u8"{p", 2);
+        Nuclex::Support::Text::lexical_append(statement, parameterIndex);
+        statement.push_back(u8'}');
+        ++parameterIndex;
+      }
+      statement.push_back(u8')');
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Generates a select plan for an entity layout</summary>
+  /// <param name="layout">Layout of the entity class the plan will fetch</param>
+  /// <param name="shape">Kind of SELECT statement that will be generated</param>
+  /// <param name="quoteStyle">Quotes that will be put around identifiers</param>
+  /// <returns>A new select plan for the entity class</returns>
+  Nuclex::ThinOrm::Fluent::SelectPlan compileSelectPlan(
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout,
+    Nuclex::ThinOrm::Fluent::SelectShape shape,
+    Nuclex::ThinOrm::Dialects::QuoteStyle quoteStyle
+  ) {
+    using Nuclex::ThinOrm::Fluent::EntityMappingConfigurator;
+    using Nuclex::ThinOrm::Fluent::SelectShape;
+
+    std::size_t columnCount = layout.Columns.size();
+
+    std::vector<EntityMappingConfigurator::ReadAttributeFunction *> readers;
+    readers.reserve(columnCount);
+
+    // The columns are listed explicitly, so the nth result column is always
+    // the column whose reader was recorded at index n
+    std::u8string statement(u8"SELECT ", 7);
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(index > 0) {
+        statement.append(u8", ", 2);
+      }
+      statement.append(layout.GetQuotedColumnName(index, quoteStyle));
+      readers.push_back(layout.Columns[index].Reader);
+    }
+    statement.append(u8" FROM ", 6);
+    statement.append(layout.GetQuotedTableName(quoteStyle));
+
+    switch(shape) {
+      case SelectShape::Paged: {
+
+        // Without an ORDER BY clause, the database may return rows in any order,
+        // so consecutive pages could overlap or skip rows
+        if(layout.PrimaryKeyColumns.Any()) {
+          appendKeyOrder(statement, layout, quoteStyle);
+        }
+        statement.append(u8" LIMIT {limit} OFFSET {offset}", 30);
+        break;
+      }
+      case SelectShape::KeyOrderedAfter: {
+        appendKeyComparison(statement, layout, quoteStyle);
+        [[fallthrough]];
+      }
+      case SelectShape::KeyOrdered: {
+        appendKeyOrder(statement, layout, quoteStyle);
+        statement.append(u8" LIMIT {limit}", 14);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+
+    return Nuclex::ThinOrm::Fluent::SelectPlan(
+      Nuclex::ThinOrm::Query(statement), std::move(readers)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityLayout::EntityLayout(const TableInfo &tableInfo) :
+    Type(tableInfo.Type),
+    TableName(tableInfo.Name),
+    Columns(tableInfo.Columns),
+    PrimaryKeyColumns(tableInfo.Columns.size()),
+    AutogeneratedColumns(tableInfo.Columns.size()),
+    InsertColumns(tableInfo.Columns.size()),
+    UpsertColumns(tableInfo.Columns.size()),
+    UpdatableColumns(tableInfo.Columns.size()),
+    quotedTableNames(),
+    quotedColumnNames(),
+    selectPlans() {
+    using Utilities::IdentifierQuoter;
+
+    std::size_t columnCount = this->Columns.size();
+
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      const ColumnInfo &column = this->Columns[index];
+      this->PrimaryKeyColumns.Set(index, column.IsPrimaryKey);
+      this->AutogeneratedColumns.Set(index, column.IsAutogenerated);
+      this->InsertColumns.Set(index, !column.IsAutogenerated);
+      this->UpsertColumns.Set(index, column.IsPrimaryKey || !column.IsAutogenerated);
+      this->UpdatableColumns.Set(index, !column.IsPrimaryKey && !column.IsAutogenerated);
+    }
+
+    // The connection only tells which quotes it expects when a query is run,
+    // so the names and select plans are prepared for each quote style
+    for(std::size_t styleIndex = 0; styleIndex < QuoteStyleCount; ++styleIndex) {
+      Dialects::QuoteStyle quoteStyle = static_cast<Dialects::QuoteStyle>(styleIndex);
+
+      this->quotedTableNames[styleIndex] = IdentifierQuoter::Quote(this->TableName, quoteStyle);
+      this->quotedColumnNames[styleIndex].reserve(columnCount);
+      for(std::size_t index = 0; index < columnCount; ++index) {
+        this->quotedColumnNames[styleIndex].push_back(
+          IdentifierQuoter::Quote(this->Columns[index].Name, quoteStyle)
+        );
+      }
+
+      // Entities without columns can be registered, they just can't be queried
+      std::array<std::optional<SelectPlan>, 4> &plans = this->selectPlans[styleIndex];
+      if(columnCount > 0) {
+        plans[static_cast<std::size_t>(SelectShape::All)].emplace(
+          compileSelectPlan(*this, SelectShape::All, quoteStyle)
+        );
+        plans[static_cast<std::size_t>(SelectShape::Paged)].emplace(
+          compileSelectPlan(*this, SelectShape::Paged, quoteStyle)
+        );
+        if(this->PrimaryKeyColumns.Any()) {
+          plans[static_cast<std::size_t>(SelectShape::KeyOrdered)].emplace(
+            compileSelectPlan(*this, SelectShape::KeyOrdered, quoteStyle)
+          );
+          plans[static_cast<std::size_t>(SelectShape::KeyOrderedAfter)].emplace(
+            compileSelectPlan(*this, SelectShape::KeyOrderedAfter, quoteStyle)
+          );
+        }
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  const SelectPlan &EntityLayout::GetSelectPlan(
+    SelectShape shape, Dialects::QuoteStyle quoteStyle
+  ) const {
+    const std::optional<SelectPlan> &plan = (
+      this->selectPlans[static_cast<std::size_t>(quoteStyle)][static_cast<std::size_t>(shape)]
+    );
+    if(!plan.has_value()) [[unlikely]] {
+      if(this->Columns.empty()) {
+        throw std::invalid_argument(
+          reinterpret_cast<const char *>(
+            u8"Tried to query an entity class that has no columns mapped to it"
+          )
+        );
+      } else {
+        throw std::invalid_argument(
+          reinterpret_cast<const char *>(
+            u8"Tried to order by primary key for an entity class that has no columns "
+            u8"registered as its primary key"
+          )
+        );
+      }
+    }
+
+    return plan.value();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::u8string EntityLayout::FormInsertStatement(
+    Dialects::QuoteStyle quoteStyle, std::size_t rowCount
+  ) const {
+    if(this->InsertColumns.None()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Tried to insert an entity class whose columns are all auto-generated"
+        )
+      );
+    }
+
+    std::u8string statement;
+    appendInsert(statement, *this, this->InsertColumns, quoteStyle, rowCount);
+    return statement;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::u8string EntityLayout::FormUpsertStatement(
+    Dialects::UpsertStyle style, Dialects::QuoteStyle quoteStyle, std::size_t rowCount
+  ) const {
+    if(this->PrimaryKeyColumns.None()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Tried to upsert an entity class that has no columns registered "
+          u8"as its primary key"
+        )
+      );
+    }
+
+    bool isOnDuplicateKey = (style == Dialects::UpsertStyle::OnDuplicateKeyUpdate);
+    std::size_t columnCount = this->Columns.size();
+
+    std::u8string statement;
+    appendInsert(statement, *this, this->UpsertColumns, quoteStyle, rowCount);
+
+    // Every written column that isn't part of the key takes the rejected row's value
+    std::u8string assignments;
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->UpsertColumns.Test(index) && !this->PrimaryKeyColumns.Test(index)) {
+        if(!assignments.empty()) {
+          assignments.append(u8", ", 2);
+        }
+        const std::u8string &columnName = this->GetQuotedColumnName(index, quoteStyle);
+        assignments.append(columnName);
+        if(isOnDuplicateKey) {
+          assignments.append(u8" = VALUES(", 10);
+          assignments.append(columnName);
+          assignments.push_back(u8')');
+        } else {
+          assignments.append(u8" = excluded.", 12);
+          assignments.append(columnName);
+        }
+      }
+    }
+
+    if(isOnDuplicateKey) {
+      statement.append(u8" ON DUPLICATE KEY UPDATE ", 25);
+
+      // If the entity consists only of its key, there is nothing to update,
+      // but MySQL has no way to say that other than a dummy assignment
+      if(assignments.empty()) {
+        std::size_t keyIndex = 0;
+        while(!this->PrimaryKeyColumns.Test(keyIndex)) {
+          ++keyIndex;
+        }
+        const std::u8string &keyName = this->GetQuotedColumnName(keyIndex, quoteStyle);
+        assignments.append(keyName);
+        assignments.append(u8" = ", 3);
+        assignments.append(keyName);
+      }
+      statement.append(assignments);
+    } else {
+      statement.append(u8" ON CONFLICT (", 14);
+      bool isFirst = true;
+      for(std::size_t index = 0; index < columnCount; ++index) {
+        if(this->PrimaryKeyColumns.Test(index)) {
+          if(!isFirst) {
+            statement.append(u8", ", 2);
+          }
+          statement.append(this->GetQuotedColumnName(index, quoteStyle));
+          isFirst = false;
+        }
+      }
+      if(assignments.empty()) {
+        statement.append(u8") DO NOTHING", 12);
+      } else {
+        statement.append(u8") DO UPDATE SET ", 16);
+        statement.append(assignments);
+      }
+    }
+
+    return statement;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::u8string EntityLayout::FormUpdateStatement(
+    const ColumnSet &assignedColumns, Dialects::QuoteStyle quoteStyle
+  ) const {
+    if(this->PrimaryKeyColumns.None()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Tried to update an entity class that has no columns registered "
+          u8"as its primary key"
+        )
+      );
+    }
+    if(assignedColumns.None()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"An update has to assign at least one column")
+      );
+    }
+
+    std::size_t columnCount = this->Columns.size();
+    std::size_t parameterIndex = 0;
+
+    std::u8string statement(u8"UPDATE ", 7);
+    statement.append(this->GetQuotedTableName(quoteStyle));
+    statement.append(u8" SET ", 5);
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(assignedColumns.Test(index)) {
+        if(parameterIndex > 0) {
+          statement.append(u8", ", 2);
+        }
+        statement.append(this->GetQuotedColumnName(index, quoteStyle));
+        statement.append(u8" = {p", 5);
+        Nuclex::Support::Text::lexical_append(statement, parameterIndex);
+        statement.push_back(u8'}');
+        ++parameterIndex;
+      }
+    }
+
+    statement.append(u8" WHERE ", 7);
+    bool isFirst = true;
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->PrimaryKeyColumns.Test(index)) {
+        if(!isFirst) {
+          statement.append(u8" AND ", 5);
+        }
+        statement.append(this->GetQuotedColumnName(index, quoteStyle));
+        statement.append(u8" = {p", 5);
+        Nuclex::Support::Text::lexical_append(statement, parameterIndex);
+        statement.push_back(u8'}');
+        ++parameterIndex;
+        isFirst = false;
+      }
+    }
+
+    return statement;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityLayout::BindUpdateParameters(
+    Query &statement, const void *entity, const ColumnSet &assignedColumns
+  ) const {
+    std::size_t columnCount = this->Columns.size();
+    std::size_t parameterIndex = 0;
+
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(assignedColumns.Test(index)) {
+        statement.SetParameterValue(parameterIndex, this->Columns[index].Getter(entity));
+        ++parameterIndex;
+      }
+    }
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->PrimaryKeyColumns.Test(index)) {
+        statement.SetParameterValue(parameterIndex, this->Columns[index].Getter(entity));
+        ++parameterIndex;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityLayout::GetPrimaryKey(const void *entity, std::vector<Value> &key) const {
+    key.clear();
+    key.reserve(this->PrimaryKeyColumns.Count());
+
+    std::size_t columnCount = this->Columns.size();
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->PrimaryKeyColumns.Test(index)) {
+        key.push_back(this->Columns[index].Getter(entity));
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
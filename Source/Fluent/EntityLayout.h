@@ -0,0 +1,203 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_ENTITYLAYOUT_H
+#define NUCLEX_THINORM_FLUENT_ENTITYLAYOUT_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#include "Nuclex/ThinOrm/Dialects/UpsertStyle.h" // for UpsertStyle
+#include "Nuclex/ThinOrm/Dialects/QuoteStyle.h" // for QuoteStyle
+
+#include "./TableInfo.h"
+#include "./SelectPlan.h"
+#include "./ColumnSet.h"
+
+#include <array> // for std::array<>
+#include <optional> // for std::optional<>
+#include <string> // for std::u8string
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Immutable, query-ready description of how an entity maps to its table</summary>
+  /// <remarks>
+  ///   <para>
+  ///     When the entity registry is frozen, each registered <see cref="TableInfo" /> is
+  ///     compiled into an entity layout. The columns are stored in a contiguous array in
+  ///     the order they were declared, the primary key and auto-generated flags are
+  ///     collected into bit sets that can be tested or iterated without touching the
+  ///     column records and the table and column names are quoted up front, once for
+  ///     each identifier quote style a database might expect.
+  ///   </para>
+  ///   <para>
+  ///     Entity layouts never change after they have been created, so any number of
+  ///     threads can read them at the same time without synchronization.
+  ///   </para>
+  /// </remarks>
+  class EntityLayout {
+
+    /// <summary>Compiles the layout for a registered entity table</summary>
+    /// <param name="tableInfo">Table registration the layout will be compiled from</param>
+    public: explicit EntityLayout(const TableInfo &tableInfo);
+
+    /// <summary>Looks up the select plan for the specified statement shape</summary>
+    /// <param name="shape">Kind of SELECT statement the plan should use</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <returns>The select plan for the specified shape</returns>
+    public: const SelectPlan &GetSelectPlan(
+      SelectShape shape, Dialects::QuoteStyle quoteStyle
+    ) const;
+
+    /// <summary>Looks up the name of the table, quoted for use in SQL statements</summary>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <returns>The quoted table name</returns>
+    public: inline const std::u8string &GetQuotedTableName(
+      Dialects::QuoteStyle quoteStyle
+    ) const;
+
+    /// <summary>Looks up the name of a column, quoted for use in SQL statements</summary>
+    /// <param name="index">Index of the column whose quoted name will be returned</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <returns>The quoted column name</returns>
+    public: inline const std::u8string &GetQuotedColumnName(
+      std::size_t index, Dialects::QuoteStyle quoteStyle
+    ) const;
+
+    /// <summary>Generates a statement that inserts multiple rows</summary>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <param name="rowCount">Number of rows the statement will insert</param>
+    /// <returns>
+    ///   The statement text. Its parameters are named {p0}, {p1}, ... and take the values
+    ///   of the <see cref="InsertColumns" />, row by row, column by column.
+    /// </returns>
+    public: std::u8string FormInsertStatement(
+      Dialects::QuoteStyle quoteStyle, std::size_t rowCount
+    ) const;
+
+    /// <summary>Generates a statement that inserts or updates multiple rows</summary>
+    /// <param name="style">Syntax the database uses for upserts</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <param name="rowCount">Number of rows the statement will insert or update</param>
+    /// <returns>
+    ///   The statement text. Its parameters are named {p0}, {p1}, ... and take the values
+    ///   of the <see cref="UpsertColumns" />, row by row, column by column.
+    /// </returns>
+    public: std::u8string FormUpsertStatement(
+      Dialects::UpsertStyle style, Dialects::QuoteStyle quoteStyle, std::size_t rowCount
+    ) const;
+
+    /// <summary>Generates a statement that updates some columns of a single row</summary>
+    /// <param name="assignedColumns">Columns that will be written by the statement</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <returns>
+    ///   The statement text. Its parameters are named {p0}, {p1}, ... and take the values
+    ///   of the assigned columns followed by the values of the primary key columns, each
+    ///   in the order the columns were declared.
+    /// </returns>
+    public: std::u8string FormUpdateStatement(
+      const ColumnSet &assignedColumns, Dialects::QuoteStyle quoteStyle
+    ) const;
+
+    /// <summary>Assigns an entity's attributes to the parameters of an update statement</summary>
+    /// <param name="statement">
+    ///   Statement generated by <see cref="FormUpdateStatement" /> for the same columns
+    /// </param>
+    /// <param name="entity">Entity whose attributes will be assigned</param>
+    /// <param name="assignedColumns">Columns the statement has been generated for</param>
+    public: void BindUpdateParameters(
+      Query &statement, const void *entity, const ColumnSet &assignedColumns
+    ) const;
+
+    /// <summary>Reads the primary key of an entity</summary>
+    /// <param name="entity">Entity whose primary key will be read</param>
+    /// <param name="key">Receives one value per primary key column</param>
+    public: void GetPrimaryKey(const void *entity, std::vector<Value> &key) const;
+
+    /// <summary>Type of the entity class the table is mapped to</summary>
+    public: const std::type_info &Type;
+    /// <summary>Name of the table in the database</summary>
+    public: std::u8string TableName;
+
+    /// <summary>Mapped columns in the order they were declared</summary>
+    public: std::vector<ColumnInfo> Columns;
+
+    /// <summary>Indices of the columns that form the primary key</summary>
+    public: ColumnSet PrimaryKeyColumns;
+    /// <summary>Indices of the columns whose values are generated by the database</summary>
+    public: ColumnSet AutogeneratedColumns;
+    /// <summary>Indices of the columns that are written by a plain insert</summary>
+    /// <remarks>
+    ///   All columns except the auto-generated ones, which the database fills in.
+    /// </remarks>
+    public: ColumnSet InsertColumns;
+    /// <summary>Indices of the columns that are written by an upsert</summary>
+    /// <remarks>
+    ///   All columns except the auto-generated ones, but including the primary key even
+    ///   if it is auto-generated, since an upsert has to know which row it targets.
+    /// </remarks>
+    public: ColumnSet UpsertColumns;
+    /// <summary>Indices of the columns that can be changed by an update</summary>
+    /// <remarks>
+    ///   All columns except the primary key, which identifies the row to update, and
+    ///   the auto-generated ones, which are maintained by the database.
+    /// </remarks>
+    public: ColumnSet UpdatableColumns;
+
+    /// <summary>Number of identifier quote styles the layout prepares names for</summary>
+    private: static constexpr std::size_t QuoteStyleCount = 3;
+
+    /// <summary>Quoted table name for each quote style</summary>
+    private: std::array<std::u8string, QuoteStyleCount> quotedTableNames;
+    /// <summary>Quoted column names for each quote style, indexed like the columns</summary>
+    private: std::array<std::vector<std::u8string>, QuoteStyleCount> quotedColumnNames;
+    /// <summary>Select plans for each quote style and shape</summary>
+    /// <remarks>
+    ///   Plans are missing if the entity has no columns or, for the shapes ordered by
+    ///   primary key, if the entity has no primary key.
+    /// </remarks>
+    private: std::array<
+      std::array<std::optional<SelectPlan>, 4>, QuoteStyleCount
+    > selectPlans;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline const std::u8string &EntityLayout::GetQuotedTableName(
+    Dialects::QuoteStyle quoteStyle
+  ) const {
+    return this->quotedTableNames[static_cast<std::size_t>(quoteStyle)];
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline const std::u8string &EntityLayout::GetQuotedColumnName(
+    std::size_t index, Dialects::QuoteStyle quoteStyle
+  ) const {
+    return this->quotedColumnNames[static_cast<std::size_t>(quoteStyle)][index];
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_ENTITYLAYOUT_H
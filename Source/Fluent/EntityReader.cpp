@@ -0,0 +1,177 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Fluent/EntityReader.h"
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+#include "Nuclex/ThinOrm/DataContext.h" // for DataContext
+#include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+#include "Nuclex/ThinOrm/Connections/Connection.h" // for Connection
+
+#include "./GlobalEntityRegistry.Implementation.h"
+
+#include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append()
+
+#include <algorithm> // for std::min()
+#include <limits> // for std::numeric_limits<>
+#include <stdexcept> // for std::runtime_error, std::invalid_argument
+#include <string> // for std::u8string
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Converts a row count into a value that can be bound to a query</summary>
+  /// <param name="rowCount">Row count that will be converted</param>
+  /// <returns>A value holding the row count, clamped to the range of a 64-bit integer</returns>
+  Nuclex::ThinOrm::Value rowCountToValue(std::size_t rowCount) {
+    const std::size_t maximumRowCount = static_cast<std::size_t>(
+      std::numeric_limits<std::int64_t>::max()
+    );
+    return Nuclex::ThinOrm::Value(
+      static_cast<std::int64_t>(std::min(rowCount, maximumRowCount))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Picks the kind of SELECT statement needed for a query shape</summary>
+  /// <param name="shape">Query shape for which the SELECT statement will be picked</param>
+  /// <returns>The kind of SELECT statement that can run the query</returns>
+  Nuclex::ThinOrm::Fluent::SelectShape selectShapeFromQueryShape(
+    const Nuclex::ThinOrm::Fluent::QueryShape &shape
+  ) {
+    using Nuclex::ThinOrm::Fluent::SelectShape;
+
+    if(shape.IsOrderedByKey) {
+      return shape.AfterKey.empty() ? SelectShape::KeyOrdered : SelectShape::KeyOrderedAfter;
+    } else if((shape.Offset != 0) || shape.Limit.has_value()) {
+      return SelectShape::Paged;
+    } else {
+      return SelectShape::All;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityReader::EntityReader(
+    DataContext &dataContext, const std::type_info &entityType, const QueryShape &shape
+  ) :
+    layout(&dataContext.GetEntityRegistry().implementation->GetEntityLayout(entityType)),
+    lease(dataContext.LeaseConnection()),
+    plan(
+      &this->layout->GetSelectPlan(
+        selectShapeFromQueryShape(shape), this->lease->GetQuoteStyle()
+      )
+    ),
+    query(this->plan->Statement),
+    reader() {
+
+    if(shape.IsOrderedByKey) {
+      if(shape.Offset != 0) {
+        throw std::invalid_argument(
+          reinterpret_cast<const char *>(
+            u8"Queries ordered by primary key for keyset pagination can not skip rows"
+          )
+        );
+      }
+
+      this->query.SetParameterValue(
+        u8"limit", rowCountToValue(shape.Limit.value_or(std::numeric_limits<std::size_t>::max()))
+      );
+
+      // The key parameters are numbered in the order of the primary key columns
+      if(!shape.AfterKey.empty()) {
+        std::size_t keyColumnCount = this->layout->PrimaryKeyColumns.Count();
+        if(shape.AfterKey.size() != keyColumnCount) {
+          throw std::invalid_argument(
+            reinterpret_cast<const char *>(
+              u8"Keyset position must provide one value per primary key column"
+            )
+          );
+        }
+        for(std::size_t index = 0; index < keyColumnCount; ++index) {
+          std::u8string parameterName(u8"key", 3);
+          Nuclex::Support::Text::lexical_append(parameterName, index);
+          this->query.SetParameterValue(parameterName, shape.AfterKey[index]);
+        }
+      }
+    } else if((shape.Offset != 0) || shape.Limit.has_value()) {
+
+      // Not all databases allow an offset without a limit, so when the caller only skips
+      // rows, the limit is set to the highest value that any database will accept
+      this->query.SetParameterValue(
+        u8"limit", rowCountToValue(shape.Limit.value_or(std::numeric_limits<std::size_t>::max()))
+      );
+      this->query.SetParameterValue(u8"offset", rowCountToValue(shape.Offset));
+    }
+
+    this->reader = this->lease->RunRowQuery(this->query);
+    if(this->reader->CountColumns() != this->plan->Readers.size()) {
+      throw std::runtime_error(
+        reinterpret_cast<const char *>(
+          u8"Database returned a different number of columns than the generated "
+          u8"SELECT statement requested"
+        )
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityReader::~EntityReader() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool EntityReader::MoveToNext() {
+    return this->reader->MoveToNext();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::optional<std::size_t> EntityReader::GetRowCountHint() const {
+    return this->reader->GetRowCountHint();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityReader::GetPrimaryKey(const void *entity, std::vector<Value> &key) const {
+    this->layout->GetPrimaryKey(entity, key);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityReader::ReadCurrentRow(void *entity) const {
+    std::size_t columnCount = this->plan->Readers.size();
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      this->plan->Readers[index](entity, *this->reader, index);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
@@ -0,0 +1,296 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Fluent/EntityTracker.h"
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+#include "Nuclex/ThinOrm/DataContext.h" // for DataContext
+#include "Nuclex/ThinOrm/Connections/Connection.h" // for Connection
+
+#include "./GlobalEntityRegistry.Implementation.h"
+
+#include <cstddef> // for std::byte
+#include <span> // for std::span<>
+#include <stdexcept> // for std::invalid_argument, std::logic_error
+#include <string_view> // for std::u8string_view
+#include <utility> // for std::move()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends the raw bytes of a trivially copyable value to a byte string</summary>
+  /// <typeparam name="TScalar">Type of value whose bytes will be appended</typeparam>
+  /// <param name="fingerprint">Byte string the value's bytes will be appended to</param>
+  /// <param name="scalar">Value whose bytes will be appended</param>
+  template<typename TScalar>
+  void appendBytes(std::u8string &fingerprint, const TScalar &scalar) {
+    fingerprint.append(reinterpret_cast<const char8_t *>(&scalar), sizeof(scalar));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends a length-prefixed sequence of bytes to a byte string</summary>
+  /// <param name="fingerprint">Byte string the bytes will be appended to</param>
+  /// <param name="bytes">Bytes that will be appended</param>
+  void appendSequence(std::u8string &fingerprint, std::span<const std::byte> bytes) {
+    appendBytes(fingerprint, bytes.size());
+    fingerprint.append(reinterpret_cast<const char8_t *>(bytes.data()), bytes.size());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends a byte string that uniquely represents a value</summary>
+  /// <param name="fingerprint">Byte string the value's representation will be appended to</param>
+  /// <param name="value">Value that will be appended</param>
+  /// <remarks>
+  ///   Two values produce the same bytes if and only if they have the same type and
+  ///   content. Variable-length contents are prefixed with their length, so fingerprints
+  ///   of several values can be concatenated without becoming ambiguous.
+  /// </remarks>
+  void appendFingerprint(std::u8string &fingerprint, const Nuclex::ThinOrm::Value &value) {
+    using Nuclex::ThinOrm::ValueType;
+
+    ValueType type = value.GetType();
+    fingerprint.push_back(static_cast<char8_t>(type));
+    if(value.IsEmpty()) {
+      fingerprint.push_back(u8'\0');
+      return;
+    }
+    fingerprint.push_back(u8'\1');
+
+    switch(type) {
+      case ValueType::Boolean:
+      case ValueType::UInt8:
+      case ValueType::Int16:
+      case ValueType::Int32:
+      case ValueType::Int64: {
+        appendBytes(fingerprint, value.AsInt64().value());
+        break;
+      }
+      case ValueType::Float:
+      case ValueType::Double: {
+        appendBytes(fingerprint, value.AsDouble().value());
+        break;
+      }
+      case ValueType::Date:
+      case ValueType::Time:
+      case ValueType::DateTime: {
+        appendBytes(fingerprint, value.AsDateTime().value().GetTicks());
+        break;
+      }
+      case ValueType::Decimal: {
+        std::u8string text = value.AsString().value();
+        appendSequence(fingerprint, std::as_bytes(std::span<const char8_t>(text)));
+        break;
+      }
+      case ValueType::String: {
+        std::u8string_view text = value.GetStringView().value();
+        appendSequence(fingerprint, std::as_bytes(std::span<const char8_t>(text)));
+        break;
+      }
+      case ValueType::Blob: {
+        appendSequence(fingerprint, value.GetBlobView().value());
+        break;
+      }
+      default: {
+        throw std::invalid_argument(
+          reinterpret_cast<const char *>(u8"Attribute has a value type that can not be tracked")
+        );
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Forms the key under which an entity's snapshot is stored</summary>
+  /// <param name="layout">Layout of the entity class</param>
+  /// <param name="entity">Entity whose snapshot key will be formed</param>
+  /// <returns>The fingerprints of the entity's primary key columns</returns>
+  std::u8string formSnapshotKey(
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout, const void *entity
+  ) {
+    std::u8string key;
+
+    std::size_t columnCount = layout.Columns.size();
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(layout.PrimaryKeyColumns.Test(index)) {
+        appendFingerprint(key, layout.Columns[index].Getter(entity));
+      }
+    }
+
+    return key;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Throws an exception reporting that an entity isn't being tracked</summary>
+  [[noreturn]] void throwEntityNotTracked() {
+    throw std::logic_error(
+      reinterpret_cast<const char *>(
+        u8"Entity is not being tracked. Either it was never tracked or its primary key "
+        u8"has been changed since."
+      )
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityTracker::EntityTracker(DataContext &dataContext, const std::type_info &entityType) :
+    dataContext(&dataContext),
+    layout(&dataContext.GetEntityRegistry().implementation->GetEntityLayout(entityType)),
+    snapshots() {
+
+    if(this->layout->PrimaryKeyColumns.None()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Tried to track an entity class that has no columns registered "
+          u8"as its primary key"
+        )
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityTracker::~EntityTracker() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityTracker::Track(const void *entity) {
+    std::size_t columnCount = this->layout->Columns.size();
+
+    // Only the updatable columns are ever compared, the others are left empty
+    std::vector<std::u8string> snapshot(columnCount);
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->layout->UpdatableColumns.Test(index)) {
+        appendFingerprint(snapshot[index], this->layout->Columns[index].Getter(entity));
+      }
+    }
+
+    this->snapshots.insert_or_assign(formSnapshotKey(*this->layout, entity), std::move(snapshot));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityTracker::Forget(const void *entity) {
+    this->snapshots.erase(formSnapshotKey(*this->layout, entity));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void EntityTracker::Clear() noexcept {
+    this->snapshots.clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t EntityTracker::CountTrackedEntities() const noexcept {
+    return this->snapshots.size();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool EntityTracker::IsTracked(const void *entity) const {
+    return this->snapshots.contains(formSnapshotKey(*this->layout, entity));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool EntityTracker::HasChanges(const void *entity) const {
+    SnapshotMap::const_iterator iterator = this->snapshots.find(
+      formSnapshotKey(*this->layout, entity)
+    );
+    if(iterator == this->snapshots.end()) {
+      throwEntityNotTracked();
+    }
+
+    std::u8string fingerprint;
+    std::size_t columnCount = this->layout->Columns.size();
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->layout->UpdatableColumns.Test(index)) {
+        fingerprint.clear();
+        appendFingerprint(fingerprint, this->layout->Columns[index].Getter(entity));
+        if(fingerprint != iterator->second[index]) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t EntityTracker::Update(const void *entity) {
+    SnapshotMap::iterator iterator = this->snapshots.find(
+      formSnapshotKey(*this->layout, entity)
+    );
+    if(iterator == this->snapshots.end()) {
+      throwEntityNotTracked();
+    }
+
+    // Collect the columns that differ from the snapshot, keeping their new fingerprints
+    // so the snapshot can be brought up to date once the row has been written
+    std::size_t columnCount = this->layout->Columns.size();
+    std::vector<std::u8string> &snapshot = iterator->second;
+    std::vector<std::u8string> fingerprints(columnCount);
+    ColumnSet changedColumns(columnCount);
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(this->layout->UpdatableColumns.Test(index)) {
+        appendFingerprint(fingerprints[index], this->layout->Columns[index].Getter(entity));
+        changedColumns.Set(index, fingerprints[index] != snapshot[index]);
+      }
+    }
+    if(changedColumns.None()) {
+      return 0;
+    }
+
+    std::size_t affectedRowCount;
+    {
+      Connections::ConnectionLease lease = this->dataContext->LeaseConnection();
+      Query statement = (
+        this->dataContext->GetEntityRegistry().implementation->GetUpdateStatement(
+          *this->layout, changedColumns, lease->GetQuoteStyle()
+        )
+      );
+      this->layout->BindUpdateParameters(statement, entity, changedColumns);
+      affectedRowCount = lease->RunUpdateQuery(statement);
+    }
+
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(changedColumns.Test(index)) {
+        snapshot[index].swap(fingerprints[index]);
+      }
+    }
+
+    return affectedRowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
@@ -0,0 +1,256 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Fluent/EntityWriter.h"
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+#include "Nuclex/ThinOrm/Fluent/BulkInsertBuilder.h" // for BulkInsertBuilder
+#include "Nuclex/ThinOrm/DataContext.h" // for DataContext
+#include "Nuclex/ThinOrm/Value.h" // for Value
+#include "Nuclex/ThinOrm/Connections/Connection.h" // for Connection
+
+#include "./GlobalEntityRegistry.Implementation.h"
+
+#include <algorithm> // for std::min(), std::max()
+#include <optional> // for std::optional<>
+#include <stdexcept> // for std::invalid_argument
+#include <vector> // for std::vector<>
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether a key value is the placeholder of a not yet inserted entity</summary>
+  /// <param name="value">Value of an auto-generated primary key column</param>
+  /// <returns>True if the value is empty, zero or an empty string</returns>
+  bool isUnassignedKeyValue(const Nuclex::ThinOrm::Value &value) {
+    using Nuclex::ThinOrm::ValueType;
+
+    if(value.IsEmpty()) {
+      return true;
+    }
+
+    switch(value.GetType()) {
+      case ValueType::UInt8:
+      case ValueType::Int16:
+      case ValueType::Int32:
+      case ValueType::Int64: {
+        return (value.AsInt64().value() == 0);
+      }
+      case ValueType::String: {
+        return value.GetStringView().value().empty();
+      }
+      default: {
+        return false;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether an entity's auto-generated primary key is still unassigned</summary>
+  /// <param name="layout">Layout of the entity class</param>
+  /// <param name="entity">Entity whose primary key will be checked</param>
+  /// <returns>True if the entity has not received its key from the database yet</returns>
+  bool hasUnassignedKey(const Nuclex::ThinOrm::Fluent::EntityLayout &layout, const void *entity) {
+    std::size_t columnCount = layout.Columns.size();
+    for(std::size_t index = 0; index < columnCount; ++index) {
+      if(layout.PrimaryKeyColumns.Test(index) && layout.AutogeneratedColumns.Test(index)) {
+        if(isUnassignedKeyValue(layout.Columns[index].Getter(entity))) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Writes entities via multi-row statements holding as many rows as possible</summary>
+  /// <typeparam name="TGetStatementFunction">
+  ///   Function that provides the statement writing a specified number of rows
+  /// </typeparam>
+  /// <param name="connection">Connection on which the statements will be run</param>
+  /// <param name="layout">Layout of the entity class that will be written</param>
+  /// <param name="columns">Columns the statements provide values for</param>
+  /// <param name="entities">Addresses of the entities that will be written</param>
+  /// <param name="getStatement">Called to obtain the statement for each chunk</param>
+  /// <returns>The number of rows the database reported as affected</returns>
+  template<typename TGetStatementFunction>
+  std::size_t writeInChunks(
+    Nuclex::ThinOrm::Connections::Connection &connection,
+    const Nuclex::ThinOrm::Fluent::EntityLayout &layout,
+    const Nuclex::ThinOrm::Fluent::ColumnSet &columns,
+    const std::vector<const std::byte *> &entities,
+    const TGetStatementFunction &getStatement
+  ) {
+    using Nuclex::ThinOrm::Fluent::BulkInsertBuilder;
+    using Nuclex::ThinOrm::Query;
+
+    std::size_t columnCount = layout.Columns.size();
+    std::size_t maximumChunkRowCount = std::min(
+      connection.GetMaximumParameterCount() / std::max<std::size_t>(columns.Count(), 1),
+      BulkInsertBuilder::MaximumRowsPerStatement
+    );
+    if(maximumChunkRowCount == 0) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Table has more columns than the database accepts parameters in one statement"
+        )
+      );
+    }
+
+    // All chunks except the last one have the same size, so at most two different
+    // statements are needed and each is fetched from the registry only once
+    std::optional<Query> fullChunkStatement;
+    std::size_t entityCount = entities.size();
+    std::size_t affectedRowCount = 0;
+    std::size_t entityIndex = 0;
+    while(entityIndex < entityCount) {
+      std::size_t chunkRowCount = std::min(entityCount - entityIndex, maximumChunkRowCount);
+
+      std::optional<Query> remainderStatement;
+      Query *statement;
+      if(chunkRowCount == maximumChunkRowCount) {
+        if(!fullChunkStatement.has_value()) {
+          fullChunkStatement.emplace(getStatement(chunkRowCount));
+        }
+        statement = &fullChunkStatement.value();
+      } else {
+        remainderStatement.emplace(getStatement(chunkRowCount));
+        statement = &remainderStatement.value();
+      }
+
+      std::size_t parameterIndex = 0;
+      for(std::size_t chunkRowIndex = 0; chunkRowIndex < chunkRowCount; ++chunkRowIndex) {
+        const void *entity = entities[entityIndex + chunkRowIndex];
+        for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+          if(columns.Test(columnIndex)) {
+            statement->SetParameterValue(
+              parameterIndex, layout.Columns[columnIndex].Getter(entity)
+            );
+            ++parameterIndex;
+          }
+        }
+      }
+      affectedRowCount += connection.RunUpdateQuery(*statement);
+
+      entityIndex += chunkRowCount;
+    }
+
+    return affectedRowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityWriter::EntityWriter(DataContext &dataContext, const std::type_info &entityType) :
+    dataContext(&dataContext),
+    layout(&dataContext.GetEntityRegistry().implementation->GetEntityLayout(entityType)) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  EntityWriter::~EntityWriter() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t EntityWriter::Upsert(
+    const std::byte *firstEntity, std::size_t entitySize, std::size_t entityCount
+  ) {
+    if(entityCount == 0) {
+      return 0;
+    }
+
+    // New entities all carry the same placeholder key until the database assigns one,
+    // so upserting them would make each new entity overwrite the one before it
+    std::vector<const std::byte *> existingEntities;
+    std::vector<const std::byte *> newEntities;
+    existingEntities.reserve(entityCount);
+    for(std::size_t entityIndex = 0; entityIndex < entityCount; ++entityIndex) {
+      const std::byte *entity = firstEntity + (entityIndex * entitySize);
+      if(hasUnassignedKey(*this->layout, entity)) {
+        newEntities.push_back(entity);
+      } else {
+        existingEntities.push_back(entity);
+      }
+    }
+
+    GlobalEntityRegistry::Implementation &registry = (
+      *this->dataContext->GetEntityRegistry().implementation
+    );
+    Connections::ConnectionLease lease = this->dataContext->LeaseConnection();
+    Dialects::QuoteStyle quoteStyle = lease->GetQuoteStyle();
+
+    std::size_t affectedRowCount = 0;
+    if(!existingEntities.empty()) {
+      Dialects::UpsertStyle style = lease->GetUpsertStyle();
+      affectedRowCount += writeInChunks(
+        *lease, *this->layout, this->layout->UpsertColumns, existingEntities,
+        [&](std::size_t rowCount) {
+          return registry.GetUpsertStatement(*this->layout, style, quoteStyle, rowCount);
+        }
+      );
+    }
+    if(!newEntities.empty()) {
+      affectedRowCount += writeInChunks(
+        *lease, *this->layout, this->layout->InsertColumns, newEntities,
+        [&](std::size_t rowCount) {
+          return registry.GetInsertStatement(*this->layout, quoteStyle, rowCount);
+        }
+      );
+    }
+
+    return affectedRowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t EntityWriter::Update(
+    const std::byte *firstEntity, std::size_t entitySize, std::size_t entityCount
+  ) {
+    if((entityCount == 0) || this->layout->UpdatableColumns.None()) {
+      return 0;
+    }
+
+    Connections::ConnectionLease lease = this->dataContext->LeaseConnection();
+    Query statement = this->dataContext->GetEntityRegistry().implementation->GetUpdateStatement(
+      *this->layout, this->layout->UpdatableColumns, lease->GetQuoteStyle()
+    );
+
+    std::size_t affectedRowCount = 0;
+    for(std::size_t entityIndex = 0; entityIndex < entityCount; ++entityIndex) {
+      const void *entity = firstEntity + (entityIndex * entitySize);
+      this->layout->BindUpdateParameters(statement, entity, this->layout->UpdatableColumns);
+      affectedRowCount += lease->RunUpdateQuery(statement);
+    }
+
+    return affectedRowCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
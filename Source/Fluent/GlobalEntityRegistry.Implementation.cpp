@@ -22,23 +22,165 @@ limitations under the License.
 
 #include "./GlobalEntityRegistry.Implementation.h"
 
-namespace {
+#include <stdexcept> // for std::invalid_argument, std::logic_error
+#include <utility> // for std::move()
+
+namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
+
+  GlobalEntityRegistry::Implementation::Implementation() :
+    Tables(),
+    freezeMutex(),
+    entityLayouts(),
+    publishedEntityLayouts(nullptr),
+    insertStatementMutex(),
+    insertStatements(),
+    upsertStatementMutex(),
+    upsertStatements(),
+    updateStatementMutex(),
+    updateStatements() {}
+
   // ------------------------------------------------------------------------------------------- //
 
-} // anonymous namespace
+  GlobalEntityRegistry::Implementation::~Implementation() = default;
 
-namespace Nuclex::ThinOrm::Fluent {
+  // ------------------------------------------------------------------------------------------- //
+
+  void GlobalEntityRegistry::Implementation::Freeze() {
+    std::lock_guard<std::mutex> freezeScope(this->freezeMutex);
+    if(static_cast<bool>(this->entityLayouts)) {
+      return;
+    }
+
+    std::unique_ptr<TypeEntityLayoutMap> layouts = std::make_unique<TypeEntityLayoutMap>();
+    layouts->reserve(this->Tables.size());
+    for(const TypeTableInfoMap::value_type &table : this->Tables) {
+      layouts->emplace(table.first, EntityLayout(table.second));
+    }
+
+    // The layouts are never modified after this point, so once the pointer has been
+    // published, readers can access them without taking the mutex
+    this->entityLayouts = std::move(layouts);
+    this->publishedEntityLayouts.store(this->entityLayouts.get(), std::memory_order_release);
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
-  GlobalEntityRegistry::Implementation::Implementation() :
-    Tables() {}
+  bool GlobalEntityRegistry::Implementation::IsFrozen() const noexcept {
+    return (this->publishedEntityLayouts.load(std::memory_order_acquire) != nullptr);
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
-  GlobalEntityRegistry::Implementation::~Implementation() = default;
+  void GlobalEntityRegistry::Implementation::RequireNotFrozen() const {
+    if(IsFrozen()) {
+      throw std::logic_error(
+        reinterpret_cast<const char *>(
+          u8"Entity mappings can not be changed after the entity registry has been frozen. "
+          u8"Register all entities before running any queries."
+        )
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  const EntityLayout &GlobalEntityRegistry::Implementation::GetEntityLayout(
+    const std::type_info &entityType
+  ) {
+    const TypeEntityLayoutMap *layouts = this->publishedEntityLayouts.load(
+      std::memory_order_acquire
+    );
+    if(layouts == nullptr) [[unlikely]] {
+      Freeze();
+      layouts = this->publishedEntityLayouts.load(std::memory_order_acquire);
+    }
+
+    TypeEntityLayoutMap::const_iterator iterator = layouts->find(std::type_index(entityType));
+    if(iterator == layouts->end()) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(
+          u8"Tried to use an entity class that had not been registered as an entity class."
+        )
+      );
+    }
+
+    return iterator->second;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Query GlobalEntityRegistry::Implementation::GetInsertStatement(
+    const EntityLayout &layout, Dialects::QuoteStyle quoteStyle, std::size_t rowCount
+  ) {
+    InsertStatementKey key(&layout, quoteStyle, rowCount);
+    {
+      std::lock_guard<std::mutex> insertStatementScope(this->insertStatementMutex);
+
+      InsertStatementMap::const_iterator iterator = this->insertStatements.find(key);
+      if(iterator != this->insertStatements.end()) {
+        return iterator->second;
+      }
+    }
+
+    Query statement(layout.FormInsertStatement(quoteStyle, rowCount));
+    {
+      std::lock_guard<std::mutex> insertStatementScope(this->insertStatementMutex);
+      return this->insertStatements.emplace(key, std::move(statement)).first->second;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Query GlobalEntityRegistry::Implementation::GetUpsertStatement(
+    const EntityLayout &layout,
+    Dialects::UpsertStyle style,
+    Dialects::QuoteStyle quoteStyle,
+    std::size_t rowCount
+  ) {
+    UpsertStatementKey key(&layout, style, quoteStyle, rowCount);
+    {
+      std::lock_guard<std::mutex> upsertStatementScope(this->upsertStatementMutex);
+
+      UpsertStatementMap::const_iterator iterator = this->upsertStatements.find(key);
+      if(iterator != this->upsertStatements.end()) {
+        return iterator->second;
+      }
+    }
+
+    // If two threads generate the same statement at once, the first one to finish wins
+    // and the other thread's statement is thrown away. Both are identical anyway.
+    Query statement(layout.FormUpsertStatement(style, quoteStyle, rowCount));
+    {
+      std::lock_guard<std::mutex> upsertStatementScope(this->upsertStatementMutex);
+      return this->upsertStatements.emplace(key, std::move(statement)).first->second;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Query GlobalEntityRegistry::Implementation::GetUpdateStatement(
+    const EntityLayout &layout,
+    const ColumnSet &assignedColumns,
+    Dialects::QuoteStyle quoteStyle
+  ) {
+    UpdateStatementKey key(&layout, quoteStyle, assignedColumns);
+    {
+      std::lock_guard<std::mutex> updateStatementScope(this->updateStatementMutex);
+
+      UpdateStatementMap::const_iterator iterator = this->updateStatements.find(key);
+      if(iterator != this->updateStatements.end()) {
+        return iterator->second;
+      }
+    }
+
+    Query statement(layout.FormUpdateStatement(assignedColumns, quoteStyle));
+    {
+      std::lock_guard<std::mutex> updateStatementScope(this->updateStatementMutex);
+      return this->updateStatements.emplace(key, std::move(statement)).first->second;
+    }
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
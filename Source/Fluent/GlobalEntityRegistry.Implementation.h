@@ -24,15 +24,33 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h"
 
 #include "./TableInfo.h"
+#include "./EntityLayout.h"
 
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Dialects/UpsertStyle.h" // for UpsertStyle
+#include "Nuclex/ThinOrm/Dialects/QuoteStyle.h" // for QuoteStyle
+
+#include <atomic> // for std::atomic<>
+#include <map> // for std::map<>
+#include <tuple> // for std::tuple<>
 #include <typeindex> // for std::type_index
 #include <unordered_map> // for std::unordered_map<>
+#include <memory> // for std::unique_ptr<>
+#include <mutex> // for std::mutex
 
 namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
   /// <summary>Private implementation of the global entity registry</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Registration works on the <see cref="Tables" /> map. Once the registry is frozen,
+  ///     the tables are compiled into immutable <see cref="EntityLayout" /> instances that
+  ///     are published through an atomic pointer. From then on, looking up an entity
+  ///     layout is a single hash map access without any locks and registration is over.
+  ///   </para>
+  /// </remarks>
   class GlobalEntityRegistry::Implementation {
 
     /// <summary>Initializes the private entity registry implementation</summary>
@@ -47,6 +65,122 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <summary>Tables that have been registered for different entity types</summary>
     public: TypeTableInfoMap Tables;
 
+    /// <summary>Compiles the registered tables into entity layouts</summary>
+    /// <remarks>
+    ///   Can safely be called from multiple threads, only the first call does any work.
+    /// </remarks>
+    public: void Freeze();
+
+    /// <summary>Checks whether the registry has been frozen</summary>
+    /// <returns>True if the registry has been frozen, false otherwise</returns>
+    public: bool IsFrozen() const noexcept;
+
+    /// <summary>Throws an exception if the registry has been frozen</summary>
+    public: void RequireNotFrozen() const;
+
+    /// <summary>Looks up the layout of a registered entity type</summary>
+    /// <param name="entityType">Type of entity class whose layout will be looked up</param>
+    /// <returns>The layout of the specified entity type</returns>
+    /// <remarks>
+    ///   Freezes the registry if that hasn't happened yet. Can be called from multiple
+    ///   threads at once, the returned layout lives as long as the registry.
+    /// </remarks>
+    public: const EntityLayout &GetEntityLayout(const std::type_info &entityType);
+
+    /// <summary>Looks up or generates a statement that inserts multiple entities</summary>
+    /// <param name="layout">Layout of the entity class that will be inserted</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <param name="rowCount">Number of entities the statement will insert</param>
+    /// <returns>A copy of the insert statement for the specified number of rows</returns>
+    /// <remarks>
+    ///   Used for entities whose auto-generated primary key has not been assigned yet,
+    ///   which have to be inserted with the key left out so the database generates it.
+    /// </remarks>
+    public: Query GetInsertStatement(
+      const EntityLayout &layout, Dialects::QuoteStyle quoteStyle, std::size_t rowCount
+    );
+
+    /// <summary>Looks up or generates a statement that upserts multiple entities</summary>
+    /// <param name="layout">Layout of the entity class that will be upserted</param>
+    /// <param name="style">Syntax the database uses for upserts</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <param name="rowCount">Number of entities the statement will upsert</param>
+    /// <returns>A copy of the upsert statement for the specified number of rows</returns>
+    /// <remarks>
+    ///   Upserts are generated on demand because their length depends on the number of
+    ///   rows. The returned copies share the original's statement id, so connections
+    ///   only need to prepare each statement once.
+    /// </remarks>
+    public: Query GetUpsertStatement(
+      const EntityLayout &layout,
+      Dialects::UpsertStyle style,
+      Dialects::QuoteStyle quoteStyle,
+      std::size_t rowCount
+    );
+
+    /// <summary>Looks up or generates a statement that updates some columns of an entity</summary>
+    /// <param name="layout">Layout of the entity class that will be updated</param>
+    /// <param name="assignedColumns">Columns the statement will write</param>
+    /// <param name="quoteStyle">Quotes the database expects around identifiers</param>
+    /// <returns>A copy of the update statement for the specified columns</returns>
+    /// <remarks>
+    ///   Change tracking only writes the columns that have been modified, so there is
+    ///   one statement for each combination of columns. Only combinations that actually
+    ///   occur are ever generated and, as with upserts, all copies of a statement share
+    ///   the original's statement id.
+    /// </remarks>
+    public: Query GetUpdateStatement(
+      const EntityLayout &layout,
+      const ColumnSet &assignedColumns,
+      Dialects::QuoteStyle quoteStyle
+    );
+
+    /// <summary>Map of a RTTI type to compiled entity layouts</summary>
+    private: typedef std::unordered_map<std::type_index, EntityLayout> TypeEntityLayoutMap;
+
+    /// <summary>Must be held while the registry is being frozen</summary>
+    private: std::mutex freezeMutex;
+    /// <summary>Entity layouts compiled when the registry was frozen</summary>
+    private: std::unique_ptr<const TypeEntityLayoutMap> entityLayouts;
+    /// <summary>Published entity layouts, null until the registry is frozen</summary>
+    private: std::atomic<const TypeEntityLayoutMap *> publishedEntityLayouts;
+
+    /// <summary>Identifies an insert statement by entity, quotes and row count</summary>
+    private: typedef std::tuple<
+      const EntityLayout *, Dialects::QuoteStyle, std::size_t
+    > InsertStatementKey;
+    /// <summary>Map of entity layouts, quotes and row counts to insert statements</summary>
+    private: typedef std::map<InsertStatementKey, Query> InsertStatementMap;
+
+    /// <summary>Must be held while accessing the generated insert statements</summary>
+    private: std::mutex insertStatementMutex;
+    /// <summary>Insert statements that have been generated so far</summary>
+    private: InsertStatementMap insertStatements;
+
+    /// <summary>Identifies an upsert statement by entity, syntax and row count</summary>
+    private: typedef std::tuple<
+      const EntityLayout *, Dialects::UpsertStyle, Dialects::QuoteStyle, std::size_t
+    > UpsertStatementKey;
+    /// <summary>Map of entity layouts, syntaxes and row counts to upsert statements</summary>
+    private: typedef std::map<UpsertStatementKey, Query> UpsertStatementMap;
+
+    /// <summary>Must be held while accessing the generated upsert statements</summary>
+    private: std::mutex upsertStatementMutex;
+    /// <summary>Upsert statements that have been generated so far</summary>
+    private: UpsertStatementMap upsertStatements;
+
+    /// <summary>Identifies an update statement by entity, quotes and assigned columns</summary>
+    private: typedef std::tuple<
+      const EntityLayout *, Dialects::QuoteStyle, ColumnSet
+    > UpdateStatementKey;
+    /// <summary>Map of entity layouts, quotes and assigned columns to update statements</summary>
+    private: typedef std::map<UpdateStatementKey, Query> UpdateStatementMap;
+
+    /// <summary>Must be held while accessing the generated update statements</summary>
+    private: std::mutex updateStatementMutex;
+    /// <summary>Update statements that have been generated so far</summary>
+    private: UpdateStatementMap updateStatements;
+
   };
 
   // ------------------------------------------------------------------------------------------- //
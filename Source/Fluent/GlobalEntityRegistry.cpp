@@ -41,7 +41,7 @@ namespace {
   Nuclex::ThinOrm::Fluent::ColumnInfo &getColumnInfoForPropertyUpdateOrThrow(
     std::unordered_map<std::type_index, Nuclex::ThinOrm::Fluent::TableInfo> &tables,
     const std::type_info &entityType,
-    const std::u8string &columnName
+    const std::u8string_view &columnName
   ) {
     typedef std::unordered_map<
       std::type_index, Nuclex::ThinOrm::Fluent::TableInfo
@@ -57,10 +57,10 @@ namespace {
       );
     }
 
-    Nuclex::ThinOrm::Fluent::TableInfo::SizeColumnInfoMap::iterator columnIterator = (
-      tableIterator->second.Columns.find(columnName)
+    Nuclex::ThinOrm::Fluent::ColumnInfo *columnInfo = (
+      tableIterator->second.FindColumn(columnName)
     );
-    if(columnIterator == tableIterator->second.Columns.end()) {
+    if(columnInfo == nullptr) {
       throw std::invalid_argument(
         reinterpret_cast<const char *>(
           u8"Tried to change the properties of a column<->attribute mapping for a column "
@@ -69,7 +69,7 @@ namespace {
       );
     }
 
-    return columnIterator->second;
+    return *columnInfo;
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -89,9 +89,30 @@ namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
+  GlobalEntityRegistry &GlobalEntityRegistry::GetDefault() {
+    static GlobalEntityRegistry defaultRegistry;
+    return defaultRegistry;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void GlobalEntityRegistry::Freeze() {
+    this->implementation->Freeze();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool GlobalEntityRegistry::IsFrozen() const noexcept {
+    return this->implementation->IsFrozen();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   void GlobalEntityRegistry::AddEntity(
     const std::type_info &entityType, const std::u8string_view &tableName
   ) {
+    this->implementation->RequireNotFrozen();
+
     this->implementation->Tables.emplace(
       std::type_index(entityType),
       TableInfo(std::u8string(tableName), entityType)
@@ -105,8 +126,11 @@ namespace Nuclex::ThinOrm::Fluent {
     const std::u8string_view &columnName,
     GetAttributeValueFunction *getter,
     SetAttributeValueFunction *setter,
+    ReadAttributeFunction *reader,
     const std::type_info &attributeType
   ) {
+    this->implementation->RequireNotFrozen();
+
     Implementation::TypeTableInfoMap::iterator iterator = this->implementation->Tables.find(
       std::type_index(entityType)
     );
@@ -119,10 +143,21 @@ namespace Nuclex::ThinOrm::Fluent {
       );
     }
 
-    iterator->second.Columns.emplace(
-      std::u8string(columnName),
-      ColumnInfo(std::u8string(columnName), attributeType, getter, setter)
-    );
+    // Like with the entities themselves, mapping the same column twice keeps
+    // the first mapping. The columns are stored in declaration order.
+    if(iterator->second.FindColumn(columnName) == nullptr) {
+      iterator->second.Columns.emplace_back(
+        std::u8string(columnName), attributeType, getter, setter, reader
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BulkInsertBuilder GlobalEntityRegistry::CreateBulkInsertBuilder(
+    const std::type_info &entityType
+  ) const {
+    return BulkInsertBuilder(entityType, this->implementation->GetEntityLayout(entityType));
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -132,8 +167,10 @@ namespace Nuclex::ThinOrm::Fluent {
     const std::u8string_view &columnName,
     bool isNullable /* = true */
   ) {
+    this->implementation->RequireNotFrozen();
+
     ColumnInfo &columnInfo = getColumnInfoForPropertyUpdateOrThrow(
-      this->implementation->Tables, entityType, std::u8string(columnName)
+      this->implementation->Tables, entityType, columnName
     );
     columnInfo.IsNullable = isNullable;
   }
@@ -145,8 +182,10 @@ namespace Nuclex::ThinOrm::Fluent {
     const std::u8string_view &columnName,
     bool isPrimaryKey /* = true */
   ) {
+    this->implementation->RequireNotFrozen();
+
     ColumnInfo &columnInfo = getColumnInfoForPropertyUpdateOrThrow(
-      this->implementation->Tables, entityType, std::u8string(columnName)
+      this->implementation->Tables, entityType, columnName
     );
     columnInfo.IsPrimaryKey = isPrimaryKey;
   }
@@ -158,8 +197,10 @@ namespace Nuclex::ThinOrm::Fluent {
     const std::u8string_view &columnName,
     bool isAutoGenerated /* = true */
   ) {
+    this->implementation->RequireNotFrozen();
+
     ColumnInfo &columnInfo = getColumnInfoForPropertyUpdateOrThrow(
-      this->implementation->Tables, entityType, std::u8string(columnName)
+      this->implementation->Tables, entityType, columnName
     );
     columnInfo.IsAutogenerated = isAutoGenerated;
   }
@@ -0,0 +1,84 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_FLUENT_SELECTPLAN_H
+#define NUCLEX_THINORM_FLUENT_SELECTPLAN_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Fluent/EntityMappingConfigurator.h" // for ReadAttributeFunction
+
+#include <vector> // for std::vector<>
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Kinds of SELECT statements that can be generated for an entity</summary>
+  enum class SelectShape {
+
+    /// <summary>Selects all rows of the table</summary>
+    All,
+
+    /// <summary>Selects a window of rows via the {limit} and {offset} parameters</summary>
+    Paged,
+    /// <summary>Selects up to {limit} rows in primary key order</summary>
+    KeyOrdered,
+    /// <summary>Selects up to {limit} rows in primary key order after {key0}...</summary>
+    KeyOrderedAfter
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Generated SELECT statement and how its result maps to an entity</summary>
+  /// <remarks>
+  ///   Select plans are generated once per entity type and shape when the entity registry
+  ///   is frozen, then reused for all queries of the same kind. Because the plan generates
+  ///   the column list itself, the position of each column in the result is known in
+  ///   advance and rows can be read into entities by ordinal without looking up any
+  ///   column names.
+  /// </remarks>
+  class SelectPlan {
+
+    /// <summary>Initializes a new select plan</summary>
+    /// <param name="statement">SELECT statement that will fetch the entity's rows</param>
+    /// <param name="readers">Readers for the result columns, in column order</param>
+    public: SelectPlan(
+      const Query &statement,
+      std::vector<EntityMappingConfigurator::ReadAttributeFunction *> &&readers
+    );
+
+    /// <summary>SELECT statement that fetches the columns mapped in the entity</summary>
+    /// <remarks>
+    ///   Copies of this query keep the statement id, so the connection will prepare
+    ///   the statement only once and reuse it for all queries of this shape.
+    /// </remarks>
+    public: Query Statement;
+
+    /// <summary>Reader that stores each result column, indexed by column ordinal</summary>
+    public: std::vector<EntityMappingConfigurator::ReadAttributeFunction *> Readers;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
+
+#endif // NUCLEX_THINORM_FLUENT_SELECTPLAN_H
@@ -40,4 +40,16 @@ namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
+  ColumnInfo *TableInfo::FindColumn(const std::u8string_view &columnName) {
+    for(ColumnInfo &column : this->Columns) {
+      if(column.Name == columnName) {
+        return &column;
+      }
+    }
+
+    return nullptr;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm::Fluent
@@ -24,7 +24,8 @@ limitations under the License.
 
 #include "./ColumnInfo.h"
 
-#include <unordered_map> // for std::unordered_map<>
+#include <vector> // for std::vector<>
+#include <string_view> // for std::u8string_view
 
 namespace Nuclex::ThinOrm::Fluent {
 
@@ -44,11 +45,21 @@ namespace Nuclex::ThinOrm::Fluent {
     /// <summary>Type of the entity class the table is mapped to</summary>
     public: const std::type_info &Type;
 
-    /// <summary>Maps strings to column information records</summary>
-    public: typedef std::unordered_map<std::u8string, ColumnInfo> SizeColumnInfoMap;
-
-    /// <summary>Column metadata and getter/setter functions keyed by column offset</summary>
-    public: SizeColumnInfoMap Columns;
+    /// <summary>List of column information records</summary>
+    public: typedef std::vector<ColumnInfo> ColumnInfoVector;
+
+    /// <summary>Looks up the column with the specified name</summary>
+    /// <param name="columnName">Name of the column that will be looked up</param>
+    /// <returns>The column with the specified name or a null pointer if none exists</returns>
+    public: ColumnInfo *FindColumn(const std::u8string_view &columnName);
+
+    /// <summary>Column metadata and getter/setter functions in declaration order</summary>
+    /// <remarks>
+    ///   Columns are only looked up by name while an entity is being registered, so
+    ///   a linear search is fine here. Keeping the columns in the order they were
+    ///   declared gives generated statements a predictable column order.
+    /// </remarks>
+    public: ColumnInfoVector Columns;
 
   };
 
@@ -25,6 +25,7 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Migrations/GlobalMigrationRepository.h"
 
 #include "Nuclex/ThinOrm/Connections/ConnectionPool.h"
+#include "Nuclex/ThinOrm/Connections/ConnectionLease.h"
 #include "Nuclex/ThinOrm/Connections/Connection.h"
 #include "Nuclex/ThinOrm/Errors/AmbiguousSchemaVersionError.h"
 
@@ -81,53 +82,6 @@ namespace {
 
   // ------------------------------------------------------------------------------------------- //
 
-  /// <summary>Borrows a connection from a connection pool and handels returning it</summary>
-  class ConnectionBorrowScope {
-
-    /// <summary>Initializes a new borrow scope and borrows a connection</summary>
-    /// <param name="pool">Pool from which the connection will be borrowed</param>
-    public: inline ConnectionBorrowScope(
-      const std::shared_ptr<Nuclex::ThinOrm::Connections::ConnectionPool> &pool
-    );
-
-    /// <summary>Returns the borrowed connection to the pool</summary>
-    public: inline ~ConnectionBorrowScope();
-
-    /// <summary>Accesses the borrowed connection that scope is holding on to</summary>
-    /// <returns>The borrowed connection</returns>
-    public: inline const std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> &Get() const;
-
-    /// <summary>Pool from which the connection has been borrowed</summary>
-    private: const std::shared_ptr<Nuclex::ThinOrm::Connections::ConnectionPool> &pool;
-    /// <summary>Connection that has been borrowed from the pool</summary>
-    private: std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> connection;
-
-  };
-
-  // ------------------------------------------------------------------------------------------- //
-
-  inline ConnectionBorrowScope::ConnectionBorrowScope(
-    const std::shared_ptr<Nuclex::ThinOrm::Connections::ConnectionPool> &pool
-  ) :
-    pool(pool),
-    connection(pool->BorrowConnection()) {}
-
-  // ------------------------------------------------------------------------------------------- //
-
-  inline ConnectionBorrowScope::~ConnectionBorrowScope() {
-    this->pool->ReturnConnection(this->connection);
-  }
-
-  // ------------------------------------------------------------------------------------------- //
-
-  inline const std::shared_ptr<
-    Nuclex::ThinOrm::Connections::Connection
-  > &ConnectionBorrowScope::Get() const {
-    return this->connection;
-  }
-
-  // ------------------------------------------------------------------------------------------- //
-
 } // anonymous namespace
 
 namespace Nuclex::ThinOrm::Migrations {
@@ -165,8 +119,8 @@ namespace Nuclex::ThinOrm::Migrations {
     if(static_cast<bool>(this->connection)) {
       migrate(this->connection, nullptr);
     } else {
-      ConnectionBorrowScope borrowScope(this->pool);
-      migrate(borrowScope.Get(), nullptr);
+      Connections::ConnectionLease lease = this->pool->LeaseConnection();
+      migrate(lease.Get(), nullptr);
     }
   }
 
@@ -179,8 +133,8 @@ namespace Nuclex::ThinOrm::Migrations {
     if(static_cast<bool>(this->connection)) {
       migrate(this->connection, &schemaVersion);
     } else {
-      ConnectionBorrowScope borrowScope(this->pool);
-      migrate(borrowScope.Get(), &schemaVersion);
+      Connections::ConnectionLease lease = this->pool->LeaseConnection();
+      migrate(lease.Get(), &schemaVersion);
     }
   }
 
@@ -444,7 +444,7 @@ namespace Nuclex::ThinOrm::Platform {
   // ------------------------------------------------------------------------------------------- //
 
   std::shared_ptr<::sqlite3> SQLite3Api::Open(
-    const std::filesystem::path &path,
+    const std::u8string &uriOrName,
     int flags /* = SQLITE_OPEN_URI | SQLITE_OPEN_READWRITE */
    ) {
     ::sqlite3 *database = nullptr;
@@ -457,7 +457,7 @@ namespace Nuclex::ThinOrm::Platform {
     flags |= SQLITE_OPEN_EXRESCODE;
 
     int extendedResultCode = ::sqlite3_open_v2(
-      reinterpret_cast<const char *>(path.c_str()),
+      reinterpret_cast<const char *>(uriOrName.c_str()),
       &database,
       flags,
       nullptr
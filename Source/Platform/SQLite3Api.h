@@ -25,6 +25,8 @@ limitations under the License.
 #if defined(NUCLEX_THINORM_ENABLE_SQLITE)
 
 #include <filesystem> // for std::filesystem::path
+#include <memory> // for std::shared_ptr<>
+#include <string> // for std::u8string
 
 #include <sqlite3.h> // for the SQLite3 API methods
 
@@ -22,6 +22,10 @@ limitations under the License.
 
 #include "./Query.ImmutableState.h"
 
+#include <shared_mutex> // for std::shared_mutex
+#include <mutex> // for std::unique_lock
+#include <functional> // for std::hash
+
 namespace {
 
   // ------------------------------------------------------------------------------------------- //
@@ -88,6 +92,120 @@ namespace {
 
   // ------------------------------------------------------------------------------------------- //
 
+  /// <summary>Copies parameters so their names point into another SQL statement</summary>
+  /// <param name="sqlStatement">SQL statement the parameters' names will point into</param>
+  /// <param name="parameters">Parameters that will be copied</param>
+  /// <param name="parameterCount">Number of parameters that will be copied</param>
+  /// <returns>A list of the parameters with their names pointing into the SQL statement</returns>
+  std::vector<Nuclex::ThinOrm::QueryParameterView> rebaseQueryParameters(
+    const std::u8string &sqlStatement,
+    const Nuclex::ThinOrm::QueryParameterView *parameters,
+    std::size_t parameterCount
+  ) {
+    std::vector<Nuclex::ThinOrm::QueryParameterView> result(
+      parameters, parameters + parameterCount
+    );
+    for(std::size_t index = 0; index < parameterCount; ++index) {
+      result[index].Name = std::u8string_view(
+        sqlStatement.data() + result[index].StartIndex + 1, result[index].Length - 2
+      );
+    }
+    return result;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Assigns a value slot to each distinct parameter name</summary>
+  /// <typeparam name="TParameterSlotMap">Type of map that will be returned</typeparam>
+  /// <param name="parameters">
+  ///   Parameters which will be assigned value slots. Their slot index will be updated.
+  /// </param>
+  /// <returns>A map with the value slot index of each distinct parameter name</returns>
+  template<typename TParameterSlotMap>
+  TParameterSlotMap resolveParameterSlots(
+    std::vector<Nuclex::ThinOrm::QueryParameterView> &parameters
+  ) {
+    TParameterSlotMap result;
+
+    // Parameter names are case-insensitive, so the map takes care of deciding when
+    // the same parameter is referenced a second time (which then reuses the same slot)
+    std::size_t parameterCount = parameters.size();
+    for(std::size_t index = 0; index < parameterCount; ++index) {
+      std::pair<typename TParameterSlotMap::iterator, bool> insertResult = result.emplace(
+        std::u8string(parameters[index].Name), result.size()
+      );
+      parameters[index].SlotIndex = insertResult.first->second;
+    }
+
+    return result;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Concurrent map of parsed SQL statements by their SQL text</summary>
+  /// <typeparam name="TImmutableState">Type of the parsed SQL statements</typeparam>
+  /// <remarks>
+  ///   The table is split into independently locked shards selected by the hash of
+  ///   the SQL statement, so threads interning different statements rarely contend
+  ///   for the same lock. Lookups of statements that have already been interned (by far
+  ///   the most common case) only take a shared lock on their shard.
+  /// </remarks>
+  template<typename TImmutableState>
+  class StatementInternTable {
+
+    /// <summary>Looks up or creates the parsed state for an SQL statement</summary>
+    /// <param name="sqlStatement">SQL statement whose parsed state will be returned</param>
+    /// <returns>The shared parsed state of the SQL statement</returns>
+    public: std::shared_ptr<const TImmutableState> GetOrCreate(
+      const std::u8string &sqlStatement
+    ) {
+      std::size_t hash = std::hash<std::u8string>()(sqlStatement);
+      Shard &shard = this->shards[hash % ShardCount];
+      {
+        std::shared_lock<std::shared_mutex> statementsLock(shard.Mutex);
+        typename StatementMap::const_iterator iterator = shard.Statements.find(sqlStatement);
+        if(iterator != shard.Statements.end()) [[likely]] {
+          return iterator->second;
+        }
+      }
+
+      // Parse the SQL statement outside of the lock. Should another thread have interned
+      // the same statement in the meantime, emplace() will leave the existing entry in place
+      // and our freshly parsed state will simply be discarded.
+      std::shared_ptr<const TImmutableState> parsed = (
+        std::make_shared<const TImmutableState>(sqlStatement)
+      );
+      {
+        std::unique_lock<std::shared_mutex> statementsLock(shard.Mutex);
+        return shard.Statements.emplace(sqlStatement, std::move(parsed)).first->second;
+      }
+    }
+
+    /// <summary>Number of independently locked shards the table is split into</summary>
+    private: static constexpr std::size_t ShardCount = 16;
+
+    /// <summary>Map of parsed SQL statements by their SQL text</summary>
+    private: typedef std::unordered_map<
+      std::u8string, std::shared_ptr<const TImmutableState>
+    > StatementMap;
+
+    /// <summary>Part of the table that is protected by its own lock</summary>
+    private: struct Shard {
+
+      /// <summary>Must be held while accessing the statement map</summary>
+      public: std::shared_mutex Mutex;
+      /// <summary>Parsed SQL statements that have been interned into this shard</summary>
+      public: StatementMap Statements;
+
+    };
+
+    /// <summary>Shards into which the interned statements are distributed</summary>
+    private: Shard shards[ShardCount];
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // anonymous namespace
 
 namespace Nuclex::ThinOrm {
@@ -97,21 +215,36 @@ namespace Nuclex::ThinOrm {
   Query::ImmutableState::ImmutableState(const std::u8string &sqlStatement) :
     sqlStatement(sqlStatement),
     sqlStatementId(nextUniqueId++),
-    parameters(parseQueryParameters(sqlStatement)) {}
+    parameters(parseQueryParameters(this->sqlStatement)),
+    parameterSlots(resolveParameterSlots<ParameterSlotMap>(this->parameters)) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Query::ImmutableState::ImmutableState(
+    const std::u8string_view &sqlStatement,
+    const QueryParameterView *parameters,
+    std::size_t parameterCount
+  ) :
+    sqlStatement(sqlStatement),
+    sqlStatementId(nextUniqueId++),
+    parameters(rebaseQueryParameters(this->sqlStatement, parameters, parameterCount)),
+    parameterSlots(resolveParameterSlots<ParameterSlotMap>(this->parameters)) {}
 
   // ------------------------------------------------------------------------------------------- //
 
   Query::ImmutableState::ImmutableState(const ImmutableState &other) :
     sqlStatement(other.sqlStatement),
     sqlStatementId(other.sqlStatementId),
-    parameters(other.parameters) {}
+    parameters(parseQueryParameters(this->sqlStatement)),
+    parameterSlots(resolveParameterSlots<ParameterSlotMap>(this->parameters)) {}
 
   // ------------------------------------------------------------------------------------------- //
 
   Query::ImmutableState::ImmutableState(ImmutableState &&other) :
     sqlStatement(std::move(other.sqlStatement)),
     sqlStatementId(other.sqlStatementId),
-    parameters(std::move(other.parameters)) {}
+    parameters(parseQueryParameters(this->sqlStatement)),
+    parameterSlots(resolveParameterSlots<ParameterSlotMap>(this->parameters)) {}
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -119,6 +252,26 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  std::shared_ptr<const Query::ImmutableState> Query::ImmutableState::Intern(
+    const std::u8string &sqlStatement
+  ) {
+    static StatementInternTable<ImmutableState> internTable;
+    return internTable.GetOrCreate(sqlStatement);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t Query::ImmutableState::FindParameterSlot(const std::u8string &name) const {
+    ParameterSlotMap::const_iterator iterator = this->parameterSlots.find(name);
+    if(iterator == this->parameterSlots.end()) {
+      return std::size_t(-1);
+    } else {
+      return iterator->second;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   std::atomic<std::size_t> Query::ImmutableState::nextUniqueId(0);
 
   // ------------------------------------------------------------------------------------------- //
@@ -23,7 +23,11 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Config.h"
 #include "Nuclex/ThinOrm/Query.h"
 
+#include <Nuclex/Support/Text/StringMatcher.h> // for CaseInsensitiveUtf8Hash
+
 #include <atomic> // for std::atomic
+#include <memory> // for std::shared_ptr
+#include <unordered_map> // for std::unordered_map
 
 namespace Nuclex::ThinOrm {
 
@@ -35,6 +39,15 @@ namespace Nuclex::ThinOrm {
     /// <summary>Initializes the implementation details for a query</summary>
     /// <param name="sqlStatement">SQL statement the query will execute</param>
     public: ImmutableState(const std::u8string &sqlStatement);
+    /// <summary>Initializes the implementation details for a pre-parsed query</summary>
+    /// <param name="sqlStatement">SQL statement the query will execute</param>
+    /// <param name="parameters">Names and locations of the parameters</param>
+    /// <param name="parameterCount">Number of parameters in the SQL statement</param>
+    public: ImmutableState(
+      const std::u8string_view &sqlStatement,
+      const QueryParameterView *parameters,
+      std::size_t parameterCount
+    );
     /// <summary>Initializes the implementation details for a query</summary>
     public: ImmutableState(const ImmutableState &other);
     /// <summary>Initializes the implementation details for a query</summary>
@@ -42,6 +55,16 @@ namespace Nuclex::ThinOrm {
     /// <summary>Frees all resources owned by the implementation details</summary>
     public: ~ImmutableState();
 
+    /// <summary>Looks up or creates the shared, parsed state for an SQL statement</summary>
+    /// <param name="sqlStatement">SQL statement whose parsed state will be returned</param>
+    /// <returns>
+    ///   The parsed state for the SQL statement, shared by all callers that intern
+    ///   an identical SQL statement
+    /// </returns>
+    public: static std::shared_ptr<const ImmutableState> Intern(
+      const std::u8string &sqlStatement
+    );
+
     /// <summary>Retrieves the SQL statement the query was build for</summary>
     /// <returns>The SQL statement the query will execute</returns>
     public: inline const std::u8string &GetSqlStatement() const;
@@ -58,9 +81,28 @@ namespace Nuclex::ThinOrm {
     /// </returns>
     public: inline const std::vector<QueryParameterView> &GetParameterInfo() const;
 
+    /// <summary>Counts the number of distinct parameter names in the SQL statement</summary>
+    /// <returns>The number of value slots a query using this SQL statement needs</returns>
+    public: inline std::size_t CountParameterSlots() const;
+
+    /// <summary>Looks up the value slot a parameter with the specified name uses</summary>
+    /// <param name="name">Name of the parameter whose slot will be looked up</param>
+    /// <returns>
+    ///   The index of the parameter's value slot or std::size_t(-1) if the SQL statement
+    ///   has no parameter with the specified name
+    /// </returns>
+    public: std::size_t FindParameterSlot(const std::u8string &name) const;
+
     /// <summary>Stores names and locations of parameters</summary>
     private: typedef std::vector<QueryParameterView> ParameterViewVector;
 
+    /// <summary>Map of value slot indices by parameter name</summary>
+    private: typedef std::unordered_map<
+      std::u8string, std::size_t,
+      Nuclex::Support::Text::CaseInsensitiveUtf8Hash,
+      Nuclex::Support::Text::CaseInsensitiveUtf8EqualTo
+    > ParameterSlotMap;
+
     /// <summary>Generator that is consulted to obtain a unique ID for a query</summary>
     private: static std::atomic<std::size_t> nextUniqueId;
 
@@ -70,6 +112,8 @@ namespace Nuclex::ThinOrm {
     private: std::size_t sqlStatementId;
     /// <summary>Names and locations of the query parameters in the query string</summary>
     private: ParameterViewVector parameters;
+    /// <summary>Value slot of each distinct parameter name in the query string</summary>
+    private: ParameterSlotMap parameterSlots;
 
   };
 
@@ -93,6 +137,12 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  inline std::size_t Query::ImmutableState::CountParameterSlots() const {
+    return this->parameterSlots.size();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm
 
 #endif // NUCLEX_THINORM_QUERY_IMMUTABLESTATE_H
@@ -24,25 +24,30 @@ limitations under the License.
 
 #include "Nuclex/ThinOrm/Errors/UnassignedParameterError.h"
 
+#include <optional> // for std::optional
+
 namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
-  Query::Implementation::Implementation() :
+  Query::Implementation::Implementation(std::size_t parameterSlotCount) :
     stateMutex(),
-    parameterValues() {}
+    parameterValues(parameterSlotCount, Value(std::optional<bool>())),
+    parameterAssigned(parameterSlotCount, false) {}
 
   // ------------------------------------------------------------------------------------------- //
 
   Query::Implementation::Implementation(const Implementation &other) :
     stateMutex(),
-    parameterValues(other.parameterValues) {}
+    parameterValues(other.parameterValues),
+    parameterAssigned(other.parameterAssigned) {}
 
   // ------------------------------------------------------------------------------------------- //
 
   Query::Implementation::Implementation(Implementation &&other) :
     stateMutex(),
-    parameterValues(std::move(other.parameterValues)) {}
+    parameterValues(std::move(other.parameterValues)),
+    parameterAssigned(std::move(other.parameterAssigned)) {}
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -51,33 +56,34 @@ namespace Nuclex::ThinOrm {
   // ------------------------------------------------------------------------------------------- //
   
   void Query::Implementation::ClearParameterValues() {
-    this->parameterValues.clear();
+    std::size_t slotCount = this->parameterValues.size();
+    for(std::size_t index = 0; index < slotCount; ++index) {
+      this->parameterValues[index] = std::optional<bool>();
+      this->parameterAssigned[index] = false;
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  const Value &Query::Implementation::GetParameterValue(const std::u8string &name) const {
-    ParameterValueMap::const_iterator iterator = this->parameterValues.find(name);
-    if(iterator == this->parameterValues.end()) {
+  const Value &Query::Implementation::GetParameterValue(
+    std::size_t slotIndex, const std::u8string_view &name
+  ) const {
+    if(!this->parameterAssigned[slotIndex]) [[unlikely]] {
       std::u8string message(u8"Parameter '", 11);
       message.append(name);
       message.append(u8"' has not been given a value yet", 32);
       throw Errors::UnassignedParameterError(message);
     }
-    return iterator->second;
+    return this->parameterValues[slotIndex];
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   void Query::Implementation::SetParameterValueUnchecked(
-    const std::u8string &name, const Value &value
+    std::size_t slotIndex, const Value &value
   ) {
-    ParameterValueMap::iterator iterator = this->parameterValues.find(name);
-    if(iterator == this->parameterValues.end()) {
-      this->parameterValues.emplace(name, value);
-    } else {
-      iterator->second = value;
-    }
+    this->parameterValues[slotIndex] = value;
+    this->parameterAssigned[slotIndex] = true;
   }
 
   // ------------------------------------------------------------------------------------------- //
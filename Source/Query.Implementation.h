@@ -24,9 +24,7 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Query.h"
 #include "Nuclex/ThinOrm/Value.h"
 
-#include <Nuclex/Support/Text/StringMatcher.h>
-
-#include <unordered_map> // for std::unordered_map
+#include <vector> // for std::vector
 #include <mutex> // for std::mutex
 
 namespace Nuclex::ThinOrm {
@@ -37,7 +35,10 @@ namespace Nuclex::ThinOrm {
   class Query::Implementation {
 
     /// <summary>Initializes the implementation details for a query</summary>
-    public: Implementation();
+    /// <param name="parameterSlotCount">
+    ///   Number of distinct parameters for which values need to be stored
+    /// </param>
+    public: Implementation(std::size_t parameterSlotCount);
     /// <summary>Initializes the implementation details for a query</summary>
     public: Implementation(const Implementation &other);
     /// <summary>Initializes the implementation details for a query</summary>
@@ -48,29 +49,25 @@ namespace Nuclex::ThinOrm {
     /// <summary>Clears the values of all parameters</summary>
     public: void ClearParameterValues();
 
-    /// <summary>Retrieves the value assigned to a parameter by its name</summary>
-    /// <param name="name">Name of the parameter whose value to fetch</param>
-    /// <returns>The current value of the parameter with the specified name</returns>
-    public: const Value &GetParameterValue(const std::u8string &name) const;
-
-    /// <summary>Sets the value assigned to a parameter by its name</summary>
-    /// <param name="name">Name of the parameter whose value to set</param>
-    /// <param name="value">Value to assign to the parameter</param>
-    public: void SetParameterValueUnchecked(
-      const std::u8string &name, const Value &value
-    );
-
-    /// <summary>Map of values indexed by the name</summary>
-    private: typedef std::unordered_map<
-      std::u8string, Value,
-      Nuclex::Support::Text::CaseInsensitiveUtf8Hash,
-      Nuclex::Support::Text::CaseInsensitiveUtf8EqualTo
-    > ParameterValueMap;
+    /// <summary>Retrieves the value stored in the specified parameter slot</summary>
+    /// <param name="slotIndex">Index of the slot whose value will be returned</param>
+    /// <param name="name">Name of the parameter, used for the error message</param>
+    /// <returns>The current value stored in the specified parameter slot</returns>
+    public: const Value &GetParameterValue(
+      std::size_t slotIndex, const std::u8string_view &name
+    ) const;
+
+    /// <summary>Stores a value in the specified parameter slot</summary>
+    /// <param name="slotIndex">Index of the slot in which the value will be stored</param>
+    /// <param name="value">Value to assign to the parameter slot</param>
+    public: void SetParameterValueUnchecked(std::size_t slotIndex, const Value &value);
 
     /// <summary>Mutex to synchronize state (parameters + prepared statement) updates</summary>
     private: std::mutex stateMutex;
-    /// <summary>Values assigned to the parameters in the query</summary>
-    private: ParameterValueMap parameterValues;
+    /// <summary>Values assigned to the parameters in the query, indexed by slot</summary>
+    private: std::vector<Value> parameterValues;
+    /// <summary>Whether a value has been assigned to the parameter slot</summary>
+    private: std::vector<bool> parameterAssigned;
 
   };
 
@@ -26,13 +26,30 @@ limitations under the License.
 #include "./Query.Implementation.h"
 #include "./Query.ImmutableState.h"
 
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Throws an exception indicating that there is no parameter by a name</summary>
+  /// <param name="name">Name of the parameter the user tried to access</param>
+  [[noreturn]] void throwNoSuchParameterError(const std::u8string &name) {
+    std::u8string message(u8"No such query parameter: '", 26);
+    message.append(name);
+    message.push_back(u8'\'');
+    throw Nuclex::ThinOrm::Errors::BadParameterNameError(message);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
 namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
   Query::Query(const std::u8string &sqlStatement) :
     immutableState(std::make_shared<ImmutableState>(sqlStatement)),
-    implementation(std::make_unique<Implementation>()) {}
+    implementation(std::make_unique<Implementation>(this->immutableState->CountParameterSlots())) {}
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -48,10 +65,32 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  Query::Query(const std::shared_ptr<const ImmutableState> &immutableState) :
+    immutableState(immutableState), // share ownership
+    implementation(std::make_unique<Implementation>(this->immutableState->CountParameterSlots())) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
   Query::~Query() = default;
 
   // ------------------------------------------------------------------------------------------- //
 
+  Query Query::FromInternedStatement(const std::u8string &sqlStatement) {
+    return Query(ImmutableState::Intern(sqlStatement));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::shared_ptr<const Query::ImmutableState> Query::adoptParsedStatement(
+    const std::u8string_view &sqlStatement,
+    const QueryParameterView *parameters,
+    std::size_t parameterCount
+  ) {
+    return std::make_shared<const ImmutableState>(sqlStatement, parameters, parameterCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   const std::u8string &Query::GetSqlStatement() const {
     return this->immutableState->GetSqlStatement();
   }
@@ -83,56 +122,37 @@ namespace Nuclex::ThinOrm {
   // ------------------------------------------------------------------------------------------- //
 
   const Value &Query::GetParameterValue(std::size_t index) const {
-    const std::vector<QueryParameterView> &parameters = this->immutableState->GetParameterInfo();
-    std::u8string parameterName = std::u8string(parameters.at(index).Name);
-    return this->implementation->GetParameterValue(parameterName);
+    const QueryParameterView &parameter = this->immutableState->GetParameterInfo().at(index);
+    return this->implementation->GetParameterValue(parameter.SlotIndex, parameter.Name);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   const Value &Query::GetParameterValue(const std::u8string &name) const {
-    using Nuclex::Support::Text::StringMatcher;
-    constexpr bool CaseSensitive = false;
-
-    const std::vector<QueryParameterView> &parameters = this->immutableState->GetParameterInfo();
-    for(std::size_t index = 0; index < parameters.size(); ++index) {
-      if(StringMatcher::AreEqual<CaseSensitive>(parameters[index].Name, name)) {
-        return this->implementation->GetParameterValue(name);
-      }
+    std::size_t slotIndex = this->immutableState->FindParameterSlot(name);
+    if(slotIndex == std::size_t(-1)) [[unlikely]] {
+      throwNoSuchParameterError(name);
     }
 
-    std::u8string message(u8"No such query parameter: '", 26);
-    message.append(name);
-    message.push_back(u8'\'');
-    throw Errors::BadParameterNameError(message);
+    return this->implementation->GetParameterValue(slotIndex, name);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   void Query::SetParameterValue(std::size_t index, const Value &value) {
-    const std::vector<QueryParameterView> &parameters = this->immutableState->GetParameterInfo();
-    std::u8string parameterName = std::u8string(parameters.at(index).Name);
-    this->implementation->SetParameterValueUnchecked(parameterName, value);
+    const QueryParameterView &parameter = this->immutableState->GetParameterInfo().at(index);
+    this->implementation->SetParameterValueUnchecked(parameter.SlotIndex, value);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
   void Query::SetParameterValue(const std::u8string &name, const Value &value) {
-    using Nuclex::Support::Text::StringMatcher;
-    constexpr bool CaseSensitive = false;
-
-    const std::vector<QueryParameterView> &parameters = this->immutableState->GetParameterInfo();
-    for(std::size_t index = 0; index < parameters.size(); ++index) {
-      if(StringMatcher::AreEqual<CaseSensitive>(parameters[index].Name, name)) {
-        this->implementation->SetParameterValueUnchecked(name, value);
-        return;
-      }
+    std::size_t slotIndex = this->immutableState->FindParameterSlot(name);
+    if(slotIndex == std::size_t(-1)) [[unlikely]] {
+      throwNoSuchParameterError(name);
     }
 
-    std::u8string message(u8"No such query parameter: '", 26);
-    message.append(name);
-    message.push_back(u8'\'');
-    throw Errors::BadParameterNameError(message);
+    this->implementation->SetParameterValueUnchecked(slotIndex, value);
   }
 
   // ------------------------------------------------------------------------------------------- //
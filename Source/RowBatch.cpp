@@ -0,0 +1,472 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/RowBatch.h"
+
+#include "Nuclex/ThinOrm/Errors/BadValueTypeError.h" // for BadValueTypeError
+
+#include <optional> // for std::optional
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether the specified value type is one of the integer types</summary>
+  /// <param name="valueType">Value type that will be checked</param>
+  /// <returns>True if the value type is an integer type</returns>
+  bool isIntegerType(Nuclex::ThinOrm::ValueType valueType) {
+    using Nuclex::ThinOrm::ValueType;
+    return (
+      (valueType == ValueType::UInt8) ||
+      (valueType == ValueType::Int16) ||
+      (valueType == ValueType::Int32) ||
+      (valueType == ValueType::Int64)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether the specified value type stores a date and/or time</summary>
+  /// <param name="valueType">Value type that will be checked</param>
+  /// <returns>True if the value type is a date, time or date/time type</returns>
+  bool isDateTimeType(Nuclex::ThinOrm::ValueType valueType) {
+    using Nuclex::ThinOrm::ValueType;
+    return (
+      (valueType == ValueType::Date) ||
+      (valueType == ValueType::Time) ||
+      (valueType == ValueType::DateTime)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Throws an exception reporting that a column has the wrong type</summary>
+  [[noreturn]] void throwColumnTypeMismatch() {
+    throw Nuclex::ThinOrm::Errors::BadValueTypeError(
+      u8"Row batch column was not of the expected type"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  RowBatchColumn::RowBatchColumn() :
+    type(ValueType::String),
+    name(),
+    rowCount(0),
+    nullBits(),
+    bytes8(),
+    int16s(),
+    int32s(),
+    int64s(),
+    decimals(),
+    floats(),
+    doubles(),
+    dateTimes(),
+    packedBytes(),
+    packedEnds() {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::Reset(ValueType type, const std::u8string_view &name) {
+    this->type = type;
+    this->name.assign(name);
+    this->rowCount = 0;
+
+    // clear() keeps the vectors' capacity, so only the first batch has to grow them
+    this->nullBits.clear();
+    this->bytes8.clear();
+    this->int16s.clear();
+    this->int32s.clear();
+    this->int64s.clear();
+    this->decimals.clear();
+    this->floats.clear();
+    this->doubles.clear();
+    this->dateTimes.clear();
+    this->packedBytes.clear();
+    this->packedEnds.clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const std::uint8_t> RowBatchColumn::GetBooleans() const {
+    require(ValueType::Boolean);
+    return std::span<const std::uint8_t>(this->bytes8);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const std::uint8_t> RowBatchColumn::GetUInt8s() const {
+    require(ValueType::UInt8);
+    return std::span<const std::uint8_t>(this->bytes8);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const std::int16_t> RowBatchColumn::GetInt16s() const {
+    require(ValueType::Int16);
+    return std::span<const std::int16_t>(this->int16s);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const std::int32_t> RowBatchColumn::GetInt32s() const {
+    require(ValueType::Int32);
+    return std::span<const std::int32_t>(this->int32s);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const std::int64_t> RowBatchColumn::GetInt64s() const {
+    require(ValueType::Int64);
+    return std::span<const std::int64_t>(this->int64s);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const Decimal> RowBatchColumn::GetDecimals() const {
+    require(ValueType::Decimal);
+    return std::span<const Decimal>(this->decimals);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const float> RowBatchColumn::GetFloats() const {
+    require(ValueType::Float);
+    return std::span<const float>(this->floats);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const double> RowBatchColumn::GetDoubles() const {
+    require(ValueType::Double);
+    return std::span<const double>(this->doubles);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const DateTime> RowBatchColumn::GetDateTimes() const {
+    if(!isDateTimeType(this->type)) [[unlikely]] {
+      throwColumnTypeMismatch();
+    }
+    return std::span<const DateTime>(this->dateTimes);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::u8string_view RowBatchColumn::GetString(std::size_t rowIndex) const {
+    require(ValueType::String);
+
+    std::size_t start = (rowIndex == 0) ? 0 : this->packedEnds[rowIndex - 1];
+    return std::u8string_view(
+      reinterpret_cast<const char8_t *>(this->packedBytes.data() + start),
+      this->packedEnds[rowIndex] - start
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::span<const std::byte> RowBatchColumn::GetBlob(std::size_t rowIndex) const {
+    require(ValueType::Blob);
+
+    std::size_t start = (rowIndex == 0) ? 0 : this->packedEnds[rowIndex - 1];
+    return std::span<const std::byte>(
+      this->packedBytes.data() + start, this->packedEnds[rowIndex] - start
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value RowBatchColumn::GetValue(std::size_t rowIndex) const {
+    bool isNull = IsNull(rowIndex);
+
+    switch(this->type) {
+      case ValueType::Boolean: {
+        if(isNull) {
+          return Value(std::optional<bool>());
+        } else {
+          return Value(this->bytes8[rowIndex] != 0);
+        }
+      }
+      case ValueType::UInt8: {
+        if(isNull) {
+          return Value(std::optional<std::uint8_t>());
+        } else {
+          return Value(this->bytes8[rowIndex]);
+        }
+      }
+      case ValueType::Int16: {
+        if(isNull) {
+          return Value(std::optional<std::int16_t>());
+        } else {
+          return Value(this->int16s[rowIndex]);
+        }
+      }
+      case ValueType::Int32: {
+        if(isNull) {
+          return Value(std::optional<std::int32_t>());
+        } else {
+          return Value(this->int32s[rowIndex]);
+        }
+      }
+      case ValueType::Int64: {
+        if(isNull) {
+          return Value(std::optional<std::int64_t>());
+        } else {
+          return Value(this->int64s[rowIndex]);
+        }
+      }
+      case ValueType::Decimal: {
+        if(isNull) {
+          return Value(std::optional<Decimal>());
+        } else {
+          return Value(this->decimals[rowIndex]);
+        }
+      }
+      case ValueType::Float: {
+        if(isNull) {
+          return Value(std::optional<float>());
+        } else {
+          return Value(this->floats[rowIndex]);
+        }
+      }
+      case ValueType::Double: {
+        if(isNull) {
+          return Value(std::optional<double>());
+        } else {
+          return Value(this->doubles[rowIndex]);
+        }
+      }
+      case ValueType::String: {
+        if(isNull) {
+          return Value(std::optional<std::u8string>());
+        } else {
+          return Value(GetString(rowIndex));
+        }
+      }
+      case ValueType::Date: {
+        if(isNull) {
+          return Value::FromDate(std::optional<DateTime>());
+        } else {
+          return Value::FromDate(this->dateTimes[rowIndex]);
+        }
+      }
+      case ValueType::Time: {
+        if(isNull) {
+          return Value::FromTime(std::optional<DateTime>());
+        } else {
+          return Value::FromTime(this->dateTimes[rowIndex]);
+        }
+      }
+      case ValueType::DateTime: {
+        if(isNull) {
+          return Value::FromDateTime(std::optional<DateTime>());
+        } else {
+          return Value::FromDateTime(this->dateTimes[rowIndex]);
+        }
+      }
+      case ValueType::Blob: {
+        if(isNull) {
+          return Value(std::optional<std::vector<std::byte>>());
+        } else {
+          return Value(GetBlob(rowIndex));
+        }
+      }
+      default: {
+        throwColumnTypeMismatch();
+      }
+    } // switch on column type
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendNull() {
+
+    // Every typed array receives a placeholder so row indices stay aligned
+    switch(this->type) {
+      case ValueType::Boolean:
+      case ValueType::UInt8: { this->bytes8.push_back(0); break; }
+      case ValueType::Int16: { this->int16s.push_back(0); break; }
+      case ValueType::Int32: { this->int32s.push_back(0); break; }
+      case ValueType::Int64: { this->int64s.push_back(0); break; }
+      case ValueType::Decimal: { this->decimals.push_back(Decimal(0)); break; }
+      case ValueType::Float: { this->floats.push_back(0.0f); break; }
+      case ValueType::Double: { this->doubles.push_back(0.0); break; }
+      case ValueType::Date:
+      case ValueType::Time:
+      case ValueType::DateTime: { this->dateTimes.push_back(DateTime(std::int64_t(0))); break; }
+      case ValueType::String:
+      case ValueType::Blob: { this->packedEnds.push_back(this->packedBytes.size()); break; }
+      default: { throwColumnTypeMismatch(); }
+    }
+
+    appendNullBit(true);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendBoolean(bool value) {
+    require(ValueType::Boolean);
+    this->bytes8.push_back(value ? 1 : 0);
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendInteger(std::int64_t value) {
+    switch(this->type) {
+      case ValueType::UInt8: { this->bytes8.push_back(static_cast<std::uint8_t>(value)); break; }
+      case ValueType::Int16: { this->int16s.push_back(static_cast<std::int16_t>(value)); break; }
+      case ValueType::Int32: { this->int32s.push_back(static_cast<std::int32_t>(value)); break; }
+      case ValueType::Int64: { this->int64s.push_back(value); break; }
+      default: { throwColumnTypeMismatch(); }
+    }
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendDecimal(const Decimal &value) {
+    require(ValueType::Decimal);
+    this->decimals.push_back(value);
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendFloatingPoint(double value) {
+    if(this->type == ValueType::Double) {
+      this->doubles.push_back(value);
+    } else if(this->type == ValueType::Float) {
+      this->floats.push_back(static_cast<float>(value));
+    } else {
+      throwColumnTypeMismatch();
+    }
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendDateTime(const DateTime &value) {
+    if(!isDateTimeType(this->type)) [[unlikely]] {
+      throwColumnTypeMismatch();
+    }
+    this->dateTimes.push_back(value);
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendString(const std::u8string_view &value) {
+    require(ValueType::String);
+    appendBytes(reinterpret_cast<const std::byte *>(value.data()), value.length());
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendBlob(const std::span<const std::byte> &value) {
+    require(ValueType::Blob);
+    appendBytes(value.data(), value.size());
+    appendNullBit(false);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::AppendValue(const Value &value) {
+    if(value.IsEmpty()) {
+      AppendNull();
+      return;
+    }
+
+    // Values that already have the column's type are appended without any conversion,
+    // everything else goes through the Value class' conversion operators
+    if(isIntegerType(this->type)) {
+      AppendInteger(static_cast<std::int64_t>(value));
+    } else if(isDateTimeType(this->type)) {
+      AppendDateTime(static_cast<DateTime>(value));
+    } else {
+      switch(this->type) {
+        case ValueType::Boolean: { AppendBoolean(static_cast<bool>(value)); break; }
+        case ValueType::Decimal: { AppendDecimal(static_cast<Decimal>(value)); break; }
+        case ValueType::Float:
+        case ValueType::Double: { AppendFloatingPoint(static_cast<double>(value)); break; }
+        case ValueType::String: {
+          if(value.GetType() == ValueType::String) {
+            AppendString(value.GetStringView().value());
+          } else {
+            AppendString(static_cast<std::u8string>(value));
+          }
+          break;
+        }
+        case ValueType::Blob: {
+          if(value.GetType() == ValueType::Blob) {
+            AppendBlob(value.GetBlobView().value());
+          } else {
+            std::vector<std::byte> bytes = static_cast<std::vector<std::byte>>(value);
+            AppendBlob(std::span<const std::byte>(bytes));
+          }
+          break;
+        }
+        default: { throwColumnTypeMismatch(); }
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::require(ValueType requiredType) const {
+    if(this->type != requiredType) [[unlikely]] {
+      throwColumnTypeMismatch();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatchColumn::appendBytes(const std::byte *bytes, std::size_t byteCount) {
+    this->packedBytes.insert(this->packedBytes.end(), bytes, bytes + byteCount);
+    this->packedEnds.push_back(this->packedBytes.size());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  RowBatch::RowBatch() :
+    columnCount(0),
+    columns() {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void RowBatch::Reset(std::size_t columnCount) {
+    if(this->columns.size() < columnCount) {
+      this->columns.resize(columnCount);
+    }
+    this->columnCount = columnCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
@@ -32,6 +32,95 @@ namespace {
 namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
+
+  std::optional<std::size_t> RowReader::GetRowCountHint() const {
+    return std::optional<std::size_t>();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool RowReader::TryReadColumnInt64(std::size_t columnIndex, std::int64_t &target) const {
+    Value value = GetColumnValue(columnIndex);
+    if(value.IsEmpty()) {
+      return false;
+    }
+
+    target = static_cast<std::int64_t>(value);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool RowReader::TryReadColumnDouble(std::size_t columnIndex, double &target) const {
+    Value value = GetColumnValue(columnIndex);
+    if(value.IsEmpty()) {
+      return false;
+    }
+
+    target = static_cast<double>(value);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool RowReader::TryReadColumnString(std::size_t columnIndex, std::u8string &target) const {
+    Value value = GetColumnValue(columnIndex);
+    if(value.IsEmpty()) {
+      return false;
+    }
+
+    target = static_cast<std::u8string>(value);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool RowReader::TryReadColumnBlob(
+    std::size_t columnIndex, std::vector<std::byte> &target
+  ) const {
+    Value value = GetColumnValue(columnIndex);
+    if(value.IsEmpty()) {
+      return false;
+    }
+
+    target = static_cast<std::vector<std::byte>>(value);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t RowReader::FetchBatch(RowBatch &batch, std::size_t maximumRowCount) {
+    if((maximumRowCount == 0) || !MoveToNext()) {
+      batch.Reset(0);
+      return 0;
+    }
+
+    // Set up the columns from the first row. For most backends, the column types are
+    // known without a row, but some (like SQLite) only know the type of the current row.
+    std::size_t columnCount = CountColumns();
+    batch.Reset(columnCount);
+    for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+      batch.GetColumn(columnIndex).Reset(
+        GetColumnType(columnIndex), GetColumnName(columnIndex)
+      );
+    }
+
+    std::size_t rowCount = 0;
+    for(;;) {
+      for(std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
+        batch.GetColumn(columnIndex).AppendValue(GetColumnValue(columnIndex));
+      }
+
+      ++rowCount;
+      if(rowCount >= maximumRowCount) {
+        return rowCount;
+      }
+      if(!MoveToNext()) {
+        return rowCount;
+      }
+    }
+  }
+
   // ------------------------------------------------------------------------------------------- //
 
 } // namespace Nuclex::ThinOrm
@@ -0,0 +1,118 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "Nuclex/ThinOrm/Transactions/Transaction.h"
+#include "Nuclex/ThinOrm/Connections/Connection.h"
+
+#include <stdexcept> // for std::logic_error
+
+namespace Nuclex::ThinOrm::Transactions {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Transaction::Transaction() noexcept :
+    connection(nullptr),
+    depth(0),
+    serial(0) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Transaction::Transaction(
+    Connections::Connection &connection, std::size_t depth, std::uint64_t serial
+  ) noexcept :
+    connection(&connection),
+    depth(depth),
+    serial(serial) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Transaction::Transaction(Transaction &&other) noexcept :
+    connection(other.connection),
+    depth(other.depth),
+    serial(other.serial) {
+    other.connection = nullptr;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Transaction::~Transaction() {
+    if(IsActive()) {
+      try {
+        Rollback();
+      }
+      catch(...) {
+        // Destructors must not throw. The connection has forgotten the transaction
+        // already, so the next transaction begun on it will start from a clean slate.
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool Transaction::IsActive() const noexcept {
+    return (
+      (this->connection != nullptr) &&
+      this->connection->isTransactionActive(this->depth, this->serial)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void Transaction::Commit() {
+    if(!IsActive()) {
+      throw std::logic_error(
+        reinterpret_cast<const char *>(u8"Transaction has already been ended")
+      );
+    }
+
+    this->connection->endTransaction(this->depth, true);
+    this->connection = nullptr;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void Transaction::Rollback() {
+    if(IsActive()) {
+      Connections::Connection *endingConnection = this->connection;
+      this->connection = nullptr;
+      endingConnection->endTransaction(this->depth, false);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Transaction &Transaction::operator =(Transaction &&other) {
+    if(&other != this) {
+      Rollback();
+
+      this->connection = other.connection;
+      this->depth = other.depth;
+      this->serial = other.serial;
+      other.connection = nullptr;
+    }
+
+    return *this;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Transactions
@@ -0,0 +1,63 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./IdentifierQuoter.h"
+
+namespace Nuclex::ThinOrm::Utilities {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void IdentifierQuoter::AppendQuoted(
+    std::u8string &target,
+    const std::u8string_view &identifier,
+    Dialects::QuoteStyle quoteStyle /* = Dialects::QuoteStyle::DoubleQuotes */
+  ) {
+    char8_t openingQuote, closingQuote;
+    switch(quoteStyle) {
+      case Dialects::QuoteStyle::Brackets: {
+        openingQuote = u8'[';
+        closingQuote = u8']';
+        break;
+      }
+      case Dialects::QuoteStyle::Backticks: {
+        openingQuote = closingQuote = u8'`';
+        break;
+      }
+      default: {
+        openingQuote = closingQuote = u8'"';
+        break;
+      }
+    }
+
+    target.push_back(openingQuote);
+    for(char8_t character : identifier) {
+      if(character == closingQuote) {
+        target.push_back(closingQuote);
+      }
+      target.push_back(character);
+    }
+    target.push_back(closingQuote);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Utilities
@@ -0,0 +1,79 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_UTILITIES_IDENTIFIERQUOTER_H
+#define NUCLEX_THINORM_UTILITIES_IDENTIFIERQUOTER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Dialects/QuoteStyle.h"
+
+#include <string> // for std::u8string
+#include <string_view> // for std::u8string_view
+
+namespace Nuclex::ThinOrm::Utilities {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Helper methods to put identifiers into quotes for generated SQL</summary>
+  /// <remarks>
+  ///   Generated statements always quote table and column names so that names which
+  ///   happen to be reserved words or contain unusual characters are passed through
+  ///   unharmed. Closing quote characters inside the identifier are doubled, which is
+  ///   the escape convention for all three quote styles.
+  /// </remarks>
+  class IdentifierQuoter {
+
+    /// <summary>Appends an identifier in quotes to the specified string</summary>
+    /// <param name="target">String to which the quoted identifier will be appended</param>
+    /// <param name="identifier">Identifier that will be quoted and appended</param>
+    /// <param name="quoteStyle">Quotes that will be put around the identifier</param>
+    public: static void AppendQuoted(
+      std::u8string &target,
+      const std::u8string_view &identifier,
+      Dialects::QuoteStyle quoteStyle = Dialects::QuoteStyle::DoubleQuotes
+    );
+
+    /// <summary>Puts an identifier into quotes</summary>
+    /// <param name="identifier">Identifier that will be quoted</param>
+    /// <param name="quoteStyle">Quotes that will be put around the identifier</param>
+    /// <returns>The identifier in quotes</returns>
+    public: static inline std::u8string Quote(
+      const std::u8string_view &identifier,
+      Dialects::QuoteStyle quoteStyle = Dialects::QuoteStyle::DoubleQuotes
+    );
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::u8string IdentifierQuoter::Quote(
+    const std::u8string_view &identifier,
+    Dialects::QuoteStyle quoteStyle /* = Dialects::QuoteStyle::DoubleQuotes */
+  ) {
+    std::u8string result;
+    result.reserve(identifier.length() + 2);
+    AppendQuoted(result, identifier, quoteStyle);
+    return result;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Utilities
+
+#endif // NUCLEX_THINORM_UTILITIES_IDENTIFIERQUOTER_H
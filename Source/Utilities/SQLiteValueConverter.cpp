@@ -0,0 +1,321 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "./SQLiteValueConverter.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "./Iso8601Converter.h" // for Iso8601Converter
+#include "Nuclex/ThinOrm/DateTime.h" // for DateTime
+
+#include <string_view> // for std::string_view
+#include <optional> // for std::optional
+#include <cstddef> // for std::byte
+#include <span> // for std::span
+#include <stdexcept> // for std::runtime_error
+
+// Converts a UTF-8 string literal into a char pointer for the std exceptions
+#define U8CHARS(x) (reinterpret_cast<const char *>(x))
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether a column type declaration contains the specified keyword</summary>
+  /// <param name="declaredType">Column type as declared in the CREATE TABLE statement</param>
+  /// <param name="upperCaseKeyword">Keyword to look for, must be upper case ASCII</param>
+  /// <returns>True if the keyword appears anywhere inside the declared type</returns>
+  /// <remarks>
+  ///   This mirrors how SQLite itself determines column affinity: by looking for
+  ///   substrings such as 'INT' or 'CHAR' inside the declared type, ignoring case.
+  /// </remarks>
+  bool declaredTypeContains(const std::string_view &declaredType, const char *upperCaseKeyword) {
+    std::string_view keyword(upperCaseKeyword);
+    if(keyword.length() > declaredType.length()) {
+      return false;
+    }
+
+    std::string_view::size_type lastStart = declaredType.length() - keyword.length();
+    for(std::string_view::size_type start = 0; start <= lastStart; ++start) {
+      bool matches = true;
+      for(std::string_view::size_type index = 0; index < keyword.length(); ++index) {
+        char character = declaredType[start + index];
+        if((character >= 'a') && (character <= 'z')) {
+          character -= ('a' - 'A');
+        }
+        if(character != keyword[index]) {
+          matches = false;
+          break;
+        }
+      }
+      if(matches) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Looks up the value type matching a column's declared type</summary>
+  /// <param name="declaredType">
+  ///   Column type as declared in the CREATE TABLE statement, can be a null pointer
+  /// </param>
+  /// <returns>The matching value type or nothing if the declared type is unknown</returns>
+  std::optional<Nuclex::ThinOrm::ValueType> valueTypeFromDeclaredType(const char *declaredType) {
+    using Nuclex::ThinOrm::ValueType;
+
+    if(declaredType == nullptr) {
+      return std::optional<ValueType>();
+    }
+
+    // The order of these checks matters. For example, 'DATETIME' needs to be caught
+    // before 'DATE' and 'TIME' and 'BOOL' would never contain 'INT' but SQLite gives
+    // columns declared as 'INTEGER' any special treatment only via the 'INT' substring.
+    std::string_view type(declaredType);
+    if(declaredTypeContains(type, "BOOL")) {
+      return ValueType::Boolean;
+    } else if(declaredTypeContains(type, "INT")) {
+      return ValueType::Int64;
+    } else if(declaredTypeContains(type, "DATETIME") || declaredTypeContains(type, "TIMESTAMP")) {
+      return ValueType::DateTime;
+    } else if(declaredTypeContains(type, "DATE")) {
+      return ValueType::Date;
+    } else if(declaredTypeContains(type, "TIME")) {
+      return ValueType::Time;
+    } else if(
+      declaredTypeContains(type, "CHAR") ||
+      declaredTypeContains(type, "CLOB") ||
+      declaredTypeContains(type, "TEXT")
+    ) {
+      return ValueType::String;
+    } else if(declaredTypeContains(type, "BLOB")) {
+      return ValueType::Blob;
+    } else if(
+      declaredTypeContains(type, "REAL") ||
+      declaredTypeContains(type, "FLOA") ||
+      declaredTypeContains(type, "DOUB")
+    ) {
+      return ValueType::Double;
+    } else {
+      return std::optional<ValueType>();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Binds a UTF-8 string to a parameter of a prepared statement</summary>
+  /// <param name="statement">Prepared statement the string will be bound to</param>
+  /// <param name="parameterIndex">One-based index of the parameter to bind</param>
+  /// <param name="text">String that will be bound to the parameter</param>
+  /// <returns>The result code returned by SQLite's binding function</returns>
+  int bindText(::sqlite3_stmt *statement, int parameterIndex, const std::u8string_view &text) {
+    return ::sqlite3_bind_text64(
+      statement,
+      parameterIndex,
+      reinterpret_cast<const char *>(text.data()),
+      static_cast<::sqlite3_uint64>(text.length()),
+      SQLITE_TRANSIENT,
+      SQLITE_UTF8
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Utilities {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  int SQLiteValueConverter::BindValue(
+    ::sqlite3_stmt *statement, int parameterIndex, const Value &value
+  ) {
+    if(value.IsEmpty()) {
+      return ::sqlite3_bind_null(statement, parameterIndex);
+    }
+
+    switch(value.GetType()) {
+      case ValueType::Boolean: {
+        return ::sqlite3_bind_int(statement, parameterIndex, static_cast<bool>(value) ? 1 : 0);
+      }
+      case ValueType::UInt8:
+      case ValueType::Int16:
+      case ValueType::Int32:
+      case ValueType::Int64: {
+        return ::sqlite3_bind_int64(
+          statement, parameterIndex, static_cast<::sqlite3_int64>(static_cast<std::int64_t>(value))
+        );
+      }
+      case ValueType::Float:
+      case ValueType::Double: {
+        return ::sqlite3_bind_double(statement, parameterIndex, static_cast<double>(value));
+      }
+      case ValueType::String: { // Strings can be bound without making a copy first
+        return bindText(statement, parameterIndex, value.GetStringView().value());
+      }
+      case ValueType::Decimal:
+      case ValueType::Date:
+      case ValueType::Time:
+      case ValueType::DateTime: {
+        return bindText(statement, parameterIndex, static_cast<std::u8string>(value));
+      }
+      case ValueType::Blob: {
+        std::span<const std::byte> bytes = value.GetBlobView().value();
+        if(bytes.empty()) { // SQLite would bind NULL if given a null pointer
+          return ::sqlite3_bind_zeroblob(statement, parameterIndex, 0);
+        }
+        return ::sqlite3_bind_blob64(
+          statement,
+          parameterIndex,
+          bytes.data(),
+          static_cast<::sqlite3_uint64>(bytes.size()),
+          SQLITE_TRANSIENT
+        );
+      }
+      default: {
+        throw std::runtime_error(
+          U8CHARS(
+            u8"Attempted to bind a Nuclex::ThinOrm::Value() to an SQLite statement, "
+            u8"but the Nuclex::ThinOrm::Value's type cannot be represented in SQLite."
+          )
+        );
+      }
+    } // switch on value type
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value SQLiteValueConverter::ValueFromColumn(::sqlite3_stmt *statement, int columnIndex) {
+    std::optional<ValueType> declaredType = valueTypeFromDeclaredType(
+      ::sqlite3_column_decltype(statement, columnIndex)
+    );
+
+    switch(::sqlite3_column_type(statement, columnIndex)) {
+      case SQLITE_INTEGER: {
+        std::int64_t integer = static_cast<std::int64_t>(
+          ::sqlite3_column_int64(statement, columnIndex)
+        );
+        if(declaredType.has_value() && (declaredType.value() == ValueType::Boolean)) {
+          return Value(integer != 0);
+        } else {
+          return Value(integer);
+        }
+      }
+      case SQLITE_FLOAT: {
+        return Value(::sqlite3_column_double(statement, columnIndex));
+      }
+      case SQLITE_TEXT: {
+
+        // Per the SQLite docs, the text pointer needs to be fetched before the length,
+        // otherwise the length may be of a different encoding of the string.
+        const char8_t *characters = reinterpret_cast<const char8_t *>(
+          ::sqlite3_column_text(statement, columnIndex)
+        );
+        std::u8string_view text(
+          characters, static_cast<std::size_t>(::sqlite3_column_bytes(statement, columnIndex))
+        );
+
+        // Dates and times are stored as ISO 8601 strings, so if the column was declared
+        // as holding dates and/or times, turn them back into the right kind of value.
+        if(declaredType.has_value()) {
+          switch(declaredType.value()) {
+            case ValueType::Date: {
+              return Value::FromDate(
+                DateTime(Iso8601Converter::ParseIso8601DateTime(text))
+              );
+            }
+            case ValueType::Time: {
+              return Value::FromTime(
+                DateTime(Iso8601Converter::ParseIso8601Time(text))
+              );
+            }
+            case ValueType::DateTime: {
+              return Value::FromDateTime(
+                DateTime(Iso8601Converter::ParseIso8601DateTime(text))
+              );
+            }
+            default: { break; }
+          }
+        }
+
+        return Value(text);
+      }
+      case SQLITE_BLOB: {
+        const std::byte *bytes = reinterpret_cast<const std::byte *>(
+          ::sqlite3_column_blob(statement, columnIndex)
+        );
+        std::size_t length = static_cast<std::size_t>(
+          ::sqlite3_column_bytes(statement, columnIndex)
+        );
+        return Value(std::span<const std::byte>(bytes, length));
+      }
+      default: { // SQLITE_NULL
+        return EmptyValueFromType(ValueTypeFromColumn(statement, columnIndex));
+      }
+    } // switch on storage class
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  ValueType SQLiteValueConverter::ValueTypeFromColumn(::sqlite3_stmt *statement, int columnIndex) {
+    std::optional<ValueType> declaredType = valueTypeFromDeclaredType(
+      ::sqlite3_column_decltype(statement, columnIndex)
+    );
+    if(declaredType.has_value()) {
+      return declaredType.value();
+    }
+
+    switch(::sqlite3_column_type(statement, columnIndex)) {
+      case SQLITE_INTEGER: { return ValueType::Int64; }
+      case SQLITE_FLOAT: { return ValueType::Double; }
+      case SQLITE_BLOB: { return ValueType::Blob; }
+      default: { return ValueType::String; } // Text and null with unknown type
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value SQLiteValueConverter::EmptyValueFromType(ValueType valueType) {
+    switch(valueType) {
+      case ValueType::Boolean: { return Value(std::optional<bool>()); }
+      case ValueType::UInt8: { return Value(std::optional<std::uint8_t>()); }
+      case ValueType::Int16: { return Value(std::optional<std::int16_t>()); }
+      case ValueType::Int32: { return Value(std::optional<std::int32_t>()); }
+      case ValueType::Int64: { return Value(std::optional<std::int64_t>()); }
+      case ValueType::Decimal: { return Value(std::optional<Decimal>()); }
+      case ValueType::Float: { return Value(std::optional<float>()); }
+      case ValueType::Double: { return Value(std::optional<double>()); }
+      case ValueType::Date: { return Value::FromDate(std::optional<DateTime>()); }
+      case ValueType::Time: { return Value::FromTime(std::optional<DateTime>()); }
+      case ValueType::DateTime: { return Value::FromDateTime(std::optional<DateTime>()); }
+      case ValueType::Blob: { return Value(std::optional<std::vector<std::byte>>()); }
+      default: { return Value(std::optional<std::u8string>()); }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Utilities
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
@@ -0,0 +1,88 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_UTILITIES_SQLITEVALUECONVERTER_H
+#define NUCLEX_THINORM_UTILITIES_SQLITEVALUECONVERTER_H
+
+#include "Nuclex/ThinOrm/Config.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "Nuclex/ThinOrm/Value.h" // for Value
+
+#include <sqlite3.h> // for ::sqlite3_stmt
+
+namespace Nuclex::ThinOrm::Utilities {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Moves values between prepared SQLite statements and the Value class</summary>
+  /// <remarks>
+  ///   <para>
+  ///     SQLite only knows five storage classes (integer, real, text, blob and null),
+  ///     so richer types need to be mapped onto those. Booleans are stored as integers,
+  ///     decimals as well as dates and times are stored as text in ISO 8601 format,
+  ///     which is what SQLite's own date and time functions expect.
+  ///   </para>
+  ///   <para>
+  ///     When reading, the declared type of a result column (if it stems from a table
+  ///     column) is used to turn values back into the type they were stored as.
+  ///   </para>
+  /// </remarks>
+  class SQLiteValueConverter {
+
+    /// <summary>Binds a value to a parameter of a prepared statement</summary>
+    /// <param name="statement">Prepared statement the value will be bound to</param>
+    /// <param name="parameterIndex">One-based index of the parameter to bind</param>
+    /// <param name="value">Value that will be bound to the parameter</param>
+    /// <returns>The result code returned by SQLite's binding function</returns>
+    public: static int BindValue(
+      ::sqlite3_stmt *statement, int parameterIndex, const Value &value
+    );
+
+    /// <summary>Reads the value of a column in the current result row</summary>
+    /// <param name="statement">Prepared statement that has stepped onto a row</param>
+    /// <param name="columnIndex">Zero-based index of the column to read</param>
+    /// <returns>A value holding the contents of the column in the current row</returns>
+    public: static Value ValueFromColumn(::sqlite3_stmt *statement, int columnIndex);
+
+    /// <summary>Determines the value type that best represents a result column</summary>
+    /// <param name="statement">Prepared statement whose result column will be checked</param>
+    /// <param name="columnIndex">Zero-based index of the column to check</param>
+    /// <returns>The value type best suited to represent the column's contents</returns>
+    /// <remarks>
+    ///   If the column has a declared type, that type decides. For computed columns,
+    ///   the storage class of the value in the current row is used instead.
+    /// </remarks>
+    public: static ValueType ValueTypeFromColumn(::sqlite3_stmt *statement, int columnIndex);
+
+    /// <summary>Constructs an empty value of the specified type</summary>
+    /// <param name="valueType">Type the empty value should have</param>
+    /// <returns>An empty value of the specified type</returns>
+    public: static Value EmptyValueFromType(ValueType valueType);
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Utilities
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#endif // NUCLEX_THINORM_UTILITIES_SQLITEVALUECONVERTER_H
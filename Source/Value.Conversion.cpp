@@ -221,7 +221,7 @@ namespace Nuclex::ThinOrm {
         case ValueType::Decimal: { return !this->value.DecimalValue.IsZero(); }
         case ValueType::Float: { return (this->value.Float != 0.0f); }
         case ValueType::Double: { return (this->value.Float != 0.0); }
-        case ValueType::String: { return BooleanFromString(this->value.String); }
+        case ValueType::String: { return BooleanFromString(std::u8string(getStringView())); }
         case ValueType::Blob: {
           return !this->value.Blob.empty();
         }
@@ -263,12 +263,13 @@ namespace Nuclex::ThinOrm {
           );
         }
         case ValueType::String: {
-          if(this->value.String.find(u8'.') == std::string::npos) {
-            return Nuclex::Support::Text::lexical_cast<std::uint8_t>(this->value.String);
+          std::u8string stringValue(getStringView());
+          if(stringValue.find(u8'.') == std::string::npos) {
+            return Nuclex::Support::Text::lexical_cast<std::uint8_t>(stringValue);
           } else {
             return static_cast<std::uint8_t>(
               Nuclex::ThinOrm::Utilities::Quantizer::NearestInt32(
-                Nuclex::Support::Text::lexical_cast<float>(this->value.String)
+                Nuclex::Support::Text::lexical_cast<float>(stringValue)
               )
             );
           }
@@ -333,12 +334,13 @@ namespace Nuclex::ThinOrm {
           );
         }
         case ValueType::String: {
-          if(this->value.String.find(u8'.') == std::string::npos) {
-            return Nuclex::Support::Text::lexical_cast<std::int16_t>(this->value.String);
+          std::u8string stringValue(getStringView());
+          if(stringValue.find(u8'.') == std::string::npos) {
+            return Nuclex::Support::Text::lexical_cast<std::int16_t>(stringValue);
           } else {
             return static_cast<std::int16_t>(
               Nuclex::ThinOrm::Utilities::Quantizer::NearestInt32(
-                Nuclex::Support::Text::lexical_cast<float>(this->value.String)
+                Nuclex::Support::Text::lexical_cast<float>(stringValue)
               )
             );
           }
@@ -393,11 +395,12 @@ namespace Nuclex::ThinOrm {
           return Nuclex::ThinOrm::Utilities::Quantizer::NearestInt32(this->value.Double);
         }
         case ValueType::String: {
-          if(this->value.String.find(u8'.') == std::string::npos) {
-            return Nuclex::Support::Text::lexical_cast<std::int32_t>(this->value.String);
+          std::u8string stringValue(getStringView());
+          if(stringValue.find(u8'.') == std::string::npos) {
+            return Nuclex::Support::Text::lexical_cast<std::int32_t>(stringValue);
           } else {
             return Nuclex::ThinOrm::Utilities::Quantizer::NearestInt32(
-              Nuclex::Support::Text::lexical_cast<float>(this->value.String)
+              Nuclex::Support::Text::lexical_cast<float>(stringValue)
             );
           }
         }
@@ -451,11 +454,12 @@ namespace Nuclex::ThinOrm {
           return Nuclex::ThinOrm::Utilities::Quantizer::NearestInt64(this->value.Double);
         }
         case ValueType::String: {
-          if(this->value.String.find(u8'.') == std::string::npos) {
-            return Nuclex::Support::Text::lexical_cast<std::int64_t>(this->value.String);
+          std::u8string stringValue(getStringView());
+          if(stringValue.find(u8'.') == std::string::npos) {
+            return Nuclex::Support::Text::lexical_cast<std::int64_t>(stringValue);
           } else {
             return Nuclex::ThinOrm::Utilities::Quantizer::NearestInt64(
-              Nuclex::Support::Text::lexical_cast<double>(this->value.String)
+              Nuclex::Support::Text::lexical_cast<double>(stringValue)
             );
           }
         }
@@ -546,7 +550,7 @@ namespace Nuclex::ThinOrm {
         case ValueType::Float: { return this->value.Float; }
         case ValueType::Double: { return static_cast<float>(this->value.Double); }
         case ValueType::String: {
-          return Nuclex::Support::Text::lexical_cast<float>(this->value.String);
+          return Nuclex::Support::Text::lexical_cast<float>(std::u8string(getStringView()));
         }
         case ValueType::Date: {
           return static_cast<float>(
@@ -593,7 +597,7 @@ namespace Nuclex::ThinOrm {
         case ValueType::Float: { return static_cast<double>(this->value.Float); }
         case ValueType::Double: { return this->value.Double; }
         case ValueType::String: {
-          return Nuclex::Support::Text::lexical_cast<double>(this->value.String);
+          return Nuclex::Support::Text::lexical_cast<double>(std::u8string(getStringView()));
         }
         case ValueType::Date: {
           return static_cast<double>(
@@ -653,7 +657,7 @@ namespace Nuclex::ThinOrm {
         case ValueType::Double: {
           return Nuclex::Support::Text::lexical_cast<std::u8string>(this->value.Double);
         }
-        case ValueType::String: { return this->value.String; }
+        case ValueType::String: { return std::u8string(getStringView()); }
         case ValueType::Date: { return DateTime(this->value.Int64).ToIso8601Date(); }
         case ValueType::Time: { return DateTime(this->value.Int64).ToIso8601Time(); }
         case ValueType::DateTime: { return DateTime(this->value.Int64).ToIso8601DateTime(); }
@@ -698,7 +702,7 @@ namespace Nuclex::ThinOrm {
         case ValueType::Double: {
           return Nuclex::Support::Text::lexical_cast<std::u8string>(this->value.Double);
         }
-        case ValueType::String: { return this->value.String; }
+        case ValueType::String: { return std::u8string(getStringView()); }
         #endif
         case ValueType::Date:
         case ValueType::Time:
@@ -767,11 +771,10 @@ namespace Nuclex::ThinOrm {
           break;
         }
         case ValueType::String: {
-          result.resize(this->value.String.size());
+          std::u8string_view stringValue = getStringView();
+          result.resize(stringValue.size());
           std::copy_n(
-            this->value.String.data(),
-            this->value.String.size(),
-            reinterpret_cast<char8_t *>(result.data())
+            stringValue.data(), stringValue.size(), reinterpret_cast<char8_t *>(result.data())
           );
           break;
         }
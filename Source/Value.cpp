@@ -23,6 +23,7 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Value.h"
 
 #include <cassert> // for assert()
+#include <algorithm> // for std::copy_n()
 
 #include "Nuclex/ThinOrm//Errors/BadValueTypeError.h" // for BadValueTypeError
 
@@ -54,6 +55,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const Value &other) noexcept :
     type(other.type),
     empty(other.empty),
+    shortString(other.shortString),
     value() {
 
     if(!other.empty) [[likely]] {
@@ -69,7 +71,12 @@ namespace Nuclex::ThinOrm {
         case ValueType::Float: { this->value.Float = other.value.Float; break; }
         case ValueType::Double: { this->value.Double = other.value.Double; break; }
         case ValueType::String: {
-          new(&this->value.String) std::u8string(other.value.String); break;
+          if(other.shortString) {
+            this->value.ShortString = other.value.ShortString;
+          } else {
+            new(&this->value.String) std::u8string(other.value.String);
+          }
+          break;
         }
         case ValueType::Date:
         case ValueType::Time:
@@ -89,6 +96,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(Value &&other) noexcept :
     type(other.type),
     empty(other.empty),
+    shortString(other.shortString),
     value() {
 
     if(!other.empty) [[likely]] {
@@ -104,7 +112,12 @@ namespace Nuclex::ThinOrm {
         case ValueType::Float: { this->value.Float = other.value.Float; break; }
         case ValueType::Double: { this->value.Double = other.value.Double; break; }
         case ValueType::String: {
-          new(&this->value.String) std::u8string(std::move(other.value.String)); break;
+          if(other.shortString) {
+            this->value.ShortString = other.value.ShortString;
+          } else {
+            new(&this->value.String) std::u8string(std::move(other.value.String));
+          }
+          break;
         }
         case ValueType::Date:
         case ValueType::Time:
@@ -126,6 +139,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(bool booleanValue) noexcept :
     type(ValueType::Boolean),
     empty(false),
+    shortString(false),
     value() {
     this->value.Boolean = booleanValue;
   }
@@ -135,6 +149,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(std::uint8_t uint8Value) noexcept :
     type(ValueType::UInt8),
     empty(false),
+    shortString(false),
     value() {
     this->value.Uint8 = uint8Value;
   }
@@ -144,6 +159,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(std::int16_t int16Value) noexcept :
     type(ValueType::Int16),
     empty(false),
+    shortString(false),
     value() {
     this->value.Int16 = int16Value;
   }
@@ -153,6 +169,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(std::int32_t int32Value) noexcept :
     type(ValueType::Int32),
     empty(false),
+    shortString(false),
     value() {
     this->value.Int32 = int32Value;
   }
@@ -162,6 +179,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(std::int64_t int64Value) noexcept :
     type(ValueType::Int64),
     empty(false),
+    shortString(false),
     value() {
     this->value.Int64 = int64Value;
   }
@@ -171,6 +189,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const Decimal &decimalValue) noexcept :
     type(ValueType::Decimal),
     empty(false),
+    shortString(false),
     value() {
     new(&this->value.DecimalValue) Decimal(decimalValue);
   }
@@ -180,6 +199,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(float floatValue) noexcept :
     type(ValueType::Float),
     empty(false),
+    shortString(false),
     value() {
     this->value.Float = floatValue;
   }
@@ -189,6 +209,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(double doubleValue) noexcept :
     type(ValueType::Double),
     empty(false),
+    shortString(false),
     value() {
     this->value.Double = doubleValue;
   }
@@ -198,8 +219,36 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::u8string &stringValue) noexcept :
     type(ValueType::String),
     empty(false),
+    shortString(false),
     value() {
-    new(&this->value.String) std::u8string(stringValue);
+    constructString(stringValue);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value::Value(std::u8string &&stringValue) noexcept :
+    type(ValueType::String),
+    empty(false),
+    shortString(false),
+    value() {
+
+    // Taking over the string's buffer is free, but only if it has one. Otherwise the string's
+    // characters are in its own small buffer and our short string storage is just as good.
+    if(stringValue.length() <= sizeof(this->value.ShortString.Characters)) {
+      constructString(stringValue);
+    } else {
+      new(&this->value.String) std::u8string(std::move(stringValue));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value::Value(const std::u8string_view &stringValue) noexcept :
+    type(ValueType::String),
+    empty(false),
+    shortString(false),
+    value() {
+    constructString(stringValue);
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -207,15 +256,37 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::vector<std::byte> &blobValue) noexcept :
     type(ValueType::Blob),
     empty(false),
+    shortString(false),
     value() {
     new(&this->value.Blob) std::vector<std::byte>(blobValue);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
+  Value::Value(std::vector<std::byte> &&blobValue) noexcept :
+    type(ValueType::Blob),
+    empty(false),
+    shortString(false),
+    value() {
+    new(&this->value.Blob) std::vector<std::byte>(std::move(blobValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value::Value(const std::span<const std::byte> &blobValue) noexcept :
+    type(ValueType::Blob),
+    empty(false),
+    shortString(false),
+    value() {
+    new(&this->value.Blob) std::vector<std::byte>(blobValue.begin(), blobValue.end());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   Value::Value(const std::optional<bool> &booleanValue) noexcept :
     type(ValueType::Boolean),
     empty(!booleanValue.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Boolean = booleanValue.value();
@@ -227,6 +298,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<std::uint8_t> &uint8Value) noexcept :
     type(ValueType::UInt8),
     empty(!uint8Value.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Uint8 = uint8Value.value();
@@ -238,6 +310,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<std::int16_t> &int16Value) noexcept :
     type(ValueType::Int16),
     empty(!int16Value.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Int16 = int16Value.value();
@@ -249,6 +322,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<std::int32_t> &int32Value) noexcept :
     type(ValueType::Int32),
     empty(!int32Value.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Int32 = int32Value.value();
@@ -260,6 +334,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<std::int64_t> &int64Value) noexcept :
     type(ValueType::Int64),
     empty(!int64Value.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Int64 = int64Value.value();
@@ -271,6 +346,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<Decimal> &decimalValue) noexcept :
     type(ValueType::Decimal),
     empty(!decimalValue.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       new(&this->value.DecimalValue) Decimal(decimalValue.value());
@@ -282,6 +358,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<float> &floatValue) noexcept :
     type(ValueType::Float),
     empty(!floatValue.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Float = floatValue.value();
@@ -293,6 +370,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<double> &doubleValue) noexcept :
     type(ValueType::Double),
     empty(!doubleValue.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       this->value.Double = doubleValue.value();
@@ -304,9 +382,26 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<std::u8string> &stringValue) noexcept :
     type(ValueType::String),
     empty(!stringValue.has_value()),
+    shortString(false),
+    value() {
+    if(!empty) {
+      constructString(stringValue.value());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  Value::Value(std::optional<std::u8string> &&stringValue) noexcept :
+    type(ValueType::String),
+    empty(!stringValue.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
-      new(&this->value.String) std::u8string(stringValue.value());
+      if(stringValue.value().length() <= sizeof(this->value.ShortString.Characters)) {
+        constructString(stringValue.value());
+      } else {
+        new(&this->value.String) std::u8string(std::move(stringValue.value()));
+      }
     }
   }
 
@@ -315,6 +410,7 @@ namespace Nuclex::ThinOrm {
   Value::Value(const std::optional<std::vector<std::byte>> &blobValue) noexcept :
     type(ValueType::Blob),
     empty(!blobValue.has_value()),
+    shortString(false),
     value() {
     if(!empty) {
       new(&this->value.Blob) std::vector<std::byte>(blobValue.value());
@@ -323,11 +419,28 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  Value::Value(std::optional<std::vector<std::byte>> &&blobValue) noexcept :
+    type(ValueType::Blob),
+    empty(!blobValue.has_value()),
+    shortString(false),
+    value() {
+    if(!empty) {
+      new(&this->value.Blob) std::vector<std::byte>(std::move(blobValue.value()));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   Value::~Value() noexcept {
     if(!this->empty) [[likely]] {
       switch(this->type) {
         case ValueType::Decimal: { this->value.DecimalValue.~Decimal(); break; }
-        case ValueType::String: { this->value.String.~basic_string(); break; }
+        case ValueType::String: {
+          if(!this->shortString) {
+            this->value.String.~basic_string();
+          }
+          break;
+        }
         case ValueType::Blob: { this->value.Blob.~vector(); break; }
         default: break;
       }
@@ -425,14 +538,38 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  std::optional<std::u8string_view> Value::GetStringView() const {
+    Require(ValueType::String);
+    if(this->empty) [[unlikely]] {
+      return std::optional<std::u8string_view>();
+    } else {
+      return getStringView();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::optional<std::span<const std::byte>> Value::GetBlobView() const {
+    Require(ValueType::Blob);
+    if(this->empty) [[unlikely]] {
+      return std::optional<std::span<const std::byte>>();
+    } else {
+      return std::span<const std::byte>(this->value.Blob.data(), this->value.Blob.size());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   Value &Value::operator =(const Value &other) noexcept {
     this->~Value();
 
-    // Here, 'this->empty' will be 'true' after the destructor call,
-    // which is ideal in case a copy constructor throws an exception.
-    // We'll only set it at the end of the method if we filled in a value.
+    // Mark the value as empty after the destructor call, which is ideal in case
+    // a copy constructor throws an exception. We'll only set it at the end of
+    // the method if we filled in a value.
+    this->empty = true;
 
     this->type = other.type;
+    this->shortString = other.shortString;
 
     if(!other.empty) [[likely]] {
       switch(other.type) {
@@ -447,7 +584,12 @@ namespace Nuclex::ThinOrm {
         case ValueType::Float: { this->value.Float = other.value.Float; break; }
         case ValueType::Double: { this->value.Double = other.value.Double; break; }
         case ValueType::String: {
-          new(&this->value.String) std::u8string(other.value.String); break;
+          if(other.shortString) {
+            this->value.ShortString = other.value.ShortString;
+          } else {
+            new(&this->value.String) std::u8string(other.value.String);
+          }
+          break;
         }
         case ValueType::Date:
         case ValueType::Time:
@@ -471,11 +613,13 @@ namespace Nuclex::ThinOrm {
   Value &Value::operator =(Value &&other) noexcept {
     this->~Value();
 
-    // Here, 'this->empty' will be 'true' after the destructor call,
-    // which is ideal in case a copy constructor throws an exception.
-    // We'll only set it at the end of the method if we filled in a value.
+    // Mark the value as empty after the destructor call, which is ideal in case
+    // a copy constructor throws an exception. We'll only set it at the end of
+    // the method if we filled in a value.
+    this->empty = true;
 
     this->type = other.type;
+    this->shortString = other.shortString;
 
     if(!other.empty) [[likely]] {
       switch(other.type) {
@@ -490,7 +634,12 @@ namespace Nuclex::ThinOrm {
         case ValueType::Float: { this->value.Float = other.value.Float; break; }
         case ValueType::Double: { this->value.Double = other.value.Double; break; }
         case ValueType::String: {
-          new(&this->value.String) std::u8string(std::move(other.value.String)); break;
+          if(other.shortString) {
+            this->value.ShortString = other.value.ShortString;
+          } else {
+            new(&this->value.String) std::u8string(std::move(other.value.String));
+          }
+          break;
         }
         case ValueType::Date:
         case ValueType::Time:
@@ -586,7 +735,7 @@ namespace Nuclex::ThinOrm {
     this->~Value();
     this->type = ValueType::Decimal;
     if(decimalValue.has_value()) [[likely]] {
-      this->value.DecimalValue = decimalValue.value();
+      new(&this->value.DecimalValue) Decimal(decimalValue.value());
       this->empty = false;
     } else {
       this->empty = true;
@@ -628,7 +777,12 @@ namespace Nuclex::ThinOrm {
     this->~Value();
     this->type = ValueType::String;
     if(stringValue.has_value()) [[likely]] {
-      this->value.String = stringValue.value();
+      if(stringValue.value().length() <= sizeof(this->value.ShortString.Characters)) {
+        constructString(stringValue.value());
+      } else {
+        new(&this->value.String) std::u8string(std::move(stringValue.value()));
+        this->shortString = false;
+      }
       this->empty = false;
     } else {
       this->empty = true;
@@ -642,7 +796,7 @@ namespace Nuclex::ThinOrm {
     this->~Value();
     this->type = ValueType::Blob;
     if(blobValue.has_value()) [[likely]] {
-      this->value.Blob = blobValue.value();
+      new(&this->value.Blob) std::vector<std::byte>(std::move(blobValue.value()));
       this->empty = false;
     } else {
       this->empty = true;
@@ -652,4 +806,18 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  void Value::constructString(const std::u8string_view &stringValue) noexcept {
+    std::u8string_view::size_type length = stringValue.length();
+    if(length <= sizeof(this->value.ShortString.Characters)) [[likely]] {
+      this->value.ShortString.Length = static_cast<std::uint8_t>(length);
+      std::copy_n(stringValue.data(), length, this->value.ShortString.Characters);
+      this->shortString = true;
+    } else {
+      new(&this->value.String) std::u8string(stringValue);
+      this->shortString = false;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm
@@ -0,0 +1,140 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/Connections/ConcurrentConnectionPool.h"
+
+#include "./DummyConnection.h" // for DummyConnection, DummyConnectionFactory
+
+#include <atomic> // for std::atomic
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+#include <stdexcept> // for std::logic_error
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentConnectionPoolTest, ShardCountIsRoundedToPowerOfTwo) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 2, 5);
+
+    EXPECT_EQ(pool.CountShards(), 8U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentConnectionPoolTest, ReturnedConnectionsAreReused) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString());
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    pool.ReturnConnection(first);
+    std::shared_ptr<Connection> second = pool.BorrowConnection();
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(factory->ConnectCount.load(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentConnectionPoolTest, ConnectionsReturnedByOtherThreadsCanBeBorrowed) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 2, 4);
+
+    std::shared_ptr<Connection> connection = pool.BorrowConnection();
+    std::thread returner(
+      [&pool, &connection]() { pool.ReturnConnection(connection); }
+    );
+    returner.join();
+
+    // The connection may have landed in another shard, but borrowing should find it
+    std::shared_ptr<Connection> borrowed = pool.BorrowConnection();
+    EXPECT_EQ(borrowed, connection);
+    EXPECT_EQ(factory->ConnectCount.load(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentConnectionPoolTest, RetainedConnectionsAreLimitedPerShard) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 2, 1);
+
+    std::vector<std::shared_ptr<Connection>> borrowed;
+    for(std::size_t index = 0; index < 4; ++index) {
+      borrowed.push_back(pool.BorrowConnection());
+    }
+    for(const std::shared_ptr<Connection> &connection : borrowed) {
+      pool.ReturnConnection(connection);
+    }
+
+    EXPECT_EQ(pool.CountRetainedConnections(), 2U);
+
+    pool.EvictAll();
+    EXPECT_EQ(pool.CountRetainedConnections(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentConnectionPoolTest, ConnectionsAreNeverHandedOutTwice) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 4, 4);
+
+    std::atomic<std::size_t> doubleBorrowCount = 0;
+    std::vector<std::thread> threads;
+    for(std::size_t threadIndex = 0; threadIndex < 8; ++threadIndex) {
+      threads.emplace_back(
+        [&pool, &doubleBorrowCount]() {
+          for(std::size_t iteration = 0; iteration < 1000; ++iteration) {
+            std::shared_ptr<Connection> connection = pool.BorrowConnection();
+            DummyConnection &dummy = static_cast<DummyConnection &>(*connection);
+            if(!dummy.IsHealthy.exchange(false)) {
+              ++doubleBorrowCount; // Somebody else is using this connection right now
+            }
+            dummy.IsHealthy.store(true);
+            pool.ReturnConnection(connection);
+          }
+        }
+      );
+    }
+    for(std::thread &thread : threads) {
+      thread.join();
+    }
+
+    EXPECT_EQ(doubleBorrowCount.load(), 0U);
+    EXPECT_LE(pool.CountRetainedConnections(), 16U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
@@ -0,0 +1,202 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/Connections/ConnectionLease.h"
+#include "Nuclex/ThinOrm/Connections/StandardConnectionPool.h"
+#include "Nuclex/ThinOrm/Connections/ConcurrentConnectionPool.h"
+#include "Nuclex/ThinOrm/Query.h"
+
+#include "./DummyConnection.h" // for DummyConnection, DummyConnectionFactory
+
+#include <atomic> // for std::atomic
+#include <stdexcept> // for std::logic_error, std::runtime_error
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Connection pool that fails whenever a connection is given back to it</summary>
+  class ThrowingConnectionPool : public Nuclex::ThinOrm::Connections::ConnectionPool {
+
+    /// <summary>Hands out a new dummy connection</summary>
+    /// <returns>The new dummy connection</returns>
+    public: std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> BorrowConnection() override {
+      return std::make_shared<Nuclex::ThinOrm::Connections::DummyConnection>();
+    }
+
+    /// <summary>Refuses to take back a connection</summary>
+    /// <param name="connection">Connection that will not be taken back</param>
+    public: void ReturnConnection(
+      const std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> &connection
+    ) override {
+      (void)connection;
+      throw std::runtime_error("Simulated failure returning a connection");
+    }
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, DefaultConstructedLeaseIsEmpty) {
+    ConnectionLease lease;
+    EXPECT_FALSE(static_cast<bool>(lease));
+    EXPECT_NO_THROW(lease.Release());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, ConnectionIsReturnedWhenLeaseIsDestroyed) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+
+    std::shared_ptr<Connection> leasedConnection;
+    {
+      ConnectionLease lease = pool.LeaseConnection();
+      ASSERT_TRUE(static_cast<bool>(lease));
+      leasedConnection = lease.Get();
+      EXPECT_EQ(pool.CountOutstandingLeases(), 1U);
+    }
+
+    EXPECT_EQ(pool.CountOutstandingLeases(), 0U);
+    EXPECT_EQ(pool.BorrowConnection(), leasedConnection);
+    EXPECT_EQ(factory->ConnectCount.load(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, ConnectionIsReturnedWhenExceptionIsThrown) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 2, 1);
+
+    EXPECT_THROW(
+      {
+        ConnectionLease lease = pool.LeaseConnection();
+        lease->RunStatement(Query(u8"SELECT 1"));
+      },
+      std::logic_error
+    );
+
+    EXPECT_EQ(pool.CountOutstandingLeases(), 0U);
+    EXPECT_EQ(pool.CountRetainedConnections(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, DestructorSwallowsExceptionsFromPool) {
+    ThrowingConnectionPool pool;
+
+    EXPECT_NO_THROW(
+      {
+        ConnectionLease lease = pool.LeaseConnection();
+      }
+    );
+    EXPECT_EQ(pool.CountOutstandingLeases(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, ExplicitReleasePassesOnExceptionsFromPool) {
+    ThrowingConnectionPool pool;
+
+    ConnectionLease lease = pool.LeaseConnection();
+    EXPECT_THROW(lease.Release(), std::runtime_error);
+    EXPECT_FALSE(static_cast<bool>(lease));
+    EXPECT_EQ(pool.CountOutstandingLeases(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, BrokenConnectionsAreDiscarded) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+
+    {
+      ConnectionLease lease = pool.LeaseConnection();
+      lease.MarkBroken();
+      EXPECT_TRUE(lease.IsBroken());
+      EXPECT_EQ(pool.CountOpenConnections(), 1U);
+    }
+
+    EXPECT_EQ(pool.CountOpenConnections(), 0U);
+    pool.BorrowConnection();
+    EXPECT_EQ(factory->ConnectCount.load(), 2U); // Had to connect again
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, MovedLeaseReturnsConnectionOnlyOnce) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 2, 1);
+
+    ConnectionLease outer;
+    {
+      ConnectionLease inner = pool.LeaseConnection();
+      outer = std::move(inner);
+      EXPECT_FALSE(static_cast<bool>(inner));
+    }
+
+    EXPECT_TRUE(static_cast<bool>(outer));
+    EXPECT_EQ(pool.CountOutstandingLeases(), 1U);
+    EXPECT_EQ(pool.CountRetainedConnections(), 0U);
+
+    outer.Release();
+    EXPECT_FALSE(static_cast<bool>(outer));
+    EXPECT_EQ(pool.CountOutstandingLeases(), 0U);
+    EXPECT_EQ(pool.CountRetainedConnections(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConnectionLeaseTest, AssigningToLeaseReturnsPreviousConnection) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    ConcurrentConnectionPool<> pool(factory, Configuration::ConnectionString(), 2, 1);
+
+    ConnectionLease first = pool.LeaseConnection();
+    ConnectionLease second = pool.LeaseConnection();
+    EXPECT_EQ(pool.CountOutstandingLeases(), 2U);
+
+    first = std::move(second);
+    EXPECT_EQ(pool.CountOutstandingLeases(), 1U);
+    EXPECT_EQ(pool.CountRetainedConnections(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
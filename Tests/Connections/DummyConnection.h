@@ -0,0 +1,119 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_THINORM_CONNECTIONS_DUMMYCONNECTION_H
+#define NUCLEX_THINORM_CONNECTIONS_DUMMYCONNECTION_H
+
+#include "Nuclex/ThinOrm/Config.h"
+#include "Nuclex/ThinOrm/Connections/Connection.h" // for Connection
+#include "Nuclex/ThinOrm/Connections/ConnectionFactory.h" // for ConnectionFactory
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/Value.h" // for Value
+#include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+
+#include <atomic> // for std::atomic
+#include <memory> // for std::shared_ptr, std::unique_ptr
+#include <stdexcept> // for std::logic_error
+#include <string> // for std::u8string
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Connection that doesn't connect anywhere, only used as a token</summary>
+  class DummyConnection : public Connection {
+
+    /// <summary>Pretends to run a statement on the database</summary>
+    /// <param name="statement">Statement that will not be run</param>
+    public: void RunStatement(const Nuclex::ThinOrm::Query &statement) override {
+      (void)statement;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to run a query with a single result on the database</summary>
+    /// <param name="scalarQuery">Query that will not be run</param>
+    /// <returns>Nothing, always throws</returns>
+    public: Nuclex::ThinOrm::Value RunScalarQuery(
+      const Nuclex::ThinOrm::Query &scalarQuery
+    ) override {
+      (void)scalarQuery;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to run an updating query on the database</summary>
+    /// <param name="updateQuery">Query that will not be run</param>
+    /// <returns>Nothing, always throws</returns>
+    public: std::size_t RunUpdateQuery(const Nuclex::ThinOrm::Query &updateQuery) override {
+      (void)updateQuery;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to run a query producing rows on the database</summary>
+    /// <param name="rowQuery">Query that will not be run</param>
+    /// <returns>Nothing, always throws</returns>
+    public: std::unique_ptr<Nuclex::ThinOrm::RowReader> RunRowQuery(
+      const Nuclex::ThinOrm::Query &rowQuery
+    ) override {
+      (void)rowQuery;
+      throw std::logic_error("Dummy connection can't run queries");
+    }
+
+    /// <summary>Pretends to check whether a table exists</summary>
+    /// <param name="tableName">Name of the table that will not be checked</param>
+    /// <returns>Always false</returns>
+    public: bool DoesTableOrViewExist(const std::u8string &tableName) override {
+      (void)tableName;
+      return false;
+    }
+
+    /// <summary>Reports whether the dummy connection has been marked as healthy</summary>
+    /// <returns>The value of the <see cref="IsHealthy" /> flag</returns>
+    public: bool CheckHealth() override { return this->IsHealthy.load(); }
+
+    /// <summary>Whether the dummy connection will pass health checks</summary>
+    public: std::atomic<bool> IsHealthy = true;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Factory that creates dummy connections and counts them</summary>
+  class DummyConnectionFactory : public ConnectionFactory {
+
+    /// <summary>Creates a new dummy connection</summary>
+    /// <param name="connectionProperties">Ignored</param>
+    /// <returns>The new dummy connection</returns>
+    public: std::shared_ptr<Connection> Connect(
+      const Nuclex::ThinOrm::Configuration::ConnectionProperties &connectionProperties
+    ) const override {
+      (void)connectionProperties;
+      ++this->ConnectCount;
+      return std::make_shared<DummyConnection>();
+    }
+
+    /// <summary>Number of connections that have been created so far</summary>
+    public: mutable std::atomic<std::size_t> ConnectCount = 0;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
+
+#endif // NUCLEX_THINORM_CONNECTIONS_DUMMYCONNECTION_H
@@ -0,0 +1,187 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2025 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "../../../Source/Connections/QtSql/QtSqlRowReader.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_QT)
+
+#include "../../../Source/Connections/QtSql/QtSqlMaterializedQuery.h" // for QtSqlMaterializedQuery
+#include "../../../Source/Utilities/QStringConverter.h" // for QStringConverter
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include <Nuclex/Support/Text/LexicalAppend.h> // for lexical_append<>
+
+#include <QString> // for QString
+
+#include <memory> // for std::shared_ptr, std::make_shared
+#include <stdexcept> // for std::out_of_range
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Sets up a temporary in-memory Qt database for testing</summary>
+  class TemporaryDatabaseScope {
+
+    /// <summary>Prepares a new in-memory database</summary>
+    public: inline TemporaryDatabaseScope();
+    /// <summary>Destroys the in-memory database, invalidating all open queries</summary>
+    public: inline ~TemporaryDatabaseScope();
+
+    /// <summary>Opens the in-memory database. Must be called before use</summary>
+    public: inline void OpenMemoryDatabase();
+
+    /// <summary>Fetches the Qt database instance (unique to the scope)</summary>
+    /// <returns>The Qt database instance</returns>
+    public: inline QSqlDatabase &GetDatabase();
+
+    /// <summary>Builds a unique name for the database</summary>
+    /// <param name="uniqueId">
+    ///   A unique value that should only exist once per active database
+    /// </param>
+    /// <returns>A Qt string containing a unique but descriptive name</returns>
+    private: inline static QString makeUniqueDatabaseName(std::uintptr_t uniqueId);
+
+    /// <summary>Name of the unique database instance, needed for cleanup</summary>
+    private: QString connectionName;
+    /// <summary>The temporary in-memory database created for this scope</summary>
+    private: QSqlDatabase qtDatabase;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline TemporaryDatabaseScope::TemporaryDatabaseScope() :
+    connectionName(),
+    qtDatabase() {
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+    std::intptr_t uniqueId = reinterpret_cast<std::intptr_t>(this);
+    this->connectionName = makeUniqueDatabaseName(uniqueId);
+
+    this->qtDatabase = QSqlDatabase::addDatabase(
+      QStringConverter::FromU8(std::u8string(u8"QSQLITE")), this->connectionName
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline TemporaryDatabaseScope::~TemporaryDatabaseScope() {
+    if(this->qtDatabase.isOpen()) {
+      this->qtDatabase.close();
+    }
+    QSqlDatabase::removeDatabase(this->connectionName);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void TemporaryDatabaseScope::OpenMemoryDatabase() {
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+    this->qtDatabase.setDatabaseName(
+      QStringConverter::FromU8(std::u8string(u8":memory:"))
+    );
+    if(!this->qtDatabase.open()) {
+      throw std::runtime_error(U8CHARS(u8"Failed to open memory database"));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline QSqlDatabase &TemporaryDatabaseScope::GetDatabase() {
+    return this->qtDatabase;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline QString TemporaryDatabaseScope::makeUniqueDatabaseName(std::uintptr_t uniqueId) {
+    using Nuclex::ThinOrm::Utilities::QStringConverter;
+
+    std::u8string name(u8"temp-", 5);
+    Nuclex::Support::Text::lexical_append(name, uniqueId);
+
+    return QStringConverter::FromU8(name);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Connections::QtSql {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(QtSqlRowReaderTest, ColumnSchemaIsAvailable) {
+    TemporaryDatabaseScope tempDb;
+    tempDb.OpenMemoryDatabase();
+
+    QtSqlMaterializedQuery(
+      tempDb.GetDatabase(), Query(u8"CREATE TABLE test (id INTEGER, name TEXT)")
+    ).RunWithoutResult();
+
+    std::shared_ptr<QtSqlMaterializedQuery> selectQuery = (
+      std::make_shared<QtSqlMaterializedQuery>(
+        tempDb.GetDatabase(), Query(u8"SELECT id, name FROM test")
+      )
+    );
+    std::unique_ptr<RowReader> reader = selectQuery->RunWithMultiRowResult(
+      selectQuery, std::weak_ptr<QtSqlMaterializedQueryCache>()
+    );
+
+    ASSERT_EQ(reader->CountColumns(), 2U);
+    EXPECT_EQ(reader->GetColumnName(0), u8"id");
+    EXPECT_EQ(reader->GetColumnName(1), u8"name");
+
+    // The schema was captured up front, so it survives the query being finished
+    EXPECT_FALSE(reader->MoveToNext());
+    EXPECT_EQ(reader->CountColumns(), 2U);
+    EXPECT_EQ(reader->GetColumnName(1), u8"name");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(QtSqlRowReaderTest, ColumnsCanBeLookedUpByNameIgnoringCase) {
+    TemporaryDatabaseScope tempDb;
+    tempDb.OpenMemoryDatabase();
+
+    std::shared_ptr<QtSqlMaterializedQuery> selectQuery = (
+      std::make_shared<QtSqlMaterializedQuery>(
+        tempDb.GetDatabase(), Query(u8"SELECT 12 AS First, 34 AS Second, 56 AS second")
+      )
+    );
+    std::unique_ptr<RowReader> reader = selectQuery->RunWithMultiRowResult(
+      selectQuery, std::weak_ptr<QtSqlMaterializedQueryCache>()
+    );
+
+    ASSERT_TRUE(reader->MoveToNext());
+    EXPECT_EQ(static_cast<std::int32_t>(reader->GetColumnValue(u8"first")), 12);
+    EXPECT_EQ(static_cast<std::int32_t>(reader->GetColumnValue(u8"FIRST")), 12);
+    EXPECT_THROW(reader->GetColumnValue(u8"second"), std::out_of_range);
+    EXPECT_THROW(reader->GetColumnValue(u8"third"), std::out_of_range);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections::QtSql
+
+#endif // defined(NUCLEX_THINORM_ENABLE_QT)
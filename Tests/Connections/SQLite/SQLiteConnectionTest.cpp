@@ -0,0 +1,497 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "../../../Source/Connections/SQLite/SQLiteConnection.h"
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+#include "../../../Source/Platform/SQLite3Api.h" // for SQLite3Api
+#include "Nuclex/ThinOrm/Query.h" // for Query
+#include "Nuclex/ThinOrm/RowReader.h" // for RowReader
+#include "Nuclex/ThinOrm/RowBatch.h" // for RowBatch
+#include "Nuclex/ThinOrm/Transactions/Transaction.h" // for Transaction
+
+#include <stdexcept> // for std::logic_error, std::out_of_range
+#include <string> // for std::string
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+  #include "Nuclex/ThinOrm/Errors/OperationCancelledError.h"
+  #include <coroutine> // for std::suspend_never
+  #include <future> // for std::promise, std::future
+  #include <exception> // for std::terminate()
+  #include <stop_token> // for std::stop_source
+  #include <thread> // for std::jthread, std::this_thread
+  #include <chrono> // for std::chrono::milliseconds
+#endif
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Opens a new, empty in-memory SQLite database</summary>
+  /// <returns>A connection to the in-memory database</returns>
+  std::shared_ptr<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection> openMemoryDatabase() {
+    using Nuclex::ThinOrm::Platform::SQLite3Api;
+    return std::make_shared<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection>(
+      SQLite3Api::Open(std::u8string(u8":memory:"))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Counts the rows in the 'test' table of the specified database</summary>
+  /// <param name="connection">Connection to the database whose rows will be counted</param>
+  /// <returns>The number of rows in the 'test' table</returns>
+  std::int32_t countTestRows(Nuclex::ThinOrm::Connections::Connection &connection) {
+    using Nuclex::ThinOrm::Query;
+    return static_cast<std::int32_t>(
+      connection.RunScalarQuery(Query(u8"SELECT COUNT(*) FROM test"))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+  /// <summary>Coroutine that starts immediately and cleans up after itself</summary>
+  struct DetachedCoroutine {
+
+    /// <summary>Controls how the detached coroutine is started and finished</summary>
+    struct promise_type {
+      DetachedCoroutine get_return_object() noexcept { return DetachedCoroutine(); }
+      std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+      std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Awaits a task and forwards its outcome to a promise</summary>
+  /// <param name="task">Task that will be awaited</param>
+  /// <param name="result">Promise that will receive the task's result or exception</param>
+  /// <returns>The detached coroutine doing the forwarding</returns>
+  template<typename TResult>
+  DetachedCoroutine forwardResult(asyncpp::task<TResult> task, std::promise<TResult> result) {
+    try {
+      if constexpr(std::is_void_v<TResult>) {
+        co_await std::move(task);
+        result.set_value();
+      } else {
+        result.set_value(co_await std::move(task));
+      }
+    }
+    catch(...) {
+      result.set_exception(std::current_exception());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Blocks the calling thread until a task has completed</summary>
+  /// <param name="task">Task that will be waited for</param>
+  /// <returns>The result provided by the task</returns>
+  template<typename TResult>
+  TResult waitFor(asyncpp::task<TResult> &&task) {
+    std::promise<TResult> result;
+    std::future<TResult> future = result.get_future();
+    forwardResult(std::move(task), std::move(result));
+    return future.get();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Connections::SQLite {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, CanRunScalarQuery) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    Value result = connection->RunScalarQuery(Query(u8"SELECT 42"));
+    EXPECT_EQ(static_cast<std::int32_t>(result), 42);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, ParametersAreBoundByIndex) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER, name TEXT)"));
+
+    Query insertQuery(u8"INSERT INTO test (id, name) VALUES ({id}, {name})");
+    insertQuery.SetParameterValue(u8"id", Value(std::int32_t(1)));
+    insertQuery.SetParameterValue(u8"name", Value(std::u8string(u8"one")));
+    EXPECT_EQ(connection->RunUpdateQuery(insertQuery), 1U);
+
+    insertQuery.SetParameterValue(u8"id", Value(std::int32_t(2)));
+    insertQuery.SetParameterValue(u8"name", Value(std::u8string(u8"two")));
+    EXPECT_EQ(connection->RunUpdateQuery(insertQuery), 1U);
+
+    std::unique_ptr<RowReader> reader = connection->RunRowQuery(
+      Query(u8"SELECT id, name FROM test ORDER BY id")
+    );
+    ASSERT_EQ(reader->CountColumns(), 2U);
+    EXPECT_EQ(reader->GetColumnName(1), u8"name");
+
+    ASSERT_TRUE(reader->MoveToNext());
+    EXPECT_EQ(static_cast<std::int32_t>(reader->GetColumnValue(0)), 1);
+    EXPECT_EQ(static_cast<std::u8string>(reader->GetColumnValue(u8"NAME")), u8"one");
+
+    ASSERT_TRUE(reader->MoveToNext());
+    EXPECT_EQ(static_cast<std::int32_t>(reader->GetColumnValue(0)), 2);
+    EXPECT_EQ(static_cast<std::u8string>(reader->GetColumnValue(u8"name")), u8"two");
+
+    EXPECT_FALSE(reader->MoveToNext());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, MissingColumnErrorNamesTheColumn) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    std::unique_ptr<RowReader> reader = connection->RunRowQuery(Query(u8"SELECT 1 AS id"));
+    ASSERT_TRUE(reader->MoveToNext());
+    try {
+      reader->GetColumnValue(u8"missing");
+      FAIL() << "Looking up a nonexistent column should throw";
+    }
+    catch(const std::out_of_range &error) {
+      EXPECT_NE(std::string(error.what()).find("'missing'"), std::string::npos);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, RepeatedParametersAreBoundOnce) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    Query scalarQuery(u8"SELECT {value} + {other} * {value}");
+    scalarQuery.SetParameterValue(u8"value", Value(std::int32_t(3)));
+    scalarQuery.SetParameterValue(u8"other", Value(std::int32_t(5)));
+    EXPECT_EQ(static_cast<std::int32_t>(connection->RunScalarQuery(scalarQuery)), 18);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, PreparedStatementsAreReused) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    Query scalarQuery(u8"SELECT {value}");
+    for(std::int32_t index = 0; index < 3; ++index) {
+      scalarQuery.SetParameterValue(0, Value(index));
+      EXPECT_EQ(static_cast<std::int32_t>(connection->RunScalarQuery(scalarQuery)), index);
+    }
+
+    StatementCacheStatistics statistics = connection->GetStatementCacheStatistics();
+    EXPECT_EQ(statistics.MissCount, 1U);
+    EXPECT_EQ(statistics.HitCount, 2U);
+    EXPECT_EQ(statistics.CachedStatementCount, 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, CanCheckIfTableExists) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    EXPECT_FALSE(connection->DoesTableOrViewExist(u8"test"));
+
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER)"));
+    EXPECT_TRUE(connection->DoesTableOrViewExist(u8"test"));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, RowsCanBeFetchedInBatches) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(
+      Query(u8"CREATE TABLE test (id INTEGER, name TEXT, ratio REAL, active BOOLEAN)")
+    );
+    connection->RunStatement(
+      Query(
+        u8"INSERT INTO test (id, name, ratio, active) VALUES "
+        u8"(1, 'one', 0.5, 1), (2, NULL, 1.5, 0), (3, 'three', NULL, 1)"
+      )
+    );
+
+    std::unique_ptr<RowReader> reader = connection->RunRowQuery(
+      Query(u8"SELECT id, name, ratio, active FROM test ORDER BY id")
+    );
+
+    RowBatch batch;
+    ASSERT_EQ(reader->FetchBatch(batch, 2), 2U);
+    ASSERT_EQ(batch.CountColumns(), 4U);
+    ASSERT_EQ(batch.CountRows(), 2U);
+    EXPECT_EQ(batch.GetColumn(1).GetName(), u8"name");
+
+    std::span<const std::int64_t> ids = batch.GetColumn(0).GetInt64s();
+    ASSERT_EQ(ids.size(), 2U);
+    EXPECT_EQ(ids[0], 1);
+    EXPECT_EQ(ids[1], 2);
+    EXPECT_EQ(batch.GetColumn(1).GetString(0), u8"one");
+    EXPECT_TRUE(batch.GetColumn(1).IsNull(1));
+    EXPECT_EQ(batch.GetColumn(2).GetDoubles()[1], 1.5);
+    EXPECT_EQ(batch.GetColumn(3).GetBooleans()[0], 1U);
+
+    // The second batch only gets the remaining row and reuses the same buffers
+    ASSERT_EQ(reader->FetchBatch(batch, 2), 1U);
+    ASSERT_EQ(batch.CountRows(), 1U);
+    EXPECT_EQ(batch.GetColumn(0).GetInt64s()[0], 3);
+    EXPECT_EQ(batch.GetColumn(1).GetString(0), u8"three");
+    EXPECT_TRUE(batch.GetColumn(2).IsNull(0));
+    EXPECT_FALSE(batch.GetColumn(3).IsNull(0));
+
+    EXPECT_EQ(reader->FetchBatch(batch, 2), 0U);
+    EXPECT_FALSE(reader->MoveToNext());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, StatementsCanBeRunInBatches) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER, name TEXT)"));
+
+    std::vector<std::size_t> affectedRowCounts = connection->RunBatch(
+      Query(u8"INSERT INTO test (id, name) VALUES ({id}, {name})"),
+      std::vector<std::vector<Value>> {
+        { Value(std::int32_t(1)), Value(std::u8string(u8"one")) },
+        { Value(std::int32_t(2)), Value(std::u8string(u8"two")) },
+        { Value(std::int32_t(3)), Value(std::u8string(u8"three")) }
+      }
+    );
+    ASSERT_EQ(affectedRowCounts.size(), 3U);
+    EXPECT_EQ(affectedRowCounts[0], 1U);
+    EXPECT_EQ(affectedRowCounts[2], 1U);
+    EXPECT_EQ(countTestRows(*connection), 3);
+
+    affectedRowCounts = connection->RunBatch(
+      Query(u8"DELETE FROM test WHERE id >= {id}"),
+      std::vector<std::vector<Value>> {
+        { Value(std::int32_t(3)) },
+        { Value(std::int32_t(1)) }
+      }
+    );
+    ASSERT_EQ(affectedRowCounts.size(), 2U);
+    EXPECT_EQ(affectedRowCounts[0], 1U);
+    EXPECT_EQ(affectedRowCounts[1], 2U);
+    EXPECT_EQ(countTestRows(*connection), 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, CommittedTransactionsArePersisted) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER)"));
+    {
+      Transactions::Transaction transaction = connection->BeginTransaction();
+      EXPECT_TRUE(transaction.IsActive());
+      EXPECT_FALSE(transaction.IsNested());
+      EXPECT_EQ(connection->GetTransactionDepth(), 1U);
+
+      connection->RunStatement(Query(u8"INSERT INTO test (id) VALUES (1)"));
+      transaction.Commit();
+      EXPECT_FALSE(transaction.IsActive());
+    }
+
+    EXPECT_EQ(connection->GetTransactionDepth(), 0U);
+    EXPECT_EQ(countTestRows(*connection), 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, UncommittedTransactionsAreRolledBack) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER)"));
+    {
+      Transactions::Transaction transaction = connection->BeginTransaction(
+        Transactions::IsolationLevel::Isolated_BlockConcurrentWrites
+      );
+      connection->RunStatement(Query(u8"INSERT INTO test (id) VALUES (1)"));
+      EXPECT_EQ(countTestRows(*connection), 1);
+    }
+
+    EXPECT_EQ(connection->GetTransactionDepth(), 0U);
+    EXPECT_EQ(countTestRows(*connection), 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, NestedTransactionsCanBeRolledBackAlone) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER)"));
+    {
+      Transactions::Transaction outer = connection->BeginTransaction();
+      connection->RunStatement(Query(u8"INSERT INTO test (id) VALUES (1)"));
+      {
+        Transactions::Transaction inner = connection->BeginTransaction();
+        EXPECT_TRUE(inner.IsNested());
+        EXPECT_EQ(connection->GetTransactionDepth(), 2U);
+
+        connection->RunStatement(Query(u8"INSERT INTO test (id) VALUES (2)"));
+        inner.Rollback();
+      }
+      {
+        Transactions::Transaction inner = connection->BeginTransaction();
+        connection->RunStatement(Query(u8"INSERT INTO test (id) VALUES (3)"));
+        inner.Commit();
+      }
+      outer.Commit();
+    }
+
+    EXPECT_EQ(countTestRows(*connection), 2);
+    EXPECT_EQ(
+      static_cast<std::int32_t>(connection->RunScalarQuery(Query(u8"SELECT SUM(id) FROM test"))),
+      4
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, TransactionCannotCommitBeforeNestedTransaction) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER)"));
+
+    Transactions::Transaction outer = connection->BeginTransaction();
+    Transactions::Transaction inner = connection->BeginTransaction();
+    EXPECT_THROW(outer.Commit(), std::logic_error);
+    EXPECT_TRUE(outer.IsActive());
+
+    // Rolling back the outer transaction also ends the nested one
+    outer.Rollback();
+    EXPECT_FALSE(inner.IsActive());
+    EXPECT_EQ(connection->GetTransactionDepth(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, EndedNestedTransactionIsNotRevivedByNewOnes) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+    connection->RunStatement(Query(u8"CREATE TABLE test (id INTEGER)"));
+
+    Transactions::Transaction staleOuter = connection->BeginTransaction();
+    Transactions::Transaction staleInner = connection->BeginTransaction();
+    staleOuter.Rollback();
+    EXPECT_FALSE(staleInner.IsActive());
+
+    // The new transactions reach the same depths as the ended ones, but the scope of
+    // the old nested transaction must neither consider itself active again nor touch
+    // the savepoint of the new nested transaction
+    Transactions::Transaction outer = connection->BeginTransaction();
+    Transactions::Transaction inner = connection->BeginTransaction();
+    EXPECT_FALSE(staleInner.IsActive());
+    EXPECT_THROW(staleInner.Commit(), std::logic_error);
+    staleInner.Rollback();
+    EXPECT_TRUE(inner.IsActive());
+    EXPECT_EQ(connection->GetTransactionDepth(), 2U);
+
+    connection->RunStatement(Query(u8"INSERT INTO test (id) VALUES (1)"));
+    inner.Commit();
+    outer.Commit();
+    EXPECT_EQ(countTestRows(*connection), 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+  TEST(SQLiteConnectionTest, QueriesCanBeRunAsynchronously) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    waitFor(connection->RunStatementAsync(Query(u8"CREATE TABLE test (id INTEGER)")));
+    EXPECT_EQ(
+      waitFor(connection->RunUpdateQueryAsync(Query(u8"INSERT INTO test VALUES (1), (2)"))),
+      2U
+    );
+
+    Value count = waitFor(connection->RunScalarQueryAsync(Query(u8"SELECT COUNT(*) FROM test")));
+    EXPECT_EQ(static_cast<std::int32_t>(count), 2);
+
+    std::unique_ptr<RowReader> reader = waitFor(
+      connection->RunRowQueryAsync(Query(u8"SELECT id FROM test ORDER BY id"))
+    );
+    ASSERT_TRUE(reader->MoveToNext());
+    EXPECT_EQ(static_cast<std::int32_t>(reader->GetColumnValue(0)), 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, CancelledAsynchronousQueriesAreNotRun) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    std::stop_source stopSource;
+    stopSource.request_stop();
+    EXPECT_THROW(
+      waitFor(
+        connection->RunStatementAsync(
+          Query(u8"CREATE TABLE test (id INTEGER)"), stopSource.get_token()
+        )
+      ),
+      Errors::OperationCancelledError
+    );
+    EXPECT_FALSE(connection->DoesTableOrViewExist(u8"test"));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SQLiteConnectionTest, RunningAsynchronousQueriesCanBeCancelled) {
+    std::shared_ptr<SQLiteConnection> connection = openMemoryDatabase();
+
+    // Counting this high takes far longer than the test is willing to wait, so the query
+    // only completes in time if the stop interrupts it while it is running
+    std::stop_source stopSource;
+    std::jthread stopper(
+      [&stopSource]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stopSource.request_stop();
+      }
+    );
+    EXPECT_THROW(
+      waitFor(
+        connection->RunScalarQueryAsync(
+          Query(
+            u8"WITH RECURSIVE counter(x) AS ("
+            u8"  SELECT 1 UNION ALL SELECT x + 1 FROM counter WHERE x < 10000000000"
+            u8") SELECT COUNT(*) FROM counter"
+          ),
+          stopSource.get_token()
+        )
+      ),
+      Errors::OperationCancelledError
+    );
+
+    // The connection remains usable after the interrupted query
+    EXPECT_EQ(static_cast<std::int32_t>(connection->RunScalarQuery(Query(u8"SELECT 1"))), 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#endif // defined(NUCLEX_THINORM_SUPPORT_ASYNCPP)
+
+} // namespace Nuclex::ThinOrm::Connections::SQLite
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
@@ -0,0 +1,220 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/Connections/StandardConnectionPool.h"
+
+#include "./DummyConnection.h" // for DummyConnection, DummyConnectionFactory
+
+#include <atomic> // for std::atomic
+#include <thread> // for std::thread, std::this_thread
+#include <chrono> // for std::chrono::milliseconds
+#include <vector> // for std::vector
+#include <stdexcept> // for std::logic_error
+
+namespace Nuclex::ThinOrm::Connections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, ReturnedConnectionsAreReused) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    pool.ReturnConnection(first);
+    std::shared_ptr<Connection> second = pool.BorrowConnection();
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(factory->ConnectCount.load(), 1U);
+    EXPECT_EQ(pool.CountOpenConnections(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, TryBorrowFailsWhenLimitIsReached) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString(), 3, 2);
+
+    std::shared_ptr<Connection> first = pool.TryBorrowConnection();
+    std::shared_ptr<Connection> second = pool.TryBorrowConnection();
+    ASSERT_TRUE(static_cast<bool>(first));
+    ASSERT_TRUE(static_cast<bool>(second));
+    EXPECT_FALSE(static_cast<bool>(pool.TryBorrowConnection()));
+
+    pool.ReturnConnection(second);
+    EXPECT_EQ(pool.TryBorrowConnection(), second);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, BorrowTimesOutWhenLimitIsReached) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString(), 3, 1);
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    EXPECT_THROW(
+      pool.BorrowConnection(std::chrono::milliseconds(10)), Errors::ConnectionPoolTimeoutError
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, DiscardedConnectionsFreeTheirSlot) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString(), 3, 1);
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    pool.DiscardConnection(first);
+    EXPECT_EQ(pool.CountOpenConnections(), 0U);
+
+    std::shared_ptr<Connection> second = pool.TryBorrowConnection();
+    ASSERT_TRUE(static_cast<bool>(second));
+    EXPECT_NE(first, second);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, WaitingBorrowersAreServed) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString(), 3, 2);
+
+    std::atomic<std::size_t> borrowCount = 0;
+    std::vector<std::thread> threads;
+    for(std::size_t index = 0; index < 8; ++index) {
+      threads.emplace_back(
+        [&pool, &borrowCount] {
+          for(std::size_t repetition = 0; repetition < 100; ++repetition) {
+            std::shared_ptr<Connection> connection = pool.BorrowConnection(
+              std::chrono::seconds(10)
+            );
+            ++borrowCount;
+            pool.ReturnConnection(connection);
+          }
+        }
+      );
+    }
+    for(std::thread &thread : threads) {
+      thread.join();
+    }
+
+    EXPECT_EQ(borrowCount.load(), 800U);
+    EXPECT_LE(factory->ConnectCount.load(), 2U);
+    EXPECT_LE(pool.CountOpenConnections(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, IdleConnectionsAreEvicted) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+    pool.SetMaximumIdleTime(std::chrono::milliseconds(1));
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    std::shared_ptr<Connection> second = pool.BorrowConnection();
+    pool.ReturnConnection(first);
+    pool.ReturnConnection(second);
+    EXPECT_EQ(pool.CountOpenConnections(), 2U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.PerformMaintenance();
+    EXPECT_EQ(pool.CountOpenConnections(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, MaintenanceKeepsMinimumIdleConnections) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+    pool.SetMaximumIdleTime(std::chrono::milliseconds(1));
+    pool.SetMinimumIdleConnectionCount(2);
+
+    pool.PerformMaintenance();
+    EXPECT_EQ(pool.CountOpenConnections(), 2U);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.PerformMaintenance();
+    EXPECT_EQ(pool.CountOpenConnections(), 2U);
+    EXPECT_EQ(factory->ConnectCount.load(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, UnhealthyConnectionsAreNotHandedOut) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+    pool.SetHealthCheckInterval(std::chrono::milliseconds(1));
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    std::static_pointer_cast<DummyConnection>(first)->IsHealthy = false;
+    pool.ReturnConnection(first);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::shared_ptr<Connection> second = pool.BorrowConnection();
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool.CountOpenConnections(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StandardConnectionPoolTest, MaintenanceThreadProbesRetainedConnections) {
+    std::shared_ptr<DummyConnectionFactory> factory = (
+      std::make_shared<DummyConnectionFactory>()
+    );
+    StandardConnectionPool<> pool(factory, Configuration::ConnectionString());
+    pool.SetHealthCheckInterval(std::chrono::milliseconds(1));
+
+    std::shared_ptr<Connection> first = pool.BorrowConnection();
+    std::static_pointer_cast<DummyConnection>(first)->IsHealthy = false;
+    pool.ReturnConnection(first);
+
+    pool.StartMaintenance(std::chrono::milliseconds(1));
+    for(std::size_t attempt = 0; attempt < 1000; ++attempt) {
+      if(pool.CountOpenConnections() == 0) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pool.StopMaintenance();
+
+    EXPECT_EQ(pool.CountOpenConnections(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Connections
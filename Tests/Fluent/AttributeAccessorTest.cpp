@@ -25,6 +25,7 @@ limitations under the License.
 #include "Nuclex/ThinOrm/Fluent/AttributeAccessor.h" // for AttributeAccessor
 
 #include <ctime> // for std::time()
+#include <vector> // for std::vector<>
 
 namespace {
 
@@ -44,6 +45,61 @@ namespace {
 
   // ------------------------------------------------------------------------------------------- //
 
+  /// <summary>Row reader that serves a single row of predefined values</summary>
+  class SingleRowReader : public Nuclex::ThinOrm::RowReader {
+
+    /// <summary>Initializes a new single row reader</summary>
+    /// <param name="values">Values of the columns in the row</param>
+    public: SingleRowReader(const std::vector<Nuclex::ThinOrm::Value> &values) :
+      values(values) {}
+
+    /// <summary>Tries to move to the next row in the result</summary>
+    /// <returns>Always false since the reader is permanently on its only row</returns>
+    public: bool MoveToNext() override { return false; }
+
+    /// <summary>Counts the number of columns the query result returns</summary>
+    /// <returns>The number of columns in the result</returns>
+    public: std::size_t CountColumns() const override { return this->values.size(); }
+
+    /// <summary>Retrieves the name of the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose name will be returned</param>
+    /// <returns>The name of the column with the specified index</returns>
+    public: const std::u8string GetColumnName(std::size_t columnIndex) const override {
+      (void)columnIndex;
+      return std::u8string();
+    }
+
+    /// <summary>Looks up the data type of the specified column</summary>
+    /// <param name="columnIndex">Index of the column whose data type will be looked up</param>
+    /// <returns>The data type of the specified column</returns>
+    public: Nuclex::ThinOrm::ValueType GetColumnType(std::size_t columnIndex) const override {
+      return this->values.at(columnIndex).GetType();
+    }
+
+    /// <summary>Retrieves the value of the specified column in the current row</summary>
+    /// <param name="columnIndex">Index of the column whose value will be retrieved</param>
+    /// <returns>The value of the specified column in the current row</returns>
+    public: Nuclex::ThinOrm::Value GetColumnValue(std::size_t columnIndex) const override {
+      return this->values.at(columnIndex);
+    }
+
+    /// <summary>Retrieves the value of the specified column in the current row</summary>
+    /// <param name="columnName">Name of the column whose value will be retrieved</param>
+    /// <returns>The value of the specified column in the current row</returns>
+    public: Nuclex::ThinOrm::Value GetColumnValue(
+      const std::u8string &columnName
+    ) const override {
+      (void)columnName;
+      throw std::out_of_range(reinterpret_cast<const char *>(u8"Columns have no names"));
+    }
+
+    /// <summary>Values of the columns in the row</summary>
+    private: std::vector<Nuclex::ThinOrm::Value> values;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // anonymous namespace
 
 namespace Nuclex::ThinOrm::Fluent {
@@ -101,4 +157,46 @@ namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(AttributeAccessorTest, CanReadAttributesFromRow) {
+    SingleRowReader reader(
+      { Value(std::int32_t(42)), Value(std::u8string(u8"Jane Doe")), Value(std::u8string(u8"hash")) }
+    );
+    TestEntity t = {};
+
+    AttributeAccessor<&TestEntity::Id>::Read(static_cast<void *>(&t), reader, 0);
+    AttributeAccessor<&TestEntity::Name>::Read(static_cast<void *>(&t), reader, 1);
+    AttributeAccessor<&TestEntity::PasswordHash>::Read(static_cast<void *>(&t), reader, 2);
+
+    EXPECT_EQ(t.Id, 42);
+    EXPECT_EQ(t.Name, std::u8string(u8"Jane Doe"));
+    ASSERT_TRUE(t.PasswordHash.has_value());
+    EXPECT_EQ(t.PasswordHash.value(), std::u8string(u8"hash"));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(AttributeAccessorTest, NullColumnsResetOptionalAttributes) {
+    SingleRowReader reader({ Value(std::optional<std::u8string>()) });
+    TestEntity t = {};
+    t.PasswordHash = u8"hash";
+
+    AttributeAccessor<&TestEntity::PasswordHash>::Read(static_cast<void *>(&t), reader, 0);
+
+    EXPECT_FALSE(t.PasswordHash.has_value());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(AttributeAccessorTest, NullColumnsCannotBeReadIntoRequiredAttributes) {
+    SingleRowReader reader({ Value(std::optional<std::u8string>()) });
+    TestEntity t = {};
+
+    EXPECT_THROW(
+      AttributeAccessor<&TestEntity::Name>::Read(static_cast<void *>(&t), reader, 0),
+      std::runtime_error
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm::Fluent
@@ -0,0 +1,248 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/Fluent/BulkInsertBuilder.h" // for BulkInsertBuilder
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+
+#include "../../Source/Connections/SQLite/SQLiteConnection.h" // for SQLiteConnection
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+  #include "../../Source/Platform/SQLite3Api.h" // for SQLite3Api
+#endif
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Example entity class for testing</summary>
+  class TestEntity {
+
+    /// <summary>An integer-typed attribute</summary>
+    public: int Id;
+    /// <summary>A UTF-8 string attribute</summary>
+    public: std::u8string Name;
+    /// <summary>An optional UTF-8 string attribute</summary>
+    public: std::optional<std::u8string> PasswordHash;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  /// <summary>SQLite connection that asks for backticks and records its updates</summary>
+  /// <remarks>
+  ///   SQLite accepts backticks around identifiers for compatibility with MySQL,
+  ///   so this connection can stand in for one that talks to MySQL.
+  /// </remarks>
+  class BacktickConnection : public Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection {
+
+    /// <summary>Initializes a new backtick-quoting SQLite connection</summary>
+    /// <param name="database">SQLite database the connection will access</param>
+    public: BacktickConnection(const std::shared_ptr<::sqlite3> &database) :
+      SQLiteConnection(database),
+      LastUpdateStatement() {}
+
+    /// <summary>Reports backticks as the quotes the database expects</summary>
+    /// <returns>The backtick quote style</returns>
+    public: Nuclex::ThinOrm::Dialects::QuoteStyle GetQuoteStyle() const override {
+      return Nuclex::ThinOrm::Dialects::QuoteStyle::Backticks;
+    }
+
+    /// <summary>Records the statement and runs it on the SQLite database</summary>
+    /// <param name="updateQuery">Query that will be run</param>
+    /// <returns>The number of rows affected by the query</returns>
+    public: std::size_t RunUpdateQuery(const Nuclex::ThinOrm::Query &updateQuery) override {
+      this->LastUpdateStatement = updateQuery.GetSqlStatement();
+      return SQLiteConnection::RunUpdateQuery(updateQuery);
+    }
+
+    /// <summary>SQL text of the most recent update query</summary>
+    public: std::u8string LastUpdateStatement;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Creates the 'users' table in a database</summary>
+  /// <param name="connection">Connection to the database the table will be created in</param>
+  void createUserTable(Nuclex::ThinOrm::Connections::Connection &connection) {
+    connection.RunStatement(
+      Nuclex::ThinOrm::Query(
+        u8"CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, passwordHash TEXT)"
+      )
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Opens a new in-memory SQLite database with a 'users' table</summary>
+  /// <returns>A connection to the in-memory database</returns>
+  std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> openUserDatabase() {
+    using Nuclex::ThinOrm::Platform::SQLite3Api;
+
+    std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> connection = (
+      std::make_shared<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection>(
+        SQLite3Api::Open(std::u8string(u8":memory:"))
+      )
+    );
+    createUserTable(*connection);
+
+    return connection;
+  }
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(BulkInsertBuilderTest, GeneratesMultiRowStatement) {
+    BulkInsertBuilder builder(u8"users", { u8"id", u8"name" });
+    EXPECT_EQ(builder.CountColumns(), 2U);
+
+    const Query &statement = builder.GetStatement(2);
+    EXPECT_EQ(
+      statement.GetSqlStatement(),
+      u8"INSERT INTO \"users\" (\"id\", \"name\") VALUES ({p0}, {p1}), ({p2}, {p3})"
+    );
+    EXPECT_EQ(statement.CountParameters(), 4U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(BulkInsertBuilderTest, StatementsAreCachedPerRowCount) {
+    BulkInsertBuilder builder(u8"users", { u8"id", u8"name" });
+
+    std::size_t statementId = builder.GetStatement(10).GetSqlStatementId();
+    EXPECT_NE(builder.GetStatement(3).GetSqlStatementId(), statementId);
+    EXPECT_EQ(builder.GetStatement(10).GetSqlStatementId(), statementId);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(BulkInsertBuilderTest, StatementsAreCachedPerQuoteStyle) {
+    BulkInsertBuilder builder(u8"users", { u8"id", u8"name" });
+
+    const Query &statement = builder.GetStatement(1, Dialects::QuoteStyle::Backticks);
+    EXPECT_EQ(
+      statement.GetSqlStatement(), u8"INSERT INTO `users` (`id`, `name`) VALUES ({p0}, {p1})"
+    );
+    EXPECT_NE(builder.GetStatement(1).GetSqlStatementId(), statement.GetSqlStatementId());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(BulkInsertBuilderTest, RowsPerStatementRespectParameterLimit) {
+    BulkInsertBuilder builder(u8"users", { u8"id", u8"name", u8"passwordHash" });
+
+    EXPECT_EQ(builder.GetMaximumRowsPerStatement(999), 333U);
+    EXPECT_EQ(
+      builder.GetMaximumRowsPerStatement(65535), BulkInsertBuilder::MaximumRowsPerStatement
+    );
+    EXPECT_THROW(builder.GetMaximumRowsPerStatement(2), std::invalid_argument);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  TEST(BulkInsertBuilderTest, CanInsertRowsInChunks) {
+    std::shared_ptr<Connections::Connection> connection = openUserDatabase();
+    BulkInsertBuilder builder(u8"users", { u8"id", u8"name", u8"passwordHash" });
+
+    // Enough rows to need multiple statements and a smaller one for the remainder
+    std::vector<std::vector<Value>> rows;
+    for(std::int32_t index = 0; index < 2500; ++index) {
+      rows.push_back(
+        { Value(index), Value(std::u8string(u8"user")), Value(std::optional<std::u8string>()) }
+      );
+    }
+
+    EXPECT_EQ(builder.Insert(*connection, rows), 2500U);
+    EXPECT_EQ(
+      static_cast<std::int32_t>(connection->RunScalarQuery(Query(u8"SELECT COUNT(*) FROM users"))),
+      2500
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(BulkInsertBuilderTest, CanInsertRegisteredEntities) {
+    GlobalEntityRegistry registry;
+    registry.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().AutoGenerated().PrimaryKey().
+      WithColumn<&TestEntity::Name>(u8"name").NotNull().
+      WithColumn<&TestEntity::PasswordHash>(u8"passwordHash");
+
+    // The auto-generated id column should be left for the database to fill
+    BulkInsertBuilder builder = registry.CreateBulkInsertBuilder<TestEntity>();
+    EXPECT_EQ(builder.CountColumns(), 2U);
+
+    std::vector<TestEntity> users(3);
+    users[0].Name = u8"Alice";
+    users[1].Name = u8"Bob";
+    users[2].Name = u8"Carol";
+    users[2].PasswordHash = u8"hash";
+
+    std::shared_ptr<Connections::Connection> connection = openUserDatabase();
+    EXPECT_EQ(builder.Insert(*connection, users), 3U);
+
+    Value name = connection->RunScalarQuery(
+      Query(u8"SELECT name FROM users WHERE passwordHash = 'hash'")
+    );
+    EXPECT_EQ(name.AsString(), u8"Carol");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(BulkInsertBuilderTest, InsertUsesTheConnectionsQuoteStyle) {
+    GlobalEntityRegistry registry;
+    registry.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().AutoGenerated().PrimaryKey().
+      WithColumn<&TestEntity::Name>(u8"name").NotNull().
+      WithColumn<&TestEntity::PasswordHash>(u8"passwordHash");
+    BulkInsertBuilder builder = registry.CreateBulkInsertBuilder<TestEntity>();
+
+    BacktickConnection connection(Platform::SQLite3Api::Open(std::u8string(u8":memory:")));
+    createUserTable(connection);
+
+    std::vector<TestEntity> users(1);
+    users[0].Name = u8"Alice";
+    EXPECT_EQ(builder.Insert(connection, users), 1U);
+    EXPECT_EQ(
+      connection.LastUpdateStatement,
+      u8"INSERT INTO `users` (`name`, `passwordHash`) VALUES ({p0}, {p1})"
+    );
+  }
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
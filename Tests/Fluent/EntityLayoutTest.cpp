@@ -0,0 +1,302 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include "../../Source/Fluent/EntityLayout.h"
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/Fluent/AttributeAccessor.h" // for AttributeAccessor
+#include "Nuclex/ThinOrm/Dialects/UpsertStyle.h" // for UpsertStyle
+#include "Nuclex/ThinOrm/Dialects/QuoteStyle.h" // for QuoteStyle
+
+#include <stdexcept> // for std::invalid_argument
+#include <string> // for std::string, std::to_string()
+#include <typeinfo> // for typeid
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Example entity class for testing</summary>
+  class TestEntity {
+
+    /// <summary>An integer-typed attribute</summary>
+    public: int Id;
+    /// <summary>A UTF-8 string attribute</summary>
+    public: std::u8string Name;
+    /// <summary>An integer-typed attribute the database fills in</summary>
+    public: int Revision;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Adds a column for an attribute of the test entity to a table description</summary>
+  /// <typeparam name="AttributePointer">Pointer to the attribute the column maps to</typeparam>
+  /// <param name="tableInfo">Table description the column will be added to</param>
+  /// <param name="name">Name of the column in the database table</param>
+  /// <returns>The column that has been added</returns>
+  template<auto AttributePointer>
+  Nuclex::ThinOrm::Fluent::ColumnInfo &addColumn(
+    Nuclex::ThinOrm::Fluent::TableInfo &tableInfo, const std::u8string &name
+  ) {
+    using Nuclex::ThinOrm::Fluent::AttributePointerTraits;
+    typedef Nuclex::ThinOrm::Fluent::AttributeAccessor<AttributePointer> Accessor;
+    typedef typename AttributePointerTraits<decltype(AttributePointer)>::AttributeType Attribute;
+
+    return tableInfo.Columns.emplace_back(
+      name,
+      typeid(Attribute),
+      &Accessor::Get, &Accessor::Set, &Accessor::Read
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Describes the 'users' table with an id, a name and a revision column</summary>
+  /// <returns>A description of the 'users' table</returns>
+  Nuclex::ThinOrm::Fluent::TableInfo describeUsersTable() {
+    Nuclex::ThinOrm::Fluent::TableInfo tableInfo(u8"users", typeid(TestEntity));
+    addColumn<&TestEntity::Id>(tableInfo, u8"id").IsPrimaryKey = true;
+    addColumn<&TestEntity::Name>(tableInfo, u8"name");
+    addColumn<&TestEntity::Revision>(tableInfo, u8"revision").IsAutogenerated = true;
+    return tableInfo;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, ColumnFlagsAreCollectedInBitSets) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(layout.GetQuotedTableName(Dialects::QuoteStyle::DoubleQuotes), u8"\"users\"");
+    ASSERT_EQ(layout.Columns.size(), 3U);
+    EXPECT_EQ(layout.GetQuotedColumnName(1, Dialects::QuoteStyle::DoubleQuotes), u8"\"name\"");
+
+    EXPECT_TRUE(layout.PrimaryKeyColumns.Test(0));
+    EXPECT_EQ(layout.PrimaryKeyColumns.Count(), 1U);
+    EXPECT_TRUE(layout.AutogeneratedColumns.Test(2));
+    EXPECT_EQ(layout.AutogeneratedColumns.Count(), 1U);
+    EXPECT_EQ(layout.UpsertColumns.Count(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, EntitiesCanMapMoreThan64Columns) {
+    TableInfo tableInfo(u8"wide", typeid(TestEntity));
+    addColumn<&TestEntity::Id>(tableInfo, u8"id").IsPrimaryKey = true;
+    for(std::size_t index = 1; index < 100; ++index) {
+      std::string name = std::string("column") + std::to_string(index);
+      addColumn<&TestEntity::Name>(tableInfo, std::u8string(name.begin(), name.end()));
+    }
+    EntityLayout layout(tableInfo);
+
+    EXPECT_EQ(layout.Columns.size(), 100U);
+    EXPECT_EQ(layout.UpdatableColumns.Count(), 99U);
+
+    ColumnSet assignedColumns;
+    assignedColumns.Set(99);
+    EXPECT_EQ(
+      layout.FormUpdateStatement(assignedColumns, Dialects::QuoteStyle::DoubleQuotes),
+      u8"UPDATE \"wide\" SET \"column99\" = {p0} WHERE \"id\" = {p1}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, InsertLeavesOutAutoGeneratedColumns) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(
+      layout.FormInsertStatement(Dialects::QuoteStyle::DoubleQuotes, 2),
+      u8"INSERT INTO \"users\" (\"id\", \"name\") VALUES ({p0}, {p1}), ({p2}, {p3})"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, CanFormOnConflictUpsert) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(
+      layout.FormUpsertStatement(
+        Dialects::UpsertStyle::OnConflictDoUpdate, Dialects::QuoteStyle::DoubleQuotes, 2
+      ),
+      u8"INSERT INTO \"users\" (\"id\", \"name\") VALUES ({p0}, {p1}), ({p2}, {p3}) "
+      u8"ON CONFLICT (\"id\") DO UPDATE SET \"name\" = excluded.\"name\""
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, CanFormOnDuplicateKeyUpsert) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(
+      layout.FormUpsertStatement(
+        Dialects::UpsertStyle::OnDuplicateKeyUpdate, Dialects::QuoteStyle::Backticks, 1
+      ),
+      u8"INSERT INTO `users` (`id`, `name`) VALUES ({p0}, {p1}) "
+      u8"ON DUPLICATE KEY UPDATE `name` = VALUES(`name`)"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, KeyOnlyUpsertsDoNothingOnConflict) {
+    TableInfo tableInfo(u8"tags", typeid(TestEntity));
+    addColumn<&TestEntity::Name>(tableInfo, u8"name").IsPrimaryKey = true;
+    EntityLayout layout(tableInfo);
+
+    EXPECT_EQ(
+      layout.FormUpsertStatement(
+        Dialects::UpsertStyle::OnConflictDoUpdate, Dialects::QuoteStyle::DoubleQuotes, 1
+      ),
+      u8"INSERT INTO \"tags\" (\"name\") VALUES ({p0}) ON CONFLICT (\"name\") DO NOTHING"
+    );
+    EXPECT_EQ(
+      layout.FormUpsertStatement(
+        Dialects::UpsertStyle::OnDuplicateKeyUpdate, Dialects::QuoteStyle::Backticks, 1
+      ),
+      u8"INSERT INTO `tags` (`name`) VALUES ({p0}) ON DUPLICATE KEY UPDATE `name` = `name`"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, UpdateOnlyAssignsRequestedColumns) {
+    EntityLayout layout(describeUsersTable());
+    EXPECT_EQ(layout.UpdatableColumns.Count(), 1U);
+
+    EXPECT_EQ(
+      layout.FormUpdateStatement(layout.UpdatableColumns, Dialects::QuoteStyle::DoubleQuotes),
+      u8"UPDATE \"users\" SET \"name\" = {p0} WHERE \"id\" = {p1}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, UpdateUsesTheRequestedQuoteStyle) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(
+      layout.FormUpdateStatement(layout.UpdatableColumns, Dialects::QuoteStyle::Backticks),
+      u8"UPDATE `users` SET `name` = {p0} WHERE `id` = {p1}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, UpdateMatchesAllPrimaryKeyColumns) {
+    TableInfo tableInfo(u8"memberships", typeid(TestEntity));
+    addColumn<&TestEntity::Id>(tableInfo, u8"groupId").IsPrimaryKey = true;
+    addColumn<&TestEntity::Revision>(tableInfo, u8"userId").IsPrimaryKey = true;
+    addColumn<&TestEntity::Name>(tableInfo, u8"role");
+    EntityLayout layout(tableInfo);
+
+    ColumnSet assignedColumns;
+    assignedColumns.Set(2);
+    EXPECT_EQ(
+      layout.FormUpdateStatement(assignedColumns, Dialects::QuoteStyle::DoubleQuotes),
+      u8"UPDATE \"memberships\" SET \"role\" = {p0} "
+      u8"WHERE \"groupId\" = {p1} AND \"userId\" = {p2}"
+    );
+    EXPECT_THROW(
+      layout.FormUpdateStatement(ColumnSet(), Dialects::QuoteStyle::DoubleQuotes),
+      std::invalid_argument
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, PagedSelectIsOrderedByPrimaryKey) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(
+      layout.GetSelectPlan(
+        SelectShape::Paged, Dialects::QuoteStyle::DoubleQuotes
+      ).Statement.GetSqlStatement(),
+      u8"SELECT \"id\", \"name\", \"revision\" FROM \"users\" "
+      u8"ORDER BY \"id\" LIMIT {limit} OFFSET {offset}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, PagedSelectWithoutPrimaryKeyIsUnordered) {
+    TableInfo tableInfo(u8"log", typeid(TestEntity));
+    addColumn<&TestEntity::Name>(tableInfo, u8"message");
+    EntityLayout layout(tableInfo);
+
+    EXPECT_EQ(
+      layout.GetSelectPlan(
+        SelectShape::Paged, Dialects::QuoteStyle::DoubleQuotes
+      ).Statement.GetSqlStatement(),
+      u8"SELECT \"message\" FROM \"log\" LIMIT {limit} OFFSET {offset}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, SelectPlansUseTheRequestedQuoteStyle) {
+    EntityLayout layout(describeUsersTable());
+
+    EXPECT_EQ(
+      layout.GetSelectPlan(
+        SelectShape::All, Dialects::QuoteStyle::Backticks
+      ).Statement.GetSqlStatement(),
+      u8"SELECT `id`, `name`, `revision` FROM `users`"
+    );
+    EXPECT_EQ(
+      layout.GetSelectPlan(
+        SelectShape::KeyOrdered, Dialects::QuoteStyle::Brackets
+      ).Statement.GetSqlStatement(),
+      u8"SELECT [id], [name], [revision] FROM [users] ORDER BY [id] LIMIT {limit}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EntityLayoutTest, KeyOrderedSelectComparesRowValues) {
+    TableInfo tableInfo(u8"memberships", typeid(TestEntity));
+    addColumn<&TestEntity::Id>(tableInfo, u8"groupId").IsPrimaryKey = true;
+    addColumn<&TestEntity::Revision>(tableInfo, u8"userId").IsPrimaryKey = true;
+    EntityLayout layout(tableInfo);
+
+    EXPECT_EQ(
+      layout.GetSelectPlan(
+        SelectShape::KeyOrderedAfter, Dialects::QuoteStyle::DoubleQuotes
+      ).Statement.GetSqlStatement(),
+      u8"SELECT \"groupId\", \"userId\" FROM \"memberships\" "
+      u8"WHERE (\"groupId\", \"userId\") > ({key0}, {key1}) "
+      u8"ORDER BY \"groupId\", \"userId\" LIMIT {limit}"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
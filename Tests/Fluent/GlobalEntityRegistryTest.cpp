@@ -23,8 +23,10 @@ limitations under the License.
 #include <gtest/gtest.h>
 
 #include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+#include "Nuclex/ThinOrm/Query.h" // for Query
 
 #include <ctime> // for std::time()
+#include <stdexcept> // for std::logic_error
 
 namespace {
 
@@ -61,4 +63,51 @@ namespace Nuclex::ThinOrm::Fluent {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(GlobalEntityRegistryTest, FreezesOnFirstUse) {
+    GlobalEntityRegistry r;
+    r.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().AutoGenerated().PrimaryKey().
+      WithColumn<&TestEntity::Name>(u8"name").NotNull();
+
+    EXPECT_FALSE(r.IsFrozen());
+    r.CreateBulkInsertBuilder<TestEntity>();
+    EXPECT_TRUE(r.IsFrozen());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(GlobalEntityRegistryTest, MappingsCanNotBeChangedAfterFreezing) {
+    GlobalEntityRegistry r;
+    r.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().AutoGenerated().PrimaryKey();
+
+    r.Freeze();
+    EXPECT_THROW(
+      r.AddEntity(typeid(TestEntity), u8"people"),
+      std::logic_error
+    );
+    EXPECT_THROW(
+      r.SetColumnNullable(typeid(TestEntity), u8"id"),
+      std::logic_error
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(GlobalEntityRegistryTest, ColumnsKeepDeclarationOrder) {
+    GlobalEntityRegistry r;
+    r.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::PasswordHash>(u8"passwordHash").
+      WithColumn<&TestEntity::Name>(u8"name").NotNull().
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().PrimaryKey();
+
+    BulkInsertBuilder builder = r.CreateBulkInsertBuilder<TestEntity>();
+    EXPECT_EQ(
+      builder.GetStatement(1).GetSqlStatement(),
+      u8"INSERT INTO \"users\" (\"passwordHash\", \"name\", \"id\") VALUES ({p0}, {p1}, {p2})"
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm::Fluent
@@ -0,0 +1,630 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/Fluent/Table.h" // for Table
+#include "Nuclex/ThinOrm/Fluent/ChangeTracker.h" // for ChangeTracker
+#include "Nuclex/ThinOrm/Fluent/GlobalEntityRegistry.h" // for GlobalEntityRegistry
+#include "Nuclex/ThinOrm/DataContext.h" // for DataContext
+#include "Nuclex/ThinOrm/Connections/StatementCacheStatistics.h"
+
+#include "../../Source/Connections/SQLite/SQLiteConnection.h" // for SQLiteConnection
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+  #include "../../Source/Platform/SQLite3Api.h" // for SQLite3Api
+#endif
+
+#include <span> // for std::span<>
+#include <ranges> // for std::ranges::input_range
+#include <stdexcept> // for std::invalid_argument, std::logic_error
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Example entity class for testing</summary>
+  class TestEntity {
+
+    /// <summary>An integer-typed attribute</summary>
+    public: int Id;
+    /// <summary>A UTF-8 string attribute</summary>
+    public: std::u8string Name;
+    /// <summary>An optional UTF-8 string attribute</summary>
+    public: std::optional<std::u8string> PasswordHash;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Example entity class with a composite primary key</summary>
+  class TestMembership {
+
+    /// <summary>Id of the group the user is a member of</summary>
+    public: int GroupId;
+    /// <summary>Id of the user who is a member of the group</summary>
+    public: int UserId;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  /// <summary>Data context exposing a table of test entities</summary>
+  class TestDataContext : public Nuclex::ThinOrm::DataContext {
+
+    /// <summary>Initializes a new test data context</summary>
+    /// <param name="connection">Connection to the database that will be accessed</param>
+    /// <param name="registry">Entity registry holding the mapping for test entities</param>
+    public: TestDataContext(
+      const std::shared_ptr<Nuclex::ThinOrm::Connections::Connection> &connection,
+      Nuclex::ThinOrm::Fluent::GlobalEntityRegistry &registry
+    ) :
+      DataContext(connection, registry),
+      Users(*this) {}
+
+    /// <summary>Users stored in the database</summary>
+    public: Nuclex::ThinOrm::Fluent::Table<TestEntity> Users;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Maps the test entity to the 'users' table</summary>
+  /// <param name="registry">Registry in which the test entity will be registered</param>
+  void registerTestEntity(Nuclex::ThinOrm::Fluent::GlobalEntityRegistry &registry) {
+    registry.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().AutoGenerated().PrimaryKey().
+      WithColumn<&TestEntity::Name>(u8"name").NotNull().
+      WithColumn<&TestEntity::PasswordHash>(u8"passwordHash");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Opens a new in-memory SQLite database with a 'users' table</summary>
+  /// <param name="userCount">Number of users that will be added to the table</param>
+  /// <returns>A connection to the in-memory database</returns>
+  std::shared_ptr<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection> openUserDatabase(
+    std::int32_t userCount
+  ) {
+    using Nuclex::ThinOrm::Platform::SQLite3Api;
+    using Nuclex::ThinOrm::Query;
+    using Nuclex::ThinOrm::Value;
+
+    std::shared_ptr<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection> connection = (
+      std::make_shared<Nuclex::ThinOrm::Connections::SQLite::SQLiteConnection>(
+        SQLite3Api::Open(std::u8string(u8":memory:"))
+      )
+    );
+    connection->RunStatement(
+      Query(u8"CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT, passwordHash TEXT)")
+    );
+
+    Query insertQuery(u8"INSERT INTO users (id, name) VALUES ({id}, {name})");
+    for(std::int32_t index = 1; index <= userCount; ++index) {
+      std::u8string name(u8"user");
+      name.push_back(static_cast<char8_t>(u8'0' + index % 10));
+      insertQuery.SetParameterValue(0, Value(index));
+      insertQuery.SetParameterValue(1, Value(name));
+      connection->RunUpdateQuery(insertQuery);
+    }
+
+    return connection;
+  }
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm::Fluent {
+
+  // ------------------------------------------------------------------------------------------- //
+
+#if defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  TEST(TableTest, CanFetchAllEntities) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    std::vector<TestEntity> users = context.Users.ToVector();
+    ASSERT_EQ(users.size(), 3U);
+    EXPECT_EQ(users[0].Id, 1);
+    EXPECT_EQ(users[0].Name, u8"user1");
+    EXPECT_FALSE(users[0].PasswordHash.has_value());
+    EXPECT_EQ(users[2].Id, 3);
+    EXPECT_EQ(users[2].Name, u8"user3");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, SkipAndTakeSelectWindow) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(10), registry);
+
+    std::vector<TestEntity> users = context.Users.Skip(2).Take(3).ToVector();
+    ASSERT_EQ(users.size(), 3U);
+    EXPECT_EQ(users[0].Id, 3);
+    EXPECT_EQ(users[2].Id, 5);
+
+    // Skipping after taking eats into the taken rows
+    users = context.Users.Take(5).Skip(3).ToVector();
+    ASSERT_EQ(users.size(), 2U);
+    EXPECT_EQ(users[0].Id, 4);
+    EXPECT_EQ(users[1].Id, 5);
+
+    // Skip without Take still needs to return all remaining rows
+    users = context.Users.Skip(8).ToVector();
+    ASSERT_EQ(users.size(), 2U);
+    EXPECT_EQ(users[1].Id, 10);
+
+    // The table itself must not have been modified by any of the above
+    EXPECT_EQ(context.Users.ToVector().size(), 10U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, GeneratedStatementsAreReused) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    std::shared_ptr<Connections::SQLite::SQLiteConnection> connection = openUserDatabase(10);
+    TestDataContext context(connection, registry);
+
+    Connections::StatementCacheStatistics before = connection->GetStatementCacheStatistics();
+    for(std::size_t page = 0; page < 5; ++page) {
+      EXPECT_EQ(context.Users.Skip(page * 2).Take(2).ToVector().size(), 2U);
+    }
+    Connections::StatementCacheStatistics after = connection->GetStatementCacheStatistics();
+
+    // All pages share one statement with different parameters, so it's only prepared once
+    EXPECT_EQ(after.MissCount - before.MissCount, 1U);
+    EXPECT_EQ(after.HitCount - before.HitCount, 4U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, FirstReturnsFirstRow) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    EXPECT_EQ(context.Users.First().Id, 1);
+    EXPECT_EQ(context.Users.Skip(1).First().Id, 2);
+    EXPECT_THROW(context.Users.Skip(3).First(), Errors::UnexpectedResultCountError);
+
+    EXPECT_FALSE(context.Users.Skip(3).FirstOrDefault().has_value());
+    std::optional<TestEntity> first = context.Users.FirstOrDefault();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first.value().Name, u8"user1");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, SingleRequiresExactlyOneRow) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    EXPECT_EQ(context.Users.Skip(2).Single().Id, 3);
+    EXPECT_THROW(context.Users.Single(), Errors::UnexpectedResultCountError);
+    EXPECT_THROW(context.Users.Skip(3).Single(), Errors::UnexpectedResultCountError);
+
+    EXPECT_FALSE(context.Users.Skip(3).SingleOrDefault().has_value());
+    EXPECT_THROW(context.Users.SingleOrDefault(), Errors::UnexpectedResultCountError);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, CanAppendToExistingVector) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(5), registry);
+
+    std::vector<TestEntity> users(1);
+    users[0].Id = 42;
+    context.Users.Skip(3).AppendTo(users);
+
+    // Existing entities must be kept and the results added behind them
+    ASSERT_EQ(users.size(), 3U);
+    EXPECT_EQ(users[0].Id, 42);
+    EXPECT_EQ(users[1].Id, 4);
+    EXPECT_EQ(users[2].Id, 5);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, CanVisitEntitiesInChunks) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(10), registry);
+
+    std::vector<std::size_t> chunkSizes;
+    std::vector<std::int32_t> ids;
+    context.Users.ForEachChunk(
+      4,
+      [&chunkSizes, &ids](std::span<TestEntity> chunk) {
+        chunkSizes.push_back(chunk.size());
+        for(TestEntity &user : chunk) {
+          ids.push_back(user.Id);
+        }
+      }
+    );
+
+    ASSERT_EQ(chunkSizes.size(), 3U);
+    EXPECT_EQ(chunkSizes[0], 4U);
+    EXPECT_EQ(chunkSizes[1], 4U);
+    EXPECT_EQ(chunkSizes[2], 2U);
+
+    ASSERT_EQ(ids.size(), 10U);
+    for(std::size_t index = 0; index < 10; ++index) {
+      EXPECT_EQ(ids[index], static_cast<std::int32_t>(index + 1));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, ChunkSizeMustNotBeZero) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(1), registry);
+
+    EXPECT_THROW(
+      context.Users.ForEachChunk(0, [](std::span<TestEntity>) {}),
+      std::invalid_argument
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, EnumeratorIsInputRange) {
+    EXPECT_TRUE(std::ranges::input_range<EntityEnumerator<TestEntity>>);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, CanEnumerateEntities) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(10), registry);
+
+    std::vector<std::int32_t> ids;
+    const TestEntity *previousUser = nullptr;
+    for(const TestEntity &user : context.Users.Skip(2).Enumerate()) {
+      ids.push_back(user.Id);
+
+      // All rows should be read into the same entity instance
+      if(previousUser != nullptr) {
+        EXPECT_EQ(&user, previousUser);
+      }
+      previousUser = &user;
+    }
+
+    ASSERT_EQ(ids.size(), 8U);
+    EXPECT_EQ(ids[0], 3);
+    EXPECT_EQ(ids[7], 10);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, EnumeratorCanBeAdvancedManually) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(2), registry);
+
+    EntityEnumerator<TestEntity> enumerator = context.Users.Enumerate();
+    ASSERT_TRUE(enumerator.MoveToNext());
+    EXPECT_EQ(enumerator.GetCurrent().Name, u8"user1");
+    ASSERT_TRUE(enumerator.MoveToNext());
+    EXPECT_EQ(enumerator.GetCurrent().Name, u8"user2");
+    EXPECT_FALSE(enumerator.MoveToNext());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, KeysetPaginationWalksWholeTable) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(10), registry);
+
+    KeysetCursor cursor;
+    std::vector<TestEntity> page = context.Users.NextPage(cursor, 4);
+    ASSERT_EQ(page.size(), 4U);
+    EXPECT_EQ(page[0].Id, 1);
+    EXPECT_EQ(page[3].Id, 4);
+    EXPECT_FALSE(cursor.IsAtEnd());
+
+    page = context.Users.NextPage(cursor, 4);
+    ASSERT_EQ(page.size(), 4U);
+    EXPECT_EQ(page[0].Id, 5);
+
+    page = context.Users.NextPage(cursor, 4);
+    ASSERT_EQ(page.size(), 2U);
+    EXPECT_EQ(page[1].Id, 10);
+    EXPECT_TRUE(cursor.IsAtEnd());
+
+    // Past the end, the cursor should stay on the last row
+    EXPECT_TRUE(context.Users.NextPage(cursor, 4).empty());
+    ASSERT_EQ(cursor.GetLastKey().size(), 1U);
+    EXPECT_EQ(static_cast<std::int32_t>(cursor.GetLastKey()[0]), 10);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, KeysetCursorCanBeResumed) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(10), registry);
+
+    KeysetCursor cursor({ Value(std::int32_t(6)) });
+    std::vector<TestEntity> page = context.Users.NextPage(cursor, 3);
+    ASSERT_EQ(page.size(), 3U);
+    EXPECT_EQ(page[0].Id, 7);
+    EXPECT_EQ(page[2].Id, 9);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, KeysetPaginationSupportsCompositeKeys) {
+    GlobalEntityRegistry registry;
+    registry.RegisterTable<TestMembership>(u8"memberships").
+      WithColumn<&TestMembership::GroupId>(u8"groupId").NotNull().PrimaryKey().
+      WithColumn<&TestMembership::UserId>(u8"userId").NotNull().PrimaryKey();
+
+    std::shared_ptr<Connections::Connection> connection = openUserDatabase(0);
+    connection->RunStatement(
+      Query(
+        u8"CREATE TABLE memberships (groupId INTEGER, userId INTEGER, "
+        u8"PRIMARY KEY (groupId, userId))"
+      )
+    );
+    connection->RunStatement(
+      Query(u8"INSERT INTO memberships VALUES (2, 1), (1, 2), (1, 1), (2, 3), (1, 3)")
+    );
+
+    DataContext context(connection, registry);
+    Table<TestMembership> memberships(context);
+
+    KeysetCursor cursor;
+    std::vector<TestMembership> page = memberships.NextPage(cursor, 2);
+    ASSERT_EQ(page.size(), 2U);
+    EXPECT_EQ(page[1].GroupId, 1);
+    EXPECT_EQ(page[1].UserId, 2);
+
+    page = memberships.NextPage(cursor, 2);
+    ASSERT_EQ(page.size(), 2U);
+    EXPECT_EQ(page[0].GroupId, 1);
+    EXPECT_EQ(page[0].UserId, 3);
+    EXPECT_EQ(page[1].GroupId, 2);
+    EXPECT_EQ(page[1].UserId, 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, KeysetPaginationRequiresPrimaryKey) {
+    GlobalEntityRegistry registry;
+    registry.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().
+      WithColumn<&TestEntity::Name>(u8"name").NotNull();
+    TestDataContext context(openUserDatabase(1), registry);
+
+    KeysetCursor cursor;
+    EXPECT_THROW(context.Users.NextPage(cursor, 10), std::invalid_argument);
+    EXPECT_THROW(context.Users.Skip(1).NextPage(cursor, 10), std::logic_error);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, UpsertInsertsOrUpdatesByPrimaryKey) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    TestEntity changedUser;
+    changedUser.Id = 2;
+    changedUser.Name = u8"changed";
+    changedUser.PasswordHash = u8"hash";
+    context.Users.Upsert(changedUser);
+
+    TestEntity newUser;
+    newUser.Id = 4;
+    newUser.Name = u8"new";
+    context.Users.Upsert(newUser);
+
+    std::vector<TestEntity> users = context.Users.ToVector();
+    ASSERT_EQ(users.size(), 4U);
+    EXPECT_EQ(users[1].Name, u8"changed");
+    ASSERT_TRUE(users[1].PasswordHash.has_value());
+    EXPECT_EQ(users[1].PasswordHash.value(), u8"hash");
+    EXPECT_EQ(users[3].Name, u8"new");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, UpsertCanWriteManyEntitiesInBatches) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(10), registry);
+
+    // Enough entities to need multiple statements, overlapping the existing rows
+    std::vector<TestEntity> users(2500);
+    for(std::size_t index = 0; index < users.size(); ++index) {
+      users[index].Id = static_cast<int>(index + 1);
+      users[index].Name = u8"synchronized";
+    }
+    context.Users.Upsert(users);
+
+    std::vector<TestEntity> storedUsers = context.Users.ToVector();
+    ASSERT_EQ(storedUsers.size(), 2500U);
+    EXPECT_EQ(storedUsers[0].Name, u8"synchronized");
+    EXPECT_EQ(storedUsers[2499].Id, 2500);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, UpsertInsertsEntitiesWithoutAssignedKeys) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(2), registry);
+
+    std::vector<TestEntity> newUsers(2);
+    newUsers[0].Id = 0;
+    newUsers[0].Name = u8"first";
+    newUsers[1].Id = 0;
+    newUsers[1].Name = u8"second";
+    EXPECT_EQ(context.Users.Upsert(newUsers), 2U);
+
+    TestEntity thirdUser;
+    thirdUser.Id = 0;
+    thirdUser.Name = u8"third";
+    context.Users.Upsert(thirdUser);
+
+    std::vector<TestEntity> storedUsers = context.Users.ToVector();
+    ASSERT_EQ(storedUsers.size(), 5U);
+    EXPECT_EQ(storedUsers[0].Name, u8"user1");
+    EXPECT_EQ(storedUsers[2].Name, u8"first");
+    EXPECT_EQ(storedUsers[3].Name, u8"second");
+    EXPECT_EQ(storedUsers[4].Name, u8"third");
+    EXPECT_EQ(storedUsers[4].Id, 5);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, UpsertRequiresPrimaryKey) {
+    GlobalEntityRegistry registry;
+    registry.RegisterTable<TestEntity>(u8"users").
+      WithColumn<&TestEntity::Id>(u8"id").NotNull().
+      WithColumn<&TestEntity::Name>(u8"name").NotNull();
+    TestDataContext context(openUserDatabase(1), registry);
+
+    TestEntity user;
+    user.Id = 1;
+    EXPECT_THROW(context.Users.Upsert(user), std::invalid_argument);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, UpdateWritesEntityIntoItsRow) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    std::vector<TestEntity> users = context.Users.ToVector();
+    ASSERT_EQ(users.size(), 3U);
+    users[1].Name = u8"changed";
+    users[1].PasswordHash = u8"hash";
+    EXPECT_EQ(context.Users.Update(users[1]), 1U);
+
+    std::vector<TestEntity> storedUsers = context.Users.ToVector();
+    ASSERT_EQ(storedUsers.size(), 3U);
+    EXPECT_EQ(storedUsers[0].Name, u8"user1");
+    EXPECT_EQ(storedUsers[1].Name, u8"changed");
+    ASSERT_TRUE(storedUsers[1].PasswordHash.has_value());
+    EXPECT_EQ(storedUsers[1].PasswordHash.value(), u8"hash");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, ChangeTrackerOnlyWritesChangedColumns) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    std::shared_ptr<Connections::SQLite::SQLiteConnection> connection = openUserDatabase(3);
+    TestDataContext context(connection, registry);
+
+    ChangeTracker<TestEntity> tracker(context);
+    std::vector<TestEntity> users = context.Users.ToVector(tracker);
+    ASSERT_EQ(users.size(), 3U);
+    EXPECT_EQ(tracker.CountTrackedEntities(), 3U);
+    EXPECT_FALSE(tracker.HasChanges(users[0]));
+
+    // Change the name behind the tracker's back. Since only the password hash is
+    // modified on the entity, the update must leave the name alone.
+    connection->RunUpdateQuery(Query(u8"UPDATE users SET name = 'external' WHERE id = 1"));
+    users[0].PasswordHash = u8"hash";
+    EXPECT_TRUE(tracker.HasChanges(users[0]));
+    EXPECT_EQ(tracker.Update(users[0]), 1U);
+    EXPECT_FALSE(tracker.HasChanges(users[0]));
+
+    std::vector<TestEntity> storedUsers = context.Users.ToVector();
+    ASSERT_EQ(storedUsers.size(), 3U);
+    EXPECT_EQ(storedUsers[0].Name, u8"external");
+    ASSERT_TRUE(storedUsers[0].PasswordHash.has_value());
+    EXPECT_EQ(storedUsers[0].PasswordHash.value(), u8"hash");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, ChangeTrackerSkipsUnchangedEntities) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    ChangeTracker<TestEntity> tracker(context);
+    std::vector<TestEntity> users = context.Users.ToVector(tracker);
+    ASSERT_EQ(users.size(), 3U);
+
+    users[2].Name = u8"changed";
+    EXPECT_EQ(tracker.Update(users), 1U);
+    EXPECT_EQ(tracker.Update(users), 0U);
+
+    std::vector<TestEntity> storedUsers = context.Users.ToVector();
+    ASSERT_EQ(storedUsers.size(), 3U);
+    EXPECT_EQ(storedUsers[2].Name, u8"changed");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, ChangeTrackerRejectsUntrackedEntities) {
+    GlobalEntityRegistry registry;
+    registerTestEntity(registry);
+    TestDataContext context(openUserDatabase(3), registry);
+
+    ChangeTracker<TestEntity> tracker(context);
+    std::vector<TestEntity> users = context.Users.ToVector(tracker);
+    ASSERT_EQ(users.size(), 3U);
+
+    tracker.Forget(users[0]);
+    EXPECT_FALSE(tracker.IsTracked(users[0]));
+    EXPECT_THROW(tracker.Update(users[0]), std::logic_error);
+
+    // Entities are identified by primary key, so changing it loses the snapshot
+    users[1].Id = 42;
+    EXPECT_THROW(tracker.HasChanges(users[1]), std::logic_error);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TableTest, QueryingUnregisteredEntityThrows) {
+    GlobalEntityRegistry registry;
+    TestDataContext context(openUserDatabase(1), registry);
+
+    EXPECT_THROW(context.Users.ToVector(), std::invalid_argument);
+  }
+
+#endif // defined(NUCLEX_THINORM_ENABLE_SQLITE)
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Fluent
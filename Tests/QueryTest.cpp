@@ -106,6 +106,55 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(QueryTest, RepeatedParametersShareOneSlot) {
+    std::u8string queryString(
+      u8"SELECT * FROM users WHERE name={name} OR nickname={NAME} OR age={age}", 69
+    );
+    Query query(queryString);
+
+    const std::vector<QueryParameterView> &parameters = query.GetParameterInfo();
+    ASSERT_EQ(parameters.size(), 3U);
+    EXPECT_EQ(parameters.at(0).SlotIndex, 0U);
+    EXPECT_EQ(parameters.at(1).SlotIndex, 0U);
+    EXPECT_EQ(parameters.at(2).SlotIndex, 1U);
+
+    query.SetParameterValue(1, Value(456));
+    EXPECT_EQ(query.GetParameterValue(0).AsInt32(), 456);
+    EXPECT_EQ(query.GetParameterValue(u8"Name").AsInt32(), 456);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(QueryTest, ClearedParametersAreUnassigned) {
+    std::u8string queryString(u8"SELECT * FROM users WHERE name={userName}", 41);
+    Query query(queryString);
+
+    query.SetParameterValue(0, Value(123));
+    query.ClearParameterValues();
+    EXPECT_THROW(
+      query.GetParameterValue(0),
+      Nuclex::ThinOrm::Errors::UnassignedParameterError
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(QueryTest, InternedQueriesShareStatementId) {
+    std::u8string queryString(u8"SELECT * FROM users WHERE name={userName}", 41);
+
+    Query first = Query::FromInternedStatement(queryString);
+    Query second = Query::FromInternedStatement(queryString);
+    EXPECT_EQ(first.GetSqlStatementId(), second.GetSqlStatementId());
+    EXPECT_NE(Query(queryString).GetSqlStatementId(), first.GetSqlStatementId());
+
+    first.SetParameterValue(u8"userName", Value(1));
+    second.SetParameterValue(u8"userName", Value(2));
+    EXPECT_EQ(first.GetParameterValue(0).AsInt32(), 1);
+    EXPECT_EQ(second.GetParameterValue(0).AsInt32(), 2);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   TEST(QueryTest, CurlyBracesCanBeEscaped) {
     std::u8string queryString(
       u8"SELECT * FROM users WHERE age >= {minimumAge} AND name='{{curly}}'", 66
@@ -0,0 +1,138 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/RowBatch.h"
+#include "Nuclex/ThinOrm/Errors/BadValueTypeError.h"
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RowBatchTest, StartsOutEmpty) {
+    RowBatch batch;
+    EXPECT_EQ(batch.CountColumns(), 0U);
+    EXPECT_EQ(batch.CountRows(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RowBatchTest, IntegersAreNarrowedToColumnType) {
+    RowBatchColumn column;
+    column.Reset(ValueType::Int16, u8"id");
+    column.AppendInteger(123);
+    column.AppendNull();
+    column.AppendInteger(-456);
+
+    std::span<const std::int16_t> values = column.GetInt16s();
+    ASSERT_EQ(values.size(), 3U);
+    EXPECT_EQ(values[0], 123);
+    EXPECT_EQ(values[1], 0);
+    EXPECT_EQ(values[2], -456);
+    EXPECT_FALSE(column.IsNull(0));
+    EXPECT_TRUE(column.IsNull(1));
+    EXPECT_FALSE(column.IsNull(2));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RowBatchTest, StringsArePackedIntoOneBuffer) {
+    RowBatchColumn column;
+    column.Reset(ValueType::String, u8"name");
+    column.AppendString(u8"Hello");
+    column.AppendNull();
+    column.AppendString(u8"");
+    column.AppendString(u8"World");
+
+    ASSERT_EQ(column.CountRows(), 4U);
+    EXPECT_EQ(column.GetString(0), u8"Hello");
+    EXPECT_TRUE(column.IsNull(1));
+    EXPECT_EQ(column.GetString(1), u8"");
+    EXPECT_EQ(column.GetString(2), u8"");
+    EXPECT_FALSE(column.IsNull(2));
+    EXPECT_EQ(column.GetString(3), u8"World");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RowBatchTest, NullBitmapCoversManyRows) {
+    RowBatchColumn column;
+    column.Reset(ValueType::Double, u8"ratio");
+    for(std::size_t index = 0; index < 200; ++index) {
+      if((index % 3) == 0) {
+        column.AppendNull();
+      } else {
+        column.AppendFloatingPoint(static_cast<double>(index));
+      }
+    }
+
+    EXPECT_EQ(column.GetNullBitmap().size(), 4U);
+    for(std::size_t index = 0; index < 200; ++index) {
+      EXPECT_EQ(column.IsNull(index), (index % 3) == 0);
+    }
+
+    // Resetting must not leave stale null bits from the previous rows behind
+    column.Reset(ValueType::Double, u8"ratio");
+    column.AppendFloatingPoint(1.0);
+    EXPECT_FALSE(column.IsNull(0));
+    EXPECT_EQ(column.GetDoubles()[0], 1.0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RowBatchTest, GenericValuesAreConvertedToColumnType) {
+    RowBatchColumn column;
+    column.Reset(ValueType::Int32, u8"count");
+    column.AppendValue(Value(std::int64_t(42)));
+    column.AppendValue(Value(std::optional<std::int32_t>()));
+
+    EXPECT_EQ(column.GetInt32s()[0], 42);
+    EXPECT_TRUE(column.IsNull(1));
+
+    Value boxed = column.GetValue(0);
+    EXPECT_EQ(boxed.GetType(), ValueType::Int32);
+    EXPECT_EQ(static_cast<std::int32_t>(boxed), 42);
+    EXPECT_TRUE(column.GetValue(1).IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RowBatchTest, AccessingWrongTypeThrowsException) {
+    RowBatchColumn column;
+    column.Reset(ValueType::Int64, u8"id");
+    column.AppendInteger(1);
+
+    EXPECT_THROW(column.GetInt32s(), Errors::BadValueTypeError);
+    EXPECT_THROW(column.AppendString(u8"text"), Errors::BadValueTypeError);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
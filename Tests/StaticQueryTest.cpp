@@ -0,0 +1,92 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "Nuclex/ThinOrm/StaticQuery.h"
+#include "Nuclex/ThinOrm/Value.h"
+#include "Nuclex/ThinOrm/Errors/BadParameterNameError.h"
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Static query used to check the compile-time parameter parsing</summary>
+  typedef Nuclex::ThinOrm::StaticQuery<
+    u8"SELECT * FROM users WHERE name={userName} OR nickname={USERNAME} AND age>={age}"
+  > FindUserQuery;
+
+  // The parameters should be known at compile time
+  static_assert(FindUserQuery::ParameterCount == 3);
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::ThinOrm {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StaticQueryTest, ParametersAreProvidedWithoutParsing) {
+    FindUserQuery query;
+
+    const std::vector<QueryParameterView> &parameters = query.GetParameterInfo();
+    ASSERT_EQ(parameters.size(), 3U);
+    EXPECT_TRUE(parameters.at(0).Name == std::u8string(u8"userName"));
+    EXPECT_EQ(parameters.at(0).SlotIndex, 0U);
+    EXPECT_EQ(parameters.at(1).SlotIndex, 0U);
+    EXPECT_TRUE(parameters.at(2).Name == std::u8string(u8"age"));
+    EXPECT_EQ(parameters.at(2).SlotIndex, 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StaticQueryTest, InstancesShareStatementId) {
+    FindUserQuery first;
+    FindUserQuery second;
+    EXPECT_EQ(first.GetSqlStatementId(), second.GetSqlStatementId());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StaticQueryTest, ParametersCanBeAssignedByCheckedName) {
+    FindUserQuery query;
+
+    query.SetParameterValue<u8"age">(Value(21));
+    EXPECT_EQ(query.GetParameterValue<u8"AGE">().AsInt32(), 21);
+    EXPECT_EQ(query.GetParameterValue(2).AsInt32(), 21);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(StaticQueryTest, RuntimeParameterNamesAreStillChecked) {
+    FindUserQuery query;
+
+    EXPECT_THROW(
+      query.SetParameterValue(u8"mooh", Value(10)),
+      Nuclex::ThinOrm::Errors::BadParameterNameError
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm
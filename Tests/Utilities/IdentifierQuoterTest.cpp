@@ -0,0 +1,55 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_THINORM_SOURCE 1
+
+#include <gtest/gtest.h>
+
+#include "../../Source/Utilities/IdentifierQuoter.h" // for IdentifierQuoter
+
+namespace Nuclex::ThinOrm::Utilities {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(IdentifierQuoterTest, IdentifiersCanBeQuoted) {
+    EXPECT_EQ(IdentifierQuoter::Quote(u8"users"), u8"\"users\"");
+    EXPECT_EQ(IdentifierQuoter::Quote(u8"users", Dialects::QuoteStyle::Brackets), u8"[users]");
+    EXPECT_EQ(IdentifierQuoter::Quote(u8"users", Dialects::QuoteStyle::Backticks), u8"`users`");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(IdentifierQuoterTest, ClosingQuotesAreEscaped) {
+    EXPECT_EQ(IdentifierQuoter::Quote(u8"a\"b"), u8"\"a\"\"b\"");
+    EXPECT_EQ(IdentifierQuoter::Quote(u8"a]b[", Dialects::QuoteStyle::Brackets), u8"[a]]b[]");
+    EXPECT_EQ(IdentifierQuoter::Quote(u8"a`b", Dialects::QuoteStyle::Backticks), u8"`a``b`");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(IdentifierQuoterTest, QuotedIdentifiersCanBeAppended) {
+    std::u8string statement(u8"SELECT * FROM ");
+    IdentifierQuoter::AppendQuoted(statement, u8"my table");
+    EXPECT_EQ(statement, u8"SELECT * FROM \"my table\"");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::ThinOrm::Utilities
@@ -211,4 +211,68 @@ namespace Nuclex::ThinOrm {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(ValueTest, ShortAndLongStringsCanBeStored) {
+    std::u8string shortString(u8"Hello World");
+    std::u8string longString(u8"This string is too long to fit into the short string storage");
+
+    Value shortValue{std::u8string_view(shortString)};
+    Value longValue{std::u8string_view(longString)};
+    EXPECT_EQ(shortValue.GetStringView().value(), shortString);
+    EXPECT_EQ(longValue.GetStringView().value(), longString);
+
+    Value shortCopy(shortValue);
+    Value longCopy(longValue);
+    EXPECT_EQ(shortCopy.AsString(), shortString);
+    EXPECT_EQ(longCopy.AsString(), longString);
+
+    shortCopy = longValue;
+    longCopy = shortValue;
+    EXPECT_EQ(shortCopy.AsString(), longString);
+    EXPECT_EQ(longCopy.AsString(), shortString);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ValueTest, StringsCanBeMovedIn) {
+    std::u8string longString(u8"This string is too long to fit into the short string storage");
+    const char8_t *characters = longString.data();
+
+    Value longValue(std::move(longString));
+    EXPECT_EQ(longValue.GetStringView().value().data(), characters);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ValueTest, BlobsCanBeViewed) {
+    std::vector<std::byte> blob = { std::byte(1), std::byte(2), std::byte(3) };
+    const std::byte *bytes = blob.data();
+
+    Value blobValue(std::move(blob));
+    std::optional<std::span<const std::byte>> view = blobValue.GetBlobView();
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view.value().data(), bytes);
+    EXPECT_EQ(view.value().size(), 3U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ValueTest, ViewsRequireMatchingType) {
+    Value integerValue(std::int32_t(123));
+    EXPECT_THROW(integerValue.GetStringView(), Errors::BadValueTypeError);
+    EXPECT_THROW(integerValue.GetBlobView(), Errors::BadValueTypeError);
+
+    Value emptyString(std::optional<std::u8string>{});
+    EXPECT_FALSE(emptyString.GetStringView().has_value());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ValueTest, AssigningEmptyValueMakesValueEmpty) {
+    Value testValue(std::u8string(u8"This string is too long for the short string storage"));
+    testValue = Value(std::optional<std::u8string>{});
+    EXPECT_TRUE(testValue.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::ThinOrm